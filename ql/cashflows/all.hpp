@@ -7,7 +7,9 @@
 #include <ql/cashflows/cashflows.hpp>
 #include <ql/cashflows/cashflowvectors.hpp>
 #include <ql/cashflows/cmscoupon.hpp>
+#include <ql/cashflows/cmsreplicationcache.hpp>
 #include <ql/cashflows/cmsreplicationpricer.hpp>
+#include <ql/cashflows/compiledleg.hpp>
 #include <ql/cashflows/conundrumpricer.hpp>
 #include <ql/cashflows/coupon.hpp>
 #include <ql/cashflows/couponpricer.hpp>
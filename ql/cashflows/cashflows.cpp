@@ -21,6 +21,7 @@
 */
 
 #include <ql/cashflows/cashflows.hpp>
+#include <ql/cashflows/compiledleg.hpp>
 #include <ql/cashflows/coupon.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/math/solvers1d/brent.hpp>
@@ -29,6 +30,7 @@
 #include <ql/patterns/visitor.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/termstructures/yield/zerospreadedtermstructure.hpp>
+#include <algorithm>
 
 using boost::shared_ptr;
 using boost::dynamic_pointer_cast;
@@ -1306,4 +1308,452 @@ namespace QuantLib {
         return solver.solve(objFunction, accuracy, guess, step);
     }
 
+
+    // compiled-leg utility functions
+    namespace {
+
+        // alive flows of a compiled leg, discounted at a flat yield
+        class CompiledYieldFlows {
+          public:
+            CompiledYieldFlows(const CompiledLeg& leg,
+                               const DayCounter& dayCounter,
+                               bool includeSettlementDateFlows,
+                               const Date& settlementDate,
+                               const Date& npvDate) {
+                std::vector<CompiledLeg::FlowStatus> status;
+                std::vector<Real> amounts;
+                leg.status(includeSettlementDateFlows, settlementDate,
+                           status);
+                leg.amounts(status, amounts);
+
+                const std::vector<Date>& dates = leg.dates();
+                const std::vector<bool>& isCoupon = leg.isCoupon();
+                Date lastDate = npvDate;
+                Date refStartDate, refEndDate;
+                for (Size i=0; i<leg.size(); ++i) {
+                    if (status[i] == CompiledLeg::Occurred)
+                        continue;
+
+                    const Date& couponDate = dates[i];
+                    if (isCoupon[i]) {
+                        refStartDate = leg.referencePeriodStarts()[i];
+                        refEndDate = leg.referencePeriodEnds()[i];
+                    } else {
+                        if (lastDate == npvDate) {
+                            // we don't have a previous coupon date,
+                            // so we fake it
+                            refStartDate = couponDate - 1*Years;
+                        } else  {
+                            refStartDate = lastDate;
+                        }
+                        refEndDate = couponDate;
+                    }
+                    QL_REQUIRE(couponDate>=lastDate,
+                               "d1 (" << lastDate << ") "
+                               "later than d2 (" << couponDate << ")");
+                    periods_.push_back(
+                        dayCounter.yearFraction(lastDate, couponDate,
+                                                refStartDate, refEndDate));
+                    amounts_.push_back(amounts[i]);
+                    lastDate = couponDate;
+                }
+            }
+            const std::vector<Real>& amounts() const { return amounts_; }
+            Real npv(const InterestRate& y) const {
+                Real npv = 0.0;
+                DiscountFactor discount = 1.0;
+                for (Size i=0; i<amounts_.size(); ++i) {
+                    discount *= y.discountFactor(periods_[i]);
+                    npv += amounts_[i] * discount;
+                }
+                return npv;
+            }
+            // derivative of the NPV with respect to the yield
+            Real npvDerivative(const InterestRate& y) const {
+                Rate r = y.rate();
+                Real N = Real(y.frequency());
+                Real dPdy = 0.0, dLogDiscount = 0.0;
+                DiscountFactor discount = 1.0;
+                for (Size i=0; i<amounts_.size(); ++i) {
+                    Time t = periods_[i];
+                    DiscountFactor B = y.discountFactor(t);
+                    discount *= B;
+                    switch (y.compounding()) {
+                      case Simple:
+                        dLogDiscount -= t * B;
+                        break;
+                      case Compounded:
+                        dLogDiscount -= t/(1.0+r/N);
+                        break;
+                      case Continuous:
+                        dLogDiscount -= t;
+                        break;
+                      case SimpleThenCompounded:
+                        if (t<=1.0/N)
+                            dLogDiscount -= t * B;
+                        else
+                            dLogDiscount -= t/(1.0+r/N);
+                        break;
+                      default:
+                        QL_FAIL("unknown compounding convention (" <<
+                                Integer(y.compounding()) << ")");
+                    }
+                    dPdy += amounts_[i] * discount * dLogDiscount;
+                }
+                return dPdy;
+            }
+          private:
+            std::vector<Real> amounts_;
+            std::vector<Time> periods_;
+        };
+
+        class CompiledIrrFinder : public std::unary_function<Rate, Real> {
+          public:
+            CompiledIrrFinder(const CompiledYieldFlows& flows,
+                              Real npv,
+                              const DayCounter& dayCounter,
+                              Compounding comp,
+                              Frequency freq)
+            : flows_(flows), npv_(npv),
+              dayCounter_(dayCounter), compounding_(comp), frequency_(freq) {
+                checkSign();
+            }
+            Real operator()(Rate y) const {
+                InterestRate yield(y, dayCounter_, compounding_, frequency_);
+                return npv_ - flows_.npv(yield);
+            }
+            Real derivative(Rate y) const {
+                InterestRate yield(y, dayCounter_, compounding_, frequency_);
+                return -flows_.npvDerivative(yield);
+            }
+          private:
+            void checkSign() const {
+                // see IrrFinder::checkSign; flows trading ex-coupon
+                // have null amounts and don't change the sign.
+                const std::vector<Real>& amounts = flows_.amounts();
+                Integer lastSign = sign(-npv_),
+                        signChanges = 0;
+                for (Size i = 0; i < amounts.size(); ++i) {
+                    Integer thisSign = sign(amounts[i]);
+                    if (lastSign * thisSign < 0) // sign change
+                        signChanges++;
+
+                    if (thisSign != 0)
+                        lastSign = thisSign;
+                }
+                QL_REQUIRE(signChanges > 0,
+                           "the given cash flows cannot result in the given market "
+                           "price due to their sign");
+            }
+            const CompiledYieldFlows& flows_;
+            Real npv_;
+            DayCounter dayCounter_;
+            Compounding compounding_;
+            Frequency frequency_;
+        };
+
+        // alive flows of a compiled leg, discounted on a z-spreaded
+        // curve as done by ZeroSpreadedTermStructure
+        class CompiledZSpreadFlows {
+          public:
+            CompiledZSpreadFlows(const CompiledLeg& leg,
+                                 const YieldTermStructure& discountCurve,
+                                 const DayCounter& dayCounter,
+                                 Compounding comp,
+                                 Frequency freq,
+                                 bool includeSettlementDateFlows,
+                                 const Date& settlementDate,
+                                 const Date& npvDate)
+            : dayCounter_(dayCounter), compounding_(comp), frequency_(freq) {
+                std::vector<CompiledLeg::FlowStatus> status;
+                std::vector<Real> amounts;
+                leg.status(includeSettlementDateFlows, settlementDate,
+                           status);
+                leg.amounts(status, amounts);
+                std::vector<Time> times;
+                leg.times(discountCurve.referenceDate(),
+                          discountCurve.dayCounter(), times);
+                for (Size i=0; i<leg.size(); ++i) {
+                    if (status[i] == CompiledLeg::Alive) {
+                        amounts_.push_back(amounts[i]);
+                        times_.push_back(times[i]);
+                    }
+                }
+                npvTime_ = discountCurve.timeFromReference(npvDate);
+
+                // the spreaded curve has the same time range and
+                // extrapolation settings as the original one; the
+                // range check it would perform is done here, after
+                // which the original rates are extrapolated as needed.
+                std::vector<Time> t(times_);
+                t.push_back(npvTime_);
+                Time tMin = *std::min_element(t.begin(), t.end());
+                Time tMax = *std::max_element(t.begin(), t.end());
+                QL_REQUIRE(tMin >= 0.0,
+                           "negative time (" << tMin << ") given");
+                QL_REQUIRE(discountCurve.allowsExtrapolation()
+                           || tMax <= discountCurve.maxTime() + QL_EPSILON,
+                           "time (" << tMax << ") is past max curve time ("
+                           << discountCurve.maxTime() << ")");
+                discountCurve.zeroRate(t, zeroRates_, compounding_,
+                                       frequency_, true);
+                npvZeroRate_ = zeroRates_.back();
+                zeroRates_.pop_back();
+            }
+            Real npv(Spread zSpread) const {
+                Real npv = 0.0;
+                for (Size i=0; i<amounts_.size(); ++i)
+                    npv += amounts_[i] *
+                           discount(zeroRates_[i], zSpread, times_[i]);
+                return npv/discount(npvZeroRate_, zSpread, npvTime_);
+            }
+          private:
+            DiscountFactor discount(Rate zeroRate, Spread zSpread,
+                                    Time t) const {
+                if (t == 0.0)
+                    return 1.0;
+                InterestRate spreadedRate(zeroRate + zSpread, dayCounter_,
+                                          compounding_, frequency_);
+                return spreadedRate.discountFactor(t);
+            }
+            DayCounter dayCounter_;
+            Compounding compounding_;
+            Frequency frequency_;
+            std::vector<Real> amounts_, zeroRates_;
+            std::vector<Time> times_;
+            Time npvTime_;
+            Rate npvZeroRate_;
+        };
+
+        class CompiledZSpreadFinder : public std::unary_function<Rate, Real> {
+          public:
+            CompiledZSpreadFinder(const CompiledZSpreadFlows& flows,
+                                  Real npv)
+            : flows_(flows), npv_(npv) {}
+            Real operator()(Rate zSpread) const {
+                return npv_ - flows_.npv(zSpread);
+            }
+          private:
+            const CompiledZSpreadFlows& flows_;
+            Real npv_;
+        };
+
+    } // anonymous namespace ends here
+
+    Real CashFlows::npv(const CompiledLeg& leg,
+                        const YieldTermStructure& discountCurve,
+                        bool includeSettlementDateFlows,
+                        Date settlementDate,
+                        Date npvDate) {
+        Real npv, bps;
+        npvbps(leg, discountCurve, includeSettlementDateFlows,
+               settlementDate, npvDate, npv, bps);
+        return npv;
+    }
+
+    Real CashFlows::bps(const CompiledLeg& leg,
+                        const YieldTermStructure& discountCurve,
+                        bool includeSettlementDateFlows,
+                        Date settlementDate,
+                        Date npvDate) {
+        Real npv, bps;
+        npvbps(leg, discountCurve, includeSettlementDateFlows,
+               settlementDate, npvDate, npv, bps);
+        return bps;
+    }
+
+    void CashFlows::npvbps(const CompiledLeg& leg,
+                           const YieldTermStructure& discountCurve,
+                           bool includeSettlementDateFlows,
+                           Date settlementDate,
+                           Date npvDate,
+                           Real& npv,
+                           Real& bps) {
+
+        npv = 0.0;
+        bps = 0.0;
+        if (leg.empty())
+            return;
+
+        if (settlementDate == Date())
+            settlementDate = Settings::instance().evaluationDate();
+
+        if (npvDate == Date())
+            npvDate = settlementDate;
+
+        std::vector<CompiledLeg::FlowStatus> status;
+        std::vector<Real> amounts;
+        leg.status(includeSettlementDateFlows, settlementDate, status);
+        leg.amounts(status, amounts);
+        std::vector<Time> times;
+        leg.times(discountCurve.referenceDate(),
+                  discountCurve.dayCounter(), times);
+        const std::vector<Real>& sensitivities = leg.rateSensitivities();
+
+        std::vector<Time> aliveTimes;
+        std::vector<Size> aliveFlows;
+        aliveTimes.reserve(leg.size());
+        aliveFlows.reserve(leg.size());
+        for (Size i=0; i<leg.size(); ++i) {
+            if (status[i] == CompiledLeg::Alive) {
+                aliveTimes.push_back(times[i]);
+                aliveFlows.push_back(i);
+            }
+        }
+        std::vector<DiscountFactor> discounts;
+        discountCurve.discount(aliveTimes, discounts);
+
+        for (Size j=0; j<aliveFlows.size(); ++j) {
+            Size i = aliveFlows[j];
+            npv += amounts[i] * discounts[j];
+            bps += sensitivities[i] * discounts[j];
+        }
+        DiscountFactor d = discountCurve.discount(npvDate);
+        npv /= d;
+        bps = basisPoint_ * bps / d;
+    }
+
+    Real CashFlows::npv(const CompiledLeg& leg,
+                        const InterestRate& y,
+                        bool includeSettlementDateFlows,
+                        Date settlementDate,
+                        Date npvDate) {
+
+        if (leg.empty())
+            return 0.0;
+
+        if (settlementDate == Date())
+            settlementDate = Settings::instance().evaluationDate();
+
+        if (npvDate == Date())
+            npvDate = settlementDate;
+
+        CompiledYieldFlows flows(leg, y.dayCounter(),
+                                 includeSettlementDateFlows,
+                                 settlementDate, npvDate);
+        return flows.npv(y);
+    }
+
+    Real CashFlows::npv(const CompiledLeg& leg,
+                        Rate yield,
+                        const DayCounter& dc,
+                        Compounding comp,
+                        Frequency freq,
+                        bool includeSettlementDateFlows,
+                        Date settlementDate,
+                        Date npvDate) {
+        return npv(leg, InterestRate(yield, dc, comp, freq),
+                   includeSettlementDateFlows,
+                   settlementDate, npvDate);
+    }
+
+    Real CashFlows::bps(const CompiledLeg& leg,
+                        const InterestRate& yield,
+                        bool includeSettlementDateFlows,
+                        Date settlementDate,
+                        Date npvDate) {
+
+        if (leg.empty())
+            return 0.0;
+
+        if (settlementDate == Date())
+            settlementDate = Settings::instance().evaluationDate();
+
+        if (npvDate == Date())
+            npvDate = settlementDate;
+
+        FlatForward flatRate(settlementDate, yield.rate(), yield.dayCounter(),
+                             yield.compounding(), yield.frequency());
+        return bps(leg, flatRate,
+                   includeSettlementDateFlows,
+                   settlementDate, npvDate);
+    }
+
+    Rate CashFlows::yield(const CompiledLeg& leg,
+                          Real npv,
+                          const DayCounter& dayCounter,
+                          Compounding compounding,
+                          Frequency frequency,
+                          bool includeSettlementDateFlows,
+                          Date settlementDate,
+                          Date npvDate,
+                          Real accuracy,
+                          Size maxIterations,
+                          Rate guess) {
+
+        if (settlementDate == Date())
+            settlementDate = Settings::instance().evaluationDate();
+
+        if (npvDate == Date())
+            npvDate = settlementDate;
+
+        // dates, amounts and year fractions are only computed once;
+        // the solver iterations loop over the flattened flows.
+        CompiledYieldFlows flows(leg, dayCounter,
+                                 includeSettlementDateFlows,
+                                 settlementDate, npvDate);
+        NewtonSafe solver;
+        solver.setMaxEvaluations(maxIterations);
+        CompiledIrrFinder objFunction(flows, npv,
+                                      dayCounter, compounding, frequency);
+        return solver.solve(objFunction, accuracy, guess, guess/10.0);
+    }
+
+    Real CashFlows::npv(const CompiledLeg& leg,
+                        const shared_ptr<YieldTermStructure>& discountCurve,
+                        Spread zSpread,
+                        const DayCounter& dc,
+                        Compounding comp,
+                        Frequency freq,
+                        bool includeSettlementDateFlows,
+                        Date settlementDate,
+                        Date npvDate) {
+
+        if (leg.empty())
+            return 0.0;
+
+        if (settlementDate == Date())
+            settlementDate = Settings::instance().evaluationDate();
+
+        if (npvDate == Date())
+            npvDate = settlementDate;
+
+        CompiledZSpreadFlows flows(leg, *discountCurve, dc, comp, freq,
+                                   includeSettlementDateFlows,
+                                   settlementDate, npvDate);
+        return flows.npv(zSpread);
+    }
+
+    Spread CashFlows::zSpread(const CompiledLeg& leg,
+                              Real npv,
+                              const shared_ptr<YieldTermStructure>& discount,
+                              const DayCounter& dayCounter,
+                              Compounding compounding,
+                              Frequency frequency,
+                              bool includeSettlementDateFlows,
+                              Date settlementDate,
+                              Date npvDate,
+                              Real accuracy,
+                              Size maxIterations,
+                              Rate guess) {
+
+        if (settlementDate == Date())
+            settlementDate = Settings::instance().evaluationDate();
+
+        if (npvDate == Date())
+            npvDate = settlementDate;
+
+        // the zero rates of the original curve are only computed
+        // once; the solver iterations just add the spread.
+        CompiledZSpreadFlows flows(leg, *discount,
+                                   dayCounter, compounding, frequency,
+                                   includeSettlementDateFlows,
+                                   settlementDate, npvDate);
+        Brent solver;
+        solver.setMaxEvaluations(maxIterations);
+        CompiledZSpreadFinder objFunction(flows, npv);
+        Real step = 0.01;
+        return solver.solve(objFunction, accuracy, guess, step);
+    }
+
 }
@@ -35,6 +35,7 @@
 namespace QuantLib {
 
     class YieldTermStructure;
+    class CompiledLeg;
 
     //! %cashflow-analysis functions
     /*! \todo add tests */
@@ -400,6 +401,87 @@ namespace QuantLib {
         }
         //@}
 
+        //! \name Compiled-leg functions
+        /*! These overloads return the same results as the ones
+            taking a leg (within the required accuracy for yield and
+            z-spread) but work on its flattened representation.  They
+            should be preferred when the same cash flows are analyzed
+            repeatedly, e.g., on large bond portfolios.
+        */
+        //@{
+        static Real npv(const CompiledLeg& leg,
+                        const YieldTermStructure& discountCurve,
+                        bool includeSettlementDateFlows,
+                        Date settlementDate = Date(),
+                        Date npvDate = Date());
+        static Real bps(const CompiledLeg& leg,
+                        const YieldTermStructure& discountCurve,
+                        bool includeSettlementDateFlows,
+                        Date settlementDate = Date(),
+                        Date npvDate = Date());
+        static void npvbps(const CompiledLeg& leg,
+                           const YieldTermStructure& discountCurve,
+                           bool includeSettlementDateFlows,
+                           Date settlementDate,
+                           Date npvDate,
+                           Real& npv,
+                           Real& bps);
+        static Real npv(const CompiledLeg& leg,
+                        const InterestRate& yield,
+                        bool includeSettlementDateFlows,
+                        Date settlementDate = Date(),
+                        Date npvDate = Date());
+        static Real npv(const CompiledLeg& leg,
+                        Rate yield,
+                        const DayCounter& dayCounter,
+                        Compounding compounding,
+                        Frequency frequency,
+                        bool includeSettlementDateFlows,
+                        Date settlementDate = Date(),
+                        Date npvDate = Date());
+        static Real bps(const CompiledLeg& leg,
+                        const InterestRate& yield,
+                        bool includeSettlementDateFlows,
+                        Date settlementDate = Date(),
+                        Date npvDate = Date());
+        /*! \note Unlike the overload taking a leg, the Newton solver
+                  uses the exact derivative of the NPV with respect
+                  to the yield, which usually saves iterations.
+        */
+        static Rate yield(const CompiledLeg& leg,
+                          Real npv,
+                          const DayCounter& dayCounter,
+                          Compounding compounding,
+                          Frequency frequency,
+                          bool includeSettlementDateFlows,
+                          Date settlementDate = Date(),
+                          Date npvDate = Date(),
+                          Real accuracy = 1.0e-10,
+                          Size maxIterations = 100,
+                          Rate guess = 0.05);
+        static Real npv(const CompiledLeg& leg,
+                        const boost::shared_ptr<YieldTermStructure>& discount,
+                        Spread zSpread,
+                        const DayCounter& dayCounter,
+                        Compounding compounding,
+                        Frequency frequency,
+                        bool includeSettlementDateFlows,
+                        Date settlementDate = Date(),
+                        Date npvDate = Date());
+        static Spread zSpread(const CompiledLeg& leg,
+                              Real npv,
+                              const boost::shared_ptr<YieldTermStructure>&,
+                              const DayCounter& dayCounter,
+                              Compounding compounding,
+                              Frequency frequency,
+                              bool includeSettlementDateFlows,
+                              Date settlementDate = Date(),
+                              Date npvDate = Date(),
+                              Real accuracy = 1.0e-10,
+                              Size maxIterations = 100,
+                              Rate guess = 0.0);
+        //@}
+
     };
 
 }
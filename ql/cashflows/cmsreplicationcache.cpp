@@ -0,0 +1,137 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/cashflows/cmsreplicationcache.hpp>
+#include <ql/cashflows/cmscoupon.hpp>
+#include <ql/indexes/swapindex.hpp>
+#include <ql/settings.hpp>
+
+namespace QuantLib {
+
+    bool CmsReplicationCache::Key::operator<(const Key& k) const {
+        if (fixingDate != k.fixingDate)
+            return fixingDate < k.fixingDate;
+        if (paymentOffset != k.paymentOffset)
+            return paymentOffset < k.paymentOffset;
+        if (type != k.type)
+            return type < k.type;
+        if (strike != k.strike)
+            return strike < k.strike;
+        if (today != k.today)
+            return today < k.today;
+        if (forwarding != k.forwarding)
+            return forwarding < k.forwarding;
+        if (discounting != k.discounting)
+            return discounting < k.discounting;
+        if (model != k.model)
+            return model < k.model;
+        return index < k.index;
+    }
+
+    CmsReplicationCache::CmsReplicationCache()
+    : hits_(0), misses_(0), releaseWatched_(false) {}
+
+    CmsReplicationCache::Key CmsReplicationCache::key(
+                                         const CmsCoupon& coupon,
+                                         Type type,
+                                         Real strike,
+                                         const std::vector<Real>& model) {
+        const boost::shared_ptr<SwapIndex>& swapIndex = coupon.swapIndex();
+        Key k;
+        k.index = swapIndex->name();
+        k.forwarding = swapIndex->forwardingTermStructure().currentLink();
+        k.discounting = swapIndex->exogenousDiscount() ?
+            swapIndex->discountingTermStructure().currentLink() :
+            k.forwarding;
+        k.today = Settings::instance().evaluationDate();
+        k.fixingDate = coupon.fixingDate();
+        k.paymentOffset = coupon.date() - coupon.fixingDate();
+        k.type = type;
+        k.strike = strike;
+        k.model = model;
+        return k;
+    }
+
+    void CmsReplicationCache::checkEvaluationDate(const Date& today) {
+        if (today != today_) {
+            values_.clear();
+            today_ = today;
+        }
+    }
+
+    bool CmsReplicationCache::find(const Key& key, Real& value) {
+        detail::MutexLock lock(mutex_);
+        checkEvaluationDate(key.today);
+        std::map<Key, Real>::const_iterator i = values_.find(key);
+        if (i == values_.end()) {
+            ++misses_;
+            return false;
+        }
+        value = i->second;
+        ++hits_;
+        return true;
+    }
+
+    void CmsReplicationCache::store(const Key& key, Real value) {
+        detail::MutexLock lock(mutex_);
+        checkEvaluationDate(key.today);
+        values_[key] = value;
+    }
+
+    Size CmsReplicationCache::size() const {
+        detail::MutexLock lock(mutex_);
+        return values_.size();
+    }
+
+    void CmsReplicationCache::clear() {
+        detail::MutexLock lock(mutex_);
+        values_.clear();
+    }
+
+    Size CmsReplicationCache::hits() const {
+        detail::MutexLock lock(mutex_);
+        return hits_;
+    }
+
+    Size CmsReplicationCache::misses() const {
+        detail::MutexLock lock(mutex_);
+        return misses_;
+    }
+
+    void CmsReplicationCache::watch(
+                                const boost::shared_ptr<SwapIndex>& index) {
+        detail::MutexLock lock(mutex_);
+        if (releaseWatched_) {
+            // the indexes watched before the last notification are
+            // released here, since observers can't be unregistered
+            // while the notification is being sent
+            for (Size i=0; i<watched_.size(); ++i)
+                unregisterWith(watched_[i]);
+            watched_.clear();
+            releaseWatched_ = false;
+        }
+        if (registerWith(index).second)
+            watched_.push_back(index);
+    }
+
+    void CmsReplicationCache::update() {
+        detail::MutexLock lock(mutex_);
+        values_.clear();
+        releaseWatched_ = true;
+    }
+
+}
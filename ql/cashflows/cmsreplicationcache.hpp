@@ -0,0 +1,115 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file cmsreplicationcache.hpp
+    \brief cache of replicated cms optionlet values
+*/
+
+#ifndef quantlib_cms_replication_cache_hpp
+#define quantlib_cms_replication_cache_hpp
+
+#include <ql/time/date.hpp>
+#include <ql/patterns/observable.hpp>
+#include <ql/utilities/mutex.hpp>
+#include <boost/shared_ptr.hpp>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace QuantLib {
+
+    class CmsCoupon;
+    class SwapIndex;
+    class YieldTermStructure;
+
+    //! cache of replicated cms optionlet values
+    /*! Replication pricers (LinearTsrPricer, NumericHaganPricer) can
+        store here the values they obtain by numerical integration,
+        so that the coupons of a portfolio sharing the same swap
+        index, fixing date and payment-date offset are replicated
+        only once.
+
+        Values are stored per unit of accrual period and of gearing:
+        for caplets and floorlets, the optionlet price on the given
+        strike; for swaplets, the discounted convexity-adjusted rate.
+        Swap indexes are identified by their name and by their
+        forwarding and discounting curves; the pricer adds to the key
+        the values of its model parameters.
+
+        The owning pricer clears the cache when notified, i.e., when
+        any of its market data change, and passes to watch() the
+        swap index of each coupon it prices; the cache is cleared
+        when any of the watched indexes change, after which it stops
+        observing them until they are watched again.  Values stored
+        for an evaluation date are discarded as soon as a value is
+        looked up or stored for a different one.
+
+        The methods can be called concurrently; they are serialized
+        by a mutex.
+    */
+    class CmsReplicationCache : public Observer {
+      public:
+        enum Type { Floorlet = -1, Swaplet = 0, Caplet = 1 };
+        struct Key {
+            std::string index;
+            boost::shared_ptr<YieldTermStructure> forwarding, discounting;
+            Date today, fixingDate;
+            BigInteger paymentOffset;
+            Type type;
+            Real strike;
+            std::vector<Real> model;
+            bool operator<(const Key&) const;
+        };
+        CmsReplicationCache();
+        //! builds the key for the given coupon
+        static Key key(const CmsCoupon& coupon,
+                       Type type,
+                       Real strike,
+                       const std::vector<Real>& model);
+        //! \name Cached values
+        //@{
+        /*! returns true and sets the value if the key is cached,
+            returns false otherwise */
+        bool find(const Key& key, Real& value);
+        void store(const Key& key, Real value);
+        Size size() const;
+        void clear();
+        //@}
+        //! \name Observer interface
+        //@{
+        //! clears the cache when the given index changes
+        void watch(const boost::shared_ptr<SwapIndex>& index);
+        void update();
+        //@}
+        //! \name Statistics
+        //@{
+        Size hits() const;
+        Size misses() const;
+        //@}
+      private:
+        void checkEvaluationDate(const Date& today);
+        std::map<Key, Real> values_;
+        Date today_;
+        Size hits_, misses_;
+        std::vector<boost::shared_ptr<SwapIndex> > watched_;
+        bool releaseWatched_;
+        mutable detail::Mutex mutex_;
+    };
+
+}
+
+#endif
@@ -0,0 +1,122 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/cashflows/compiledleg.hpp>
+#include <ql/cashflows/fixedratecoupon.hpp>
+#include <ql/cashflows/simplecashflow.hpp>
+#include <ql/settings.hpp>
+
+using boost::shared_ptr;
+using boost::dynamic_pointer_cast;
+
+namespace QuantLib {
+
+    CompiledLeg::CompiledLeg(const Leg& leg) {
+        Size n = leg.size();
+        dates_.reserve(n);
+        exCouponDates_.reserve(n);
+        refPeriodStarts_.reserve(n);
+        refPeriodEnds_.reserve(n);
+        rateSensitivities_.reserve(n);
+        isCoupon_.reserve(n);
+        fixedAmounts_.reserve(n);
+        for (Size i=0; i<n; ++i) {
+            QL_REQUIRE(leg[i], "null cash flow at position " << i);
+            const shared_ptr<CashFlow>& cf = leg[i];
+            dates_.push_back(cf->date());
+            exCouponDates_.push_back(cf->exCouponDate());
+
+            shared_ptr<Coupon> coupon = dynamic_pointer_cast<Coupon>(cf);
+            if (coupon) {
+                isCoupon_.push_back(true);
+                refPeriodStarts_.push_back(coupon->referencePeriodStart());
+                refPeriodEnds_.push_back(coupon->referencePeriodEnd());
+                rateSensitivities_.push_back(coupon->nominal() *
+                                             coupon->accrualPeriod());
+            } else {
+                isCoupon_.push_back(false);
+                refPeriodStarts_.push_back(Date());
+                refPeriodEnds_.push_back(Date());
+                rateSensitivities_.push_back(0.0);
+            }
+
+            if (dynamic_pointer_cast<FixedRateCoupon>(cf) ||
+                dynamic_pointer_cast<SimpleCashFlow>(cf)) {
+                fixedAmounts_.push_back(cf->amount());
+            } else {
+                // the amount will be projected when needed
+                fixedAmounts_.push_back(0.0);
+                projectedIndices_.push_back(i);
+                projectedFlows_.push_back(cf);
+            }
+        }
+    }
+
+    void CompiledLeg::status(bool includeSettlementDateFlows,
+                             const Date& settlementDate,
+                             std::vector<FlowStatus>& status) const {
+        // the settings are only looked up once for all flows
+        Date today = Settings::instance().evaluationDate();
+        Date refDate = settlementDate != Date() ? settlementDate : today;
+        bool includeRefDate = includeSettlementDateFlows;
+        if (refDate == today) {
+            boost::optional<bool> includeToday =
+                Settings::instance().includeTodaysCashFlows();
+            if (includeToday)
+                includeRefDate = *includeToday;
+        }
+
+        Size n = dates_.size();
+        status.resize(n);
+        for (Size i=0; i<n; ++i) {
+            bool occurred = includeRefDate ?
+                            dates_[i] < refDate :
+                            dates_[i] <= refDate;
+            const Date& ecd = exCouponDates_[i];
+            if (occurred)
+                status[i] = Occurred;
+            else if (ecd != Date() && ecd <= refDate)
+                status[i] = TradingExCoupon;
+            else
+                status[i] = Alive;
+        }
+    }
+
+    void CompiledLeg::amounts(const std::vector<FlowStatus>& status,
+                              std::vector<Real>& amounts) const {
+        QL_REQUIRE(status.size() == dates_.size(),
+                   "wrong status size (" << status.size() << ", "
+                   << dates_.size() << " flows)");
+        amounts.resize(dates_.size());
+        for (Size i=0; i<dates_.size(); ++i)
+            amounts[i] = status[i] == Alive ? fixedAmounts_[i] : 0.0;
+        for (Size j=0; j<projectedIndices_.size(); ++j) {
+            Size i = projectedIndices_[j];
+            if (status[i] == Alive)
+                amounts[i] = projectedFlows_[j]->amount();
+        }
+    }
+
+    void CompiledLeg::times(const Date& referenceDate,
+                            const DayCounter& dayCounter,
+                            std::vector<Time>& times) const {
+        times.resize(dates_.size());
+        for (Size i=0; i<dates_.size(); ++i)
+            times[i] = dayCounter.yearFraction(referenceDate, dates_[i]);
+    }
+
+}
@@ -0,0 +1,112 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file compiledleg.hpp
+    \brief flattened representation of a leg for fast cash-flow analysis
+*/
+
+#ifndef quantlib_compiled_leg_hpp
+#define quantlib_compiled_leg_hpp
+
+#include <ql/cashflow.hpp>
+#include <ql/time/daycounter.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! flattened leg
+    /*! The cash flows of a leg are inspected once and their data
+        are stored in contiguous arrays: payment and ex-coupon dates,
+        reference periods and the nominal times accrual period of
+        coupons (i.e., their sensitivity to the paid rate).
+
+        Amounts are stored for flows known to be fixed (fixed-rate
+        coupons and simple cash flows); the other flows, e.g.,
+        floating-rate coupons, are kept as projection entries whose
+        amounts are asked to the underlying cash flow each time
+        amounts() is called.  Thus, changes in forecasting curves or
+        fixings are reflected in the results, while the dates and
+        the coupon data are frozen when the leg is compiled.  As for
+        the original leg, amounts are only asked to flows which are
+        still to be paid.
+
+        The CashFlows overloads taking a compiled leg return the same
+        results as the ones taking the original leg, but loop over
+        the arrays instead of walking the cash flows.
+
+        The class has no mutable state once compiled; results are
+        written into the vectors passed by the caller, so that an
+        instance can be used concurrently by different threads as
+        long as the underlying projected flows can.
+    */
+    class CompiledLeg {
+      public:
+        enum FlowStatus { Occurred, TradingExCoupon, Alive };
+        explicit CompiledLeg(const Leg& leg);
+        //! \name Inspectors
+        //@{
+        Size size() const { return dates_.size(); }
+        bool empty() const { return dates_.empty(); }
+        const std::vector<Date>& dates() const { return dates_; }
+        const std::vector<Date>& exCouponDates() const {
+            return exCouponDates_;
+        }
+        //! nominal times accrual period; null for non-coupon flows
+        const std::vector<Real>& rateSensitivities() const {
+            return rateSensitivities_;
+        }
+        const std::vector<bool>& isCoupon() const { return isCoupon_; }
+        const std::vector<Date>& referencePeriodStarts() const {
+            return refPeriodStarts_;
+        }
+        const std::vector<Date>& referencePeriodEnds() const {
+            return refPeriodEnds_;
+        }
+        //! indices of the flows whose amounts are projected
+        const std::vector<Size>& projectedFlows() const {
+            return projectedIndices_;
+        }
+        //@}
+        //! \name Calculations
+        //@{
+        /*! status of the flows at the given settlement date, with
+            the same logic as CashFlow::hasOccurred and
+            CashFlow::tradingExCoupon.
+        */
+        void status(bool includeSettlementDateFlows,
+                    const Date& settlementDate,
+                    std::vector<FlowStatus>& status) const;
+        //! current amounts of the alive flows; null for the others
+        void amounts(const std::vector<FlowStatus>& status,
+                     std::vector<Real>& amounts) const;
+        //! times of the payment dates with respect to the given date
+        void times(const Date& referenceDate,
+                   const DayCounter& dayCounter,
+                   std::vector<Time>& times) const;
+        //@}
+      private:
+        std::vector<Date> dates_, exCouponDates_;
+        std::vector<Date> refPeriodStarts_, refPeriodEnds_;
+        std::vector<Real> fixedAmounts_, rateSensitivities_;
+        std::vector<bool> isCoupon_;
+        std::vector<Size> projectedIndices_;
+        std::vector<boost::shared_ptr<CashFlow> > projectedFlows_;
+    };
+
+}
+
+#endif
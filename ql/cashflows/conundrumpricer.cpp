@@ -255,7 +255,8 @@ namespace QuantLib {
         Real lowerLimit,
         Real upperLimit,
         Real precision,
-        Real hardUpperLimit)
+        Real hardUpperLimit,
+        bool cacheReplication)
     : HaganPricer(swaptionVol, modelOfYieldCurve, meanReversion),
        upperLimit_(upperLimit),
        lowerLimit_(lowerLimit),
@@ -263,7 +264,31 @@ namespace QuantLib {
        precision_(precision),
        refiningIntegrationTolerance_(.0001),
        hardUpperLimit_(hardUpperLimit) {
+        if (cacheReplication)
+            cache_ = boost::shared_ptr<CmsReplicationCache>(
+                                                  new CmsReplicationCache);
+    }
+
+    void NumericHaganPricer::update() {
+        if (cache_)
+            cache_->clear();
+        HaganPricer::update();
+    }
 
+    void NumericHaganPricer::initialize(const FloatingRateCoupon& coupon) {
+        HaganPricer::initialize(coupon);
+        // cached values depend on the index curves
+        if (cache_)
+            cache_->watch(coupon_->swapIndex());
+    }
+
+    CmsReplicationCache::Key NumericHaganPricer::cacheKey(
+                                         CmsReplicationCache::Type type,
+                                         Rate strike) const {
+        std::vector<Real> model(2);
+        model[0] = modelOfYieldCurve_;
+        model[1] = meanReversion_->value();
+        return CmsReplicationCache::key(*coupon_, type, strike, model);
     }
 
     Real NumericHaganPricer::integrate(Real a,
@@ -322,6 +347,23 @@ namespace QuantLib {
 
     Real NumericHaganPricer::optionletPrice(
                                 Option::Type optionType, Real strike) const {
+        if (!cache_)
+            return optionletPriceImpl(optionType, strike);
+        CmsReplicationCache::Key key =
+            cacheKey(optionType == Option::Call ? CmsReplicationCache::Caplet
+                                                : CmsReplicationCache::Floorlet,
+                     strike);
+        Real value;
+        if (!cache_->find(key, value)) {
+            value = optionletPriceImpl(optionType, strike) /
+                    coupon_->accrualPeriod();
+            cache_->store(key, value);
+        }
+        return value * coupon_->accrualPeriod();
+    }
+
+    Real NumericHaganPricer::optionletPriceImpl(
+                                Option::Type optionType, Real strike) const {
 
         boost::shared_ptr<ConundrumIntegrand> integrand(new
             ConundrumIntegrand(vanillaOptionPricer_, rateCurve_, gFunction_,
@@ -360,6 +402,20 @@ namespace QuantLib {
             const Rate Rs = coupon_->swapIndex()->fixing(fixingDate_);
             Rate price = (gearing_*Rs + spread_)*(coupon_->accrualPeriod()*discount_);
             return price;
+        } else if (cache_) {
+            // discounted convexity-adjusted rate
+            CmsReplicationCache::Key key =
+                cacheKey(CmsReplicationCache::Swaplet, swapRateValue_);
+            Real value;
+            if (!cache_->find(key, value)) {
+                value = discount_ * swapRateValue_ +
+                        (optionletPriceImpl(Option::Call, swapRateValue_) -
+                         optionletPriceImpl(Option::Put, swapRateValue_)) /
+                            coupon_->accrualPeriod();
+                cache_->store(key, value);
+            }
+            return gearing_ * coupon_->accrualPeriod() * value
+                   + spreadLegValue_;
         } else {
             Real atmCapletPrice = optionletPrice(Option::Call, swapRateValue_);
             Real atmFloorletPrice = optionletPrice(Option::Put, swapRateValue_);
@@ -24,6 +24,7 @@
 #define quantlib_conundrum_pricer_hpp
 
 #include <ql/cashflows/couponpricer.hpp>
+#include <ql/cashflows/cmsreplicationcache.hpp>
 #include <ql/instruments/payoffs.hpp>
 
 namespace QuantLib {
@@ -245,6 +246,13 @@ namespace QuantLib {
     /*! Prices a cms coupon via static replication as in Hagan's
         "Conundrums..." article via numerical integration based on
         prices of vanilla swaptions
+
+        If requested, the replicated swaplet, caplet and floorlet
+        values are kept in a CmsReplicationCache and reused by all
+        coupons priced by this instance that share swap index,
+        fixing date and payment-date offset.  The cache is cleared
+        whenever the pricer, or any of the swap indexes it is
+        watching, is notified.
     */
     class NumericHaganPricer : public HaganPricer {
       public:
@@ -255,10 +263,17 @@ namespace QuantLib {
             Rate lowerLimit = 0.0,
             Rate upperLimit = 1.0,
             Real precision = 1.0e-6,
-            Real hardUpperLimit = QL_MAX_REAL);
+            Real hardUpperLimit = QL_MAX_REAL,
+            bool cacheReplication = false);
 
        Real upperLimit() { return upperLimit_; }
        Real stdDeviations() { return stdDeviationsForUpperLimit_; }
+       //! returns a null pointer unless the cache is enabled
+       const boost::shared_ptr<CmsReplicationCache>&
+       replicationCache() const {
+           return cache_;
+       }
+       void update();
 
       //private:
         class Function : public std::unary_function<Real, Real> {
@@ -305,12 +320,17 @@ namespace QuantLib {
         virtual Real optionletPrice(Option::Type optionType,
                                     Rate strike) const;
         virtual Real swapletPrice() const;
+        void initialize(const FloatingRateCoupon& coupon);
+        Real optionletPriceImpl(Option::Type optionType, Rate strike) const;
+        CmsReplicationCache::Key cacheKey(CmsReplicationCache::Type type,
+                                          Rate strike) const;
         Real resetUpperLimit(Real stdDeviationsForUpperLimit) const;
         Real refineIntegration(Real integralValue, const ConundrumIntegrand& integrand) const;
 
         mutable Real upperLimit_, stdDeviationsForUpperLimit_;
         const Real lowerLimit_, requiredStdDeviations_, precision_, refiningIntegrationTolerance_;
         const Real hardUpperLimit_;
+        boost::shared_ptr<CmsReplicationCache> cache_;
     };
 
     //! CMS-coupon pricer
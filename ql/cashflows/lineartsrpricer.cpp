@@ -53,6 +53,9 @@ namespace QuantLib {
         if (integrator_ == NULL)
             integrator_ =
                 boost::make_shared<GaussKronrodNonAdaptive>(1E-10, 5000, 1E-10);
+
+        if (settings_.cacheReplication_)
+            cache_ = boost::make_shared<CmsReplicationCache>();
     }
 
     Real LinearTsrPricer::GsrG(const Date &d) const {
@@ -84,6 +87,38 @@ namespace QuantLib {
                                                               : Option::Call);
     }
 
+    Real LinearTsrPricer::priceIntegrand(const Real strike) const {
+        return smileSection_->optionPrice(
+            strike, strike < swapRateValue_ ? Option::Put : Option::Call);
+    }
+
+    Real LinearTsrPricer::integral(const Real lower, const Real upper) const {
+        if (!settings_.memoizeIntegrals_)
+            return integrator_->operator()(
+                std::bind1st(std::mem_fun(&LinearTsrPricer::integrand), this),
+                lower, upper);
+        // the memoized integrals do not include the slope, which
+        // depends on the payment date of the coupon
+        std::pair<Real, Real> key(lower, upper);
+        std::map<std::pair<Real, Real>, Real>::const_iterator i =
+            memoIntegrals_.find(key);
+        if (i == memoIntegrals_.end())
+            i = memoIntegrals_.insert(std::make_pair(key,
+                    integrator_->operator()(
+                        std::bind1st(std::mem_fun(
+                                &LinearTsrPricer::priceIntegrand), this),
+                        lower, upper))).first;
+        return 2.0 * a_ * i->second;
+    }
+
+    void LinearTsrPricer::update() {
+        memoSection_.reset();
+        memoIntegrals_.clear();
+        if (cache_ != NULL)
+            cache_->clear();
+        CmsCouponPricer::update();
+    }
+
     void LinearTsrPricer::initialize(const FloatingRateCoupon &coupon) {
 
         coupon_ = dynamic_cast<const CmsCoupon *>(&coupon);
@@ -94,6 +129,9 @@ namespace QuantLib {
         fixingDate_ = coupon_->fixingDate();
         paymentDate_ = coupon_->date();
         swapIndex_ = coupon_->swapIndex();
+        // cached values depend on the index curves
+        if (cache_ != NULL)
+            cache_->watch(swapIndex_);
 
         forwardCurve_ = swapIndex_->forwardingTermStructure();
         if (swapIndex_->exogenousDiscount())
@@ -129,8 +167,27 @@ namespace QuantLib {
             swapRateValue_ = swap_->fairRate();
             annuity_ = 1.0E4 * std::fabs(swap_->fixedLegBPS());
 
-            boost::shared_ptr<SmileSection> sectionTmp =
-                swaptionVolatility()->smileSection(fixingDate_, swapTenor_);
+            boost::shared_ptr<SmileSection> sectionTmp;
+            if (settings_.memoizeIntegrals_ && memoSection_ != NULL &&
+                memoFixingDate_ == fixingDate_ &&
+                memoSwapTenor_ == swapTenor_ && memoToday_ == today_) {
+                sectionTmp = memoSection_;
+                if (memoSwapRate_ != swapRateValue_) {
+                    memoIntegrals_.clear();
+                    memoSwapRate_ = swapRateValue_;
+                }
+            } else {
+                sectionTmp =
+                    swaptionVolatility()->smileSection(fixingDate_, swapTenor_);
+                if (settings_.memoizeIntegrals_) {
+                    memoSection_ = sectionTmp;
+                    memoFixingDate_ = fixingDate_;
+                    memoSwapTenor_ = swapTenor_;
+                    memoToday_ = today_;
+                    memoSwapRate_ = swapRateValue_;
+                    memoIntegrals_.clear();
+                }
+            }
 
             // adjust bounds by section's shift
             shiftedLowerBound_ = settings_.lowerRateBound_ - sectionTmp->shift();
@@ -231,8 +288,33 @@ namespace QuantLib {
         return std::min(std::max(k, min), max);
     }
 
+    CmsReplicationCache::Key
+    LinearTsrPricer::cacheKey(CmsReplicationCache::Type type,
+                              Real strike) const {
+        return CmsReplicationCache::key(
+            *coupon_, type, strike,
+            std::vector<Real>(1, meanReversion_->value()));
+    }
+
     Real LinearTsrPricer::optionletPrice(Option::Type optionType,
                                          Real strike) const {
+        if (cache_ == NULL || coupon_->accrualPeriod() == 0.0)
+            return optionletPriceImpl(optionType, strike);
+        CmsReplicationCache::Key key =
+            cacheKey(optionType == Option::Call ? CmsReplicationCache::Caplet
+                                                : CmsReplicationCache::Floorlet,
+                     strike);
+        Real value;
+        if (!cache_->find(key, value)) {
+            value = optionletPriceImpl(optionType, strike) /
+                    coupon_->accrualPeriod();
+            cache_->store(key, value);
+        }
+        return value * coupon_->accrualPeriod();
+    }
+
+    Real LinearTsrPricer::optionletPriceImpl(Option::Type optionType,
+                                             Real strike) const {
 
         if (optionType == Option::Call && strike >= shiftedUpperBound_)
             return 0.0;
@@ -315,17 +397,11 @@ namespace QuantLib {
         if (upper > lower) {
             tmpBound = std::min(upper, swapRateValue_);
             if (tmpBound > lower) {
-                result += integrator_->operator()(
-                    std::bind1st(std::mem_fun(&LinearTsrPricer::integrand),
-                                 this),
-                    lower, tmpBound);
+                result += integral(lower, tmpBound);
             }
             tmpBound = std::max(lower, swapRateValue_);
             if (upper > tmpBound) {
-                result += integrator_->operator()(
-                    std::bind1st(std::mem_fun(&LinearTsrPricer::integrand),
-                                 this),
-                    tmpBound, upper);
+                result += integral(tmpBound, upper);
             }
             result *= (optionType == Option::Call ? 1.0 : -1.0);
         }
@@ -399,6 +475,21 @@ namespace QuantLib {
                 (coupon_->accrualPeriod() *
                  discountCurve_->discount(paymentDate_) * couponDiscountRatio_);
             return price;
+        } else if (cache_ != NULL && coupon_->accrualPeriod() != 0.0) {
+            // discounted convexity-adjusted rate
+            CmsReplicationCache::Key key =
+                cacheKey(CmsReplicationCache::Swaplet, swapRateValue_);
+            Real value;
+            if (!cache_->find(key, value)) {
+                value = discountCurve_->discount(paymentDate_) *
+                            swapRateValue_ * couponDiscountRatio_ +
+                        (optionletPriceImpl(Option::Call, swapRateValue_) -
+                         optionletPriceImpl(Option::Put, swapRateValue_)) /
+                            coupon_->accrualPeriod();
+                cache_->store(key, value);
+            }
+            return gearing_ * coupon_->accrualPeriod() * value +
+                   spreadLegValue_;
         } else {
             Real atmCapletPrice = optionletPrice(Option::Call, swapRateValue_);
             Real atmFloorletPrice = optionletPrice(Option::Put, swapRateValue_);
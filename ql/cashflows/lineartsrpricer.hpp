@@ -25,9 +25,11 @@
 
 #include <ql/termstructures/volatility/smilesection.hpp>
 #include <ql/cashflows/couponpricer.hpp>
+#include <ql/cashflows/cmsreplicationcache.hpp>
 #include <ql/instruments/payoffs.hpp>
 #include <ql/indexes/swapindex.hpp>
 #include <ql/math/integrals/integral.hpp>
+#include <map>
 
 namespace QuantLib {
 
@@ -57,6 +59,19 @@ namespace QuantLib {
         Note that for normal volatility input the lower rate bound
         should probably be adjusted to an appropriate negative value,
         there is no automatic adjustment in this case.
+
+        Optionally (see Settings::withIntegralsMemo) the pricer keeps
+        the smile section of the last fixing date and swap tenor it
+        has seen, together with the replication integrals computed
+        on it; coupons sharing the same (expiry, tenor) then reuse
+        both.  The memo is cleared whenever the pricer is notified.
+
+        The pricer can also (see Settings::withReplicationCache) keep
+        the swaplet, caplet and floorlet values it computes in a
+        CmsReplicationCache, so that all coupons it prices sharing
+        swap index, fixing date and payment-date offset are
+        replicated once.  The cache is cleared whenever the pricer,
+        or any of the swap indexes it is watching, is notified.
     */
 
     class LinearTsrPricer : public CmsCouponPricer, public MeanRevertingPricer {
@@ -68,7 +83,8 @@ namespace QuantLib {
             Settings()
                 : strategy_(RateBound), vegaRatio_(0.01),
                   priceThreshold_(1.0E-8), stdDevs_(3.0),
-                  lowerRateBound_(0.0001), upperRateBound_(2.0000) {}
+                  lowerRateBound_(0.0001), upperRateBound_(2.0000),
+                  memoizeIntegrals_(false), cacheReplication_(false) {}
 
             Settings &withRateBound(const Real lowerRateBound = 0.0001,
                                     const Real upperRateBound = 2.0000) {
@@ -108,6 +124,16 @@ namespace QuantLib {
                 return *this;
             }
 
+            Settings &withIntegralsMemo(const bool memoizeIntegrals = true) {
+                memoizeIntegrals_ = memoizeIntegrals;
+                return *this;
+            }
+
+            Settings &withReplicationCache(const bool cacheReplication = true) {
+                cacheReplication_ = cacheReplication;
+                return *this;
+            }
+
             enum Strategy {
                 RateBound,
                 VegaRatio,
@@ -120,6 +146,8 @@ namespace QuantLib {
             Real priceThreshold_;
             Real stdDevs_;
             Real lowerRateBound_, upperRateBound_;
+            bool memoizeIntegrals_;
+            bool cacheReplication_;
         };
 
 
@@ -146,6 +174,13 @@ namespace QuantLib {
             registerWith(meanReversion_);
             update();
         }
+        /* */
+        void update();
+        //! returns a null pointer unless the cache is enabled
+        const boost::shared_ptr<CmsReplicationCache>&
+        replicationCache() const {
+            return cache_;
+        }
 
 
       private:
@@ -153,6 +188,8 @@ namespace QuantLib {
         Real GsrG(const Date &d) const;
         Real singularTerms(const Option::Type type, const Real strike) const;
         Real integrand(const Real strike) const;
+        Real priceIntegrand(const Real strike) const;
+        Real integral(const Real lower, const Real upper) const;
         Real a_, b_;
 
         class VegaRatioHelper {
@@ -181,6 +218,9 @@ namespace QuantLib {
 
         void initialize(const FloatingRateCoupon &coupon);
         Real optionletPrice(Option::Type optionType, Real strike) const;
+        Real optionletPriceImpl(Option::Type optionType, Real strike) const;
+        CmsReplicationCache::Key cacheKey(CmsReplicationCache::Type type,
+                                          Real strike) const;
         Real strikeFromVegaRatio(Real ratio, Option::Type optionType,
                                  Real referenceStrike) const;
         Real strikeFromPrice(Real price, Option::Type optionType,
@@ -209,6 +249,16 @@ namespace QuantLib {
         boost::shared_ptr<Integrator> integrator_;
 
         Real shiftedLowerBound_, shiftedUpperBound_;
+
+        // memo of the section and of the integrals of the option
+        // prices over the replication intervals
+        boost::shared_ptr<SmileSection> memoSection_;
+        Date memoFixingDate_, memoToday_;
+        Period memoSwapTenor_;
+        Real memoSwapRate_;
+        mutable std::map<std::pair<Real, Real>, Real> memoIntegrals_;
+
+        boost::shared_ptr<CmsReplicationCache> cache_;
     };
 }
 
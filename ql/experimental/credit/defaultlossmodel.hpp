@@ -156,9 +156,15 @@ namespace QuantLib {
             until the basket takes in a new model....
             ..alternatively both old basket and model could be forced reset here
             */
+            const bool newBasket = basket_.empty() ||
+                basket_.currentLink().get() != bskt;
             basket_.linkTo(boost::shared_ptr<Basket>(bskt, detail::no_deletion),
                            false);
             resetModel();// or rename to setBasketImpl(...)
+            /* The baskets sharing the model, e.g. the tranches of a capital
+            structure, must take it back before their next statistic.
+            */
+            if(newBasket) notifyObservers();
         }
         // the call order matters, which is the reason for the parent to be the 
         //   sole caller.
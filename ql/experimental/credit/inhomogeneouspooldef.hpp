@@ -25,6 +25,7 @@
 #include <ql/experimental/credit/basket.hpp>
 #include <ql/experimental/credit/constantlosslatentmodel.hpp>
 #include <ql/experimental/credit/defaultlossmodel.hpp>
+#include <map>
 
 // Intended to replace InhomogeneousPoolCDOEngine in syntheticcdoengines.hpp
 
@@ -50,6 +51,13 @@ namespace QuantLib {
         // allow base correlations:
         typedef copulaPolicy copulaType;
 
+        /*! The loss distribution is tabulated on nBuckets buckets
+            up to the detachment amount of the tranche.  If
+            maxDetachment (a fraction of the pool notional) is given,
+            tranches detaching at or below it use a grid up to
+            maxDetachment instead and share their distributions; the
+            bucket count must then be chosen for that range.
+        */
         InhomogeneousPoolLossModel(
         // restricted to non random recoveries, but it could be possible.
             const boost::shared_ptr<ConstantLossLatentmodel<copulaPolicy> >& 
@@ -57,10 +65,12 @@ namespace QuantLib {
             Size nBuckets,
             Real max = 5.,
             Real min = -5.,
-            Real nSteps = 50)
+            Real nSteps = 50,
+            Real maxDetachment = Null<Real>())
         : copula_(copula), 
           nBuckets_(nBuckets), 
-          max_(max), min_(min), nSteps_(nSteps), delta_((max - min)/nSteps)
+          max_(max), min_(min), nSteps_(nSteps), delta_((max - min)/nSteps),
+          maxDetachment_(maxDetachment), hits_(0), misses_(0)
         { 
             QL_REQUIRE(copula->numFactors() == 1, 
                 "Inhomogeneous model not implemented for multifactor");
@@ -89,6 +99,11 @@ namespace QuantLib {
             dist.tranche(attachAmount_, detachAmount_);
             return dist.expectedShortfall(percentile);
         }
+        //! \name Loss-distribution cache statistics
+        //@{
+        Size distributionHits() const { return hits_; }
+        Size distributionMisses() const { return misses_; }
+        //@}
     protected:
         const boost::shared_ptr<ConstantLossLatentmodel<copulaPolicy> > copula_;
         Size nBuckets_;
@@ -102,6 +117,14 @@ namespace QuantLib {
         const Real min_;
         const Real nSteps_;
         const Real delta_; 
+        const Real maxDetachment_;
+        /* Integrated distributions and the inputs they were integrated
+           for, the first of which is the upper bound of the grid. Since
+           the bucket count is fixed, tranches with the same bound (e.g.,
+           a ladder below maxDetachment) share them. */
+        mutable std::map<Date, std::pair<std::vector<Real>, Distribution> >
+            distributions_;
+        mutable Size hits_, misses_;
     };
     // \todo Add other loss distribution statistics
     typedef InhomogeneousPoolLossModel<GaussianCopulaPolicy> 
@@ -131,8 +154,6 @@ namespace QuantLib {
     Distribution InhomogeneousPoolLossModel<CP>::lossDistrib(
         const Date& d) const 
     {
-        LossDistBucketing bucktLDistBuff(nBuckets_, detachAmount_);
-
         std::vector<Real> lgd;// switch to a mutable cache member
         std::vector<Real> recoveries = copula_->recoveries();
         std::transform(recoveries.begin(), recoveries.end(), 
@@ -140,30 +161,73 @@ namespace QuantLib {
         std::transform(lgd.begin(), lgd.end(), notionals_.begin(), 
             lgd.begin(), std::multiplies<Real>());
         std::vector<Real> prob = basket_->remainingProbabilities(d);
+
+        // upper bound of the loss grid
+        const Real maxLoss = (maxDetachment_ != Null<Real>() &&
+                              detach_ <= maxDetachment_) ?
+            std::max(maxDetachment_ * notional_, detachAmount_) :
+            detachAmount_;
+
+        // the distribution depends on the date through these inputs only
+        std::vector<Real> inputs(1, maxLoss);
+        inputs.insert(inputs.end(), lgd.begin(), lgd.end());
+        inputs.insert(inputs.end(), prob.begin(), prob.end());
+        const std::vector<std::vector<Real> >& factorWeights = 
+            copula_->factorWeights();
+        for(Size iName=0; iName<factorWeights.size(); iName++)
+            inputs.insert(inputs.end(), factorWeights[iName].begin(), 
+                factorWeights[iName].end());
+        typename std::map<Date, std::pair<std::vector<Real>, Distribution> >
+            ::const_iterator cached = distributions_.find(d);
+        if(cached != distributions_.end() && cached->second.first == inputs) {
+            ++hits_;
+            return cached->second.second;
+        }
+        ++misses_;
+
         for(Size iName=0; iName<prob.size(); iName++)
             prob[iName] = copula_->inverseCumulativeY(prob[iName], iName);
 
         // integrate locally (1 factor). 
         // use explicitly a 1D latent model object? 
         // \todo Use a library integrator here and in the homogeneous case.
-        Distribution dist(nBuckets_, 0.0, 
-            detachAmount_);
-            //notional_);
-        std::vector<Real> mkft(1, min_ + delta_ /2.);
-        for (Size i = 0; i < nSteps_; i++) {
-            std::vector<Real> conditionalProbs;
-            for(Size iName=0; iName<notionals_.size(); iName++)
-                conditionalProbs.push_back(
-                copula_->conditionalDefaultProbabilityInvP(prob[iName], iName, 
-                    mkft));
-            Distribution d = bucktLDistBuff(lgd, conditionalProbs);
-            Real densitydm = delta_ * copula_->density(mkft);
-            // also, instead of calling the static method it could be wrapped 
-            // through an inlined call in the latent model
-            for (Size j = 0; j < nBuckets_; j++)
-                dist.addDensity(j, d.density(j) * densitydm);
-            mkft[0] += delta_;
+        std::vector<Real> nodes;
+        for(Real mkft = min_ + delta_ /2.; nodes.size() < nSteps_; 
+            mkft += delta_)
+            nodes.push_back(mkft);
+        // the nodes are independent; their densities are summed in order
+        //   afterwards, so that the result does not depend on threading
+        std::vector<std::vector<Real> > densities(nodes.size());
+        std::string error;
+        #pragma omp parallel for
+        for (long i = 0; i < long(nodes.size()); i++) {
+            try {
+                const std::vector<Real> mkft(1, nodes[i]);
+                std::vector<Real> conditionalProbs;
+                for(Size iName=0; iName<notionals_.size(); iName++)
+                    conditionalProbs.push_back(
+                    copula_->conditionalDefaultProbabilityInvP(prob[iName], 
+                        iName, mkft));
+                Distribution d = LossDistBucketing(nBuckets_, maxLoss)(
+                    lgd, conditionalProbs);
+                Real densitydm = delta_ * copula_->density(mkft);
+                // also, instead of calling the static method it could be 
+                // wrapped through an inlined call in the latent model
+                densities[i].resize(nBuckets_);
+                for (Size j = 0; j < nBuckets_; j++)
+                    densities[i][j] = d.density(j) * densitydm;
+            } catch (std::exception& e) {
+                #pragma omp critical(ql_inhomogeneous_pool_loss_model)
+                if (error.empty()) error = e.what();
+            }
         }
+        QL_REQUIRE(error.empty(), error);
+
+        Distribution dist(nBuckets_, 0.0, maxLoss);
+        for (Size i = 0; i < nodes.size(); i++)
+            for (Size j = 0; j < nBuckets_; j++)
+                dist.addDensity(j, densities[i][j]);
+        distributions_[d] = std::make_pair(inputs, dist);
         return dist;
     }
 
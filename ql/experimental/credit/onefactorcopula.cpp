@@ -53,6 +53,61 @@ namespace QuantLib {
         return p;
     }
 
+    //-------------------------------------------------------------------------
+    const Matrix& OneFactorCopula::conditionalProbabilities(
+                                             const vector<Real>& prob) const {
+    //-------------------------------------------------------------------------
+        calculate ();
+
+        Real c = correlation_->value();
+
+        vector<Real> key (prob);
+        key.push_back (c);
+        key.push_back (min_);
+        key.push_back (max_);
+        key.push_back (Real (steps_));
+        typedef list<pair<vector<Real>, Matrix> >::iterator iterator;
+        for (iterator i = kernels_.begin(); i != kernels_.end(); ++i) {
+            if (i->first == key) {
+                kernels_.splice (kernels_.begin(), kernels_, i);
+                ++kernelHits_;
+                return kernels_.front().second;
+            }
+        }
+        ++kernelMisses_;
+
+        Size n = prob.size();
+        Real sc = sqrt (c), s1c = sqrt (1. - c);
+
+        // thresholds, once per name; see conditionalProbability
+        // for the cutoff on small probabilities
+        vector<Real> y (n, 0.0);
+        for (Size i = 0; i < n; i++)
+            if (prob[i] >= 1e-10)
+                y[i] = inverseCumulativeY (prob[i]);
+
+        Matrix kernel (steps_, n, 0.0);
+        for (Size k = 0; k < steps_; k++) {
+            Real mk = m(k);
+            for (Size i = 0; i < n; i++) {
+                if (prob[i] < 1e-10)
+                    continue;
+                Real res = cumulativeZ ((y[i] - sc * mk) / s1c);
+                QL_REQUIRE (res >= 0 && res <= 1,
+                            "conditional probability " << res
+                            << "out of range");
+                kernel[k][i] = res;
+            }
+        }
+
+        if (kernels_.size() == maxKernels_)
+            kernels_.pop_back();
+        kernels_.push_front (make_pair (vector<Real>(), Matrix()));
+        kernels_.front().first.swap (key);
+        kernels_.front().second.swap (kernel);
+        return kernels_.front().second;
+    }
+
     //-------------------------------------------------------------------------
     Real OneFactorCopula::cumulativeY (Real y) const {
     //-------------------------------------------------------------------------
@@ -26,7 +26,9 @@
 
 #include <ql/experimental/credit/distribution.hpp>
 #include <ql/patterns/lazyobject.hpp>
+#include <ql/math/matrix.hpp>
 #include <ql/quote.hpp>
+#include <list>
 
 namespace QuantLib {
 
@@ -104,7 +106,8 @@ namespace QuantLib {
                         Real maximum = 5.0, Size integrationSteps = 50,
                         Real minimum = -5.0)
         : correlation_(correlation),
-          max_(maximum), steps_(integrationSteps), min_(minimum) {
+          max_(maximum), steps_(integrationSteps), min_(minimum),
+          kernelHits_(0), kernelMisses_(0) {
             QL_REQUIRE(correlation_->value() >= -1
                        && correlation_->value() <= 1,
                        "correlation out of range [-1, +1]");
@@ -156,6 +159,29 @@ namespace QuantLib {
         std::vector<Real> conditionalProbability(const std::vector<Real>& prob,
                                                  Real m) const;
 
+        //! Conditional probabilities on the integration grid
+        /*! Returns a matrix whose k-th row holds the conditional
+            probabilities \f$ \hat p_i(m_k) \f$ of all names at the
+            k-th node of the integration grid.  The inverse cumulative
+            distribution of Y is evaluated once per name, and the
+            distribution of Z once per node for all names together.
+
+            The last few results are kept together with the
+            probabilities, correlation and grid they were calculated
+            for, so that integrals over the same probabilities (e.g.,
+            for the tranches of a basket at each payment date) share
+            them.  The returned reference is valid until the next
+            call.
+        */
+        const Matrix& conditionalProbabilities(
+                                      const std::vector<Real>& prob) const;
+
+        //! \name Kernel cache statistics
+        //@{
+        Size kernelHits() const { return kernelHits_; }
+        Size kernelMisses() const { return kernelMisses_; }
+        //@}
+
         /*! Integral over the density \f$ \rho(m) \f$ of M and the conditional
             probability related to p:
 
@@ -192,10 +218,13 @@ namespace QuantLib {
         Real integral(const F& f, std::vector<Real>& probabilities) const {
             calculate();
 
+            // copied, since f might use the copula as well
+            const Matrix kernel = conditionalProbabilities(probabilities);
+            std::vector<Real> conditional(kernel.columns());
             Real avg = 0.0;
             for (Size i = 0; i < steps_; i++) {
-                std::vector<Real> conditional
-                    = conditionalProbability(probabilities, m(i));
+                std::copy(kernel.row_begin(i), kernel.row_end(i),
+                          conditional.begin());
                 Real prob = f(conditional);
                 avg += prob * densitydm(i);
             }
@@ -218,10 +247,12 @@ namespace QuantLib {
                               const std::vector<Real>& probabilities) const {
             calculate();
 
+            const Matrix kernel = conditionalProbabilities(probabilities);
+            std::vector<Real> conditional(kernel.columns());
             Distribution dist(f.buckets(), 0.0, f.maximum());
             for (Size i = 0; i < steps(); i++) {
-                std::vector<Real> conditional
-                    = conditionalProbability(probabilities, m(i));
+                std::copy(kernel.row_begin(i), kernel.row_end(i),
+                          conditional.begin());
                 Distribution d = f(nominals, conditional);
                 for (Size j = 0; j < dist.size(); j++)
                     dist.addDensity(j, d.density(j) * densitydm(i));
@@ -256,6 +287,15 @@ namespace QuantLib {
 
         Real m(Size i) const;
         Real densitydm(Size i) const;
+
+      private:
+        // conditional probabilities on the grid and the probabilities,
+        // correlation and grid they were calculated for, most recently
+        // used first; a few are kept, since the tranches of a basket
+        // usually alternate between the same payment dates
+        static const Size maxKernels_ = 16;
+        mutable std::list<std::pair<std::vector<Real>, Matrix> > kernels_;
+        mutable Size kernelHits_, kernelMisses_;
     };
 
     inline Real OneFactorCopula::correlation() const {
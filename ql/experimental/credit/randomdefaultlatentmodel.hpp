@@ -117,23 +117,68 @@ namespace QuantLib {
         }
 
         void performCalculations() const {
+            simsBuffer_.clear();
             static_cast<const derivedRandomLM<copulaPolicy, USNG>* >(
                 this)->initDates();//in update?
             copulasRng_ = boost::make_shared<copulaRNG_type>(copula_, seed_);
             performSimulations();
         }
 
+        /* The samples are drawn serially, in blocks, so that the sequence
+        and thus the results do not depend on the number of threads; the 
+        events, which require the inversion of the default curves, are then 
+        determined in parallel. The default curves have been calculated by 
+        initDates.
+        */
         void performSimulations() const {
-            // Next sequence should determine the event and push it into buffer
-            for(Size i=nSims_; i; i--) {
-                const std::vector<Real>& sample =
-                    copulasRng_->nextSequence().value;
-                static_cast<const derivedRandomLM<copulaPolicy, USNG>* >(
-                    this)->nextSample(sample);
-            // alternatively make call an explicit local method...
+            const Size blockSize = 1024;
+            simsBuffer_.resize(nSims_);
+            std::vector<std::vector<Real> > samples;
+            std::string error;
+            for(Size iBlock=0; iBlock < nSims_; iBlock += blockSize) {
+                const Size n = std::min(blockSize, nSims_ - iBlock);
+                samples.resize(n);
+                for(Size i=0; i < n; i++)
+                    samples[i] = copulasRng_->nextSequence().value;
+
+                // Next sequence should determine the event and store it
+                #pragma omp parallel for
+                for(long i=0; i < long(n); i++) {
+                    try {
+                        static_cast<const derivedRandomLM<copulaPolicy, 
+                            USNG>* >(this)->nextSample(samples[i], 
+                                simsBuffer_[iBlock + i]);
+                    } catch (std::exception& e) {
+                        #pragma omp critical(ql_random_default_latent_model)
+                        if (error.empty()) error = e.what();
+                    }
+                }
+                QL_REQUIRE(error.empty(), error);
             }
         }
 
+        /*! To be called by children when the basket is reset. The
+        simulated events only depend on the pool names and their default
+        keys, and not on the tranche or the notionals of the basket, so
+        that they are shared among baskets on the same pool (e.g., the
+        tranches of a capital structure.) Changes in the default curves
+        of the names reach the model directly.
+        */
+        void resetSimulations() {
+            const boost::shared_ptr<Pool>& pool = basket_->pool();
+            const std::vector<DefaultProbKey> keys = basket_->defaultKeys();
+            if(pool == simulatedPool_ && keys == simulatedKeys_)
+                return;
+            simulatedPool_ = pool;
+            simulatedKeys_ = keys;
+            for(Size iName=0; iName < keys.size(); iName++)
+                registerWith(pool->get(pool->names()[iName]).
+                    defaultProbability(keys[iName]));
+            simsBuffer_.clear();
+            // invalidate current calculations if any and notify observers
+            LazyObject::update();
+        }
+
         /* Method to access simulation results and avoiding a copy of
         each thread results buffer. PerformCalculations should have been called.
         Here in the monothread version this method is redundant/trivial but
@@ -214,6 +259,9 @@ namespace QuantLib {
 
         mutable std::vector<std::vector<simEvent<derivedRandomLM<copulaPolicy,
             USNG > > > > simsBuffer_;
+        // pool and keys the buffered simulations were generated for
+        boost::shared_ptr<Pool> simulatedPool_;
+        std::vector<DefaultProbKey> simulatedKeys_;
 
         mutable copulaPolicy copula_;
         mutable boost::shared_ptr<copulaRNG_type> copulasRng_;
@@ -865,7 +913,8 @@ namespace QuantLib {
         */
         friend class RandomLM< ::QuantLib::RandomDefaultLM, copulaPolicy, USNG>;
     protected:
-        void nextSample(const std::vector<Real>& values) const;
+        void nextSample(const std::vector<Real>& values,
+            std::vector<defaultSimEvent>& events) const;
         void initDates() const {
             /* Precalculate horizon time default probabilities (used to
               determine if the default took place and subsequently compute its
@@ -875,6 +924,7 @@ namespace QuantLib {
             Date maxHorizonDate = today  + Period(this->maxHorizon_, Days);
 
             const boost::shared_ptr<Pool>& pool = this->basket_->pool();
+            horizonDefaultPs_.clear();
             for(Size iName=0; iName < this->basket_->size(); ++iName)//use'live'
                 horizonDefaultPs_.push_back(pool->get(pool->names()[iName]).
                     defaultProbability(this->basket_->defaultKeys()[iName])
@@ -898,18 +948,14 @@ namespace QuantLib {
         Size basketSize() const { return copula_->size(); }
     private:
         void resetModel() /*const*/ {
-            /* Explore: might save recalculation if the basket is the same
-            (some situations, like BC or control variates) in that case do not
-            update, only reset the copula's basket.
-            */
             copula_->resetBasket(this->basket_.currentLink());
 
             QL_REQUIRE(this->basket_->size() == copula_->size(),
                 "Incompatible basket and model sizes.");
             QL_REQUIRE(recoveries_.size() == this->basket_->size(),
                 "Incompatible basket and recovery sizes.");
-            // invalidate current calculations if any and notify observers
-            LazyObject::update();
+            // invalidates current calculations unless they can be shared
+            this->resetSimulations();
         }
         // This one and the buffer might be moved to the parent, only some
         //   dates might be specific to a particular model.
@@ -924,11 +970,12 @@ namespace QuantLib {
 
     template<class C, class URNG>
     void RandomDefaultLM<C, URNG>::nextSample(
-        const std::vector<Real>& values) const
+        const std::vector<Real>& values,
+        std::vector<defaultSimEvent>& events) const
     {
         const boost::shared_ptr<Pool>& pool = this->basket_->pool();
         // starts with no events
-        this->simsBuffer_.push_back(std::vector<defaultSimEvent> ());
+        events.clear();
 
         for(Size iName=0; iName<copula_->size(); iName++) {
             Real latentVarSample =
@@ -956,8 +1003,7 @@ namespace QuantLib {
                                         std::log(1.-simDefaultProb)
                     /std::log(1.-data_.horizonDefaultPs_[iName])));
                    */
-                this->simsBuffer_.back().push_back(defaultSimEvent(iName,
-                    dateSTride));
+                events.push_back(defaultSimEvent(iName, dateSTride));
                //emplace_back
             }
         /* Used to remove sims with no events. Uses less memory, faster
@@ -23,14 +23,17 @@
 
 namespace QuantLib {
 
-    FdmSabrFpeUnderlyingPart::FdmSabrFpeUnderlyingPart(const boost::shared_ptr<FdmMesher>& mesher, const Real beta, const Real nu, const Real rho) :
+    FdmSabrFpeUnderlyingPart::FdmSabrFpeUnderlyingPart(const boost::shared_ptr<FdmMesher>& mesher, const Real beta, const Real nu, const Real rho,
+                                                       const Real gamma) :
       volatilityValues_(mesher->locations(1)),
 	  forwardValues_(mesher->locations(0)),
       dxMap_ (FirstDerivativeOp(0, mesher).mult(2.0*beta*Pow(forwardValues_,2.0*beta-1.0)*volatilityValues_*volatilityValues_+
-												2.0*nu*rho*Pow(forwardValues_,beta)*volatilityValues_)),
+												(1.0+gamma)*nu*rho*Pow(forwardValues_,beta)*Pow(volatilityValues_,gamma))),
       dxxMap_(SecondDerivativeOp(0, mesher).mult(0.5*volatilityValues_*volatilityValues_*Pow(forwardValues_,2.0*beta))),
+      // the zero order terms of all parts are collected here
       mapT_  (dxMap_.add(dxxMap_).add(beta*volatilityValues_*volatilityValues_*Pow(forwardValues_,2.0*beta-2.0)*(2.0*beta-1.0)+
-	                                  2.0*beta*nu*rho*Pow(forwardValues_,beta-1.0)*volatilityValues_+nu*nu)),
+	                                  (1.0+gamma)*beta*nu*rho*Pow(forwardValues_,beta-1.0)*Pow(volatilityValues_,gamma)+
+                                      gamma*(2.0*gamma-1.0)*nu*nu*Pow(volatilityValues_,2.0*gamma-2.0))),
       mesher_(mesher) {
         
     }
@@ -45,11 +48,13 @@ namespace QuantLib {
 
     FdmSabrFpeVolatilityPart::FdmSabrFpeVolatilityPart(
             const boost::shared_ptr<FdmMesher>& mesher,
-			const Real beta, const Real nu, const Real rho) :
+			const Real beta, const Real nu, const Real rho,
+            const Real gamma) :
       volatilityValues_(mesher->locations(1)),
 	  forwardValues_(mesher->locations(0)),
-	  dyMap_(FirstDerivativeOp(1,mesher).mult(beta*nu*rho*volatilityValues_*volatilityValues_*Pow(forwardValues_,beta-1.0)+2.0*nu*nu*volatilityValues_)),
-	  dyyMap_(SecondDerivativeOp(1,mesher).mult(0.5*nu*nu*volatilityValues_*volatilityValues_)),
+	  dyMap_(FirstDerivativeOp(1,mesher).mult(beta*nu*rho*Pow(volatilityValues_,1.0+gamma)*Pow(forwardValues_,beta-1.0)+
+                                              2.0*gamma*nu*nu*Pow(volatilityValues_,2.0*gamma-1.0))),
+	  dyyMap_(SecondDerivativeOp(1,mesher).mult(0.5*nu*nu*Pow(volatilityValues_,2.0*gamma))),
       mapT_(dyMap_.add(dyyMap_)) {
     }
 
@@ -62,12 +67,14 @@ namespace QuantLib {
     }
 
     FdmSabrFpeOp::FdmSabrFpeOp(const boost::shared_ptr<FdmMesher> &mesher,
-                               const Real beta, const Real nu, const Real rho)
+                               const Real beta, const Real nu, const Real rho,
+                               const Real gamma)
         : volatilityValues_(mesher->locations(1)),
-          forwardValues_(mesher->locations(0)), dxMap_(mesher, beta, nu, rho),
-          dyMap_(mesher, beta, nu, rho),
+          forwardValues_(mesher->locations(0)),
+          dxMap_(mesher, beta, nu, rho, gamma),
+          dyMap_(mesher, beta, nu, rho, gamma),
           dxyMap_(SecondOrderMixedDerivativeOp(0, 1, mesher)
-                      .mult(nu * rho * volatilityValues_ * volatilityValues_ *
+                      .mult(nu * rho * Pow(volatilityValues_, 1.0 + gamma) *
                             Pow(forwardValues_, beta))) {}
 
     void FdmSabrFpeOp::setTime(Time t1, Time t2) {
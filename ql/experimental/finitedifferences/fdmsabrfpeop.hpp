@@ -35,7 +35,8 @@ namespace QuantLib {
 
 	class FdmSabrFpeUnderlyingPart {
       public:
-        FdmSabrFpeUnderlyingPart(const boost::shared_ptr<FdmMesher>& mesher, const Real beta, const Real nu, const Real rho);
+        FdmSabrFpeUnderlyingPart(const boost::shared_ptr<FdmMesher>& mesher, const Real beta, const Real nu, const Real rho,
+                                 const Real gamma = 1.0);
 
         void setTime(Time t1, Time t2);
         const TripleBandLinearOp& getMap() const;
@@ -54,7 +55,8 @@ namespace QuantLib {
       public:
         FdmSabrFpeVolatilityPart(
             const boost::shared_ptr<FdmMesher>& mesher,
-			const Real beta, const Real nu, const Real rho);
+			const Real beta, const Real nu, const Real rho,
+            const Real gamma = 1.0);
 
         void setTime(Time t1, Time t2);
         const TripleBandLinearOp& getMap() const;
@@ -73,7 +75,9 @@ namespace QuantLib {
         FdmSabrFpeOp(const boost::shared_ptr<FdmMesher>& mesher,
 			const Real beta,
 			const Real nu,
-			const Real rho);
+			const Real rho,
+            const Real gamma = 1.0); // gamma=1.0 recovers the classic sabr model,
+                                     // otherwise the zabr dynamics are used
 
         Size size() const;
         void setTime(Time t1, Time t2);
@@ -351,7 +351,9 @@ namespace QuantLib {
     const {
         calculate();
 
-        return rescaleTimeSteps_;
+        // a Disposable built from the member would swap it away
+        std::vector<Size> retVal(rescaleTimeSteps_);
+        return retVal;
     }
 
     Real LocalVolRNDCalculator::probabilityInterpolation(
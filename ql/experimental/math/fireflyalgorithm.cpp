@@ -66,9 +66,12 @@ namespace QuantLib {
                 //Assign X=lb+(ub-lb)*random
                 x[j] = lX_[j] + bounds[j] * sample[j];
             }
-            //Evaluate point
-            values_.push_back(std::make_pair(P.value(x), i));
         }
+        //Evaluate points
+        Array values;
+        P.batchValue(x_, values);
+        for (Size i = 0; i < M_; i++)
+            values_.push_back(std::make_pair(values[i], i));
 
         //init intensity & randomWalk
         intensity_->init(this);
@@ -169,6 +172,7 @@ namespace QuantLib {
                 randomWalk_->walk();
 
                 //Loop over particles
+                std::vector<Array> moved(Mfa_);
                 for (Size i = 0; i < Mfa_; i++) {
                     Size index = values_[i].second;
                     Array& x   = x_[index];
@@ -187,11 +191,17 @@ namespace QuantLib {
                             x[j] = uX_[j];
                         }
                     }
-                    //Evaluate x & mark best
-                    values_[index].first = P.value(x);
+                    moved[i] = x;
+                }
+                //Evaluate the moved particles at once & mark best
+                Array movedValues;
+                P.batchValue(moved, movedValues);
+                for (Size i = 0; i < Mfa_; i++) {
+                    Size index = values_[i].second;
+                    values_[index].first = movedValues[i];
                     if (values_[index].first < bestValue) {
                         bestValue = values_[index].first;
-                        bestX = x;
+                        bestX = x_[index];
                         iterationStat = 0;
                     }
                 }
@@ -78,10 +78,14 @@ namespace QuantLib {
                 //Assign V=(ub-lb)*2*random-(ub-lb) -> between (lb-ub) and (ub-lb)
                 v[j] = bounds[j] * (2.0*sample[2 * j + 1] - 1.0);
             }
-            //Evaluate X and assign as personal best
+            //Assign X as personal best
             pBX_.push_back(X_.back());
-            pBF_[i] = P.value(X_.back());
         }
+        //Evaluate X
+        Array values;
+        P.batchValue(X_, values);
+        for (Size i = 0; i < M_; i++)
+            pBF_[i] = values[i];
 
         //init topology & inertia
         topology_->init(this);
@@ -146,8 +150,15 @@ namespace QuantLib {
                         v[j] = 0.0;
                     }
                 }
-                //Evaluate x
-                Real f = P.value(x);
+            }
+
+            //Evaluate the particles at once
+            Array values;
+            P.batchValue(X_, values);
+            for (Size i = 0; i < M_; i++) {
+                const Array& x = X_[i];
+                Array& pB = pBX_[i];
+                Real f = values[i];
                 if (pBF_[i] < f) {
                     //Update personal best
                     pBF_[i] = f;
@@ -29,6 +29,7 @@
 #include <ql/experimental/models/quadraticlfm.hpp>
 #include <ql/experimental/models/sbsmilesection.hpp>
 #include <ql/experimental/models/splinedensitysmilesection.hpp>
+#include <ql/experimental/models/hestonslvcalibrationinputs.hpp>
 #include <ql/experimental/models/hestonslvfdmmodel.hpp>
 #include <ql/experimental/models/hestonslvmcmodel.hpp>
 
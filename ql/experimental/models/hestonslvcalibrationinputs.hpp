@@ -0,0 +1,88 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file hestonslvcalibrationinputs.hpp
+    \brief market and model inputs of a Heston SLV leverage calibration
+*/
+
+#ifndef quantlib_heston_slv_calibration_inputs_hpp
+#define quantlib_heston_slv_calibration_inputs_hpp
+
+#include <ql/processes/hestonprocess.hpp>
+#include <ql/termstructures/volatility/equityfx/localvoltermstructure.hpp>
+
+namespace QuantLib {
+
+    namespace detail {
+
+        /*! Returns the values of the inputs read by a leverage-function
+            calibration on the given grid: the Heston parameters, the
+            spot, the discount factors at the grid times and the local
+            volatility at the grid nodes, at both the node time and
+            the previous grid time.  When they are unchanged, the
+            calibration would reproduce the previous leverage function,
+            which can therefore be reused.
+        */
+        inline std::vector<Real> hestonSLVCalibrationInputs(
+            const boost::shared_ptr<HestonProcess>& hestonProcess,
+            const boost::shared_ptr<LocalVolTermStructure>& localVol,
+            const std::vector<Time>& times,
+            const std::vector<boost::shared_ptr<std::vector<Real> > >&
+                                                                strikes) {
+            const Handle<YieldTermStructure>& rTS =
+                hestonProcess->riskFreeRate();
+            const Handle<YieldTermStructure>& qTS =
+                hestonProcess->dividendYield();
+            const Real spot = hestonProcess->s0()->value();
+
+            std::vector<Real> inputs;
+            inputs.push_back(Real(rTS->referenceDate().serialNumber()));
+            inputs.push_back(spot);
+            inputs.push_back(hestonProcess->v0());
+            inputs.push_back(hestonProcess->kappa());
+            inputs.push_back(hestonProcess->theta());
+            inputs.push_back(hestonProcess->sigma());
+            inputs.push_back(hestonProcess->rho());
+
+            for (Size i=0; i < times.size(); ++i) {
+                inputs.push_back(rTS->discount(times[i], true));
+                inputs.push_back(qTS->discount(times[i], true));
+            }
+
+            try {
+                inputs.push_back(localVol->localVol(0.0, spot, true));
+                for (Size i=0; i < times.size(); ++i) {
+                    const Time tPrev = times[(i > 0) ? i-1 : 0];
+                    for (Size j=0; j < strikes[i]->size(); ++j) {
+                        const Real k = (*strikes[i])[j];
+                        inputs.push_back(localVol->localVol(times[i], k, true));
+                        inputs.push_back(localVol->localVol(tPrev, k, true));
+                    }
+                }
+            } catch (Error&) {
+                // the surface cannot be probed; never reuse
+                return std::vector<Real>();
+            }
+
+            return inputs;
+        }
+
+    }
+
+}
+
+#endif
@@ -35,6 +35,7 @@
 #include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
 #include <ql/methods/finitedifferences/utilities/fdmmesherintegral.hpp>
 #include <ql/experimental/models/hestonslvfdmmodel.hpp>
+#include <ql/experimental/models/hestonslvcalibrationinputs.hpp>
 #include <ql/experimental/finitedifferences/fdmhestonfwdop.hpp>
 #include <ql/experimental/finitedifferences/localvolrndcalculator.hpp>
 #include <ql/experimental/finitedifferences/squarerootprocessrndcalculator.hpp>
@@ -50,6 +51,29 @@ using namespace boost::assign;
 namespace QuantLib {
 
     namespace {
+        /* The density of the local-vol process drives the rescaling
+           steps, the spot meshers and the bounds of the leverage
+           function; it is solved on the calculator's own time steps,
+           which differ from the ones at which the local volatility is
+           probed.  Its values on the meshers are therefore part of the
+           calibration inputs. */
+        void appendLocalVolRNDInputs(const LocalVolRNDCalculator& rnd,
+                                     const TimeGrid& timeGrid,
+                                     std::vector<Real>& inputs) {
+            const std::vector<Size> rescaleSteps = rnd.rescaleTimeSteps();
+            inputs.insert(inputs.end(),
+                          rescaleSteps.begin(), rescaleSteps.end());
+
+            for (Size i=1; i < timeGrid.size(); ++i) {
+                const Time t = timeGrid[i];
+                const std::vector<Real>& x = rnd.mesher(t)->locations();
+                for (Size j=0; j < x.size(); ++j) {
+                    inputs.push_back(x[j]);
+                    inputs.push_back(rnd.pdf(x[j], t));
+                }
+            }
+        }
+
         boost::shared_ptr<Fdm1dMesher> varianceMesher(
             const SquareRootProcessRNDCalculator& rnd,
             Time t0, Time t1, Size vGrid,
@@ -282,6 +306,9 @@ namespace QuantLib {
     }
 
     void HestonSLVFDMModel::update() {
+        // recalculate on the next request; the leverage function is
+        // kept anyway if the calibration inputs are unchanged
+        calculated_ = false;
         notifyObservers();
     }
 
@@ -301,10 +328,9 @@ namespace QuantLib {
     }
 
     void HestonSLVFDMModel::performCalculations() const {
-        logEntries_.clear();
-
         const boost::shared_ptr<HestonProcess> hestonProcess
             = hestonModel_->process();
+
         const boost::shared_ptr<Quote> spot
             = hestonProcess->s0().currentLink();
         const boost::shared_ptr<YieldTermStructure> rTS
@@ -362,6 +388,37 @@ namespace QuantLib {
             params_.localVolEpsProb,
             params_.maxIntegrationIterations);
 
+        // create strikes from meshers
+        std::vector<boost::shared_ptr<std::vector<Real> > > vStrikes(
+            timeGrid->size());
+
+        for (Size i=0; i < timeGrid->size(); ++i) {
+            const boost::shared_ptr<Fdm1dMesher> m
+                = localVolRND.mesher(timeGrid->at(i));
+            vStrikes[i] = boost::make_shared<std::vector<Real> >(xGrid);
+            std::transform(m->locations().begin(), m->locations().end(),
+                           vStrikes[i]->begin(),
+                           std::ptr_fun<Real, Real>(std::exp));
+        }
+
+        // reuse the previous leverage function if its inputs are unchanged
+        const std::vector<Time> calibrationTimes(
+            timeGrid->begin(), timeGrid->end());
+        std::vector<Real> inputs = detail::hestonSLVCalibrationInputs(
+            hestonProcess, localVol_.currentLink(),
+            calibrationTimes, vStrikes);
+        if (!inputs.empty()) {
+            inputs.insert(inputs.end(),
+                          calibrationTimes.begin(), calibrationTimes.end());
+            appendLocalVolRNDInputs(localVolRND, *timeGrid, inputs);
+        }
+        if (leverageFunction_ && !inputs.empty()
+            && inputs == calibrationInputs_)
+            return;
+
+        logEntries_.clear();
+        calibrationInputs_.clear();
+
         const std::vector<Size> rescaleSteps
             = localVolRND.rescaleTimeSteps();
 
@@ -383,7 +440,8 @@ namespace QuantLib {
         for (Size i=1; i < timeGrid->size(); ++i) {
             xMesher.push_back(localVolRND.mesher(timeGrid->at(i)));
 
-            if (i == rescaleSteps[rescaleIdx]) {
+            if (rescaleIdx < rescaleSteps.size()
+                && i == rescaleSteps[rescaleIdx]) {
                 ++rescaleIdx;
                 vMesher.push_back(varianceMesher(squareRootRnd,
                     timeGrid->at(rescaleSteps[rescaleIdx-1]),
@@ -410,18 +468,6 @@ namespace QuantLib {
         std::fill(L->column_begin(0),L->column_end(0), l0);
         std::fill(L->column_begin(1),L->column_end(1), l0);
 
-        // create strikes from meshers
-        std::vector<boost::shared_ptr<std::vector<Real> > > vStrikes(
-            timeGrid->size());
-
-        for (Size i=0; i < timeGrid->size(); ++i) {
-            vStrikes[i] = boost::make_shared<std::vector<Real> >(xGrid);
-            std::transform(xMesher[i]->locations().begin(),
-                           xMesher[i]->locations().end(),
-                           vStrikes[i]->begin(),
-                           std::ptr_fun<Real, Real>(std::exp));
-        }
-
         const boost::shared_ptr<FixedLocalVolSurface> leverageFct(
             new FixedLocalVolSurface(referenceDate, times, vStrikes, L, dc));
 
@@ -475,31 +521,27 @@ namespace QuantLib {
                 const boost::shared_ptr<FdmScheme> fdmScheme(
                     fdmSchemeFactory(params_.schemeDesc, hestonFwdOp));
 
-                for (Size j=0; j < x.size(); ++j) {
-                    Array pSlice(vGrid);
-                    for (Size k=0; k < vGrid; ++k)
-                        pSlice[k] = pn[j + k*xGrid];
-
-                    const Real pInt = (trafoType == FdmSquareRootFwdOp::Power)
-                       ? DiscreteSimpsonIntegral()(v, Pow(v, alpha-1)*pSlice)
-                       : DiscreteSimpsonIntegral()(v, pSlice);
-
-                    const Real vpInt = (trafoType == FdmSquareRootFwdOp::Log)
-                      ? DiscreteSimpsonIntegral()(v, Exp(v)*pSlice)
-                      : (trafoType == FdmSquareRootFwdOp::Power)
-                      ? DiscreteSimpsonIntegral()(v, Pow(v, alpha)*pSlice)
-                      : DiscreteSimpsonIntegral()(v, v*pSlice);
-
-                    const Real scale = pInt/vpInt;
-                    const Volatility localVol = localVol_->localVol(t, x[j]);
-
-                    const Real l = (scale >= 0.0)
-                      ? localVol*std::sqrt(scale) : 1.0;
-
-                    (*L)[j][i] = std::min(50.0, std::max(0.001, l));
-
-                    leverageFct->setInterpolation(Linear());
+                // the leverage at each spot level only depends on the
+                // density slice at that level; the first one is done
+                // serially, so that lazy dependencies of the local vol
+                // surface are calculated before going parallel.
+                std::vector<std::string> errors(x.size());
+
+                leverage(0, i, t, x, v, pn, alpha, *L);
+                #pragma omp parallel for
+                for (long j=1; j < long(x.size()); ++j) {
+                    try {
+                        leverage(j, i, t, x, v, pn, alpha, *L);
+                    } catch (std::exception& e) {
+                        errors[j] = e.what();
+                    } catch (...) {
+                        errors[j] = "unknown error";
+                    }
                 }
+                for (Size j=1; j < x.size(); ++j)
+                    QL_REQUIRE(errors[j].empty(), errors[j]);
+
+                leverageFct->setInterpolation(Linear());
 
                 const Real sLowerBound = std::max(x.front(),
                     std::exp(localVolRND.invcdf(
@@ -541,6 +583,40 @@ namespace QuantLib {
         }
 
         leverageFunction_ = leverageFct;
+
+        calibrationInputs_.swap(inputs);
+    }
+
+    void HestonSLVFDMModel::leverage(Size j, Size i, Time t,
+                                     const Array& x, const Array& v,
+                                     const Array& p, Real alpha,
+                                     Matrix& L) const {
+        const Size xGrid = params_.xGrid;
+        const Size vGrid = params_.vGrid;
+        const FdmSquareRootFwdOp::TransformationType trafoType
+          = params_.trafoType;
+
+        Array pSlice(vGrid);
+        for (Size k=0; k < vGrid; ++k)
+            pSlice[k] = p[j + k*xGrid];
+
+        const Real pInt = (trafoType == FdmSquareRootFwdOp::Power)
+           ? DiscreteSimpsonIntegral()(v, Pow(v, alpha-1)*pSlice)
+           : DiscreteSimpsonIntegral()(v, pSlice);
+
+        const Real vpInt = (trafoType == FdmSquareRootFwdOp::Log)
+          ? DiscreteSimpsonIntegral()(v, Exp(v)*pSlice)
+          : (trafoType == FdmSquareRootFwdOp::Power)
+          ? DiscreteSimpsonIntegral()(v, Pow(v, alpha)*pSlice)
+          : DiscreteSimpsonIntegral()(v, v*pSlice);
+
+        const Real scale = pInt/vpInt;
+        const Volatility localVol = localVol_->localVol(t, x[j]);
+
+        const Real l = (scale >= 0.0)
+          ? localVol*std::sqrt(scale) : 1.0;
+
+        L[j][i] = std::min(50.0, std::max(0.001, l));
     }
 
     const std::list<HestonSLVFDMModel::LogEntry>& HestonSLVFDMModel::logEntries()
@@ -67,6 +67,15 @@ class SimpleQuote;
         const FdmSchemeDesc schemeDesc;
     };
 
+    //! Heston stochastic local volatility model
+    /*! The leverage function is calibrated by evolving the forward
+        Fokker-Planck equation of the Heston process; the leverage
+        at the spot levels of each time step is calculated
+        concurrently.  On recalculation, the leverage function is
+        kept if the Heston parameters, rates and local volatility
+        it was calibrated on, as well as the density of the
+        local-vol process on the spot meshers, are unchanged.
+    */
     class HestonSLVFDMModel : public LazyObject {
       public:
         HestonSLVFDMModel(
@@ -93,6 +102,9 @@ class SimpleQuote;
 
       protected:
         void performCalculations() const;
+        void leverage(Size j, Size i, Time t,
+                      const Array& x, const Array& v,
+                      const Array& p, Real alpha, Matrix& L) const;
 
         const Handle<LocalVolTermStructure> localVol_;
         const Handle<HestonModel> hestonModel_;
@@ -101,6 +113,7 @@ class SimpleQuote;
         const std::vector<Date> mandatoryDates_;
 
         mutable boost::shared_ptr<LocalVolTermStructure> leverageFunction_;
+        mutable std::vector<Real> calibrationInputs_;
 
         const bool logging_;
         mutable std::list<LogEntry> logEntries_;
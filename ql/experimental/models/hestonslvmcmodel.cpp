@@ -24,6 +24,7 @@
 #include <ql/math/functional.hpp>
 #include <ql/termstructures/volatility/equityfx/fixedlocalvolsurface.hpp>
 #include <ql/experimental/models/hestonslvmcmodel.hpp>
+#include <ql/experimental/models/hestonslvcalibrationinputs.hpp>
 #include <ql/experimental/processes/hestonslvprocess.hpp>
 
 #include <boost/make_shared.hpp>
@@ -72,6 +73,9 @@ namespace QuantLib {
     }
 
     void HestonSLVMCModel::update() {
+        // recalculate on the next request; the leverage function is
+        // kept anyway if the calibration inputs are unchanged
+        calculated_ = false;
         notifyObservers();
     }
 
@@ -100,6 +104,18 @@ namespace QuantLib {
         const boost::shared_ptr<YieldTermStructure> qTS
             = hestonProcess->dividendYield().currentLink();
 
+        const std::vector<Time> times(timeGrid_->begin(), timeGrid_->end());
+
+        // reuse the previous leverage function if its inputs are unchanged
+        if (leverageFunction_) {
+            const std::vector<Real> inputs = detail::hestonSLVCalibrationInputs(
+                hestonProcess, localVol_.currentLink(), times, vStrikes_);
+            if (!inputs.empty() && inputs == calibrationInputs_)
+                return;
+        }
+
+        calibrationInputs_.clear();
+
         const Real v0            = hestonProcess->v0();
         const DayCounter dc      = hestonProcess->riskFreeRate()->dayCounter();
         const Date referenceDate = hestonProcess->riskFreeRate()->referenceDate();
@@ -124,9 +140,7 @@ namespace QuantLib {
         std::fill(L->column_begin(0),L->column_end(0), lv0);
 
         leverageFunction_ = boost::make_shared<FixedLocalVolSurface>(
-            referenceDate,
-            std::vector<Time>(timeGrid_->begin(), timeGrid_->end()),
-            vStrikes, L, dc);
+            referenceDate, times, vStrikes, L, dc);
 
         const boost::shared_ptr<HestonSLVProcess> slvProcess
             = boost::make_shared<HestonSLVProcess>(hestonProcess, leverageFunction_);
@@ -134,9 +148,6 @@ namespace QuantLib {
         std::vector<std::pair<Real, Real> > pairs(
                 calibrationPaths_, std::make_pair(spot->value(), v0));
 
-        const Size k = calibrationPaths_ / nBins_;
-        const Size m = calibrationPaths_ % nBins_;
-
         const Size timeSteps = timeGrid_->size()-1;
 
         typedef boost::multi_array<Real, 3> path_type;
@@ -159,42 +170,86 @@ namespace QuantLib {
             const Time t = timeGrid_->at(n-1);
             const Time dt = timeGrid_->dt(n-1);
 
-            Array x0(2), dw(2);
+            // paths and bins are independent of each other; the first
+            // one is processed serially, so that lazy dependencies of
+            // the process and of the local vol surface are calculated
+            // before the others are processed concurrently.
+            std::string error;
+
+            evolvePath(*slvProcess, t, dt,
+                       paths[0][n-1][0], paths[0][n-1][1], pairs[0]);
+            #pragma omp parallel for
+            for (long i=1; i < long(calibrationPaths_); ++i) {
+                try {
+                    evolvePath(*slvProcess, t, dt,
+                               paths[i][n-1][0], paths[i][n-1][1],
+                               pairs[i]);
+                } catch (std::exception& e) {
+                    #pragma omp critical(ql_heston_slv_mc_model)
+                    if (error.empty()) error = e.what();
+                }
+            }
+            QL_REQUIRE(error.empty(), error);
 
-            for (Size i=0; i < calibrationPaths_; ++i) {
-                x0[0] = pairs[i].first;
-                x0[1] = pairs[i].second;
+            std::sort(pairs.begin(), pairs.end());
 
-                dw[0] = paths[i][n-1][0];
-                dw[1] = paths[i][n-1][1];
+            fillBin(0, n, t, pairs, vStrikes, *L);
+            #pragma omp parallel for
+            for (long i=1; i < long(nBins_); ++i) {
+                try {
+                    fillBin(i, n, t, pairs, vStrikes, *L);
+                } catch (std::exception& e) {
+                    #pragma omp critical(ql_heston_slv_mc_model)
+                    if (error.empty()) error = e.what();
+                }
+            }
+            QL_REQUIRE(error.empty(), error);
 
-                x0 = slvProcess->evolve(t, x0, dt, dw);
+            leverageFunction_->setInterpolation<Linear>();
+        }
 
-                pairs[i].first = x0[0];
-                pairs[i].second = x0[1];
-            }
+        vStrikes_ = vStrikes;
+        calibrationInputs_ = detail::hestonSLVCalibrationInputs(
+            hestonProcess, localVol_.currentLink(), times, vStrikes_);
+    }
 
-            std::sort(pairs.begin(), pairs.end());
+    void HestonSLVMCModel::evolvePath(const StochasticProcess& slvProcess,
+                                      Time t, Time dt, Real dw0, Real dw1,
+                                      std::pair<Real, Real>& state) const {
+        Array x0(2), dw(2);
+        x0[0] = state.first;
+        x0[1] = state.second;
 
-            Size s = 0u, e = 0u;
-            for (Size i=0; i < nBins_; ++i) {
-                const Size inc = k + (i < m);
-                e = s + inc;
+        dw[0] = dw0;
+        dw[1] = dw1;
 
-                Real sum=0.0;
-                for (Size j=s; j < e; ++j) {
-                    sum+=pairs[j].second;
-                }
-                sum/=inc;
+        x0 = slvProcess.evolve(t, x0, dt, dw);
+
+        state.first = x0[0];
+        state.second = x0[1];
+    }
 
-                vStrikes[n]->at(i) = 0.5*(pairs[e-1].first + pairs[s].first);
-                (*L)[i][n] = std::sqrt(square<Real>()(
-                     localVol_->localVol(t, vStrikes[n]->at(i), true))/sum);
+    void HestonSLVMCModel::fillBin(
+                    Size i, Size n, Time t,
+                    const std::vector<std::pair<Real, Real> >& pairs,
+                    const std::vector<boost::shared_ptr<std::vector<Real> > >&
+                                                                    vStrikes,
+                    Matrix& L) const {
+        const Size k = calibrationPaths_ / nBins_;
+        const Size m = calibrationPaths_ % nBins_;
 
-                s = e;
-            }
+        const Size s = i*k + std::min(i, m);
+        const Size inc = k + (i < m);
+        const Size e = s + inc;
 
-            leverageFunction_->setInterpolation<Linear>();
+        Real sum=0.0;
+        for (Size j=s; j < e; ++j) {
+            sum+=pairs[j].second;
         }
+        sum/=inc;
+
+        vStrikes[n]->at(i) = 0.5*(pairs[e-1].first + pairs[s].first);
+        L[i][n] = std::sqrt(square<Real>()(
+             localVol_->localVol(t, vStrikes[n]->at(i), true))/sum);
     }
 }
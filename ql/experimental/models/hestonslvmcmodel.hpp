@@ -38,6 +38,13 @@ namespace QuantLib {
         Anthonie W. van der Stoep,Lech A. Grzelak, Cornelis W. Oosterlee, 2013,
         The Heston Stochastic-Local Volatility Model: Efficient Monte Carlo Simulation
         http://papers.ssrn.com/sol3/papers.cfm?abstract_id=2278122
+
+        The calibration paths are drawn serially from the Brownian
+        generator, so that the result does not depend on the number
+        of threads; they are then evolved and binned concurrently
+        at each time step.  On recalculation, the leverage function
+        is kept if the Heston parameters, rates and local volatility
+        it was calibrated on are unchanged.
     */
 
     class HestonSLVMCModel : public LazyObject {
@@ -62,6 +69,15 @@ namespace QuantLib {
         void performCalculations() const;
 
       private:
+        void evolvePath(const StochasticProcess& slvProcess,
+                        Time t, Time dt, Real dw0, Real dw1,
+                        std::pair<Real, Real>& state) const;
+        void fillBin(Size i, Size n, Time t,
+                     const std::vector<std::pair<Real, Real> >& pairs,
+                     const std::vector<boost::shared_ptr<std::vector<Real> > >&
+                                                                    vStrikes,
+                     Matrix& L) const;
+
         const Handle<LocalVolTermStructure> localVol_;
         const Handle<HestonModel> hestonModel_;
         const boost::shared_ptr<BrownianGeneratorFactory> brownianGeneratorFactory_;
@@ -70,6 +86,8 @@ namespace QuantLib {
         boost::shared_ptr<TimeGrid> timeGrid_;
 
         mutable boost::shared_ptr<FixedLocalVolSurface> leverageFunction_;
+        mutable std::vector<boost::shared_ptr<std::vector<Real> > > vStrikes_;
+        mutable std::vector<Real> calibrationInputs_;
     };
 }
 
@@ -24,8 +24,10 @@ namespace QuantLib {
 LongstaffSchwartzProxyPathPricer::LongstaffSchwartzProxyPathPricer(
     const TimeGrid &times,
     const boost::shared_ptr<EarlyExercisePathPricer<PathType> > &pricer,
-    const boost::shared_ptr<YieldTermStructure> &termStructure)
-    : LongstaffSchwartzPathPricer<PathType>(times, pricer, termStructure),
+    const boost::shared_ptr<YieldTermStructure> &termStructure,
+    LsmCalibrationStorage::Type storage)
+    : LongstaffSchwartzPathPricer<PathType>(times, pricer, termStructure,
+                                            storage),
       coeffItm_(times.size() - 1), coeffOtm_(times.size() - 1) {}
 
 void LongstaffSchwartzProxyPathPricer::post_processing(
@@ -39,7 +39,8 @@ class LongstaffSchwartzProxyPathPricer
     LongstaffSchwartzProxyPathPricer(
         const TimeGrid &times,
         const boost::shared_ptr<EarlyExercisePathPricer<PathType> > &pricer,
-        const boost::shared_ptr<YieldTermStructure> &termStructure);
+        const boost::shared_ptr<YieldTermStructure> &termStructure,
+        LsmCalibrationStorage::Type storage = LsmCalibrationStorage::Paths);
 
     const std::vector<boost::function1<Real, StateType> > basisSystem() const {
         return v_;
@@ -81,7 +81,9 @@ class McGaussian1dNonstandardSwaptionEngine
         Size timeSteps, Size timeStepsPerYear, bool brownianBridge,
         bool antitheticVariate, Size requiredSamples, Real requiredTolerance,
         Size maxSamples, BigNatural seed, Size nCalibrationSamples,
-        bool generateProxy);
+        bool generateProxy,
+        LsmCalibrationStorage::Type calibrationStorage =
+            LsmCalibrationStorage::Paths);
 
     void calculate() const;
     void reset() const;
@@ -94,6 +96,7 @@ class McGaussian1dNonstandardSwaptionEngine
     Handle<Quote> oas_;
     Handle<YieldTermStructure> discountCurve_;
     bool generateProxy_;
+    LsmCalibrationStorage::Type calibrationStorage_;
     mutable boost::shared_ptr<NonstandardSwaption::Proxy> proxy_;
 };
 
@@ -122,6 +125,8 @@ class MakeMcGaussian1dNonstandardSwaptionEngine {
     MakeMcGaussian1dNonstandardSwaptionEngine &
     withDiscount(const Handle<YieldTermStructure> &discount);
     MakeMcGaussian1dNonstandardSwaptionEngine &withProxy(bool b = true);
+    MakeMcGaussian1dNonstandardSwaptionEngine &
+    withCalibrationStorage(LsmCalibrationStorage::Type storage);
     // conversion to pricing engine
     operator boost::shared_ptr<PricingEngine>() const;
 
@@ -134,6 +139,7 @@ class MakeMcGaussian1dNonstandardSwaptionEngine {
     Real tolerance_;
     BigNatural seed_;
     bool generateProxy_;
+    LsmCalibrationStorage::Type calibrationStorage_;
 };
 
 //! Path Pricer
@@ -173,7 +179,7 @@ McGaussian1dNonstandardSwaptionEngine<RNG, S>::
         Size timeSteps, Size timeStepsPerYear, bool brownianBridge,
         bool antitheticVariate, Size requiredSamples, Real requiredTolerance,
         Size maxSamples, BigNatural seed, Size nCalibrationSamples,
-        bool generateProxy)
+        bool generateProxy, LsmCalibrationStorage::Type calibrationStorage)
     : MCLongstaffSchwartzEngine<
           GenericModelEngine<Gaussian1dModel, NonstandardSwaption::arguments,
                              NonstandardSwaption::results>,
@@ -182,7 +188,7 @@ McGaussian1dNonstandardSwaptionEngine<RNG, S>::
           antitheticVariate, false, requiredSamples, requiredTolerance,
           maxSamples, seed, nCalibrationSamples),
       model_(model), oas_(oas), discountCurve_(discountCurve),
-      generateProxy_(generateProxy) {
+      generateProxy_(generateProxy), calibrationStorage_(calibrationStorage) {
 
     if (!oas_.empty())
         this->registerWith(oas_);
@@ -278,10 +284,12 @@ McGaussian1dNonstandardSwaptionEngine<RNG, S>::lsmPathPricer() const {
                                         Actual365Fixed());
     if (generateProxy_) {
         return boost::make_shared<LongstaffSchwartzProxyPathPricer>(
-            exerciseGrid, earlyExercisePricer, dummyCurve);
+            exerciseGrid, earlyExercisePricer, dummyCurve,
+            calibrationStorage_);
     } else {
         return boost::make_shared<LongstaffSchwartzPathPricer<Path> >(
-            exerciseGrid, earlyExercisePricer, dummyCurve);
+            exerciseGrid, earlyExercisePricer, dummyCurve,
+            calibrationStorage_);
     }
 }
 
@@ -294,7 +302,7 @@ inline MakeMcGaussian1dNonstandardSwaptionEngine<RNG, S>::
       antithetic_(false), steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), calibrationSamples_(Null<Size>()),
       maxSamples_(Null<Size>()), tolerance_(Null<Real>()), seed_(0),
-      generateProxy_(false) {}
+      generateProxy_(false), calibrationStorage_(LsmCalibrationStorage::Paths) {}
 
 template <class RNG, class S>
 inline MakeMcGaussian1dNonstandardSwaptionEngine<RNG, S> &
@@ -392,6 +400,14 @@ MakeMcGaussian1dNonstandardSwaptionEngine<RNG, S>::withProxy(bool b) {
     return *this;
 }
 
+template <class RNG, class S>
+inline MakeMcGaussian1dNonstandardSwaptionEngine<RNG, S> &
+MakeMcGaussian1dNonstandardSwaptionEngine<RNG, S>::withCalibrationStorage(
+    LsmCalibrationStorage::Type storage) {
+    calibrationStorage_ = storage;
+    return *this;
+}
+
 template <class RNG, class S>
 inline MakeMcGaussian1dNonstandardSwaptionEngine<RNG, S>::
 operator boost::shared_ptr<PricingEngine>() const {
@@ -403,7 +419,7 @@ operator boost::shared_ptr<PricingEngine>() const {
         new McGaussian1dNonstandardSwaptionEngine<RNG, S>(
             model_, oas_, discount_, steps_, stepsPerYear_, brownianBridge_,
             antithetic_, samples_, tolerance_, maxSamples_, seed_,
-            calibrationSamples_, generateProxy_));
+            calibrationSamples_, generateProxy_, calibrationStorage_));
 }
 
 } // namespace QuantLib
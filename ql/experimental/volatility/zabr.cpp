@@ -34,6 +34,7 @@
 #include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
 #include <ql/experimental/finitedifferences/fdmdupire1dop.hpp>
 #include <ql/experimental/finitedifferences/fdmzabrop.hpp>
+#include <ql/experimental/finitedifferences/fdmsabrfpeop.hpp>
 #include <boost/function.hpp>
 #include <boost/bind.hpp>
 
@@ -41,6 +42,44 @@ using std::pow;
 
 namespace QuantLib {
 
+namespace {
+
+// trapezoidal integration weights on a (non uniform) grid
+std::vector<Real> trapezoidWeights(const std::vector<Real> &x) {
+    std::vector<Real> w(x.size(), 0.0);
+    for (Size i = 1; i < x.size(); ++i) {
+        w[i - 1] += 0.5 * (x[i] - x[i - 1]);
+        w[i] += 0.5 * (x[i] - x[i - 1]);
+    }
+    return w;
+}
+
+// index of the grid point closest to x
+Size closestIndex(const std::vector<Real> &grid, const Real x) {
+    Size i = std::lower_bound(grid.begin(), grid.end(), x) - grid.begin();
+    if (i == grid.size() || (i > 0 && x - grid[i - 1] < grid[i] - x))
+        --i;
+    return i;
+}
+
+// undiscounted call price, the density is linear between grid points
+Real callPrice(const ZabrForwardDensity &d, const Real strike) {
+    Real result = 0.0;
+    for (Size i = d.forwards.size() - 1; i > 0; --i) {
+        const Real a = d.forwards[i - 1], b = d.forwards[i];
+        if (strike >= b)
+            break;
+        const Real lo = std::max(a, strike);
+        const Real s = (d.density[i] - d.density[i - 1]) / (b - a);
+        const Real c0 = d.density[i - 1] - s * a;
+        result += s * (b * b * b - lo * lo * lo) / 3.0 +
+                  (c0 - s * strike) * (b * b - lo * lo) / 2.0 -
+                  c0 * strike * (b - lo);
+    }
+    return std::max(result, 0.0);
+}
+}
+
 ZabrModel::ZabrModel(const Real expiryTime, const Real forward,
                      const Real alpha, const Real beta, const Real nu,
                      const Real rho, const Real gamma)
@@ -310,6 +349,136 @@ Real ZabrModel::fullFdPrice(const Real strike) const {
     return (*interpolation)(forward_, alpha_);
 }
 
+Disposable<std::vector<Real> >
+ZabrModel::fpePrice(const std::vector<Real> &strikes) const {
+
+    QL_REQUIRE(!strikes.empty(), "no strikes given");
+    for (Size i = 1; i < strikes.size(); ++i)
+        QL_REQUIRE(strikes[i] > strikes[i - 1],
+                   "strikes must be strictly ascending ("
+                       << strikes[i - 1] << "," << strikes[i] << ")");
+
+    // same forward grid bounds as for the single strike pde, but covering
+    // all strikes
+    const Real eps = 0.01;
+    const Real scaleFactor = 1.5;
+    const Real normInvEps = InverseCumulativeNormal()(1.0 - eps);
+    const Real alphaI = alpha_ * std::pow(forward_, beta_ - 1.0);
+    Real f0 = forward_ * std::exp(-scaleFactor * normInvEps *
+                                  std::sqrt(expiryTime_) * alphaI);
+    Real f1 = forward_ * std::exp(scaleFactor * normInvEps *
+                                  std::sqrt(expiryTime_) * alphaI);
+    const Real kMin = std::max(strikes.front(), 0.0);
+    const Real kMax = std::max(strikes.back(), forward_);
+    if (kMin > 0.0)
+        f0 = std::min(kMin / 2.0, f0);
+    f1 = std::max(kMax * 1.5, std::min(f1, std::max(2.0, kMax * 1.5)));
+
+    ZabrDensityCache::key_type key;
+    key.push_back(expiryTime_);
+    key.push_back(forward_);
+    key.push_back(alpha_);
+    key.push_back(beta_);
+    key.push_back(nu_);
+    key.push_back(rho_);
+    key.push_back(gamma_);
+    key.push_back(f0);
+    key.push_back(f1);
+
+    boost::shared_ptr<const ZabrForwardDensity> density =
+        ZabrDensityCache::instance().find(key);
+    if (!density) {
+        density = fpeDensity(f0, f1);
+        ZabrDensityCache::instance().store(key, density);
+    }
+
+    std::vector<Real> result(strikes.size());
+    for (Size i = 0; i < strikes.size(); ++i)
+        result[i] = callPrice(*density, strikes[i]);
+    return result;
+}
+
+boost::shared_ptr<const ZabrForwardDensity>
+ZabrModel::fpeDensity(const Real f0, const Real f1) const {
+
+    // the volatility grid is wider than for the single strike pde,
+    // otherwise too much mass is lost at its boundaries
+    const Real eps = 0.01;
+    const Real scaleFactor = 2.5;
+    const Real normInvEps = InverseCumulativeNormal()(1.0 - eps);
+    Real v0 = alpha_ * std::exp(-scaleFactor * normInvEps *
+                                std::sqrt(expiryTime_) * nu_);
+    Real v1 = alpha_ *
+              std::exp(scaleFactor * normInvEps * std::sqrt(expiryTime_) * nu_);
+    v1 = std::min(v1, 2.0);
+
+    const Size sizef = 200;
+    const Size sizev = 100;
+    const Size steps = Size(24 * expiryTime_ + 1);
+    const Size dampingSteps = 5;
+    const Real densityf = 0.1;
+    const Real densityv = 0.1;
+
+    // Layout
+    std::vector<Size> dim;
+    dim.push_back(sizef);
+    dim.push_back(sizev);
+    const boost::shared_ptr<FdmLinearOpLayout> layout(
+        new FdmLinearOpLayout(dim));
+
+    // Mesher, the initial forward and volatility are grid points; the
+    // forward grid is refined at its lower end, where the drift of the
+    // density dominates the diffusion and a coarse grid is unstable
+    std::vector<boost::tuple<Real, Real, bool> > cPoints;
+    cPoints.push_back(boost::make_tuple(f0, 0.001, false));
+    cPoints.push_back(boost::make_tuple(forward_, densityf, true));
+    const boost::shared_ptr<Fdm1dMesher> mf(
+        new Concentrating1dMesher(f0, f1, sizef, cPoints));
+    const boost::shared_ptr<Fdm1dMesher> mv(new Concentrating1dMesher(
+        v0, v1, sizev, std::pair<Real, Real>(alpha_, densityv), true));
+    std::vector<boost::shared_ptr<Fdm1dMesher> > meshers;
+    meshers.push_back(mf);
+    meshers.push_back(mv);
+    const boost::shared_ptr<FdmMesher> mesher(
+        new FdmMesherComposite(layout, meshers));
+
+    const std::vector<Real> &f = mf->locations();
+    const std::vector<Real> &v = mv->locations();
+    const std::vector<Real> wf = trapezoidWeights(f);
+    const std::vector<Real> wv = trapezoidWeights(v);
+
+    // initial values, a discrete dirac delta at (forward, alpha)
+    const Size i0 = closestIndex(f, forward_);
+    const Size j0 = closestIndex(v, alpha_);
+    Array rhs(layout->size(), 0.0);
+    rhs[i0 + j0 * sizef] = 1.0 / (wf[i0] * wv[j0]);
+
+    // Boundary conditions
+    FdmBoundaryConditionSet boundaries;
+
+    // the operator is time reversed, so that we can use the backward solver
+    boost::shared_ptr<FdmSabrFpeOp> map(
+        new FdmSabrFpeOp(mesher, beta_, nu_, rho_, gamma_));
+    FdmBackwardSolver solver(map, boundaries,
+                             boost::shared_ptr<FdmStepConditionComposite>(),
+                             FdmSchemeDesc::Hundsdorfer());
+
+    solver.rollback(rhs, expiryTime_, 0.0, steps, dampingSteps);
+
+    // marginal density of the forward, negative values from
+    // oscillations in the tails are removed
+    boost::shared_ptr<ZabrForwardDensity> result(new ZabrForwardDensity);
+    result->forwards = f;
+    result->density.resize(sizef, 0.0);
+    for (Size j = 0; j < sizev; ++j)
+        for (Size i = 0; i < sizef; ++i)
+            result->density[i] += rhs[i + j * sizef] * wv[j];
+    for (Size i = 0; i < sizef; ++i)
+        result->density[i] = std::max(result->density[i], 0.0);
+
+    return result;
+}
+
 Real ZabrModel::x(const Real strike) const {
     return x(std::vector<Real>(1, strike))[0];
 }
@@ -386,4 +555,71 @@ Real ZabrModel::F(const Real y, const Real u) const {
     return (-B * u + std::sqrt(B * B * u * u - 4.0 * A * (C * u * u - 1.0))) /
            (2.0 * A);
 }
+
+ZabrDensityCache::ZabrDensityCache() : capacity_(64), hits_(0), misses_(0) {}
+
+void ZabrDensityCache::setCapacity(Size capacity) {
+    detail::MutexLock lock(mutex_);
+    capacity_ = capacity;
+    trim();
+}
+
+Size ZabrDensityCache::capacity() const {
+    detail::MutexLock lock(mutex_);
+    return capacity_;
+}
+
+boost::shared_ptr<const ZabrForwardDensity>
+ZabrDensityCache::find(const key_type &key) {
+    detail::MutexLock lock(mutex_);
+    std::map<key_type, entry_list::iterator>::iterator i = index_.find(key);
+    if (i == index_.end()) {
+        ++misses_;
+        return boost::shared_ptr<const ZabrForwardDensity>();
+    }
+    entries_.splice(entries_.begin(), entries_, i->second);
+    ++hits_;
+    return i->second->second;
+}
+
+void ZabrDensityCache::store(
+    const key_type &key,
+    const boost::shared_ptr<const ZabrForwardDensity> &density) {
+    detail::MutexLock lock(mutex_);
+    // another thread might have stored it in the meantime
+    if (index_.find(key) == index_.end() && capacity_ > 0) {
+        entries_.push_front(Entry(key, density));
+        index_[key] = entries_.begin();
+        trim();
+    }
+}
+
+Size ZabrDensityCache::size() const {
+    detail::MutexLock lock(mutex_);
+    return index_.size();
+}
+
+void ZabrDensityCache::clear() {
+    detail::MutexLock lock(mutex_);
+    index_.clear();
+    entries_.clear();
+    hits_ = misses_ = 0;
+}
+
+Size ZabrDensityCache::hits() const {
+    detail::MutexLock lock(mutex_);
+    return hits_;
+}
+
+Size ZabrDensityCache::misses() const {
+    detail::MutexLock lock(mutex_);
+    return misses_;
+}
+
+void ZabrDensityCache::trim() {
+    while (entries_.size() > capacity_) {
+        index_.erase(entries_.back().first);
+        entries_.pop_back();
+    }
+}
 }
@@ -32,10 +32,20 @@
 #include <ql/math/interpolations/linearinterpolation.hpp>
 #include <ql/math/interpolations/cubicinterpolation.hpp>
 #include <ql/math/interpolations/bicubicsplineinterpolation.hpp>
+#include <ql/patterns/singleton.hpp>
+#include <ql/utilities/mutex.hpp>
+#include <boost/shared_ptr.hpp>
+#include <list>
+#include <map>
 #include <vector>
 
 namespace QuantLib {
 
+//! marginal density of the forward at expiry on a grid
+struct ZabrForwardDensity {
+    std::vector<Real> forwards, density;
+};
+
 class ZabrModel {
 
   public:
@@ -52,6 +62,19 @@ class ZabrModel {
 
     Real fullFdPrice(const Real strike) const;
 
+    /*! Call prices for all strikes from a single solve of the forward
+        (Fokker-Planck) equation for the joint density of forward and
+        volatility. The marginal density of the forward is stored in the
+        ZabrDensityCache, so that sections built again with the same
+        forward, expiry and parameters do not repeat the solve.
+
+        \warning the forward equation does not conserve the probability
+                 mass exactly; the prices are accurate for gamma close to
+                 one, i.e. for the sabr model, while for other values of
+                 gamma some mass is lost at the grid boundaries. */
+    Disposable<std::vector<Real> >
+    fpePrice(const std::vector<Real> &strikes) const;
+
     Real lognormalVolatility(const Real strike) const;
     Disposable<std::vector<Real> >
     lognormalVolatility(const std::vector<Real> &strikes) const;
@@ -83,6 +106,47 @@ class ZabrModel {
     Real lognormalVolatilityHelper(const Real strike, const Real x) const;
     Real normalVolatilityHelper(const Real strike, const Real x) const;
     Real localVolatilityHelper(const Real f, const Real x) const;
+
+    boost::shared_ptr<const ZabrForwardDensity>
+    fpeDensity(const Real f0, const Real f1) const;
+};
+
+//! cache of forward densities computed by ZabrModel::fpePrice
+/*! The densities are keyed by expiry time, forward, model parameters and
+    the bounds of the forward grid. The cache holds at most the given
+    number of densities and discards the least recently used ones when
+    full. Its methods can be called concurrently; they are serialized by a
+    mutex.
+*/
+class ZabrDensityCache : public Singleton<ZabrDensityCache> {
+    friend class Singleton<ZabrDensityCache>;
+
+  private:
+    ZabrDensityCache();
+
+  public:
+    typedef std::vector<Real> key_type;
+    //! sets the maximum number of cached densities; zero disables it
+    void setCapacity(Size capacity);
+    Size capacity() const;
+    //! returns the cached density or a null pointer
+    boost::shared_ptr<const ZabrForwardDensity> find(const key_type &key);
+    void store(const key_type &key,
+               const boost::shared_ptr<const ZabrForwardDensity> &density);
+    Size size() const;
+    void clear();
+    Size hits() const;
+    Size misses() const;
+
+  private:
+    typedef std::pair<key_type, boost::shared_ptr<const ZabrForwardDensity> >
+        Entry;
+    typedef std::list<Entry> entry_list;
+    void trim();
+    Size capacity_, hits_, misses_;
+    entry_list entries_;
+    std::map<key_type, entry_list::iterator> index_;
+    mutable detail::Mutex mutex_;
 };
 }
 
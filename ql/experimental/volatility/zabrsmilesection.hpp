@@ -41,6 +41,8 @@ struct ZabrShortMaturityLognormal {};
 struct ZabrShortMaturityNormal {};
 struct ZabrLocalVolatility {};
 struct ZabrFullFd {};
+//! full finite difference prices for all strikes from a single forward solve
+struct ZabrFokkerPlanck {};
 
 template <typename Evaluation> class ZabrSmileSection : public SmileSection {
   public:
@@ -79,14 +81,17 @@ template <typename Evaluation> class ZabrSmileSection : public SmileSection {
     void init(const std::vector<Real> &moneyness, ZabrShortMaturityNormal);
     void init(const std::vector<Real> &moneyness, ZabrLocalVolatility);
     void init(const std::vector<Real> &moneyness, ZabrFullFd);
+    void init(const std::vector<Real> &moneyness, ZabrFokkerPlanck);
     void init2(ZabrShortMaturityLognormal);
     void init2(ZabrShortMaturityNormal);
     void init2(ZabrLocalVolatility);
     void init2(ZabrFullFd);
+    void init2(ZabrFokkerPlanck);
     void init3(ZabrShortMaturityLognormal);
     void init3(ZabrShortMaturityNormal);
     void init3(ZabrLocalVolatility);
     void init3(ZabrFullFd);
+    void init3(ZabrFokkerPlanck);
     Real optionPrice(Rate strike, Option::Type type, Real discount,
                      ZabrShortMaturityLognormal) const;
     Real optionPrice(Rate strike, Option::Type type, Real discount,
@@ -95,10 +100,13 @@ template <typename Evaluation> class ZabrSmileSection : public SmileSection {
                      ZabrLocalVolatility) const;
     Real optionPrice(Rate strike, Option::Type type, Real discount,
                      ZabrFullFd) const;
+    Real optionPrice(Rate strike, Option::Type type, Real discount,
+                     ZabrFokkerPlanck) const;
     Volatility volatilityImpl(Rate strike, ZabrShortMaturityLognormal) const;
     Volatility volatilityImpl(Rate strike, ZabrShortMaturityNormal) const;
     Volatility volatilityImpl(Rate strike, ZabrLocalVolatility) const;
     Volatility volatilityImpl(Rate strike, ZabrFullFd) const;
+    Volatility volatilityImpl(Rate strike, ZabrFokkerPlanck) const;
     boost::shared_ptr<ZabrModel> model_;
     Evaluation evaluation_;
     Rate forward_;
@@ -192,6 +200,12 @@ void ZabrSmileSection<Evaluation>::init(const std::vector<Real> &moneyness,
     init(moneyness, ZabrLocalVolatility());
 }
 
+template <typename Evaluation>
+void ZabrSmileSection<Evaluation>::init(const std::vector<Real> &moneyness,
+                                        ZabrFokkerPlanck) {
+    init(moneyness, ZabrLocalVolatility());
+}
+
 template <typename Evaluation>
 void ZabrSmileSection<Evaluation>::init2(ZabrShortMaturityLognormal) {}
 
@@ -212,6 +226,11 @@ void ZabrSmileSection<Evaluation>::init2(ZabrFullFd) {
     }
 }
 
+template <typename Evaluation>
+void ZabrSmileSection<Evaluation>::init2(ZabrFokkerPlanck) {
+    callPrices_ = model_->fpePrice(strikes_);
+}
+
 template <typename Evaluation>
 void ZabrSmileSection<Evaluation>::init3(ZabrShortMaturityLognormal) {}
 
@@ -250,6 +269,11 @@ void ZabrSmileSection<Evaluation>::init3(ZabrFullFd) {
     init3(ZabrLocalVolatility());
 }
 
+template <typename Evaluation>
+void ZabrSmileSection<Evaluation>::init3(ZabrFokkerPlanck) {
+    init3(ZabrLocalVolatility());
+}
+
 template <typename Evaluation>
 Real
 ZabrSmileSection<Evaluation>::optionPrice(Real strike, Option::Type type,
@@ -286,6 +310,13 @@ Real ZabrSmileSection<Evaluation>::optionPrice(Rate strike, Option::Type type,
     return optionPrice(strike, type, discount, ZabrLocalVolatility());
 }
 
+template <typename Evaluation>
+Real ZabrSmileSection<Evaluation>::optionPrice(Rate strike, Option::Type type,
+                                               Real discount,
+                                               ZabrFokkerPlanck) const {
+    return optionPrice(strike, type, discount, ZabrLocalVolatility());
+}
+
 template <typename Evaluation>
 Real
 ZabrSmileSection<Evaluation>::volatilityImpl(Rate strike,
@@ -325,6 +356,12 @@ Real ZabrSmileSection<Evaluation>::volatilityImpl(Rate strike,
                                                   ZabrFullFd) const {
     return volatilityImpl(strike, ZabrShortMaturityNormal());
 }
+
+template <typename Evaluation>
+Real ZabrSmileSection<Evaluation>::volatilityImpl(Rate strike,
+                                                  ZabrFokkerPlanck) const {
+    return volatilityImpl(strike, ZabrShortMaturityNormal());
+}
 }
 
 #endif
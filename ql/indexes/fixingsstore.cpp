@@ -0,0 +1,395 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/indexes/fixingsstore.hpp>
+#include <ql/math/comparison.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/cstdint.hpp>
+#if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-local-typedefs"
+#endif
+#include <boost/algorithm/string/case_conv.hpp>
+#if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
+#pragma GCC diagnostic pop
+#endif
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+using boost::algorithm::to_upper_copy;
+using std::string;
+
+namespace QuantLib {
+
+    namespace {
+
+        const char binaryTag[8] = { 'Q','L','F','I','X','0','0','1' };
+
+        void writeInt(std::ofstream& out, boost::int64_t i) {
+            out.write(reinterpret_cast<const char*>(&i), sizeof(i));
+        }
+
+        boost::int64_t readInt(std::ifstream& in) {
+            boost::int64_t i = 0;
+            in.read(reinterpret_cast<char*>(&i), sizeof(i));
+            return i;
+        }
+
+        // parses yyyy-mm-dd without going through the stream machinery
+        bool parseDate(const char* begin, const char* end, Date& d) {
+            if (end - begin != 10 || begin[4] != '-' || begin[7] != '-')
+                return false;
+            int fields[3] = { 0, 0, 0 };
+            const int starts[3] = { 0, 5, 8 }, lengths[3] = { 4, 2, 2 };
+            for (Size f=0; f<3; ++f) {
+                for (int j=0; j<lengths[f]; ++j) {
+                    char c = begin[starts[f]+j];
+                    if (c < '0' || c > '9')
+                        return false;
+                    fields[f] = 10*fields[f] + (c-'0');
+                }
+            }
+            d = Date(Day(fields[2]), Month(fields[1]), Year(fields[0]));
+            return true;
+        }
+
+        string trimmed(const char* begin, const char* end) {
+            while (begin < end && (*begin == ' ' || *begin == '\t'))
+                ++begin;
+            while (end > begin && (end[-1] == ' ' || end[-1] == '\t'))
+                --end;
+            return string(begin, end);
+        }
+
+    }
+
+    FixingsStore::FixingsStore() : size_(0) {}
+
+    FixingsStore::~FixingsStore() {
+        clear();
+    }
+
+    FixingsStore::Id FixingsStore::registerName(const string& name) {
+        Id n = size_;
+        SlotPointer* chunk = chunks_[n/SlotsPerChunk].load();
+        if (!chunk) {
+            chunk = new SlotPointer[SlotsPerChunk];
+            chunks_[n/SlotsPerChunk].store(chunk);
+        }
+        Slot* s = new Slot;
+        s->name = name;
+        s->notifier = boost::make_shared<Observable>();
+        // the slot is complete before its id becomes visible
+        chunk[n%SlotsPerChunk].store(s);
+        ids_[name] = n;
+        ++size_;
+        return n;
+    }
+
+    FixingsStore::Id FixingsStore::id(const string& name) {
+        string tag = to_upper_copy(name);
+        detail::MutexLock lock(mutex_);
+        std::map<string, Id>::const_iterator i = ids_.find(tag);
+        if (i != ids_.end())
+            return i->second;
+        QL_REQUIRE(size_ < Size(MaxChunks)*SlotsPerChunk,
+                   "too many indexes registered (" << size_ << ")");
+        return registerName(tag);
+    }
+
+    bool FixingsStore::hasId(const string& name) const {
+        string tag = to_upper_copy(name);
+        detail::MutexLock lock(mutex_);
+        return ids_.find(tag) != ids_.end();
+    }
+
+    string FixingsStore::name(Id id) const {
+        return slot(id).name;
+    }
+
+    Size FixingsStore::size() const {
+        detail::MutexLock lock(mutex_);
+        return size_;
+    }
+
+    void FixingsStore::fixings(Id id,
+                               const std::vector<Date>& dates,
+                               std::vector<Real>& values) const {
+        boost::shared_ptr<const Series> s = series(id);
+        values.resize(dates.size());
+        for (Size j=0; j<dates.size(); ++j) {
+            values[j] = Null<Real>();
+            if (s) {
+                BigInteger i = dates[j].serialNumber() - s->first;
+                if (i >= 0 && i < BigInteger(s->values.size()))
+                    values[j] = s->values[i];
+            }
+        }
+    }
+
+    bool FixingsStore::hasFixings(Id id) const {
+        return bool(series(id));
+    }
+
+    Date FixingsStore::firstDate(Id id) const {
+        boost::shared_ptr<const Series> s = series(id);
+        return s ? Date(s->first) : Date();
+    }
+
+    Date FixingsStore::lastDate(Id id) const {
+        boost::shared_ptr<const Series> s = series(id);
+        return s ? Date(s->first + s->values.size() - 1) : Date();
+    }
+
+    TimeSeries<Real> FixingsStore::history(Id id) const {
+        boost::shared_ptr<const Series> s = series(id);
+        std::vector<Date> dates;
+        std::vector<Real> values;
+        if (s) {
+            for (Size i=0; i<s->values.size(); ++i) {
+                if (s->values[i] != Null<Real>()) {
+                    dates.push_back(Date(s->first + BigInteger(i)));
+                    values.push_back(s->values[i]);
+                }
+            }
+        }
+        return TimeSeries<Real>(dates.begin(), dates.end(), values.begin());
+    }
+
+    void FixingsStore::publish(Id id,
+                               const boost::shared_ptr<const Series>& s) {
+        Slot& target = slot(id);
+        {
+            detail::MutexLock lock(mutex_);
+            // readers still using the old array keep it alive
+            boost::atomic_store(&target.series, s);
+        }
+        target.notifier->notifyObservers();
+    }
+
+    void FixingsStore::setFixings(Id id,
+                                  const std::vector<Date>& dates,
+                                  const std::vector<Real>& values,
+                                  bool forceOverwrite) {
+        QL_REQUIRE(dates.size() == values.size(),
+                   "size mismatch between dates (" << dates.size()
+                   << ") and values (" << values.size() << ")");
+        if (dates.empty())
+            return;
+        Slot& target = slot(id);
+
+        {
+            detail::MutexLock lock(mutex_);
+            boost::shared_ptr<const Series> old =
+                boost::atomic_load(&target.series);
+            BigInteger first = dates[0].serialNumber(), last = first;
+            for (Size j=1; j<dates.size(); ++j) {
+                first = std::min(first, dates[j].serialNumber());
+                last = std::max(last, dates[j].serialNumber());
+            }
+            if (old) {
+                first = std::min(first, old->first);
+                last = std::max(last, old->first +
+                                      BigInteger(old->values.size()) - 1);
+            }
+
+            boost::shared_ptr<Series> s = boost::make_shared<Series>();
+            s->first = first;
+            s->values.assign(last - first + 1, Null<Real>());
+            if (old)
+                std::copy(old->values.begin(), old->values.end(),
+                          s->values.begin() + (old->first - first));
+            for (Size j=0; j<dates.size(); ++j) {
+                Real& v = s->values[dates[j].serialNumber() - first];
+                QL_REQUIRE(forceOverwrite || v == Null<Real>()
+                           || close(v, values[j]),
+                           "duplicated fixing provided for " << target.name
+                           << ": " << dates[j] << ", " << values[j]
+                           << " while " << v << " value is already present");
+                v = values[j];
+            }
+
+            boost::atomic_store(&target.series,
+                                boost::shared_ptr<const Series>(s));
+        }
+        target.notifier->notifyObservers();
+    }
+
+    void FixingsStore::setHistory(Id id, const TimeSeries<Real>& history) {
+        if (history.empty()) {
+            clearFixings(id);
+            return;
+        }
+        boost::shared_ptr<Series> s = boost::make_shared<Series>();
+        s->first = history.firstDate().serialNumber();
+        s->values.assign(history.lastDate().serialNumber() - s->first + 1,
+                         Null<Real>());
+        for (TimeSeries<Real>::const_iterator i=history.cbegin();
+             i!=history.cend(); ++i)
+            s->values[i->first.serialNumber() - s->first] = i->second;
+        publish(id, s);
+    }
+
+    void FixingsStore::clearFixings(Id id) {
+        publish(id, boost::shared_ptr<const Series>());
+    }
+
+    void FixingsStore::clear() {
+        detail::MutexLock lock(mutex_);
+        for (Size i=0; i<size_; ++i)
+            delete chunks_[i/SlotsPerChunk].load()[i%SlotsPerChunk].load();
+        for (Size i=0; i<MaxChunks; ++i) {
+            delete[] chunks_[i].load();
+            chunks_[i].store(0);
+        }
+        ids_.clear();
+        size_ = 0;
+    }
+
+    boost::shared_ptr<Observable> FixingsStore::notifier(Id id) const {
+        return slot(id).notifier;
+    }
+
+    Size FixingsStore::loadCsv(const string& fileName, bool forceOverwrite) {
+        std::ifstream in(fileName.c_str(), std::ios::in | std::ios::binary);
+        QL_REQUIRE(in, "unable to open " << fileName);
+        std::ostringstream buffer;
+        buffer << in.rdbuf();
+        const string contents = buffer.str();
+
+        // fixings are collected per index and stored in one write each
+        std::vector<Id> loaded;
+        std::map<Id, std::pair<std::vector<Date>, std::vector<Real> > > data;
+        string lastName;
+        std::pair<std::vector<Date>, std::vector<Real> >* current = 0;
+
+        Size lines = 0, lineNumber = 0;
+        const char* p = contents.c_str();
+        const char* end = p + contents.size();
+        while (p < end) {
+            const char* eol = std::find(p, end, '\n');
+            const char* lineEnd = eol;
+            if (lineEnd > p && lineEnd[-1] == '\r')
+                --lineEnd;
+            ++lineNumber;
+            if (lineEnd > p && *p != '#') {
+                const char* c1 = std::find(p, lineEnd, ',');
+                const char* c2 = std::find(std::min(c1+1, lineEnd),
+                                           lineEnd, ',');
+                QL_REQUIRE(c2 != lineEnd,
+                           fileName << ", line " << lineNumber
+                           << ": three comma-separated fields expected");
+                Date d;
+                string dateField = trimmed(c1+1, c2);
+                QL_REQUIRE(parseDate(dateField.data(),
+                                     dateField.data() + dateField.size(), d),
+                           fileName << ", line " << lineNumber
+                           << ": invalid date " << dateField);
+                string valueField = trimmed(c2+1, lineEnd);
+                char* valueEnd = 0;
+                Real value = std::strtod(valueField.c_str(), &valueEnd);
+                QL_REQUIRE(!valueField.empty() && *valueEnd == '\0',
+                           fileName << ", line " << lineNumber
+                           << ": invalid value " << valueField);
+
+                string name = trimmed(p, c1);
+                if (!current || name != lastName) {
+                    Id i = id(name);
+                    if (data.find(i) == data.end())
+                        loaded.push_back(i);
+                    current = &data[i];
+                    lastName = name;
+                }
+                current->first.push_back(d);
+                current->second.push_back(value);
+                ++lines;
+            }
+            p = eol + 1;
+        }
+
+        for (Size i=0; i<loaded.size(); ++i)
+            setFixings(loaded[i], data[loaded[i]].first,
+                       data[loaded[i]].second, forceOverwrite);
+        return lines;
+    }
+
+    void FixingsStore::loadBinary(const string& fileName) {
+        std::ifstream in(fileName.c_str(), std::ios::in | std::ios::binary);
+        QL_REQUIRE(in, "unable to open " << fileName);
+        char tag[sizeof(binaryTag)];
+        in.read(tag, sizeof(tag));
+        QL_REQUIRE(in && std::memcmp(tag, binaryTag, sizeof(tag)) == 0,
+                   fileName << " is not a fixings file");
+        QL_REQUIRE(readInt(in) == boost::int64_t(sizeof(Real)),
+                   fileName << " was written with a different Real type");
+        boost::int64_t n = readInt(in);
+        QL_REQUIRE(in && n >= 0, fileName << " is truncated");
+
+        // the whole file is read before storing anything
+        typedef std::pair<string, boost::shared_ptr<const Series> > Entry;
+        std::vector<Entry> entries;
+        for (boost::int64_t k=0; k<n; ++k) {
+            string name(std::size_t(readInt(in)), ' ');
+            if (!name.empty())
+                in.read(&name[0], name.size());
+            boost::shared_ptr<Series> s = boost::make_shared<Series>();
+            s->first = BigInteger(readInt(in));
+            s->values.resize(std::size_t(readInt(in)));
+            if (!s->values.empty())
+                in.read(reinterpret_cast<char*>(&s->values[0]),
+                        s->values.size()*sizeof(Real));
+            QL_REQUIRE(in, fileName << " is truncated");
+            if (s->values.empty())
+                s.reset();
+            entries.push_back(Entry(name, s));
+        }
+
+        for (Size k=0; k<entries.size(); ++k)
+            publish(id(entries[k].first), entries[k].second);
+    }
+
+    void FixingsStore::saveBinary(const string& fileName) const {
+        std::ofstream out(fileName.c_str(),
+                          std::ios::out | std::ios::binary | std::ios::trunc);
+        QL_REQUIRE(out, "unable to open " << fileName);
+        out.write(binaryTag, sizeof(binaryTag));
+        writeInt(out, sizeof(Real));
+        Size n = size();
+        std::vector<Id> stored;
+        for (Id i=0; i<n; ++i)
+            if (hasFixings(i))
+                stored.push_back(i);
+        writeInt(out, stored.size());
+        for (Size k=0; k<stored.size(); ++k) {
+            const Slot& source = slot(stored[k]);
+            boost::shared_ptr<const Series> s =
+                boost::atomic_load(&source.series);
+            writeInt(out, source.name.size());
+            out.write(source.name.data(), source.name.size());
+            writeInt(out, s ? s->first : 0);
+            writeInt(out, s ? s->values.size() : 0);
+            if (s && !s->values.empty())
+                out.write(reinterpret_cast<const char*>(&s->values[0]),
+                          s->values.size()*sizeof(Real));
+        }
+        QL_REQUIRE(out, "error while writing " << fileName);
+    }
+
+}
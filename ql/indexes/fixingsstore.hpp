@@ -0,0 +1,197 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fixingsstore.hpp
+    \brief flat repository for past index fixings
+*/
+
+#ifndef quantlib_fixings_store_hpp
+#define quantlib_fixings_store_hpp
+
+#include <ql/timeseries.hpp>
+#include <ql/patterns/singleton.hpp>
+#include <ql/patterns/observable.hpp>
+#include <ql/utilities/null.hpp>
+#include <ql/utilities/atomicpointer.hpp>
+#include <ql/utilities/mutex.hpp>
+#include <boost/shared_ptr.hpp>
+#include <map>
+#include <vector>
+
+namespace QuantLib {
+
+    //! flat repository for past index fixings
+    /*! This is an alternative to IndexManager meant for large
+        fixing histories.  Index names are interned once into integer
+        ids, which client code is expected to keep; the fixings of
+        each index are stored in a dense array covering the window
+        between its first and last fixing date, with null values for
+        missing dates.  Reading a fixing is thus an array access.
+
+        The array of an index is never modified in place: writes
+        build a new array and publish it atomically, so that readers
+        don't lock the store and always see a consistent history.
+        Readers hold a shared pointer to the array they use; an
+        array replaced by a write is released when the last reader
+        using it is done.  Writes are serialized by a mutex; they
+        are meant to be done in bulk, either through setFixings() or
+        by loading a file.
+
+        Histories can be loaded from CSV files with lines in the form
+        \code
+        index name,yyyy-mm-dd,value
+        \endcode
+        or from binary files written by saveBinary(), which store the
+        dense arrays verbatim and can be read back with one block
+        read per index.
+
+        \note index names are case insensitive.
+
+        \warning clear() must not be called concurrently with any
+                 other method.
+    */
+    class FixingsStore : public Singleton<FixingsStore> {
+        friend class Singleton<FixingsStore>;
+      private:
+        FixingsStore();
+      public:
+        typedef Size Id;
+        ~FixingsStore();
+        //! \name Index ids
+        //@{
+        //! returns the id of the index, registering it if needed
+        Id id(const std::string& name);
+        //! returns whether the index was registered
+        bool hasId(const std::string& name) const;
+        //! returns the (upper-case) name of the index with the given id
+        std::string name(Id id) const;
+        //! number of registered indexes
+        Size size() const;
+        //@}
+        //! \name Reading fixings
+        /*! These methods don't lock the store and can be called
+            concurrently with any write.
+        */
+        //@{
+        //! returns the fixing at the given date, or a null value
+        Real fixing(Id id, const Date& d) const;
+        //! fixings at the given dates, with null values where missing
+        void fixings(Id id,
+                     const std::vector<Date>& dates,
+                     std::vector<Real>& values) const;
+        //! returns whether any fixing was stored for the index
+        bool hasFixings(Id id) const;
+        //! first date of the stored window (null if none)
+        Date firstDate(Id id) const;
+        //! last date of the stored window (null if none)
+        Date lastDate(Id id) const;
+        //! copy of the stored fixings as a time series
+        TimeSeries<Real> history(Id id) const;
+        //@}
+        //! \name Writing fixings
+        //@{
+        /*! stores the given fixings.  Unless forceOverwrite is set,
+            an exception is raised if a fixing is already stored with
+            a different value; in this case nothing is stored.
+        */
+        void setFixings(Id id,
+                        const std::vector<Date>& dates,
+                        const std::vector<Real>& values,
+                        bool forceOverwrite = false);
+        //! replaces the stored fixings with the given time series
+        void setHistory(Id id, const TimeSeries<Real>& history);
+        //! clears the fixings of the index
+        void clearFixings(Id id);
+        //! removes all indexes and fixings and releases memory
+        void clear();
+        //! observable notifying of changes in the index fixings
+        boost::shared_ptr<Observable> notifier(Id id) const;
+        //@}
+        //! \name Files
+        //@{
+        //! loads fixings from a CSV file; returns the number of lines read
+        Size loadCsv(const std::string& fileName,
+                     bool forceOverwrite = false);
+        /*! loads the histories stored in a binary file; the whole
+            file is read before any history is stored, so that
+            nothing is stored if the file is invalid.
+        */
+        void loadBinary(const std::string& fileName);
+        //! saves all stored histories to a binary file
+        void saveBinary(const std::string& fileName) const;
+        //@}
+      private:
+        struct Series {
+            BigInteger first;
+            std::vector<Real> values;
+        };
+        struct Slot {
+            std::string name;
+            // only accessed through boost::atomic_load and atomic_store
+            boost::shared_ptr<const Series> series;
+            boost::shared_ptr<Observable> notifier;
+        };
+        typedef detail::AtomicPointer<Slot> SlotPointer;
+        enum { SlotsPerChunk = 256, MaxChunks = 4096 };
+        const Slot& slot(Id id) const;
+        Slot& slot(Id id);
+        boost::shared_ptr<const Series> series(Id id) const;
+        Id registerName(const std::string& upperCaseName);
+        void publish(Id id, const boost::shared_ptr<const Series>& series);
+        detail::AtomicPointer<SlotPointer> chunks_[MaxChunks];
+        Size size_;
+        std::map<std::string, Id> ids_;
+        mutable detail::Mutex mutex_;
+    };
+
+
+    // inline definitions
+
+    inline const FixingsStore::Slot& FixingsStore::slot(Id id) const {
+        const SlotPointer* chunk = id < Size(MaxChunks)*SlotsPerChunk ?
+            chunks_[id/SlotsPerChunk].load() : 0;
+        const Slot* s = chunk ? chunk[id%SlotsPerChunk].load() : 0;
+        QL_REQUIRE(s, "unknown index id (" << id << ")");
+        return *s;
+    }
+
+    inline FixingsStore::Slot& FixingsStore::slot(Id id) {
+        SlotPointer* chunk = id < Size(MaxChunks)*SlotsPerChunk ?
+            chunks_[id/SlotsPerChunk].load() : 0;
+        Slot* s = chunk ? chunk[id%SlotsPerChunk].load() : 0;
+        QL_REQUIRE(s, "unknown index id (" << id << ")");
+        return *s;
+    }
+
+    inline boost::shared_ptr<const FixingsStore::Series>
+    FixingsStore::series(Id id) const {
+        return boost::atomic_load(&slot(id).series);
+    }
+
+    inline Real FixingsStore::fixing(Id id, const Date& d) const {
+        boost::shared_ptr<const Series> s = series(id);
+        if (!s)
+            return Null<Real>();
+        BigInteger i = d.serialNumber() - s->first;
+        if (i < 0 || i >= BigInteger(s->values.size()))
+            return Null<Real>();
+        return s->values[i];
+    }
+
+}
+
+#endif
@@ -30,6 +30,7 @@
 #include <ql/math/comparison.hpp>
 #include <ql/errors.hpp>
 #include <vector>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -52,6 +53,13 @@ namespace QuantLib {
             virtual std::vector<Real> yValues() const = 0;
             virtual bool isInRange(Real) const = 0;
             virtual Real value(Real) const = 0;
+            /*! values at the n given points; the default
+                implementation calls value() for each point.
+            */
+            virtual void values(const Real* x, Size n, Real* y) const {
+                for (Size i=0; i<n; ++i)
+                    y[i] = value(x[i]);
+            }
             virtual Real primitive(Real) const = 0;
             virtual Real derivative(Real) const = 0;
             virtual Real secondDerivative(Real) const = 0;
@@ -105,6 +113,23 @@ namespace QuantLib {
                 else
                     return std::upper_bound(xBegin_,xEnd_-1,x)-xBegin_-1;
             }
+            /*! same result as locate(x), but the search starts from
+                the given guess; this is faster when the passed
+                points are sorted, as successive searches just walk
+                the nodes forward.
+            */
+            Size locate(Real x, Size guess) const {
+                Size n = xEnd_-xBegin_;
+                if (guess > n-2 || x < xBegin_[guess] || x > *(xEnd_-1))
+                    return locate(x);
+                // at most a few steps forward before going binary
+                for (Size k=0; k<4; ++k) {
+                    if (guess == n-2 || x < xBegin_[guess+1])
+                        return guess;
+                    ++guess;
+                }
+                return std::upper_bound(xBegin_+guess,xEnd_-1,x)-xBegin_-1;
+            }
             I1 xBegin_, xEnd_;
             I2 yBegin_;
         };
@@ -116,6 +141,24 @@ namespace QuantLib {
             checkRange(x,allowExtrapolation);
             return impl_->value(x);
         }
+        /*! values at the given points; sorted points are located
+            faster than by repeated calls to operator().
+        */
+        void values(const std::vector<Real>& x,
+                    std::vector<Real>& y,
+                    bool allowExtrapolation = false) const {
+            y.resize(x.size());
+            if (x.empty())
+                return;
+            Real xLow = x[0], xHigh = x[0];
+            for (Size i=1; i<x.size(); ++i) {
+                xLow = std::min(xLow, x[i]);
+                xHigh = std::max(xHigh, x[i]);
+            }
+            checkRange(xLow,allowExtrapolation);
+            checkRange(xHigh,allowExtrapolation);
+            impl_->values(&x[0], x.size(), &y[0]);
+        }
         Real primitive(Real x, bool allowExtrapolation = false) const {
             checkRange(x,allowExtrapolation);
             return impl_->primitive(x);
@@ -89,6 +89,20 @@ namespace QuantLib {
                 else
                     return this->yBegin_[i+1];
             }
+            void values(const Real* x, Size n, Real* y) const {
+                Size i = 0;
+                for (Size k=0; k<n; ++k) {
+                    if (x[k] <= this->xBegin_[0]) {
+                        y[k] = this->yBegin_[0];
+                        continue;
+                    }
+                    i = this->locate(x[k], i);
+                    if (x[k] == this->xBegin_[i])
+                        y[k] = this->yBegin_[i];
+                    else
+                        y[k] = this->yBegin_[i+1];
+                }
+            }
             Real primitive(Real x) const {
                 Size i = this->locate(x);
                 Real dx = x-this->xBegin_[i];
@@ -698,6 +698,15 @@ namespace QuantLib {
                 Real dx_ = x-this->xBegin_[j];
                 return this->yBegin_[j] + dx_*(a_[j] + dx_*(b_[j] + dx_*c_[j]));
             }
+            void values(const Real* x, Size n, Real* y) const {
+                Size j = 0;
+                for (Size k=0; k<n; ++k) {
+                    j = this->locate(x[k], j);
+                    Real dx_ = x[k]-this->xBegin_[j];
+                    y[k] = this->yBegin_[j] +
+                           dx_*(a_[j] + dx_*(b_[j] + dx_*c_[j]));
+                }
+            }
             Real primitive(Real x) const {
                 Size j = this->locate(x);
                 Real dx_ = x-this->xBegin_[j];
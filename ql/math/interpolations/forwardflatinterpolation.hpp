@@ -86,6 +86,17 @@ namespace QuantLib {
                 Size i = this->locate(x);
                 return this->yBegin_[i];
             }
+            void values(const Real* x, Size n, Real* y) const {
+                Size i = 0;
+                for (Size k=0; k<n; ++k) {
+                    if (x[k] >= this->xBegin_[n_-1]) {
+                        y[k] = this->yBegin_[n_-1];
+                    } else {
+                        i = this->locate(x[k], i);
+                        y[k] = this->yBegin_[i];
+                    }
+                }
+            }
             Real primitive(Real x) const {
                 Size i = this->locate(x);
                 Real dx = x-this->xBegin_[i];
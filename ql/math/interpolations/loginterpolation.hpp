@@ -308,6 +308,12 @@ namespace QuantLib {
             Real value(Real x) const {
                 return std::exp(interpolation_(x, true));
             }
+            void values(const Real* x, Size n, Real* y) const {
+                std::vector<Real> xs(x, x+n), logValues;
+                interpolation_.values(xs, logValues, true);
+                for (Size i=0; i<n; ++i)
+                    y[i] = std::exp(logValues[i]);
+            }
             Real primitive(Real) const {
                 QL_FAIL("LogInterpolation primitive not implemented");
             }
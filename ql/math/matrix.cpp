@@ -56,9 +56,106 @@
 #pragma clang diagnostic pop
 #endif
 
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <algorithm>
+
+#if defined(QL_ENABLE_BLAS_LAPACK)
+extern "C" {
+    void dgemm_(const char* transa, const char* transb,
+                const int* m, const int* n, const int* k,
+                const double* alpha, const double* a, const int* lda,
+                const double* b, const int* ldb,
+                const double* beta, double* c, const int* ldc);
+}
+#endif
+
 
 namespace QuantLib {
 
+    namespace {
+
+        // edge of the blocks processed by the matrix kernels;
+        // a block of doubles takes 32 kB
+        const Size blockSize = 64;
+
+        #if defined(QL_ENABLE_BLAS_LAPACK)
+        // below this number of multiplications the call overhead
+        // of the BLAS is not worth it
+        const Size blasThreshold = 32*32*32;
+        #endif
+
+    }
+
+    const Disposable<Matrix> operator*(const Matrix& m1, const Matrix& m2) {
+        QL_REQUIRE(m1.columns() == m2.rows(),
+                   "matrices with different sizes (" <<
+                   m1.rows() << "x" << m1.columns() << ", " <<
+                   m2.rows() << "x" << m2.columns() << ") cannot be "
+                   "multiplied");
+        const Size n = m1.rows(), p = m1.columns(), q = m2.columns();
+        Matrix result(n, q, 0.0);
+        if (n == 0 || p == 0 || q == 0)
+            return result;
+
+        const Real* a = m1.begin();
+        const Real* b = m2.begin();
+        Real* c = result.begin();
+
+        #if defined(QL_ENABLE_BLAS_LAPACK)
+        BOOST_STATIC_ASSERT((boost::is_same<Real, double>::value));
+        if (n*p*q >= blasThreshold) {
+            // row-major storage is the transpose in column-major
+            // order, hence C^T = B^T A^T
+            const int ni = int(n), pi = int(p), qi = int(q);
+            const double one = 1.0, zero = 0.0;
+            dgemm_("N", "N", &qi, &ni, &pi, &one, b, &qi, a, &pi,
+                   &zero, c, &qi);
+            return result;
+        }
+        #endif
+
+        // the terms of each element are still added in increasing
+        // order of k, so that the result doesn't depend on blocking
+        for (Size kk=0; kk<p; kk+=blockSize) {
+            const Size kEnd = std::min(kk+blockSize, p);
+            for (Size jj=0; jj<q; jj+=blockSize) {
+                const Size jEnd = std::min(jj+blockSize, q);
+                for (Size i=0; i<n; ++i) {
+                    const Real* ai = a + i*p;
+                    Real* ci = c + i*q;
+                    for (Size k=kk; k<kEnd; ++k) {
+                        const Real aik = ai[k];
+                        const Real* bk = b + k*q;
+                        for (Size j=jj; j<jEnd; ++j)
+                            ci[j] += aik*bk[j];
+                    }
+                }
+            }
+        }
+        return result;
+    }
+
+    const Disposable<Matrix> transpose(const Matrix& m) {
+        const Size rows = m.rows(), columns = m.columns();
+        Matrix result(columns, rows);
+        if (m.empty())
+            return result;
+
+        const Real* a = m.begin();
+        Real* t = result.begin();
+        for (Size ii=0; ii<rows; ii+=blockSize) {
+            const Size iEnd = std::min(ii+blockSize, rows);
+            for (Size jj=0; jj<columns; jj+=blockSize) {
+                const Size jEnd = std::min(jj+blockSize, columns);
+                for (Size i=ii; i<iEnd; ++i)
+                    for (Size j=jj; j<jEnd; ++j)
+                        t[j*rows+i] = a[i*columns+j];
+            }
+        }
+        return result;
+    }
+
     Disposable<Matrix> inverse(const Matrix& m) {
         #if !defined(QL_NO_UBLAS_SUPPORT)
 
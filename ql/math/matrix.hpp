@@ -155,12 +155,21 @@ namespace QuantLib {
     const Disposable<Array> operator*(const Array&, const Matrix&);
     /*! \relates Matrix */
     const Disposable<Array> operator*(const Matrix&, const Array&);
-    /*! \relates Matrix */
+    /*! \relates Matrix
+
+        The product is calculated on blocks of the operands small
+        enough to stay in cache; when QL_ENABLE_BLAS_LAPACK is
+        defined, larger products are delegated to the system BLAS.
+    */
     const Disposable<Matrix> operator*(const Matrix&, const Matrix&);
 
     // misc. operations
 
-    /*! \relates Matrix */
+    /*! \relates Matrix
+
+        The transposition is performed on square blocks, so that
+        both the rows read and the rows written stay in cache.
+    */
     const Disposable<Matrix> transpose(const Matrix&);
 
     /*! \relates Matrix */
@@ -536,34 +545,6 @@ namespace QuantLib {
         return result;
     }
 
-    inline const Disposable<Matrix> operator*(const Matrix& m1,
-                                              const Matrix& m2) {
-        QL_REQUIRE(m1.columns() == m2.rows(),
-                   "matrices with different sizes (" <<
-                   m1.rows() << "x" << m1.columns() << ", " <<
-                   m2.rows() << "x" << m2.columns() << ") cannot be "
-                   "multiplied");
-        Matrix result(m1.rows(),m2.columns(),0.0);
-        for (Size i=0; i<result.rows(); ++i) {
-            for (Size k=0; k<m1.columns(); ++k) {
-                for (Size j=0; j<result.columns(); ++j) {
-                    result[i][j] += m1[i][k]*m2[k][j];
-                }
-            }
-        }
-        return result;
-    }
-
-    inline const Disposable<Matrix> transpose(const Matrix& m) {
-        Matrix result(m.columns(),m.rows());
-        #if defined(QL_PATCH_MSVC) && defined(QL_DEBUG)
-        if (!m.empty())
-        #endif
-        for (Size i=0; i<m.rows(); i++)
-            std::copy(m.row_begin(i),m.row_end(i),result.column_begin(i));
-        return result;
-    }
-
     inline const Disposable<Matrix> outerProduct(const Array& v1,
                                                  const Array& v2) {
         return outerProduct(v1.begin(), v1.end(), v2.begin(), v2.end());
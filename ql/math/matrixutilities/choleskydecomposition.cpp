@@ -21,6 +21,16 @@
 #include <ql/math/matrixutilities/choleskydecomposition.hpp>
 #include <ql/math/comparison.hpp>
 
+#if defined(QL_ENABLE_BLAS_LAPACK)
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+extern "C" {
+    void dpotrf_(const char* uplo, const int* n, double* a, const int* lda,
+                 int* info);
+}
+#endif
+
 namespace QuantLib {
 
     const Disposable<Matrix> CholeskyDecomposition(const Matrix &S,
@@ -36,6 +46,28 @@ namespace QuantLib {
                            "input matrix is not symmetric");
         #endif
 
+        #if defined(QL_ENABLE_BLAS_LAPACK)
+        BOOST_STATIC_ASSERT((boost::is_same<Real, double>::value));
+        if (size > 0) {
+            // the upper factor of S in column-major order is the
+            // lower factor in row-major order
+            Matrix factor = S;
+            const int n = int(size);
+            int info = 0;
+            dpotrf_("U", &n, factor.begin(), &n, &info);
+            QL_REQUIRE(info >= 0, "dpotrf failed (info = " << info << ")");
+            if (info == 0) {
+                for (i=0; i<size; i++)
+                    std::fill(factor.row_begin(i)+i+1, factor.row_end(i),
+                              0.0);
+                return factor;
+            }
+            // not positive definite; the flexible algorithm below
+            // handles semi-definite matrices
+            QL_REQUIRE(flexible, "input matrix is not positive definite");
+        }
+        #endif
+
         Matrix result(size, size, 0.0);
         Real sum;
         for (i=0; i<size; i++) {
@@ -46,6 +46,18 @@ namespace QuantLib {
         }
         #endif
 
+        // product of the first columns of m times a diagonal matrix;
+        // same result as the full product, in O(n^2) operations
+        const Disposable<Matrix> timesDiagonal(const Matrix& m,
+                                               const Array& diagonal) {
+            Size rows = m.rows(), columns = diagonal.size();
+            Matrix result(rows, columns);
+            for (Size i=0; i<rows; ++i)
+                for (Size j=0; j<columns; ++j)
+                    result[i][j] = m[i][j]*diagonal[j];
+            return result;
+        }
+
         void normalizePseudoRoot(const Matrix& matrix,
                                  Matrix& pseudo) {
             Size size = matrix.rows();
@@ -299,13 +311,13 @@ namespace QuantLib {
             QL_REQUIRE(size == M.columns(),
                        "matrix not square");
 
-            Matrix diagonal(size, size, 0.0);
+            Array diagonal(size);
             SymmetricSchurDecomposition jd(M);
             for (Size i=0; i<size; ++i)
-                diagonal[i][i] = std::max<Real>(jd.eigenvalues()[i], 0.0);
+                diagonal[i] = std::max<Real>(jd.eigenvalues()[i], 0.0);
 
-            Matrix result =
-                jd.eigenvectors()*diagonal*transpose(jd.eigenvectors());
+            Matrix result = timesDiagonal(jd.eigenvectors(), diagonal)
+                          * transpose(jd.eigenvectors());
             return result;
         }
 
@@ -365,7 +377,7 @@ namespace QuantLib {
 
         // spectral (a.k.a Principal Component) analysis
         SymmetricSchurDecomposition jd(matrix);
-        Matrix diagonal(size, size, 0.0);
+        Array diagonal(size, 0.0);
 
         // salvaging algorithm
         Matrix result(size, size);
@@ -382,21 +394,21 @@ namespace QuantLib {
           case SalvagingAlgorithm::Spectral:
             // negative eigenvalues set to zero
             for (Size i=0; i<size; i++)
-                diagonal[i][i] =
+                diagonal[i] =
                     std::sqrt(std::max<Real>(jd.eigenvalues()[i], 0.0));
 
-            result = jd.eigenvectors() * diagonal;
+            result = timesDiagonal(jd.eigenvectors(), diagonal);
             normalizePseudoRoot(matrix, result);
             break;
           case SalvagingAlgorithm::Hypersphere:
             // negative eigenvalues set to zero
             negative=false;
             for (Size i=0; i<size; ++i){
-                diagonal[i][i] =
+                diagonal[i] =
                     std::sqrt(std::max<Real>(jd.eigenvalues()[i], 0.0));
                 if (jd.eigenvalues()[i]<0.0) negative=true;
             }
-            result = jd.eigenvectors() * diagonal;
+            result = timesDiagonal(jd.eigenvectors(), diagonal);
             normalizePseudoRoot(matrix, result);
 
             if (negative)
@@ -406,11 +418,11 @@ namespace QuantLib {
             // negative eigenvalues set to zero
             negative=false;
             for (Size i=0; i<size; ++i){
-                diagonal[i][i] =
+                diagonal[i] =
                     std::sqrt(std::max<Real>(jd.eigenvalues()[i], 0.0));
                 if (jd.eigenvalues()[i]<0.0) negative=true;
             }
-            result = jd.eigenvectors() * diagonal;
+            result = timesDiagonal(jd.eigenvectors(), diagonal);
 
             normalizePseudoRoot(matrix, result);
 
@@ -504,10 +516,10 @@ namespace QuantLib {
         // output is granted to have a rank<=maxRank
         retainedFactors=std::min(retainedFactors, maxRank);
 
-        Matrix diagonal(size, retainedFactors, 0.0);
+        Array diagonal(retainedFactors);
         for (Size i=0; i<retainedFactors; ++i)
-            diagonal[i][i] = std::sqrt(eigenValues[i]);
-        Matrix result = jd.eigenvectors() * diagonal;
+            diagonal[i] = std::sqrt(eigenValues[i]);
+        Matrix result = timesDiagonal(jd.eigenvectors(), diagonal);
 
         normalizePseudoRoot(matrix, result);
         return result;
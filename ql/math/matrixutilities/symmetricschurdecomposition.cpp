@@ -21,6 +21,18 @@
 #include <ql/math/matrixutilities/symmetricschurdecomposition.hpp>
 #include <vector>
 
+#if defined(QL_ENABLE_BLAS_LAPACK)
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_same.hpp>
+
+extern "C" {
+    void dsyevd_(const char* jobz, const char* uplo, const int* n,
+                 double* a, const int* lda, double* w,
+                 double* work, const int* lwork,
+                 int* iwork, const int* liwork, int* info);
+}
+#endif
+
 namespace QuantLib {
 
     SymmetricSchurDecomposition::SymmetricSchurDecomposition(const Matrix & s)
@@ -30,6 +42,35 @@ namespace QuantLib {
         QL_REQUIRE(s.rows()==s.columns(), "input matrix must be square");
 
         Size size = s.rows();
+
+        #if defined(QL_ENABLE_BLAS_LAPACK)
+
+        BOOST_STATIC_ASSERT((boost::is_same<Real, double>::value));
+        {
+            // in column-major order, the eigenvectors returned in
+            // the columns of a are the rows of the row-major matrix
+            Matrix a = s;
+            const int n = int(size);
+            int info = 0, lwork = -1, liwork = -1, iworkSize = 0;
+            double workSize = 0.0;
+            dsyevd_("V", "U", &n, a.begin(), &n, diagonal_.begin(),
+                    &workSize, &lwork, &iworkSize, &liwork, &info);
+            QL_REQUIRE(info == 0,
+                       "dsyevd workspace query failed (info = "
+                       << info << ")");
+            lwork = int(workSize);
+            liwork = iworkSize;
+            std::vector<double> work(lwork);
+            std::vector<int> iwork(liwork);
+            dsyevd_("V", "U", &n, a.begin(), &n, diagonal_.begin(),
+                    &work[0], &lwork, &iwork[0], &liwork, &info);
+            QL_ENSURE(info == 0,
+                      "dsyevd failed to converge (info = " << info << ")");
+            eigenVectors_ = transpose(a);
+        }
+
+        #else
+
         for (Size q=0; q<size; q++) {
             diagonal_[q] = s[q][q];
             eigenVectors_[q][q] = 1.0;
@@ -94,9 +135,11 @@ namespace QuantLib {
                                 jacobiRotate_(ss, rho, sine, j, l, l, k);
                             for (l=k+1; l<size; l++)
                                 jacobiRotate_(ss, rho, sine, j, l, k, l);
+                            // eigenvectors are stored in rows while
+                            // rotating, so that both are contiguous
                             for (l=0;   l<size; l++)
                                 jacobiRotate_(eigenVectors_,
-                                                  rho, sine, l, j, l, k);
+                                                  rho, sine, j, l, k, l);
                         }
                     }
                 }
@@ -111,6 +154,10 @@ namespace QuantLib {
         QL_ENSURE(ite<=maxIterations,
                   "Too many iterations (" << maxIterations << ") reached");
 
+        eigenVectors_ = transpose(eigenVectors_);
+
+        #endif
+
 
         // sort (eigenvalues, eigenvectors)
         std::vector<std::pair<Real, std::vector<Real> > > temp(size);
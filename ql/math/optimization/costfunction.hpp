@@ -27,6 +27,7 @@
 
 #include <ql/math/array.hpp>
 #include <ql/math/matrix.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -39,6 +40,32 @@ namespace QuantLib {
         //! method to overload to compute the cost function values in x
         virtual Disposable<Array> values(const Array& x) const =0;
 
+        //! method to overload to compute the cost function value at
+        //  several points
+        /*! The default implementation calls value() at each point in
+            turn. Cost functions whose evaluations can run concurrently
+            may override it; the results must not depend on the order
+            in which the points are evaluated.
+        */
+        virtual void batchValue(const std::vector<Array>& x,
+                                Array& y) const {
+            y = Array(x.size());
+            for (Size i=0; i<x.size(); ++i)
+                y[i] = value(x[i]);
+        }
+
+        //! method to overload to compute the cost function values at
+        //  several points
+        /*! The default implementation calls values() at each point in
+            turn; see batchValue().
+        */
+        virtual void batchValues(const std::vector<Array>& x,
+                                 std::vector<Array>& y) const {
+            y.resize(x.size());
+            for (Size i=0; i<x.size(); ++i)
+                y[i] = values(x[i]);
+        }
+
         //! method to overload to compute grad_f, the first derivative of
         //  the cost function with respect to x
         virtual void gradient(Array& grad, const Array& x) const {
@@ -259,13 +259,37 @@ namespace QuantLib {
                                - lowerBound_[memIter]);
                 }
             }
-            // evaluate objective function as soon as possible to avoid unnecessary loops
-            try {
-                population[popIter].cost = costFunction.value(population[popIter].values);
-            } catch (Error&) {
-                population[popIter].cost = QL_MAX_REAL;
+        }
+
+        // evaluate the whole generation at once, so that the cost
+        // function can run the evaluations concurrently
+        evaluate(population, costFunction);
+    }
+
+    void DifferentialEvolution::evaluate(std::vector<Candidate>& population,
+                                         const CostFunction& costFunction,
+                                         bool failOnError) const {
+        std::vector<Array> x(population.size());
+        for (Size i = 0; i < population.size(); ++i)
+            x[i] = population[i].values;
+        Array y;
+        try {
+            costFunction.batchValue(x, y);
+        } catch (Error&) {
+            if (failOnError)
+                throw;
+            // find out which candidates failed
+            y = Array(population.size());
+            for (Size i = 0; i < population.size(); ++i) {
+                try {
+                    y[i] = costFunction.value(x[i]);
+                } catch (Error&) {
+                    y[i] = QL_MAX_REAL;
+                }
             }
         }
+        for (Size i = 0; i < population.size(); ++i)
+            population[i].cost = y[i];
     }
 
     void DifferentialEvolution::getCrossoverMask(
@@ -344,15 +368,14 @@ namespace QuantLib {
 
         // use initial values provided by the user
         population.front().values = p.currentValue();
-        population.front().cost = p.costFunction().value(population.front().values);
         // rest of the initial population is random
         for (Size j = 1; j < population.size(); ++j) {
             for (Size i = 0; i < p.currentValue().size(); ++i) {
                 Real l = lowerBound_[i], u = upperBound_[i];
                 population[j].values[i] = l + (u-l)*rng_.nextReal();
             }
-            population[j].cost = p.costFunction().value(population[j].values);
         }
+        evaluate(population, p.costFunction(), true);
     }
 
 }
@@ -185,6 +185,12 @@ namespace QuantLib {
                        const std::vector<Candidate>& mutantPopulation,
                        const std::vector<Candidate>& mirrorPopulation,
                        const CostFunction& costFunction) const;
+
+        // candidates whose evaluation fails get QL_MAX_REAL as cost,
+        // unless failOnError is set
+        void evaluate(std::vector<Candidate>& population,
+                      const CostFunction& costFunction,
+                      bool failOnError = false) const;
     };
 
 }
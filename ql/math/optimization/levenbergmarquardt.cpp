@@ -26,6 +26,7 @@
 #pragma GCC diagnostic ignored "-Wunused-local-typedefs"
 #endif
 #include <boost/bind.hpp>
+#include <algorithm>
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic pop
 #endif
@@ -49,6 +50,7 @@ namespace QuantLib {
         P.reset();
         Array x_ = P.currentValue();
         currentProblem_ = &P;
+        lastPoint_ = lastValues_ = Array();
         initCostValues_ = P.costFunction().values(x_);
         int m = initCostValues_.size();
         int n = x_.size();
@@ -93,7 +95,8 @@ namespace QuantLib {
             useCostFunctionsJacobian_
                 ? boost::bind(&LevenbergMarquardt::jacFcn, this, _1, _2, _3,
                               _4, _5)
-                : MINPACK::LmdifCostFunction(NULL);
+                : boost::bind(&LevenbergMarquardt::fdJacFcn, this, _1, _2,
+                              _3, _4, _5);
         MINPACK::lmdif(m, n, xx.get(), fvec.get(),
                        endCriteria.functionEpsilon(),
                        xtol_,
@@ -130,7 +133,7 @@ namespace QuantLib {
         return ecType;
     }
 
-    void LevenbergMarquardt::fcn(int, int n, Real* x, Real* fvec, int*) {
+    void LevenbergMarquardt::fcn(int m, int n, Real* x, Real* fvec, int*) {
         Array xt(n);
         std::copy(x, x+n, xt.begin());
         // constraint handling needs some improvement in the future:
@@ -141,6 +144,10 @@ namespace QuantLib {
         } else {
             std::copy(initCostValues_.begin(), initCostValues_.end(), fvec);
         }
+        // lmdif computes the jacobian at the last accepted point,
+        // which is the last one passed here
+        lastPoint_ = xt;
+        lastValues_ = Array(fvec, fvec+m);
     }
 
     void LevenbergMarquardt::jacFcn(int m, int n, Real* x, Real* fjac, int*) {
@@ -159,4 +166,46 @@ namespace QuantLib {
         }
     }
 
+    void LevenbergMarquardt::fdJacFcn(int m, int n, Real* x, Real* fjac,
+                                      int*) {
+        // same steps as in MINPACK's fdjac2
+        const Real machep = 1.2e-16;
+        const Real eps = std::sqrt(std::max(epsfcn_, machep));
+        Array xt(n);
+        std::copy(x, x+n, xt.begin());
+        std::vector<Real> h(n);
+        std::vector<Array> points(n, xt);
+        for (int j=0; j<n; ++j) {
+            h[j] = eps*std::fabs(x[j]);
+            if (h[j] == 0.0)
+                h[j] = eps;
+            points[j][j] = x[j] + h[j];
+        }
+        const bool reuse = lastPoint_.size() == Size(n)
+            && std::equal(xt.begin(), xt.end(), lastPoint_.begin());
+        if (!reuse)
+            points.push_back(xt);
+
+        // as in fcn(), points violating the constraint get the
+        // initial cost values
+        std::vector<Array> values(points.size(), initCostValues_);
+        std::vector<Array> feasible, feasibleValues;
+        std::vector<Size> index;
+        for (Size k=0; k<points.size(); ++k) {
+            if (currentProblem_->constraint().test(points[k])) {
+                feasible.push_back(points[k]);
+                index.push_back(k);
+            }
+        }
+        currentProblem_->batchValues(feasible, feasibleValues);
+        for (Size k=0; k<index.size(); ++k)
+            values[index[k]] = feasibleValues[k];
+
+        const Array& f0 = reuse ? lastValues_ : values.back();
+        for (int j=0; j<n; ++j) {
+            for (int i=0; i<m; ++i)
+                fjac[i+m*j] = (values[j][i] - f0[i])/h[j];
+        }
+    }
+
 }
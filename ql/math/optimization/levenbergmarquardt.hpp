@@ -44,6 +44,12 @@ namespace QuantLib {
         evaluations) compared to the forward
         difference implemented here (order 1).
 
+        The built-in scheme is the forward difference of MINPACK's
+        fdjac2, but the shifted points are passed to the cost
+        function as a single batch (see CostFunction::batchValues),
+        so that cost functions supporting it can evaluate the
+        columns of the jacobian concurrently.
+
         \ingroup optimizers
     */
     class LevenbergMarquardt : public OptimizationMethod {
@@ -67,10 +73,16 @@ namespace QuantLib {
                  Real* x,
                  Real* fjac,
                  int* iflag);
+        void fdJacFcn(int m,
+                 int n,
+                 Real* x,
+                 Real* fjac,
+                 int* iflag);
 
       private:
         Problem* currentProblem_;
         Array initCostValues_;
+        Array lastPoint_, lastValues_;
         Matrix initJacobian_;
         mutable Integer info_;
         const Real epsfcn_, xtol_, gtol_;
@@ -58,6 +58,15 @@ namespace QuantLib {
         //! call cost values computation and increment evaluation counter
         Disposable<Array> values(const Array& x);
 
+        //! call cost function computation at several points and
+        //  increment evaluation counter accordingly
+        void batchValue(const std::vector<Array>& x, Array& y);
+
+        //! call cost values computation at several points and
+        //  increment evaluation counter accordingly
+        void batchValues(const std::vector<Array>& x,
+                         std::vector<Array>& y);
+
         //! call cost function gradient computation and increment
         //  evaluation counter
         void gradient(Array& grad_f,
@@ -123,6 +132,18 @@ namespace QuantLib {
         return costFunction_.values(x);
     }
 
+    inline void Problem::batchValue(const std::vector<Array>& x,
+                                    Array& y) {
+        functionEvaluation_ += Integer(x.size());
+        costFunction_.batchValue(x, y);
+    }
+
+    inline void Problem::batchValues(const std::vector<Array>& x,
+                                     std::vector<Array>& y) {
+        functionEvaluation_ += Integer(x.size());
+        costFunction_.batchValues(x, y);
+    }
+
     inline void Problem::gradient(Array& grad_f,
                                   const Array& x) {
         ++gradientEvaluation_;
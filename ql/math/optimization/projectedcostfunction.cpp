@@ -45,4 +45,22 @@ namespace QuantLib {
         return costFunction_.values(actualParameters_);
     }
 
+    void ProjectedCostFunction::batchValue(
+                                const std::vector<Array>& freeParameters,
+                                Array& y) const {
+        std::vector<Array> x(freeParameters.size());
+        for (Size i=0; i<x.size(); ++i)
+            x[i] = include(freeParameters[i]);
+        costFunction_.batchValue(x, y);
+    }
+
+    void ProjectedCostFunction::batchValues(
+                                const std::vector<Array>& freeParameters,
+                                std::vector<Array>& y) const {
+        std::vector<Array> x(freeParameters.size());
+        for (Size i=0; i<x.size(); ++i)
+            x[i] = include(freeParameters[i]);
+        costFunction_.batchValues(x, y);
+    }
+
 }
@@ -50,6 +50,11 @@ namespace QuantLib {
             virtual Real value(const Array& freeParameters) const;
             virtual Disposable<Array>
                                    values(const Array& freeParameters) const;
+            virtual void batchValue(const std::vector<Array>& freeParameters,
+                                    Array& y) const;
+            virtual void batchValues(
+                                 const std::vector<Array>& freeParameters,
+                                 std::vector<Array>& y) const;
             //@}
 
         private:
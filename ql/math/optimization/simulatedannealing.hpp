@@ -158,11 +158,18 @@ namespace QuantLib {
             P.constraint().update(vertices_[i_ + 1], direction, lambda_);
         }
         values_ = Array(n_ + 1, 0.0);
+        std::vector<Array> feasible;
         for (i_ = 0; i_ <= n_; i_++) {
+            if (P.constraint().test(vertices_[i_]))
+                feasible.push_back(vertices_[i_]);
+        }
+        Array feasibleValues;
+        P.batchValue(feasible, feasibleValues);
+        for (i_ = 0, j_ = 0; i_ <= n_; i_++) {
             if (!P.constraint().test(vertices_[i_]))
                 values_[i_] = QL_MAX_REAL;
             else
-                values_[i_] = P.value(vertices_[i_]);
+                values_[i_] = feasibleValues[j_++];
             if (boost::math::isnan(ytry_)) { // handle NAN
                 values_[i_] = QL_MAX_REAL;
             }
@@ -233,6 +240,9 @@ namespace QuantLib {
                         ysave_ = yhi_;
                         amotsa(P, 0.5);
                         if (ytry_ >= ysave_) {
+                            // the contracted vertices are evaluated
+                            // in a single batch
+                            std::vector<Array> contracted;
                             for (i_ = 0; i_ < n_ + 1; i_++) {
                                 if (i_ != ilo_) {
                                     for (j_ = 0; j_ < n_; j_++) {
@@ -240,9 +250,15 @@ namespace QuantLib {
                                                           vertices_[ilo_][j_]);
                                         vertices_[i_][j_] = sum_[j_];
                                     }
-                                    values_[i_] = P.value(sum_);
+                                    contracted.push_back(sum_);
                                 }
                             }
+                            Array contractedValues;
+                            P.batchValue(contracted, contractedValues);
+                            for (i_ = 0, j_ = 0; i_ < n_ + 1; i_++) {
+                                if (i_ != ilo_)
+                                    values_[i_] = contractedValues[j_++];
+                            }
                             iteration_ += n_;
                             for (i_ = 0; i_ < n_; i_++)
                                 sum_[i_] = 0.0;
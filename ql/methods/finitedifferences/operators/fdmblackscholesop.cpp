@@ -28,6 +28,17 @@
 
 namespace QuantLib {
 
+    namespace {
+
+        std::vector<Real> underlyingLevels(
+                                const boost::shared_ptr<FdmMesher>& mesher,
+                                Size direction) {
+            const Array x = Exp(mesher->locations(direction));
+            return std::vector<Real>(x.begin(), x.end());
+        }
+
+    }
+
     FdmBlackScholesOp::FdmBlackScholesOp(
         const boost::shared_ptr<FdmMesher>& mesher,
         const boost::shared_ptr<GeneralizedBlackScholesProcess> & bsProcess,
@@ -41,7 +52,8 @@ namespace QuantLib {
       volTS_ (bsProcess->blackVolatility().currentLink()),
       localVol_((localVol) ? bsProcess->localVolatility().currentLink()
                            : boost::shared_ptr<LocalVolTermStructure>()),
-      x_     ((localVol) ? Array(Exp(mesher->locations(direction))) : Array()),
+      x_     ((localVol) ? underlyingLevels(mesher, direction)
+                         : std::vector<Real>()),
       dxMap_ (FirstDerivativeOp(direction, mesher)),
       dxxMap_(SecondDerivativeOp(direction, mesher)),
       mapT_  (direction, mesher),
@@ -55,28 +67,33 @@ namespace QuantLib {
         const Rate q = qTS_->forwardRate(t1, t2, Continuous).rate();
 
         if (localVol_) {
-            const boost::shared_ptr<FdmLinearOpLayout> layout=mesher_->layout();
-            const FdmLinearOpIterator endIter = layout->end();
-
-            Array v(layout->size());
-            for (FdmLinearOpIterator iter = layout->begin();
-                 iter!=endIter; ++iter) {
-                const Size i = iter.index();
+            const Time t = 0.5*(t1+t2);
 
-                if (illegalLocalVolOverwrite_ < 0.0) {
-                    v[i] = square<Real>()(
-                                localVol_->localVol(0.5*(t1+t2), x_[i], true));
-                }
-                else {
-                    try {
-                        v[i] = square<Real>()(
-                                localVol_->localVol(0.5*(t1+t2), x_[i], true));
-                    } catch (Error&) {
-                        v[i] = square<Real>()(illegalLocalVolOverwrite_);
+            // all grid points are looked up in a single batch call
+            std::vector<Volatility> vols;
+            if (illegalLocalVolOverwrite_ < 0.0) {
+                localVol_->localVol(t, x_, vols, true);
+            }
+            else {
+                try {
+                    localVol_->localVol(t, x_, vols, true);
+                } catch (Error&) {
+                    // fall back to single lookups to find the illegal ones
+                    vols.resize(x_.size());
+                    for (Size i=0; i < x_.size(); ++i) {
+                        try {
+                            vols[i] = localVol_->localVol(t, x_[i], true);
+                        } catch (Error&) {
+                            vols[i] = illegalLocalVolOverwrite_;
+                        }
                     }
-
                 }
             }
+
+            Array v(vols.size());
+            for (Size i=0; i < v.size(); ++i)
+                v[i] = square<Real>()(vols[i]);
+
             mapT_.axpyb(r - q - 0.5*v, dxMap_,
                         dxxMap_.mult(0.5*v), Array(1, -r));
         }
@@ -63,7 +63,7 @@ namespace QuantLib {
         const boost::shared_ptr<YieldTermStructure> rTS_, qTS_;
         const boost::shared_ptr<BlackVolTermStructure> volTS_;
         const boost::shared_ptr<LocalVolTermStructure> localVol_;
-        const Array x_;
+        const std::vector<Real> x_;
         const FirstDerivativeOp  dxMap_;
         const TripleBandLinearOp dxxMap_;
         TripleBandLinearOp mapT_;
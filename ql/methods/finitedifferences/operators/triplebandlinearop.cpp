@@ -256,9 +256,11 @@ namespace QuantLib {
         const Size* i0ptr = i0_.get();
         const Size* i2ptr = i2_.get();
 
+        const long size = long(index->size());
         array_type retVal(r.size());
-        //#pragma omp parallel for
-        for (Size i=0; i < index->size(); ++i) {
+        // on small grids, starting the threads costs more than the loop
+        #pragma omp parallel for if (size >= 10000)
+        for (long i=0; i < size; ++i) {
             retVal[i] = r[i0ptr[i]]*lptr[i]+r[i]*dptr[i]+r[i2ptr[i]]*uptr[i];
         }
 
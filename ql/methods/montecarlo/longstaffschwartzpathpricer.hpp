@@ -29,6 +29,7 @@
 #include <ql/termstructures/yieldtermstructure.hpp>
 #include <ql/math/functional.hpp>
 #include <ql/math/generallinearleastsquares.hpp>
+#include <ql/math/matrixutilities/svd.hpp>
 #include <ql/math/statistics/incrementalstatistics.hpp>
 #include <ql/methods/montecarlo/pathpricer.hpp>
 #include <ql/methods/montecarlo/earlyexercisepathpricer.hpp>
@@ -52,6 +53,49 @@
 
 namespace QuantLib {
 
+    //! storage of the calibration sample in the Longstaff-Schwarz pricer
+    /*! With Paths every calibration path is kept in full and the
+        regression is carried out by GeneralLinearLeastSquares.
+
+        With States (and StatesSinglePrecision) only the exercise
+        value and the regression state of each path are kept, packed
+        contiguously per exercise date. The regression is then done
+        via the normal equations, which are assembled in parallel when
+        OpenMP is enabled, and the stored states of an exercise date
+        are released as soon as its coefficients are fixed. The single
+        precision variant halves the memory further at the cost of
+        rounding the stored exercise values and states to float.
+    */
+    struct LsmCalibrationStorage {
+        enum Type { Paths, States, StatesSinglePrecision };
+    };
+
+    namespace detail {
+
+        template <class T>
+        inline void lsmPackState(Real state, std::vector<T>& v) {
+            v.push_back(static_cast<T>(state));
+        }
+        template <class T>
+        inline void lsmPackState(const Array& state, std::vector<T>& v) {
+            for (Size k=0; k<state.size(); ++k)
+                v.push_back(static_cast<T>(state[k]));
+        }
+
+        template <class T>
+        inline void lsmUnpackState(const T* p, Size, Real& state) {
+            state = static_cast<Real>(*p);
+        }
+        template <class T>
+        inline void lsmUnpackState(const T* p, Size d, Array& state) {
+            if (state.size() != d)
+                state = Array(d);
+            for (Size k=0; k<d; ++k)
+                state[k] = static_cast<Real>(p[k]);
+        }
+
+    }
+
     //! Longstaff-Schwarz path pricer for early exercise options
     /*! References:
 
@@ -72,7 +116,8 @@ namespace QuantLib {
         LongstaffSchwartzPathPricer(
             const TimeGrid& times,
             const boost::shared_ptr<EarlyExercisePathPricer<PathType> >& ,
-            const boost::shared_ptr<YieldTermStructure>& termStructure);
+            const boost::shared_ptr<YieldTermStructure>& termStructure,
+            LsmCalibrationStorage::Type storage = LsmCalibrationStorage::Paths);
 
         Real operator()(const PathType& path) const;
         virtual void calibrate();
@@ -84,6 +129,15 @@ namespace QuantLib {
                                      const std::vector<StateType> &state,
                                      const std::vector<Real> &price,
                                      const std::vector<Real> &exercise) {}
+
+        template <class T>
+        void storeStates(const PathType& path,
+                         std::vector<std::vector<std::vector<T> > >&) const;
+        template <class T>
+        void calibrateStates(std::vector<std::vector<std::vector<T> > >&);
+        static Array solveNormalEquations(const Matrix& ata,
+                                          const Array& aty);
+
         bool  calibrationPhase_;
         const boost::shared_ptr<EarlyExercisePathPricer<PathType> >
             pathPricer_;
@@ -98,6 +152,13 @@ namespace QuantLib {
         const   std::vector<boost::function1<Real, StateType> > v_;
 
         const Size len_;
+
+        const LsmCalibrationStorage::Type storage_;
+        // thread local exercise values and states, packed by
+        // (exercise date, path), see LsmCalibrationStorage
+        mutable std::vector<std::vector<std::vector<Real> > > statesMt_;
+        mutable std::vector<std::vector<std::vector<float> > > statesMtSp_;
+        mutable std::vector<Size> nStatesMt_;
     };
 
     template <class PathType> inline
@@ -105,25 +166,49 @@ namespace QuantLib {
         const TimeGrid& times,
         const boost::shared_ptr<EarlyExercisePathPricer<PathType> >&
             pathPricer,
-        const boost::shared_ptr<YieldTermStructure>& termStructure)
+        const boost::shared_ptr<YieldTermStructure>& termStructure,
+        LsmCalibrationStorage::Type storage)
     : calibrationPhase_(true),
       pathPricer_(pathPricer),
       coeff_     (new Array[times.size()-2]),
       dF_        (new DiscountFactor[times.size()-1]),
       pathsMt_   (8,std::vector<PathType>()),
       v_         (pathPricer_->basisSystem()),
-      len_       (times.size()) {
+      len_       (times.size()),
+      storage_   (storage) {
 
         for (Size i=0; i<times.size()-1; ++i) {
             dF_[i] =   termStructure->discount(times[i+1])
                      / termStructure->discount(times[i]);
         }
+
+        if (storage_ != LsmCalibrationStorage::Paths) {
+            Size nThreads = 1;
+#ifdef _OPENMP
+            nThreads = omp_get_max_threads();
+#endif
+            nStatesMt_.resize(nThreads, 0);
+            if (storage_ == LsmCalibrationStorage::StatesSinglePrecision)
+                statesMtSp_.resize(nThreads,
+                                   std::vector<std::vector<float> >(len_-1));
+            else
+                statesMt_.resize(nThreads,
+                                 std::vector<std::vector<Real> >(len_-1));
+        }
     }
 
     template <class PathType> inline
     Real LongstaffSchwartzPathPricer<PathType>::operator()
         (const PathType& path) const {
         if (calibrationPhase_) {
+            if (storage_ == LsmCalibrationStorage::States) {
+                storeStates(path, statesMt_);
+                return 0.0;
+            } else if (storage_ ==
+                       LsmCalibrationStorage::StatesSinglePrecision) {
+                storeStates(path, statesMtSp_);
+                return 0.0;
+            }
             // store paths for the calibration
 #ifdef _OPENMP
             unsigned int threadId = omp_get_thread_num();
@@ -170,6 +255,13 @@ namespace QuantLib {
 
     template <class PathType> inline
     void LongstaffSchwartzPathPricer<PathType>::calibrate() {
+        if (storage_ == LsmCalibrationStorage::States) {
+            calibrateStates(statesMt_);
+            return;
+        } else if (storage_ == LsmCalibrationStorage::StatesSinglePrecision) {
+            calibrateStates(statesMtSp_);
+            return;
+        }
 #ifdef _OPENMP
         for (Size i = 0; i < pathsMt_.size(); ++i) {
             paths_.insert(paths_.end(), pathsMt_[i].begin(), pathsMt_[i].end());
@@ -235,10 +327,191 @@ namespace QuantLib {
         // remove calibration paths and release memory
         std::vector<PathType> empty;
         paths_.swap(empty);
+        for (Size i = 0; i < pathsMt_.size(); ++i)
+            std::vector<PathType>().swap(pathsMt_[i]);
+        // entering the calculation phase
+        calibrationPhase_ = false;
+    }
+
+    template <class PathType>
+    template <class T>
+    inline void LongstaffSchwartzPathPricer<PathType>::storeStates(
+        const PathType& path,
+        std::vector<std::vector<std::vector<T> > >& buffer) const {
+        unsigned int threadId = 0;
+#ifdef _OPENMP
+        threadId = omp_get_thread_num();
+#endif
+        QL_REQUIRE(threadId < buffer.size(),
+                   "thread id " << threadId << " exceeds number of "
+                   "calibration buffers (" << buffer.size() << ")");
+        for (Size i=1; i<len_; ++i) {
+            buffer[threadId][i-1].push_back(
+                static_cast<T>((*pathPricer_)(path, i)));
+            detail::lsmPackState(pathPricer_->state(path, i),
+                                 buffer[threadId][i-1]);
+        }
+        ++nStatesMt_[threadId];
+    }
+
+    template <class PathType>
+    template <class T>
+    inline void LongstaffSchwartzPathPricer<PathType>::calibrateStates(
+        std::vector<std::vector<std::vector<T> > >& buffer) {
+
+        const Size m = v_.size();
+        Size n = 0, d = 0;
+        for (Size t=0; t<buffer.size(); ++t) {
+            if (nStatesMt_[t] > 0) {
+                d = buffer[t][0].size() / nStatesMt_[t] - 1;
+                n += nStatesMt_[t];
+            }
+        }
+        const Size stride = d + 1;
+
+        // merge the thread local buffers into one (date, path) layout,
+        // releasing the thread local memory as we go
+        std::vector<std::vector<T> > states(len_-1);
+        for (Size i=0; i<len_-1; ++i) {
+            states[i].reserve(n*stride);
+            for (Size t=0; t<buffer.size(); ++t) {
+                states[i].insert(states[i].end(), buffer[t][i].begin(),
+                                 buffer[t][i].end());
+                std::vector<T>().swap(buffer[t][i]);
+            }
+        }
+        std::fill(nStatesMt_.begin(), nStatesMt_.end(), 0);
+
+        Array prices(n);
+        std::vector<StateType> p_state(n);
+        std::vector<Real> p_price(n), p_exercise(n);
+
+        for (Size j=0; j<n; ++j) {
+            const T* s = &states[len_-2][j*stride];
+            detail::lsmUnpackState(s+1, d, p_state[j]);
+            prices[j] = p_price[j] = p_exercise[j] = static_cast<Real>(*s);
+        }
+        std::vector<T>().swap(states[len_-2]);
+
+        post_processing(len_ - 1, p_state, p_price, p_exercise);
+
+        Size nThreads = 1;
+#ifdef _OPENMP
+        nThreads = omp_get_max_threads();
+#endif
+        // basis function values of the itm paths and thread local
+        // accumulators for the normal equations
+        std::vector<Real> basis(n*m);
+        std::vector<Real> acc(nThreads*(m*m+m));
+        std::vector<Size> nItmMt(nThreads);
+
+        for (Size i=len_-2; i>0; --i) {
+            const std::vector<T>& s = states[i-1];
+            std::fill(acc.begin(), acc.end(), 0.0);
+            std::fill(nItmMt.begin(), nItmMt.end(), 0);
+
+#pragma omp parallel
+            {
+                unsigned int threadId = 0;
+#ifdef _OPENMP
+                threadId = omp_get_thread_num();
+#endif
+                Real* ata = &acc[threadId*(m*m+m)];
+                Real* aty = ata + m*m;
+#pragma omp for schedule(static)
+                for (Size j=0; j<n; ++j) {
+                    detail::lsmUnpackState(&s[j*stride+1], d, p_state[j]);
+                    p_exercise[j] = static_cast<Real>(s[j*stride]);
+                    if (p_exercise[j] > 0.0) {
+                        Real* b = &basis[j*m];
+                        for (Size l=0; l<m; ++l)
+                            b[l] = v_[l](p_state[j]);
+                        const Real y = dF_[i]*prices[j];
+                        for (Size l=0; l<m; ++l) {
+                            for (Size k=0; k<=l; ++k)
+                                ata[l*m+k] += b[l]*b[k];
+                            aty[l] += b[l]*y;
+                        }
+                        ++nItmMt[threadId];
+                    }
+                }
+            }
+
+            // combine the thread local sums in a fixed order
+            Matrix ata(m, m, 0.0);
+            Array aty(m, 0.0);
+            Size nItm = 0;
+            for (Size t=0; t<nThreads; ++t) {
+                const Real* a = &acc[t*(m*m+m)];
+                for (Size l=0; l<m; ++l) {
+                    for (Size k=0; k<=l; ++k)
+                        ata[l][k] += a[l*m+k];
+                    aty[l] += a[m*m+l];
+                }
+                nItm += nItmMt[t];
+            }
+            for (Size l=0; l<m; ++l)
+                for (Size k=0; k<l; ++k)
+                    ata[k][l] = ata[l][k];
+
+            if (m <= nItm) {
+                coeff_[i-1] = solveNormalEquations(ata, aty);
+            }
+            else {
+            // see above
+                coeff_[i-1] = Array(m, 0.0);
+            }
+
+            const Array& coeff = coeff_[i-1];
+#pragma omp parallel for schedule(static)
+            for (Size j=0; j<n; ++j) {
+                prices[j]*=dF_[i];
+                if (p_exercise[j]>0.0) {
+                    Real continuationValue = 0.0;
+                    for (Size l=0; l<m; ++l) {
+                        continuationValue += coeff[l] * basis[j*m+l];
+                    }
+                    if (continuationValue < p_exercise[j]) {
+                        prices[j] = p_exercise[j];
+                    }
+                }
+                p_price[j] = prices[j];
+            }
+
+            std::vector<T>().swap(states[i-1]);
+
+            post_processing(i, p_state, p_price, p_exercise);
+        }
+
         // entering the calculation phase
         calibrationPhase_ = false;
     }
 
+    template <class PathType>
+    inline Array LongstaffSchwartzPathPricer<PathType>::solveNormalEquations(
+        const Matrix& ata, const Array& aty) {
+        // pseudo inverse of the (symmetric, positive semidefinite)
+        // normal matrix, singular directions are dropped as in
+        // GeneralLinearLeastSquares
+        const Size m = aty.size();
+        const SVD svd(ata);
+        const Matrix& U = svd.U();
+        const Matrix& V = svd.V();
+        const Array& w = svd.singularValues();
+        const Real threshold = m * QL_EPSILON * w[0];
+        Array a(m, 0.0);
+        for (Size l=0; l<m; ++l) {
+            if (w[l] > threshold) {
+                const Real u = std::inner_product(U.column_begin(l),
+                                                  U.column_end(l),
+                                                  aty.begin(), 0.0)/w[l];
+                for (Size k=0; k<m; ++k)
+                    a[k] += u*V[k][l];
+            }
+        }
+        return a;
+    }
+
     template <class PathType> inline
     Real LongstaffSchwartzPathPricer<PathType>::exerciseProbability() const {
         return exerciseProbability_.mean();
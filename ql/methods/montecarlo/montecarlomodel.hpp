@@ -29,6 +29,8 @@
 #include <ql/methods/montecarlo/mctraits.hpp>
 #include <ql/math/statistics/statistics.hpp>
 #include <boost/shared_ptr.hpp>
+#include <vector>
+#include <utility>
 
 #ifdef _OPENMP
 #include <omp.h>
@@ -85,8 +87,17 @@ namespace QuantLib {
           isControlVariate_(cvPathPricer_!=NULL),
           cvPathGenerator_(cvPathGenerator) {}
         void addSamples(Size samples);
+        /*! simulates the given number of samples using the generator
+            stream threadId without accumulating them; different
+            streams can be used concurrently */
+        void simulateBatch(
+                 Size samples, unsigned int threadId,
+                 std::vector<std::pair<result_type, Real> >& batch) const;
+        //! accumulates samples previously returned by simulateBatch
+        void addBatch(const std::vector<std::pair<result_type, Real> >&);
         const stats_type& sampleAccumulator(void) const;
       private:
+        std::pair<result_type, Real> nextSample(unsigned int threadId) const;
         const boost::shared_ptr<path_generator_type> pathGenerator_;
         const boost::shared_ptr<path_pricer_type> pathPricer_;
         stats_type sampleAccumulator_;
@@ -98,6 +109,42 @@ namespace QuantLib {
     };
 
     // inline definitions
+    template <template <class> class MC, class RNG, class S>
+    inline std::pair<typename MonteCarloModel<MC,RNG,S>::result_type, Real>
+    MonteCarloModel<MC,RNG,S>::nextSample(unsigned int threadId) const {
+
+        sample_type path = pathGenerator_->next(threadId);
+
+        result_type price = (*pathPricer_)(path.value);
+
+        if (isControlVariate_) {
+            if (!cvPathGenerator_) {
+                price += cvOptionValue_-(*cvPathPricer_)(path.value);
+            }
+            else {
+                sample_type cvPath = cvPathGenerator_->next(threadId);
+                price += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
+            }
+        }
+
+        if (isAntitheticVariate_) {
+            path = pathGenerator_->antithetic(threadId);
+            result_type price2 = (*pathPricer_)(path.value);
+            if (isControlVariate_) {
+                if (!cvPathGenerator_)
+                    price2 += cvOptionValue_-(*cvPathPricer_)(path.value);
+                else {
+                    sample_type cvPath = cvPathGenerator_->antithetic(threadId);
+                    price2 += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
+                }
+            }
+            return std::make_pair(result_type((price+price2)/2.0),
+                                  path.weight);
+        } else {
+            return std::make_pair(price, path.weight);
+        }
+    }
+
     template <template <class> class MC, class RNG, class S>
     inline void MonteCarloModel<MC,RNG,S>::addSamples(Size samples) {
 
@@ -111,40 +158,29 @@ namespace QuantLib {
                 threadId = omp_get_thread_num();
 #endif
 
-            sample_type path = pathGenerator_->next(threadId);
-
-            result_type price = (*pathPricer_)(path.value);
-
-            if (isControlVariate_) {
-                if (!cvPathGenerator_) {
-                    price += cvOptionValue_-(*cvPathPricer_)(path.value);
-                }
-                else {
-                    sample_type cvPath = cvPathGenerator_->next(threadId);
-                    price += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
-                }
-            }
-
-            if (isAntitheticVariate_) {
-                path = pathGenerator_->antithetic(threadId);
-                result_type price2 = (*pathPricer_)(path.value);
-                if (isControlVariate_) {
-                    if (!cvPathGenerator_)
-                        price2 += cvOptionValue_-(*cvPathPricer_)(path.value);
-                    else {
-                        sample_type cvPath = cvPathGenerator_->antithetic(threadId);
-                        price2 += cvOptionValue_-(*cvPathPricer_)(cvPath.value);
-                    }
-                }
-#pragma omp critical
-                sampleAccumulator_.add((price+price2)/2.0, path.weight);
-            } else {
+            const std::pair<result_type, Real> sample = nextSample(threadId);
 #pragma omp critical
-                sampleAccumulator_.add(price, path.weight);
-            }
+            sampleAccumulator_.add(sample.first, sample.second);
         } // for samples
     }
 
+    template <template <class> class MC, class RNG, class S>
+    inline void MonteCarloModel<MC,RNG,S>::simulateBatch(
+                Size samples, unsigned int threadId,
+                std::vector<std::pair<result_type, Real> >& batch) const {
+        batch.clear();
+        batch.reserve(samples);
+        for (Size j = 0; j < samples; ++j)
+            batch.push_back(nextSample(threadId));
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MonteCarloModel<MC,RNG,S>::addBatch(
+                const std::vector<std::pair<result_type, Real> >& batch) {
+        for (Size j = 0; j < batch.size(); ++j)
+            sampleAccumulator_.add(batch[j].first, batch[j].second);
+    }
+
     template <template <class> class MC, class RNG, class S>
     inline const typename MonteCarloModel<MC,RNG,S>::stats_type&
     MonteCarloModel<MC,RNG,S>::sampleAccumulator() const {
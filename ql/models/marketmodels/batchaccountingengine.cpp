@@ -0,0 +1,120 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/models/marketmodels/batchaccountingengine.hpp>
+#include <ql/models/marketmodels/batchevolver.hpp>
+#include <ql/models/marketmodels/evolutiondescription.hpp>
+#include <ql/models/marketmodels/curvestates/lmmbatchcurvestate.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    BatchAccountingEngine::BatchAccountingEngine(
+                     const boost::shared_ptr<MarketModelBatchEvolver>& evolver,
+                     const Clone<MarketModelMultiProduct>& product,
+                     Real initialNumeraireValue)
+    : evolver_(evolver), products_(evolver->numberOfPaths(), product),
+      initialNumeraireValue_(initialNumeraireValue),
+      numberProducts_(product->numberOfProducts()),
+      numberOfPaths_(evolver->numberOfPaths()),
+      weights_(numberOfPaths_), principals_(numberOfPaths_),
+      done_(numberOfPaths_),
+      numerairesHeld_(numberOfPaths_, numberProducts_),
+      numberCashFlowsThisStep_(numberProducts_),
+      cashFlowsGenerated_(numberProducts_) {
+        for (Size i=0; i<numberProducts_; ++i)
+            cashFlowsGenerated_[i].resize(
+                       product->maxNumberOfCashFlowsPerProductPerStep());
+
+        const std::vector<Time>& cashFlowTimes =
+            product->possibleCashFlowTimes();
+        const std::vector<Rate>& rateTimes = product->evolution().rateTimes();
+        discounters_.reserve(cashFlowTimes.size());
+        for (Size j=0; j<cashFlowTimes.size(); ++j)
+            discounters_.push_back(MarketModelDiscounter(cashFlowTimes[j],
+                                                         rateTimes));
+    }
+
+    void BatchAccountingEngine::batchValues() {
+        std::fill(numerairesHeld_.begin(), numerairesHeld_.end(), 0.0);
+        std::fill(principals_.begin(), principals_.end(), 1.0);
+        std::fill(done_.begin(), done_.end(), false);
+
+        const std::vector<Real>& startWeights = evolver_->startNewBatch();
+        std::copy(startWeights.begin(), startWeights.end(),
+                  weights_.begin());
+        for (Size p=0; p<numberOfPaths_; ++p)
+            products_[p]->reset();
+
+        Size alivePaths = numberOfPaths_;
+        do {
+            Size thisStep = evolver_->currentStep();
+            const std::vector<Real>& stepWeights = evolver_->advanceStep();
+            const LMMBatchCurveState& states = evolver_->currentState();
+            Size numeraire = evolver_->numeraires()[thisStep];
+
+            for (Size p=0; p<numberOfPaths_; ++p) {
+                if (done_[p])
+                    continue;
+
+                weights_[p] *= stepWeights[p];
+                const CurveState& state = states.pathState(p);
+                done_[p] = products_[p]->nextTimeStep(state,
+                                                      numberCashFlowsThisStep_,
+                                                      cashFlowsGenerated_);
+
+                // convert the cash flows to numeraire bonds as in
+                // AccountingEngine
+                for (Size i=0; i<numberProducts_; ++i) {
+                    const std::vector<MarketModelMultiProduct::CashFlow>&
+                        cashflows = cashFlowsGenerated_[i];
+                    for (Size j=0; j<numberCashFlowsThisStep_[i]; ++j) {
+                        const MarketModelDiscounter& discounter =
+                            discounters_[cashflows[j].timeIndex];
+                        Real bonds = cashflows[j].amount *
+                            discounter.numeraireBonds(state, numeraire);
+                        numerairesHeld_[p][i] += bonds/principals_[p];
+                    }
+                }
+
+                if (done_[p]) {
+                    --alivePaths;
+                } else {
+                    Size nextNumeraire = evolver_->numeraires()[thisStep+1];
+                    principals_[p] *=
+                        states.discountRatio(numeraire, nextNumeraire, p);
+                }
+            }
+        } while (alivePaths > 0);
+    }
+
+    void BatchAccountingEngine::multiplePathValues(
+                                                SequenceStatisticsInc& stats,
+                                                Size numberOfPaths) {
+        std::vector<Real> values(numberProducts_);
+        for (Size done=0; done<numberOfPaths; done+=numberOfPaths_) {
+            batchValues();
+            Size n = std::min(numberOfPaths_, numberOfPaths-done);
+            for (Size p=0; p<n; ++p) {
+                for (Size i=0; i<numberProducts_; ++i)
+                    values[i] = numerairesHeld_[p][i]*initialNumeraireValue_;
+                stats.add(values, weights_[p]);
+            }
+        }
+    }
+
+}
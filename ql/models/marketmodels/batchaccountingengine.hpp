@@ -0,0 +1,73 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file batchaccountingengine.hpp
+    \brief accounting engine driven by a batch evolver
+*/
+
+#ifndef quantlib_batch_accounting_engine_hpp
+#define quantlib_batch_accounting_engine_hpp
+
+#include <ql/models/marketmodels/multiproduct.hpp>
+#include <ql/models/marketmodels/discounter.hpp>
+#include <ql/math/statistics/sequencestatistics.hpp>
+#include <ql/utilities/clone.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    class MarketModelBatchEvolver;
+
+    //! Engine collecting cash flows along a batched market-model simulation
+    /*! Same as AccountingEngine, but the paths are evolved in blocks
+        by a MarketModelBatchEvolver; each path of a block uses its
+        own clone of the product.
+
+        \note When the number of paths is not a multiple of the
+              block size, the last block is simulated in full and
+              its extra paths are discarded.
+    */
+    class BatchAccountingEngine {
+      public:
+        BatchAccountingEngine(
+                     const boost::shared_ptr<MarketModelBatchEvolver>& evolver,
+                     const Clone<MarketModelMultiProduct>& product,
+                     Real initialNumeraireValue);
+        void multiplePathValues(SequenceStatisticsInc& stats,
+                                Size numberOfPaths);
+      private:
+        void batchValues();
+
+        boost::shared_ptr<MarketModelBatchEvolver> evolver_;
+        std::vector<Clone<MarketModelMultiProduct> > products_;
+
+        Real initialNumeraireValue_;
+        Size numberProducts_, numberOfPaths_;
+
+        // workspace
+        std::vector<Real> weights_, principals_;
+        std::vector<bool> done_;
+        Matrix numerairesHeld_;  // paths x products
+        std::vector<Size> numberCashFlowsThisStep_;
+        std::vector<std::vector<MarketModelMultiProduct::CashFlow> >
+                                                         cashFlowsGenerated_;
+        std::vector<MarketModelDiscounter> discounters_;
+    };
+
+}
+
+#endif
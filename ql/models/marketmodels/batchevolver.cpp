@@ -0,0 +1,47 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/models/marketmodels/batchevolver.hpp>
+
+namespace QuantLib {
+
+    BrownianBatch::BrownianBatch(const BrownianGeneratorFactory& factory,
+                                 Size factors,
+                                 Size steps,
+                                 Size numberOfPaths)
+    : factors_(factors), steps_(steps), paths_(numberOfPaths),
+      generator_(factory.create(factors, steps)),
+      variates_(steps, Matrix(factors, numberOfPaths)),
+      stepWeights_(steps, std::vector<Real>(numberOfPaths)),
+      pathWeights_(numberOfPaths), buffer_(factors) {
+        QL_REQUIRE(paths_ > 0, "null number of paths");
+    }
+
+    const std::vector<Real>& BrownianBatch::nextBatch() {
+        for (Size p=0; p<paths_; ++p) {
+            pathWeights_[p] = generator_->nextPath();
+            for (Size j=0; j<steps_; ++j) {
+                stepWeights_[j][p] = generator_->nextStep(buffer_);
+                Matrix& z = variates_[j];
+                for (Size k=0; k<factors_; ++k)
+                    z[k][p] = buffer_[k];
+            }
+        }
+        return pathWeights_;
+    }
+
+}
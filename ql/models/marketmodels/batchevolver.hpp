@@ -0,0 +1,88 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file batchevolver.hpp
+    \brief market-model evolvers advancing a block of paths together
+*/
+
+#ifndef quantlib_market_model_batch_evolver_hpp
+#define quantlib_market_model_batch_evolver_hpp
+
+#include <ql/models/marketmodels/browniangenerator.hpp>
+#include <ql/math/matrix.hpp>
+
+namespace QuantLib {
+
+    class CurveState;
+    class LMMBatchCurveState;
+
+    //! Market-model evolver for a block of paths
+    /*! Abstract base class. Same as MarketModelEvolver, except that
+        a fixed number of paths is evolved at each step; the state of
+        the paths is stored with the path index running fastest, so
+        that the evolution can be vectorized over paths.
+    */
+    class MarketModelBatchEvolver {
+      public:
+        virtual ~MarketModelBatchEvolver() {}
+
+        virtual const std::vector<Size>& numeraires() const = 0;
+        virtual Size numberOfPaths() const = 0;
+        //! returns the weights of the new paths
+        virtual const std::vector<Real>& startNewBatch() = 0;
+        //! returns the weights of the step for each path
+        virtual const std::vector<Real>& advanceStep() = 0;
+        virtual Size currentStep() const = 0;
+        virtual const LMMBatchCurveState& currentState() const = 0;
+        virtual void setInitialState(const CurveState&) = 0;
+    };
+
+    //! Brownian increments for a block of paths
+    /*! Paths are drawn from a Brownian generator in the same order
+        as a single-path evolver would draw them, and are stored as
+        a factors x paths matrix for each step.
+    */
+    class BrownianBatch {
+      public:
+        BrownianBatch(const BrownianGeneratorFactory& factory,
+                      Size factors,
+                      Size steps,
+                      Size numberOfPaths);
+        //! draws the next block of paths and returns their weights
+        const std::vector<Real>& nextBatch();
+        //! variates of the given step, as factors x paths
+        const Matrix& variates(Size step) const {
+            return variates_[step];
+        }
+        //! weights of the given step for each path
+        const std::vector<Real>& stepWeights(Size step) const {
+            return stepWeights_[step];
+        }
+        Size numberOfFactors() const { return factors_; }
+        Size numberOfSteps() const { return steps_; }
+        Size numberOfPaths() const { return paths_; }
+      private:
+        Size factors_, steps_, paths_;
+        boost::shared_ptr<BrownianGenerator> generator_;
+        std::vector<Matrix> variates_;
+        std::vector<std::vector<Real> > stepWeights_;
+        std::vector<Real> pathWeights_, buffer_;
+    };
+
+}
+
+#endif
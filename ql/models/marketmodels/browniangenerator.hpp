@@ -47,6 +47,22 @@ namespace QuantLib {
                                                             Size steps) const = 0;
     };
 
+    //! factory of independent Brownian-generator streams
+    /*! Each stream is a Brownian-generator factory whose generators
+        draw a sequence of paths that does not overlap with the ones
+        drawn from the other streams, provided that no more than
+        \c batchSize paths are drawn from each of them.  Streams can
+        therefore be handed out to separate workers of a parallel
+        simulation.
+    */
+    class BrownianGeneratorStreamFactory {
+      public:
+        virtual ~BrownianGeneratorStreamFactory() {}
+
+        virtual boost::shared_ptr<BrownianGeneratorFactory> stream(
+                                             Size i, Size batchSize) const = 0;
+    };
+
 }
 
 #endif
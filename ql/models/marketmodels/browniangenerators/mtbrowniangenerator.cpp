@@ -66,5 +66,25 @@ namespace QuantLib {
                               new MTBrownianGenerator(factors, steps, seed_));
     }
 
+
+    MTBrownianGeneratorStreamFactory::MTBrownianGeneratorStreamFactory(
+                                                          unsigned long seed)
+    : seed_(seed) {}
+
+    boost::shared_ptr<BrownianGeneratorFactory>
+    MTBrownianGeneratorStreamFactory::stream(Size i, Size) const {
+        unsigned long seed = 0;
+        if (seed_ != 0) {
+            MersenneTwisterUniformRng seeder(seed_);
+            for (Size j=0; j<=i; ++j)
+                seed = seeder.nextInt32();
+            // a null seed would be replaced by a random one
+            if (seed == 0)
+                seed = 1;
+        }
+        return boost::shared_ptr<BrownianGeneratorFactory>(
+                                        new MTBrownianGeneratorFactory(seed));
+    }
+
 }
 
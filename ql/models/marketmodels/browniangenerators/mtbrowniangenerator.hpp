@@ -67,6 +67,22 @@ namespace QuantLib {
         unsigned long seed_;
     };
 
+    //! Mersenne-twister Brownian-generator streams
+    /*! The i-th stream is seeded with the (i+1)-th draw of a
+        Mersenne-twister generator initialized with the given seed;
+        the batch size is not used.  As for the other generators,
+        a null seed gives non-reproducible streams.
+    */
+    class MTBrownianGeneratorStreamFactory
+        : public BrownianGeneratorStreamFactory {
+      public:
+        MTBrownianGeneratorStreamFactory(unsigned long seed = 0);
+        boost::shared_ptr<BrownianGeneratorFactory> stream(
+                                                Size i, Size batchSize) const;
+      private:
+        unsigned long seed_;
+    };
+
 }
 
 
@@ -71,6 +71,16 @@ namespace QuantLib {
             }
         }
 
+        SobolRsg skippedSobolRsg(Size dimensionality,
+                                 unsigned long seed,
+                                 SobolRsg::DirectionIntegers integers,
+                                 unsigned long skip) {
+            SobolRsg rsg(dimensionality, seed, integers);
+            if (skip > 0)
+                rsg.skipTo(skip);
+            return rsg;
+        }
+
         /*
         // variate 2 is used for the first factor's half path
         void fillByDiagonal(std::vector<std::vector<Size> >& M,
@@ -112,9 +122,10 @@ namespace QuantLib {
                                         Size steps,
                                         Ordering ordering,
                                         unsigned long seed,
-                                        SobolRsg::DirectionIntegers integers)
+                                        SobolRsg::DirectionIntegers integers,
+                                        unsigned long skip)
     : factors_(factors), steps_(steps), ordering_(ordering),
-      generator_(SobolRsg(factors*steps, seed, integers),
+      generator_(skippedSobolRsg(factors*steps, seed, integers, skip),
                  InverseCumulativeNormal()),
       bridge_(steps), lastStep_(0),
       orderedIndices_(factors, std::vector<Size>(steps)),
@@ -213,14 +224,30 @@ namespace QuantLib {
     SobolBrownianGeneratorFactory::SobolBrownianGeneratorFactory(
                                     SobolBrownianGenerator::Ordering ordering,
                                     unsigned long seed,
-                                    SobolRsg::DirectionIntegers integers)
-    : ordering_(ordering), seed_(seed), integers_(integers) {}
+                                    SobolRsg::DirectionIntegers integers,
+                                    unsigned long skip)
+    : ordering_(ordering), seed_(seed), integers_(integers), skip_(skip) {}
 
     boost::shared_ptr<BrownianGenerator>
     SobolBrownianGeneratorFactory::create(Size factors, Size steps) const {
         return boost::shared_ptr<BrownianGenerator>(
                          new SobolBrownianGenerator(factors, steps, ordering_,
-                                                    seed_, integers_));
+                                                    seed_, integers_, skip_));
+    }
+
+
+    SobolBrownianGeneratorStreamFactory::SobolBrownianGeneratorStreamFactory(
+                                    SobolBrownianGenerator::Ordering ordering,
+                                    unsigned long seed,
+                                    SobolRsg::DirectionIntegers integers)
+    : ordering_(ordering), seed_(seed), integers_(integers) {}
+
+    boost::shared_ptr<BrownianGeneratorFactory>
+    SobolBrownianGeneratorStreamFactory::stream(Size i,
+                                                Size batchSize) const {
+        return boost::shared_ptr<BrownianGeneratorFactory>(
+            new SobolBrownianGeneratorFactory(ordering_, seed_, integers_,
+                                              i*batchSize));
     }
 
 }
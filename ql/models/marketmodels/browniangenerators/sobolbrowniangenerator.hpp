@@ -52,7 +52,8 @@ namespace QuantLib {
                            Ordering ordering,
                            unsigned long seed = 0,
                            SobolRsg::DirectionIntegers directionIntegers
-                                                        = SobolRsg::Jaeckel);
+                                                        = SobolRsg::Jaeckel,
+                           unsigned long skip = 0);
 
         Real nextPath();
         Real nextStep(std::vector<Real>&);
@@ -82,13 +83,36 @@ namespace QuantLib {
                            SobolBrownianGenerator::Ordering ordering,
                            unsigned long seed = 0,
                            SobolRsg::DirectionIntegers directionIntegers
-                                                         = SobolRsg::Jaeckel);
+                                                         = SobolRsg::Jaeckel,
+                           unsigned long skip = 0);
         boost::shared_ptr<BrownianGenerator> create(Size factors,
                                                     Size steps) const;
       private:
         SobolBrownianGenerator::Ordering ordering_;
         unsigned long seed_;
         SobolRsg::DirectionIntegers integers_;
+        unsigned long skip_;
+    };
+
+    //! Sobol Brownian-generator streams
+    /*! The i-th stream skips the first <tt>i*batchSize</tt> points
+        of the Sobol sequence, so that consecutive streams together
+        draw the same points as a single serial generator.
+    */
+    class SobolBrownianGeneratorStreamFactory
+        : public BrownianGeneratorStreamFactory {
+      public:
+        SobolBrownianGeneratorStreamFactory(
+                           SobolBrownianGenerator::Ordering ordering,
+                           unsigned long seed = 0,
+                           SobolRsg::DirectionIntegers directionIntegers
+                                                         = SobolRsg::Jaeckel);
+        boost::shared_ptr<BrownianGeneratorFactory> stream(
+                                                Size i, Size batchSize) const;
+      private:
+        SobolBrownianGenerator::Ordering ordering_;
+        unsigned long seed_;
+        SobolRsg::DirectionIntegers integers_;
     };
 
 }
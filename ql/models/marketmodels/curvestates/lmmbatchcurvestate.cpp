@@ -0,0 +1,77 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/models/marketmodels/curvestates/lmmbatchcurvestate.hpp>
+#include <ql/models/marketmodels/utilities.hpp>
+
+namespace QuantLib {
+
+    LMMBatchCurveState::LMMBatchCurveState(const std::vector<Time>& rateTimes,
+                                           Size numberOfPaths)
+    : rateTimes_(rateTimes), rateTaus_(rateTimes.size()-1),
+      numberOfRates_(rateTimes.size()-1), numberOfPaths_(numberOfPaths),
+      first_(numberOfRates_),
+      forwardRates_(numberOfRates_, numberOfPaths, 0.0),
+      discRatios_(numberOfRates_+1, numberOfPaths, 1.0),
+      pathState_(rateTimes), pathForwards_(numberOfRates_) {
+        QL_REQUIRE(numberOfPaths_ > 0, "null number of paths");
+        checkIncreasingTimesAndCalculateTaus(rateTimes_, rateTaus_);
+    }
+
+    void LMMBatchCurveState::setOnForwardRates(const Matrix& rates,
+                                               Size firstValidIndex) {
+        QL_REQUIRE(rates.rows()==numberOfRates_,
+                   "rates mismatch: " <<
+                   numberOfRates_ << " required, " <<
+                   rates.rows() << " provided");
+        QL_REQUIRE(rates.columns()==numberOfPaths_,
+                   "paths mismatch: " <<
+                   numberOfPaths_ << " required, " <<
+                   rates.columns() << " provided");
+        QL_REQUIRE(firstValidIndex<numberOfRates_,
+                   "first valid index must be less than " <<
+                   numberOfRates_ << ": " <<
+                   firstValidIndex << " not allowed");
+
+        first_ = firstValidIndex;
+        for (Size i=first_; i<numberOfRates_; ++i)
+            std::copy(rates.row_begin(i), rates.row_end(i),
+                      forwardRates_.row_begin(i));
+
+        Real* d = discRatios_[first_];
+        std::fill(d, d+numberOfPaths_, 1.0);
+        for (Size i=first_; i<numberOfRates_; ++i) {
+            const Real* f = forwardRates_[i];
+            const Real* d0 = discRatios_[i];
+            Real* d1 = discRatios_[i+1];
+            const Real tau = rateTaus_[i];
+            for (Size p=0; p<numberOfPaths_; ++p)
+                d1[p] = d0[p]/(1.0+f[p]*tau);
+        }
+    }
+
+    const LMMCurveState& LMMBatchCurveState::pathState(Size path) const {
+        QL_REQUIRE(first_<numberOfRates_, "curve state not initialized");
+        QL_REQUIRE(path<numberOfPaths_,
+                   "path " << path << " out of range");
+        for (Size i=first_; i<numberOfRates_; ++i)
+            pathForwards_[i] = forwardRates_[i][path];
+        pathState_.setOnForwardRates(pathForwards_, first_);
+        return pathState_;
+    }
+
+}
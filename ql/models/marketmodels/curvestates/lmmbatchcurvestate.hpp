@@ -0,0 +1,72 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#ifndef quantlib_lmm_batch_curve_state_hpp
+#define quantlib_lmm_batch_curve_state_hpp
+
+#include <ql/models/marketmodels/curvestates/lmmcurvestate.hpp>
+#include <ql/math/matrix.hpp>
+
+namespace QuantLib {
+
+    //! %Curve states of a block of paths in a %Libor market model
+    /*! Forward rates and discount ratios are stored as rates x paths
+        matrices, i.e., with the path index running fastest, so that
+        operations on the whole block can be vectorized over paths.
+        The state of a single path can be extracted as a LMMCurveState
+        for products and discounters working on one path at a time.
+    */
+    class LMMBatchCurveState {
+      public:
+        LMMBatchCurveState(const std::vector<Time>& rateTimes,
+                           Size numberOfPaths);
+        //! \name Modifiers
+        //@{
+        void setOnForwardRates(const Matrix& fwdRates,
+                               Size firstValidIndex = 0);
+        //@}
+
+        //! \name Inspectors
+        //@{
+        Size numberOfRates() const { return numberOfRates_; }
+        Size numberOfPaths() const { return numberOfPaths_; }
+        const std::vector<Time>& rateTimes() const { return rateTimes_; }
+        //! rates x paths
+        const Matrix& forwardRates() const { return forwardRates_; }
+        //! (rates+1) x paths, normalized to the first valid rate time
+        const Matrix& discountRatios() const { return discRatios_; }
+        Real discountRatio(Size i, Size j, Size path) const {
+            return discRatios_[i][path]/discRatios_[j][path];
+        }
+        /*! returns the curve state of the given path; the returned
+            reference is reused, and therefore invalidated, by the
+            next call.
+        */
+        const LMMCurveState& pathState(Size path) const;
+        //@}
+      private:
+        std::vector<Time> rateTimes_;
+        std::vector<Time> rateTaus_;
+        Size numberOfRates_, numberOfPaths_, first_;
+        Matrix forwardRates_, discRatios_;
+        mutable LMMCurveState pathState_;
+        mutable std::vector<Rate> pathForwards_;
+    };
+
+}
+
+#endif
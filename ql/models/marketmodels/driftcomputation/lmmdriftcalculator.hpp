@@ -64,6 +64,17 @@ namespace QuantLib {
         void computeReduced(const std::vector<Rate>& fwds,
                             std::vector<Real>& drifts) const;
 
+        /*! \name Batch computation
+            Forwards and drifts of a block of paths are stored as
+            rates x paths matrices, so that the innermost loops run
+            over the paths and can be vectorized.
+        */
+        //@{
+        void compute(const Matrix& fwds, Matrix& drifts) const;
+        void computePlain(const Matrix& fwds, Matrix& drifts) const;
+        void computeReduced(const Matrix& fwds, Matrix& drifts) const;
+        //@}
+
       private:
         Size numberOfRates_, numberOfFactors_;
         bool isFullFactor_;
@@ -74,6 +85,7 @@ namespace QuantLib {
         // temporary variables to be added later
         mutable std::vector<Real> tmp_;
         mutable Matrix e_;
+        mutable Matrix tmpBatch_, eBatch_;
         std::vector<Size> downs_, ups_;
     };
 
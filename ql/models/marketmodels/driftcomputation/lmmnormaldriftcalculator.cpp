@@ -159,4 +159,117 @@ namespace QuantLib {
         }
     }
 
+    void LMMNormalDriftCalculator::compute(const Matrix& fwds,
+                                           Matrix& drifts) const {
+        #if defined(QL_EXTRA_SAFETY_CHECKS)
+            QL_REQUIRE(fwds.rows()==numberOfRates_, "numberOfRates <> dim");
+            QL_REQUIRE(drifts.rows()==numberOfRates_, "drifts.rows() <> dim");
+            QL_REQUIRE(drifts.columns()==fwds.columns(),
+                       "drifts.columns() <> number of paths");
+        #endif
+
+        if (isFullFactor_)
+            computePlain(fwds, drifts);
+        else
+            computeReduced(fwds, drifts);
+    }
+
+    void LMMNormalDriftCalculator::computePlain(const Matrix& forwards,
+                                                Matrix& drifts) const {
+
+        // Same as the single-path version, one path per column.
+        const Size paths = forwards.columns();
+        if (tmpBatch_.rows() != numberOfRates_ ||
+            tmpBatch_.columns() != paths)
+            tmpBatch_ = Matrix(numberOfRates_, paths, 0.0);
+
+        // Precompute forwards factor
+        Size i, j, p;
+        for (i=alive_; i<numberOfRates_; ++i) {
+            const Real* f = forwards[i];
+            Real* t = tmpBatch_[i];
+            for (p=0; p<paths; ++p)
+                t[p] = 1.0/(oneOverTaus_[i]+f[p]);
+        }
+
+        // Compute drifts
+        for (i=alive_; i<numberOfRates_; ++i) {
+            Real* d = drifts[i];
+            std::fill(d, d+paths, 0.0);
+            for (j=downs_[i]; j<ups_[i]; ++j) {
+                const Real* t = tmpBatch_[j];
+                const Real c = C_[i][j];
+                for (p=0; p<paths; ++p)
+                    d[p] += t[p]*c;
+            }
+            if (numeraire_>i+1) {
+                for (p=0; p<paths; ++p)
+                    d[p] = -d[p];
+            }
+        }
+    }
+
+    void LMMNormalDriftCalculator::computeReduced(const Matrix& forwards,
+                                                  Matrix& drifts) const {
+
+        // Same as the single-path version, one path per column; only
+        // the current row of e is needed, so it is kept as a
+        // factors x paths matrix.
+        const Size paths = forwards.columns();
+        if (tmpBatch_.rows() != numberOfRates_ ||
+            tmpBatch_.columns() != paths)
+            tmpBatch_ = Matrix(numberOfRates_, paths, 0.0);
+        if (eBatch_.rows() != numberOfFactors_ ||
+            eBatch_.columns() != paths)
+            eBatch_ = Matrix(numberOfFactors_, paths, 0.0);
+
+        // Precompute forwards factor
+        Size p;
+        for (Size i=alive_; i<numberOfRates_; ++i) {
+            const Real* f = forwards[i];
+            Real* t = tmpBatch_[i];
+            for (p=0; p<paths; ++p)
+                t[p] = 1.0/(oneOverTaus_[i]+f[p]);
+        }
+
+        // 1st step: the drift corresponding to the numeraire is zero.
+        if (numeraire_>0)
+            std::fill(drifts.row_begin(numeraire_-1),
+                      drifts.row_end(numeraire_-1), 0.0);
+
+        // 2nd step: move backward from N-2 (included) back to alive
+        // (included)
+        std::fill(eBatch_.begin(), eBatch_.end(), 0.0);
+        for (Integer i=static_cast<Integer>(numeraire_)-2;
+             i>=static_cast<Integer>(alive_); --i) {
+            Real* d = drifts[i];
+            const Real* t = tmpBatch_[i+1];
+            std::fill(d, d+paths, 0.0);
+            for (Size r=0; r<numberOfFactors_; ++r) {
+                Real* e = eBatch_[r];
+                const Real a = pseudo_[i+1][r], b = pseudo_[i][r];
+                for (p=0; p<paths; ++p) {
+                    e[p] += t[p]*a;
+                    d[p] -= e[p]*b;
+                }
+            }
+        }
+
+        // 3rd step: move forward from N (included) up to n (excluded)
+        std::fill(eBatch_.begin(), eBatch_.end(), 0.0);
+        for (Size i=numeraire_; i<numberOfRates_; ++i) {
+            Real* d = drifts[i];
+            const Real* t = tmpBatch_[i];
+            std::fill(d, d+paths, 0.0);
+            for (Size r=0; r<numberOfFactors_; ++r) {
+                Real* e = eBatch_[r];
+                const Real a = pseudo_[i][r];
+                for (p=0; p<paths; ++p) {
+                    e[p] += t[p]*a;
+                    d[p] += e[p]*a;
+                }
+            }
+        }
+    }
+
 }
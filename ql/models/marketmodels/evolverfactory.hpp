@@ -0,0 +1,74 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file evolverfactory.hpp
+    \brief factory of market-model evolvers
+*/
+
+#ifndef quantlib_market_model_evolver_factory_hpp
+#define quantlib_market_model_evolver_factory_hpp
+
+#include <ql/models/marketmodels/evolver.hpp>
+#include <ql/models/marketmodels/browniangenerator.hpp>
+
+namespace QuantLib {
+
+    class MarketModel;
+
+    //! Market-model evolver factory
+    /*! Abstract base class. Builds an evolver driven by the Brownian
+        generators of the given factory; it allows parallel engines
+        to give each worker its own evolver and random stream.
+    */
+    class MarketModelEvolverFactory {
+      public:
+        virtual ~MarketModelEvolverFactory() {}
+
+        virtual boost::shared_ptr<MarketModelEvolver> create(
+                                  const BrownianGeneratorFactory&) const = 0;
+    };
+
+    //! Factory for evolvers with the usual constructor signature
+    /*! \c Evolver must be constructible as
+        <tt>Evolver(marketModel, generatorFactory, numeraires,
+        initialStep)</tt>, as most of the library evolvers are.
+    */
+    template <class Evolver>
+    class GenericMarketModelEvolverFactory
+        : public MarketModelEvolverFactory {
+      public:
+        GenericMarketModelEvolverFactory(
+                          const boost::shared_ptr<MarketModel>& marketModel,
+                          const std::vector<Size>& numeraires,
+                          Size initialStep = 0)
+        : marketModel_(marketModel), numeraires_(numeraires),
+          initialStep_(initialStep) {}
+        boost::shared_ptr<MarketModelEvolver> create(
+                        const BrownianGeneratorFactory& generatorFactory) const {
+            return boost::shared_ptr<MarketModelEvolver>(
+                new Evolver(marketModel_, generatorFactory,
+                            numeraires_, initialStep_));
+        }
+      private:
+        boost::shared_ptr<MarketModel> marketModel_;
+        std::vector<Size> numeraires_;
+        Size initialStep_;
+    };
+
+}
+
+#endif
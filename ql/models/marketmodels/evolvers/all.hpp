@@ -5,12 +5,16 @@
 #include <ql/models/marketmodels/evolvers/lognormalcotswapratepc.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalfwdrateballand.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalfwdrateeuler.hpp>
+#include <ql/models/marketmodels/evolvers/lognormalfwdrateeulerbatch.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalfwdrateeulerconstrained.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalfwdrateiballand.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalfwdrateipc.hpp>
+#include <ql/models/marketmodels/evolvers/lognormalfwdrateipcbatch.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalfwdratepc.hpp>
+#include <ql/models/marketmodels/evolvers/lognormalfwdratepcbatch.hpp>
 #include <ql/models/marketmodels/evolvers/marketmodelvolprocess.hpp>
 #include <ql/models/marketmodels/evolvers/normalfwdratepc.hpp>
+#include <ql/models/marketmodels/evolvers/normalfwdratepcbatch.hpp>
 #include <ql/models/marketmodels/evolvers/svddfwdratepc.hpp>
 
 #include <ql/models/marketmodels/evolvers/volprocesses/all.hpp>
@@ -0,0 +1,184 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/models/marketmodels/evolvers/lognormalfwdrateipcbatch.hpp>
+#include <ql/models/marketmodels/marketmodel.hpp>
+#include <ql/models/marketmodels/evolutiondescription.hpp>
+
+namespace QuantLib {
+
+    LogNormalFwdRateIpcBatch::LogNormalFwdRateIpcBatch(
+                           const boost::shared_ptr<MarketModel>& marketModel,
+                           const BrownianGeneratorFactory& factory,
+                           const std::vector<Size>& numeraires,
+                           Size numberOfPaths,
+                           Size initialStep)
+    : marketModel_(marketModel),
+      numeraires_(numeraires),
+      initialStep_(initialStep),
+      numberOfRates_(marketModel->numberOfRates()),
+      numberOfFactors_(marketModel->numberOfFactors()),
+      numberOfPaths_(numberOfPaths),
+      brownians_(factory, numberOfFactors_,
+                 marketModel->evolution().numberOfSteps()-initialStep,
+                 numberOfPaths),
+      curveState_(marketModel->evolution().rateTimes(), numberOfPaths),
+      displacements_(marketModel->displacements()),
+      initialLogForwards_(numberOfRates_),
+      forwards_(numberOfRates_, numberOfPaths),
+      logForwards_(numberOfRates_, numberOfPaths),
+      drifts1_(numberOfRates_, numberOfPaths),
+      drifts2_(numberOfRates_, numberOfPaths),
+      g_(numberOfRates_, numberOfPaths),
+      rateTaus_(marketModel->evolution().rateTaus()),
+      initialDrifts_(numberOfRates_), diffusion_(numberOfPaths),
+      alive_(marketModel->evolution().firstAliveRate())
+    {
+        checkCompatibility(marketModel->evolution(), numeraires);
+        QL_REQUIRE(isInTerminalMeasure(marketModel->evolution(), numeraires),
+                   "terminal measure required for ipc ");
+
+        Size steps = marketModel->evolution().numberOfSteps();
+
+        currentStep_ = initialStep_;
+
+        calculators_.reserve(steps);
+        fixedDrifts_.reserve(steps);
+        for (Size j=0; j<steps; ++j) {
+            const Matrix& A = marketModel_->pseudoRoot(j);
+            calculators_.push_back(
+                LMMDriftCalculator(A,
+                                   displacements_,
+                                   marketModel->evolution().rateTaus(),
+                                   numeraires[j],
+                                   alive_[j]));
+            const Matrix& C = marketModel->covariance(j);
+            std::vector<Real> fixed(numberOfRates_);
+            for (Size k=0; k<numberOfRates_; ++k) {
+                Real variance = C[k][k];
+                fixed[k] = -0.5*variance;
+            }
+            fixedDrifts_.push_back(fixed);
+        }
+
+        const std::vector<Rate>& initialRates = marketModel_->initialRates();
+        for (Size i=0; i<numberOfRates_; ++i)
+            std::fill(forwards_.row_begin(i), forwards_.row_end(i),
+                      initialRates[i]);
+        setForwards(marketModel_->initialRates());
+    }
+
+    const std::vector<Size>& LogNormalFwdRateIpcBatch::numeraires() const {
+        return numeraires_;
+    }
+
+    Size LogNormalFwdRateIpcBatch::numberOfPaths() const {
+        return numberOfPaths_;
+    }
+
+    void LogNormalFwdRateIpcBatch::setForwards(const std::vector<Real>& forwards)
+    {
+        QL_REQUIRE(forwards.size()==numberOfRates_,
+                   "mismatch between forwards and rateTimes");
+        for (Size i=0; i<numberOfRates_; ++i)
+            initialLogForwards_[i] = std::log(forwards[i] +
+                                              displacements_[i]);
+        calculators_[initialStep_].compute(forwards, initialDrifts_);
+    }
+
+    void LogNormalFwdRateIpcBatch::setInitialState(const CurveState& cs) {
+        setForwards(cs.forwardRates());
+    }
+
+    const std::vector<Real>& LogNormalFwdRateIpcBatch::startNewBatch() {
+        currentStep_ = initialStep_;
+        for (Size i=0; i<numberOfRates_; ++i)
+            std::fill(logForwards_.row_begin(i), logForwards_.row_end(i),
+                      initialLogForwards_[i]);
+        return brownians_.nextBatch();
+    }
+
+    const std::vector<Real>& LogNormalFwdRateIpcBatch::advanceStep()
+    {
+        // we're going from T1 to T2
+
+        // a) compute drifts D1 at T1;
+        if (currentStep_ > initialStep_) {
+            calculators_[currentStep_].computePlain(forwards_, drifts1_);
+        } else {
+            for (Size i=0; i<numberOfRates_; ++i)
+                std::fill(drifts1_.row_begin(i), drifts1_.row_end(i),
+                          initialDrifts_[i]);
+        }
+
+        Size step = currentStep_-initialStep_;
+        const std::vector<Real>& weights = brownians_.stepWeights(step);
+        const Matrix& z = brownians_.variates(step);
+        const Matrix& A = marketModel_->pseudoRoot(currentStep_);
+        const Matrix& C = marketModel_->covariance(currentStep_);
+        const std::vector<Real>& fixedDrift = fixedDrifts_[currentStep_];
+
+        Size p;
+        Integer alive = alive_[currentStep_];
+        for (Integer i=numberOfRates_-1; i>=alive; --i) {
+            Real* drifts2 = drifts2_[i];
+            std::fill(drifts2, drifts2+numberOfPaths_, 0.0);
+            for (Size j=i+1; j<numberOfRates_; ++j) {
+                const Real c = C[i][j];
+                const Real* g = g_[j];
+                for (p=0; p<numberOfPaths_; ++p)
+                    drifts2[p] -= g[p]*c;
+            }
+            Real* logF = logForwards_[i];
+            Real* f = forwards_[i];
+            Real* g = g_[i];
+            const Real* d1 = drifts1_[i];
+            const Real fixed = fixedDrift[i], d = displacements_[i],
+                       tau = rateTaus_[i];
+            for (p=0; p<numberOfPaths_; ++p)
+                logF[p] += 0.5*(d1[p]+drifts2[p]) + fixed;
+            std::fill(diffusion_.begin(), diffusion_.end(), 0.0);
+            for (Size r=0; r<numberOfFactors_; ++r) {
+                const Real a = A[i][r];
+                const Real* zr = z[r];
+                for (p=0; p<numberOfPaths_; ++p)
+                    diffusion_[p] += a*zr[p];
+            }
+            for (p=0; p<numberOfPaths_; ++p) {
+                logF[p] += diffusion_[p];
+                f[p] = std::exp(logF[p]) - d;
+                g[p] = tau*(f[p]+d)/(1.0+tau*f[p]);
+            }
+        }
+
+        // update curve state
+        curveState_.setOnForwardRates(forwards_);
+
+        ++currentStep_;
+
+        return weights;
+    }
+
+    Size LogNormalFwdRateIpcBatch::currentStep() const {
+        return currentStep_;
+    }
+
+    const LMMBatchCurveState& LogNormalFwdRateIpcBatch::currentState() const {
+        return curveState_;
+    }
+
+}
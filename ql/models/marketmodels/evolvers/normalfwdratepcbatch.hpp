@@ -0,0 +1,73 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#ifndef quantlib_nm_forward_rate_pc_batch_evolver_hpp
+#define quantlib_nm_forward_rate_pc_batch_evolver_hpp
+
+#include <ql/models/marketmodels/batchevolver.hpp>
+#include <ql/models/marketmodels/curvestates/lmmbatchcurvestate.hpp>
+#include <ql/models/marketmodels/driftcomputation/lmmnormaldriftcalculator.hpp>
+
+namespace QuantLib {
+
+    class MarketModel;
+
+    //! Predictor-Corrector for normal forward rates on a block of paths
+    /*! Same scheme as NormalFwdRatePc; the paths drawn by the given
+        generator are the same as the ones drawn by NormalFwdRatePc.
+    */
+    class NormalFwdRatePcBatch : public MarketModelBatchEvolver {
+      public:
+        NormalFwdRatePcBatch(const boost::shared_ptr<MarketModel>&,
+                             const BrownianGeneratorFactory&,
+                             const std::vector<Size>& numeraires,
+                             Size numberOfPaths,
+                             Size initialStep = 0);
+        //! \name MarketModelBatchEvolver interface
+        //@{
+        const std::vector<Size>& numeraires() const;
+        Size numberOfPaths() const;
+        const std::vector<Real>& startNewBatch();
+        const std::vector<Real>& advanceStep();
+        Size currentStep() const;
+        const LMMBatchCurveState& currentState() const;
+        void setInitialState(const CurveState&);
+        //@}
+      private:
+        void setForwards(const std::vector<Real>& forwards);
+        // inputs
+        boost::shared_ptr<MarketModel> marketModel_;
+        std::vector<Size> numeraires_;
+        Size initialStep_;
+        // fixed variables
+        // working variables
+        Size numberOfRates_, numberOfFactors_, numberOfPaths_;
+        BrownianBatch brownians_;
+        LMMBatchCurveState curveState_;
+        Size currentStep_;
+        std::vector<Rate> initialForwards_;
+        Matrix forwards_;
+        Matrix drifts1_, drifts2_;
+        std::vector<Real> initialDrifts_, diffusion_;
+        std::vector<Size> alive_;
+        // helper classes
+        std::vector<LMMNormalDriftCalculator> calculators_;
+    };
+
+}
+
+#endif
@@ -0,0 +1,309 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/models/marketmodels/parallelaccountingengine.hpp>
+#include <ql/models/marketmodels/accountingengine.hpp>
+#include <ql/models/marketmodels/pathwiseaccountingengine.hpp>
+#include <ql/models/marketmodels/proxygreekengine.hpp>
+#include <ql/models/marketmodels/constrainedevolver.hpp>
+#include <ql/models/marketmodels/evolvers/lognormalfwdrateeuler.hpp>
+#include <ql/models/marketmodels/evolutiondescription.hpp>
+#include <ql/models/marketmodels/marketmodel.hpp>
+#include <algorithm>
+
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
+namespace QuantLib {
+
+    namespace detail {
+
+        ParallelMarketModelSimulation::ParallelMarketModelSimulation(
+            const boost::shared_ptr<BrownianGeneratorStreamFactory>&
+                                                             generatorStreams,
+            Size batchSize)
+        : generatorStreams_(generatorStreams), batchSize_(batchSize),
+          nextStream_(0) {
+            QL_REQUIRE(generatorStreams_, "no generator streams given");
+            QL_REQUIRE(batchSize_ > 0, "null batch size");
+        }
+
+        Size ParallelMarketModelSimulation::simulateRound(
+                                Size remainingPaths,
+                                std::vector<MarketModelPathBatch>& batches) {
+            #if defined(_OPENMP)
+            const Size workers = omp_get_max_threads();
+            #else
+            const Size workers = 1;
+            #endif
+            const Size n = std::min(workers,
+                                    (remainingPaths+batchSize_-1)/batchSize_);
+            batches.resize(n);
+
+            std::vector<boost::shared_ptr<BrownianGeneratorFactory> >
+                                                              generators(n);
+            Size simulated = 0;
+            for (Size i=0; i<n; ++i) {
+                generators[i] =
+                    generatorStreams_->stream(nextStream_+i, batchSize_);
+                batches[i].paths =
+                    std::min(batchSize_, remainingPaths-simulated);
+                batches[i].error.clear();
+                simulated += batches[i].paths;
+            }
+
+            #pragma omp parallel for schedule(static,1)
+            for (long i=0; i<long(n); ++i) {
+                // exceptions must not escape the parallel region
+                try {
+                    simulateBatch(*generators[i], batches[i]);
+                } catch (std::exception& e) {
+                    batches[i].error = e.what();
+                } catch (...) {
+                    batches[i].error = "unknown error";
+                }
+            }
+
+            for (Size i=0; i<n; ++i)
+                QL_REQUIRE(batches[i].error.empty(), batches[i].error);
+
+            nextStream_ += n;
+            return simulated;
+        }
+
+    }
+
+
+    ParallelAccountingEngine::ParallelAccountingEngine(
+            const boost::shared_ptr<MarketModelEvolverFactory>& evolverFactory,
+            const boost::shared_ptr<BrownianGeneratorStreamFactory>&
+                                                             generatorStreams,
+            const Clone<MarketModelMultiProduct>& product,
+            Real initialNumeraireValue,
+            Size batchSize)
+    : detail::ParallelMarketModelSimulation(generatorStreams, batchSize),
+      evolverFactory_(evolverFactory), product_(product),
+      initialNumeraireValue_(initialNumeraireValue) {}
+
+    void ParallelAccountingEngine::simulateBatch(
+                                const BrownianGeneratorFactory& generator,
+                                detail::MarketModelPathBatch& batch) const {
+        AccountingEngine engine(evolverFactory_->create(generator),
+                                product_, initialNumeraireValue_);
+        Size N = product_->numberOfProducts();
+        std::vector<Real> values(N);
+        batch.values.resize(batch.paths*N);
+        batch.weights.resize(batch.paths);
+        for (Size i=0; i<batch.paths; ++i) {
+            batch.weights[i] = engine.singlePathValues(values);
+            std::copy(values.begin(), values.end(),
+                      batch.values.begin()+i*N);
+        }
+    }
+
+    void ParallelAccountingEngine::multiplePathValues(
+                                                SequenceStatisticsInc& stats,
+                                                Size numberOfPaths) {
+        Size N = product_->numberOfProducts();
+        std::vector<detail::MarketModelPathBatch> batches;
+        Size done = 0;
+        while (done < numberOfPaths) {
+            done += simulateRound(numberOfPaths-done, batches);
+            for (Size k=0; k<batches.size(); ++k) {
+                const detail::MarketModelPathBatch& batch = batches[k];
+                for (Size i=0; i<batch.paths; ++i)
+                    stats.add(batch.values.begin()+i*N,
+                              batch.values.begin()+(i+1)*N,
+                              batch.weights[i]);
+            }
+        }
+    }
+
+
+    ParallelPathwiseAccountingEngine::ParallelPathwiseAccountingEngine(
+            const boost::shared_ptr<MarketModelEvolverFactory>& evolverFactory,
+            const boost::shared_ptr<BrownianGeneratorStreamFactory>&
+                                                             generatorStreams,
+            const Clone<MarketModelPathwiseMultiProduct>& product,
+            const boost::shared_ptr<MarketModel>& pseudoRootStructure,
+            Real initialNumeraireValue,
+            Size batchSize)
+    : detail::ParallelMarketModelSimulation(generatorStreams, batchSize),
+      evolverFactory_(evolverFactory), product_(product),
+      pseudoRootStructure_(pseudoRootStructure),
+      initialNumeraireValue_(initialNumeraireValue) {}
+
+    void ParallelPathwiseAccountingEngine::simulateBatch(
+                                const BrownianGeneratorFactory& generator,
+                                detail::MarketModelPathBatch& batch) const {
+        boost::shared_ptr<LogNormalFwdRateEuler> evolver =
+            boost::dynamic_pointer_cast<LogNormalFwdRateEuler>(
+                                          evolverFactory_->create(generator));
+        QL_REQUIRE(evolver, "LogNormalFwdRateEuler evolver required");
+        PathwiseAccountingEngine engine(evolver, product_,
+                                        pseudoRootStructure_,
+                                        initialNumeraireValue_);
+        Size N = product_->numberOfProducts() *
+                 (pseudoRootStructure_->numberOfRates()+1);
+        std::vector<Real> values(N);
+        batch.values.resize(batch.paths*N);
+        batch.weights.resize(batch.paths);
+        for (Size i=0; i<batch.paths; ++i) {
+            batch.weights[i] = engine.singlePathValues(values);
+            std::copy(values.begin(), values.end(),
+                      batch.values.begin()+i*N);
+        }
+    }
+
+    void ParallelPathwiseAccountingEngine::multiplePathValues(
+                                                SequenceStatisticsInc& stats,
+                                                Size numberOfPaths) {
+        Size N = product_->numberOfProducts() *
+                 (pseudoRootStructure_->numberOfRates()+1);
+        std::vector<detail::MarketModelPathBatch> batches;
+        Size done = 0;
+        while (done < numberOfPaths) {
+            done += simulateRound(numberOfPaths-done, batches);
+            for (Size k=0; k<batches.size(); ++k) {
+                const detail::MarketModelPathBatch& batch = batches[k];
+                for (Size i=0; i<batch.paths; ++i)
+                    stats.add(batch.values.begin()+i*N,
+                              batch.values.begin()+(i+1)*N,
+                              batch.weights[i]);
+            }
+        }
+    }
+
+
+    ParallelProxyGreekEngine::ParallelProxyGreekEngine(
+            const boost::shared_ptr<MarketModelEvolverFactory>& evolverFactory,
+            const std::vector<std::vector<
+                boost::shared_ptr<MarketModelEvolverFactory> > >&
+                                                constrainedEvolverFactories,
+            const std::vector<std::vector<std::vector<Real> > >& diffWeights,
+            const std::vector<Size>& startIndexOfConstraint,
+            const std::vector<Size>& endIndexOfConstraint,
+            const boost::shared_ptr<BrownianGeneratorStreamFactory>&
+                                                             generatorStreams,
+            const Clone<MarketModelMultiProduct>& product,
+            Real initialNumeraireValue,
+            Size batchSize)
+    : detail::ParallelMarketModelSimulation(generatorStreams, batchSize),
+      evolverFactory_(evolverFactory),
+      constrainedEvolverFactories_(constrainedEvolverFactories),
+      diffWeights_(diffWeights),
+      startIndexOfConstraint_(startIndexOfConstraint),
+      endIndexOfConstraint_(endIndexOfConstraint),
+      product_(product), initialNumeraireValue_(initialNumeraireValue),
+      numberOfModifiedValues_(0) {
+        for (Size i=0; i<constrainedEvolverFactories_.size(); ++i)
+            numberOfModifiedValues_ += constrainedEvolverFactories_[i].size();
+    }
+
+    void ParallelProxyGreekEngine::simulateBatch(
+                                const BrownianGeneratorFactory& generator,
+                                detail::MarketModelPathBatch& batch) const {
+        Size N = product_->numberOfProducts();
+
+        // all evolvers of a worker share the same random stream
+        std::vector<std::vector<boost::shared_ptr<ConstrainedEvolver> > >
+            constrainedEvolvers(constrainedEvolverFactories_.size());
+        std::vector<std::vector<std::vector<Real> > >
+            modifiedValues(constrainedEvolverFactories_.size());
+        for (Size i=0; i<constrainedEvolverFactories_.size(); ++i) {
+            for (Size j=0; j<constrainedEvolverFactories_[i].size(); ++j) {
+                boost::shared_ptr<ConstrainedEvolver> evolver =
+                    boost::dynamic_pointer_cast<ConstrainedEvolver>(
+                       constrainedEvolverFactories_[i][j]->create(generator));
+                QL_REQUIRE(evolver, "constrained evolver required");
+                evolver->setConstraintType(startIndexOfConstraint_,
+                                           endIndexOfConstraint_);
+                constrainedEvolvers[i].push_back(evolver);
+            }
+            modifiedValues[i].resize(constrainedEvolvers[i].size(),
+                                     std::vector<Real>(N));
+        }
+        ProxyGreekEngine engine(evolverFactory_->create(generator),
+                                constrainedEvolvers, diffWeights_,
+                                startIndexOfConstraint_,
+                                endIndexOfConstraint_,
+                                product_, initialNumeraireValue_);
+
+        // each path stores the original values followed by the
+        // modified ones
+        Size M = N*(1+numberOfModifiedValues_);
+        std::vector<Real> values(N);
+        batch.values.resize(batch.paths*M);
+        batch.weights.assign(batch.paths, 1.0);
+        for (Size p=0; p<batch.paths; ++p) {
+            engine.singlePathValues(values, modifiedValues);
+            std::vector<Real>::iterator out = batch.values.begin()+p*M;
+            out = std::copy(values.begin(), values.end(), out);
+            for (Size i=0; i<modifiedValues.size(); ++i)
+                for (Size j=0; j<modifiedValues[i].size(); ++j)
+                    out = std::copy(modifiedValues[i][j].begin(),
+                                    modifiedValues[i][j].end(), out);
+        }
+    }
+
+    void ParallelProxyGreekEngine::multiplePathValues(
+                  SequenceStatisticsInc& stats,
+                  std::vector<std::vector<SequenceStatisticsInc> >& modifiedStats,
+                  Size numberOfPaths) {
+        Size N = product_->numberOfProducts();
+        Size M = N*(1+numberOfModifiedValues_);
+
+        // offset of the modified values of each evolver group
+        std::vector<Size> offsets(constrainedEvolverFactories_.size());
+        Size offset = N;
+        for (Size j=0; j<offsets.size(); ++j) {
+            offsets[j] = offset;
+            offset += N*constrainedEvolverFactories_[j].size();
+        }
+
+        std::vector<Real> results(N);
+        std::vector<detail::MarketModelPathBatch> batches;
+        Size done = 0;
+        while (done < numberOfPaths) {
+            done += simulateRound(numberOfPaths-done, batches);
+            for (Size b=0; b<batches.size(); ++b) {
+                const detail::MarketModelPathBatch& batch = batches[b];
+                for (Size p=0; p<batch.paths; ++p) {
+                    std::vector<Real>::const_iterator values =
+                        batch.values.begin()+p*M;
+                    stats.add(values, values+N);
+
+                    for (Size j=0; j<diffWeights_.size(); ++j) {
+                        for (Size k=0; k<diffWeights_[j].size(); ++k) {
+                            const std::vector<Real>& weights =
+                                diffWeights_[j][k];
+                            for (Size l=0; l<N; ++l) {
+                                results[l] = weights[0]*values[l];
+                                for (Size n=1; n<weights.size(); ++n)
+                                    results[l] += weights[n] *
+                                        values[offsets[j]+(n-1)*N+l];
+                            }
+                            modifiedStats[j][k].add(results);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+}
@@ -0,0 +1,174 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file parallelaccountingengine.hpp
+    \brief multi-threaded engines collecting cash flows along
+           market-model simulations
+*/
+
+#ifndef quantlib_parallel_accounting_engine_hpp
+#define quantlib_parallel_accounting_engine_hpp
+
+#include <ql/models/marketmodels/multiproduct.hpp>
+#include <ql/models/marketmodels/pathwisemultiproduct.hpp>
+#include <ql/models/marketmodels/evolverfactory.hpp>
+#include <ql/math/statistics/sequencestatistics.hpp>
+#include <ql/utilities/clone.hpp>
+#include <string>
+#include <vector>
+
+namespace QuantLib {
+
+    class MarketModel;
+
+    namespace detail {
+
+        //! buffered results of a batch of simulated paths
+        struct MarketModelPathBatch {
+            Size paths;
+            std::vector<Real> values, weights;
+            std::string error;
+        };
+
+        //! common machinery of the parallel market-model engines
+        /*! Paths are simulated in batches of fixed size.  The i-th
+            batch ever simulated by an engine uses the i-th generator
+            stream and its own evolver and product clones; batches
+            are run in parallel rounds (one batch per OpenMP thread)
+            and their results are returned in batch order, so that
+            the collected statistics do not depend on the number of
+            threads.
+        */
+        class ParallelMarketModelSimulation {
+          public:
+            virtual ~ParallelMarketModelSimulation() {}
+          protected:
+            ParallelMarketModelSimulation(
+                const boost::shared_ptr<BrownianGeneratorStreamFactory>&,
+                Size batchSize);
+            /*! simulates the next round of batches, covering at most
+                \c remainingPaths paths, and returns the number of
+                paths simulated.
+            */
+            Size simulateRound(Size remainingPaths,
+                               std::vector<MarketModelPathBatch>& batches);
+            virtual void simulateBatch(const BrownianGeneratorFactory&,
+                                       MarketModelPathBatch&) const = 0;
+          private:
+            boost::shared_ptr<BrownianGeneratorStreamFactory>
+                                                          generatorStreams_;
+            Size batchSize_, nextStream_;
+        };
+
+    }
+
+    //! Multi-threaded version of AccountingEngine
+    /*! Each worker uses its own evolver, built by the given factory on
+        an independent Brownian-generator stream, and its own clone of
+        the product and of the discounters.
+
+        \note With Sobol streams, the drawn paths are the same as the
+              ones drawn by a serial engine using a Sobol generator
+              with the same settings.
+    */
+    class ParallelAccountingEngine
+        : public detail::ParallelMarketModelSimulation {
+      public:
+        ParallelAccountingEngine(
+            const boost::shared_ptr<MarketModelEvolverFactory>& evolverFactory,
+            const boost::shared_ptr<BrownianGeneratorStreamFactory>&
+                                                             generatorStreams,
+            const Clone<MarketModelMultiProduct>& product,
+            Real initialNumeraireValue,
+            Size batchSize = 1024);
+        void multiplePathValues(SequenceStatisticsInc& stats,
+                                Size numberOfPaths);
+      private:
+        void simulateBatch(const BrownianGeneratorFactory&,
+                           detail::MarketModelPathBatch&) const;
+        boost::shared_ptr<MarketModelEvolverFactory> evolverFactory_;
+        Clone<MarketModelMultiProduct> product_;
+        Real initialNumeraireValue_;
+    };
+
+    //! Multi-threaded version of PathwiseAccountingEngine
+    /*! The evolver factory must create LogNormalFwdRateEuler
+        instances.
+    */
+    class ParallelPathwiseAccountingEngine
+        : public detail::ParallelMarketModelSimulation {
+      public:
+        ParallelPathwiseAccountingEngine(
+            const boost::shared_ptr<MarketModelEvolverFactory>& evolverFactory,
+            const boost::shared_ptr<BrownianGeneratorStreamFactory>&
+                                                             generatorStreams,
+            const Clone<MarketModelPathwiseMultiProduct>& product,
+            const boost::shared_ptr<MarketModel>& pseudoRootStructure,
+            Real initialNumeraireValue,
+            Size batchSize = 1024);
+        void multiplePathValues(SequenceStatisticsInc& stats,
+                                Size numberOfPaths);
+      private:
+        void simulateBatch(const BrownianGeneratorFactory&,
+                           detail::MarketModelPathBatch&) const;
+        boost::shared_ptr<MarketModelEvolverFactory> evolverFactory_;
+        Clone<MarketModelPathwiseMultiProduct> product_;
+        boost::shared_ptr<MarketModel> pseudoRootStructure_;
+        Real initialNumeraireValue_;
+    };
+
+    //! Multi-threaded version of ProxyGreekEngine
+    /*! The constrained-evolver factories must create ConstrainedEvolver
+        instances; the engine sets their constraint type.
+    */
+    class ParallelProxyGreekEngine
+        : public detail::ParallelMarketModelSimulation {
+      public:
+        ParallelProxyGreekEngine(
+            const boost::shared_ptr<MarketModelEvolverFactory>& evolverFactory,
+            const std::vector<std::vector<
+                boost::shared_ptr<MarketModelEvolverFactory> > >&
+                                                constrainedEvolverFactories,
+            const std::vector<std::vector<std::vector<Real> > >& diffWeights,
+            const std::vector<Size>& startIndexOfConstraint,
+            const std::vector<Size>& endIndexOfConstraint,
+            const boost::shared_ptr<BrownianGeneratorStreamFactory>&
+                                                             generatorStreams,
+            const Clone<MarketModelMultiProduct>& product,
+            Real initialNumeraireValue,
+            Size batchSize = 1024);
+        void multiplePathValues(
+                  SequenceStatisticsInc& stats,
+                  std::vector<std::vector<SequenceStatisticsInc> >& modifiedStats,
+                  Size numberOfPaths);
+      private:
+        void simulateBatch(const BrownianGeneratorFactory&,
+                           detail::MarketModelPathBatch&) const;
+        boost::shared_ptr<MarketModelEvolverFactory> evolverFactory_;
+        std::vector<std::vector<boost::shared_ptr<MarketModelEvolverFactory> > >
+            constrainedEvolverFactories_;
+        std::vector<std::vector<std::vector<Real> > > diffWeights_;
+        std::vector<Size> startIndexOfConstraint_;
+        std::vector<Size> endIndexOfConstraint_;
+        Clone<MarketModelMultiProduct> product_;
+        Real initialNumeraireValue_;
+        Size numberOfModifiedValues_;
+    };
+
+}
+
+#endif
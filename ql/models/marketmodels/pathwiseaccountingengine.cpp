@@ -1192,13 +1192,398 @@ namespace QuantLib {
 
         } // end of method
 
-} // end of namespace
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+    PathwiseVegasAdjointAccountingEngine::PathwiseVegasAdjointAccountingEngine(
+        const boost::shared_ptr<LogNormalFwdRateEuler>& evolver, // method relies heavily on LMM Euler
+        const Clone<MarketModelPathwiseMultiProduct>& product,
+        const boost::shared_ptr<MarketModel>& pseudoRootStructure, // we need pseudo-roots and displacements
+        const std::vector<std::vector<Matrix> >& vegaBumps,
+        Real initialNumeraireValue)
+        : evolver_(evolver),
+        product_(product),
+        pseudoRootStructure_(pseudoRootStructure),
+        initialNumeraireValue_(initialNumeraireValue),
+        numberProducts_(product->numberOfProducts()),
+        numberRates_(pseudoRootStructure->numberOfRates()),
+        numberSteps_(pseudoRootStructure->numberOfSteps()),
+        factors_(pseudoRootStructure->numberOfFactors()),
+        numberBumps_(vegaBumps.empty() ? 0 : vegaBumps[0].size()),
+        doDeflation_(!product->alreadyDeflated()),
+        numerairesHeld_(product->numberOfProducts()),
+        numberCashFlowsThisStep_(product->numberOfProducts()),
+        cashFlowsGenerated_(product->numberOfProducts()),
+        driftFactors_(pseudoRootStructure->numberOfRates()),
+        driftFactorDerivatives_(pseudoRootStructure->numberOfRates()),
+        W_(pseudoRootStructure->numberOfRates()),
+        E_(pseudoRootStructure->numberOfFactors()),
+        deflatorAndDerivatives_(pseudoRootStructure->numberOfRates()+1)
+    {
+        const EvolutionDescription& evolution = pseudoRootStructure_->evolution();
+
+        QL_REQUIRE(isInMoneyMarketMeasure(evolution, evolver_->numeraires()),
+                   "the adjoint pathwise engine requires the discretely compounding money-market measure");
+
+        taus_ = evolution.rateTaus();
+        displacements_ = pseudoRootStructure_->displacements();
+        alive_ = evolution.firstAliveRate();
+
+        numberElementaryVegas_ = numberSteps_*numberRates_*factors_;
+
+        // the bumps are usually sparse, so we only keep their non-zero entries
+        QL_REQUIRE(vegaBumps.empty() || vegaBumps.size() == numberSteps_,
+                   "we need either no vega bumps or precisely one vector of vega bumps for each step.");
+
+        bumpEntries_.resize(numberBumps_);
+
+        for (Size t=0; t < vegaBumps.size(); ++t)
+        {
+            QL_REQUIRE(vegaBumps[t].size() == numberBumps_,
+                       "We must have precisely the same number of bumps for each step.");
+
+            for (Size b=0; b < numberBumps_; ++b)
+            {
+                const Matrix& bump = vegaBumps[t][b];
+                QL_REQUIRE(bump.rows() == numberRates_ && bump.columns() == factors_,
+                           "vega bump " << b << " at step " << t << " is a " << bump.rows() << "x" << bump.columns()
+                           << " matrix, " << numberRates_ << "x" << factors_ << " expected");
+
+                for (Size r=0; r < numberRates_; ++r)
+                    for (Size f=0; f < factors_; ++f)
+                        if (bump[r][f] != 0.0)
+                            bumpEntries_[b].push_back(std::make_pair(t*numberRates_*factors_+r*factors_+f, bump[r][f]));
+            }
+        }
+
+        Matrix VModel(numberSteps_+1,numberRates_);
+
+        V_.reserve(numberProducts_);
+
+        Matrix  modelCashFlowIndex(product_->possibleCashFlowTimes().size(), numberRates_+1);
+
+        numberCashFlowsThisIndex_.resize(numberProducts_);
+
+        for (Size i=0; i<numberProducts_; ++i)
+        {
+            cashFlowsGenerated_[i].resize(
+                product_->maxNumberOfCashFlowsPerProductPerStep());
+
+            for (Size j=0; j < cashFlowsGenerated_[i].size(); ++j)
+                cashFlowsGenerated_[i][j].amount.resize(numberRates_+1);
+
+            numberCashFlowsThisIndex_[i].resize(product_->possibleCashFlowTimes().size());
+
+            V_.push_back(VModel);
+
+            totalCashFlowsThisIndex_.push_back(modelCashFlowIndex);
+        }
+
+        LIBORRates_ = VModel;
+
+        Discounts_ = Matrix(numberSteps_+1,numberRates_+1);
+        for (Size i=0; i <= numberSteps_; ++i)
+            Discounts_[i][0] = 1.0;
+
+        gaussians_ = Matrix(numberSteps_, factors_);
+        partials_ = Matrix(factors_, numberRates_);
+
+        elementaryValues_.resize(numberProducts_*(1+numberRates_+numberElementaryVegas_));
+
+        const std::vector<Time>& cashFlowTimes =
+            product_->possibleCashFlowTimes();
+        numberCashFlowTimes_ = cashFlowTimes.size();
+
+        const std::vector<Time>& rateTimes = product_->evolution().rateTimes();
+        const std::vector<Time>& evolutionTimes = product_->evolution().evolutionTimes();
+        discounters_.reserve(cashFlowTimes.size());
+
+        for (Size j=0; j<cashFlowTimes.size(); ++j)
+            discounters_.push_back(MarketModelPathwiseDiscounter(cashFlowTimes[j],
+            rateTimes));
+
+        // allocate cash-flow times to steps, i.e. what is the last step completed before a flow occurs
+
+        cashFlowIndicesThisStep_.resize(numberSteps_);
+
+        for (Size i=0; i < numberCashFlowTimes_; ++i)
+        {
+            std::vector<Time>::const_iterator it = std::upper_bound( evolutionTimes.begin(), evolutionTimes.end(), cashFlowTimes[i]);
+            if (it != evolutionTimes.begin())
+                --it;
+            Size index = it - evolutionTimes.begin();
+            cashFlowIndicesThisStep_[index].push_back(i);
+        }
+    }
+
+    void PathwiseVegasAdjointAccountingEngine::singlePathValues(std::vector<Real>& values)
+    {
+        const std::vector<Real>& initialForwards = pseudoRootStructure_->initialRates();
+        std::copy(initialForwards.begin(), initialForwards.end(), LIBORRates_.row_begin(0));
+
+        // clear accumulation variables
+        for (Size i=0; i < numberProducts_; ++i)
+        {
+            numerairesHeld_[i]=0.0;
+
+            for (Size j=0; j < numberCashFlowTimes_; ++j)
+            {
+                numberCashFlowsThisIndex_[i][j] =0;
+
+                for (Size k=0; k <= numberRates_; ++k)
+                    totalCashFlowsThisIndex_[i][j][k] =0.0;
+            }
+
+            std::fill(V_[i].begin(), V_[i].end(), 0.0);
+        }
+
+        std::fill(values.begin(), values.end(), 0.0);
+
+        Real weight = evolver_->startNewPath();
+        product_->reset();
+
+        Size thisStep;
+
+        bool done = false;
+        do
+        {
+            thisStep = evolver_->currentStep();
+            Size storeStep = thisStep+1;
+            weight *= evolver_->advanceStep();
+
+            done = product_->nextTimeStep(evolver_->currentState(),
+                numberCashFlowsThisStep_,
+                cashFlowsGenerated_);
+
+            const CurveState& curveState = evolver_->currentState();
+            const std::vector<Rate>& currentForwards = curveState.forwardRates();
+
+            for (Size i=0; i < numberRates_; ++i)
+            {
+                LIBORRates_[storeStep][i] = currentForwards[i];
+                Discounts_[storeStep][i+1] = curveState.discountRatio(i+1,0);
+            }
+
+            const std::vector<Real>& brownians = evolver_->browniansThisStep();
+            std::copy(brownians.begin(), brownians.end(), gaussians_.row_begin(thisStep));
+
+            // for each product...
+            for (Size i=0; i<numberProducts_; ++i)
+            {
+                // ...and each cash flow...
+                for (Size j=0; j<numberCashFlowsThisStep_[i]; ++j)
+                {
+                    Size k = cashFlowsGenerated_[i][j].timeIndex;
+                    ++numberCashFlowsThisIndex_[i][ k];
+
+                    for (Size l=0; l <= numberRates_; ++l)
+                        totalCashFlowsThisIndex_[i][k][l] += cashFlowsGenerated_[i][j].amount[l]*weight;
+                }
+            }
+
+        } while (!done);
+
+        // cash-flows gathered, now go backwards through the steps
+
+        Size entriesPerProduct = 1+numberRates_+numberElementaryVegas_;
+
+        bool flowsFound = false;
 
+        Integer finalStepDone = thisStep;
+
+        for (Integer currentStep =  numberSteps_-1; currentStep >=0 ; --currentStep) // must be a signed type as we go negative
+        {
+            Integer stepToUse = std::min<Integer>(currentStep, finalStepDone)+1;
+
+            for (Size k=0; k < cashFlowIndicesThisStep_[currentStep].size(); ++k)
+            {
+                Size cashFlowIndex =cashFlowIndicesThisStep_[currentStep][k];
+
+                // first check to see if anything actually happened before spending time on computing stuff
+                bool noFlows = true;
+                for (Size l=0; l < numberProducts_ && noFlows; ++l)
+                    noFlows = noFlows && (numberCashFlowsThisIndex_[l][cashFlowIndex] ==0);
+
+                flowsFound = flowsFound || !noFlows;
 
+                if (!noFlows)
+                {
+                    if (doDeflation_)
+                        discounters_[cashFlowIndex].getFactors(LIBORRates_, Discounts_,stepToUse, deflatorAndDerivatives_); // get amount to discount cash flow by and amount to multiply its derivatives by
 
+                    for (Size j=0; j < numberProducts_; ++j)
+                    {
+                        if (numberCashFlowsThisIndex_[j][cashFlowIndex] > 0)
+                        {
+                            Real deflatedCashFlow = totalCashFlowsThisIndex_[j][cashFlowIndex][0];
+                            if (doDeflation_)
+                                deflatedCashFlow *= deflatorAndDerivatives_[0];
+                            numerairesHeld_[j] += deflatedCashFlow;
 
+                            for (Size i=1; i <= numberRates_; ++i)
+                            {
+                                Real thisDerivative =  totalCashFlowsThisIndex_[j][cashFlowIndex][i];
+                                if (doDeflation_)
+                                {
+                                    thisDerivative *= deflatorAndDerivatives_[0];
+                                    thisDerivative +=  totalCashFlowsThisIndex_[j][cashFlowIndex][0]*deflatorAndDerivatives_[i];
+                                }
 
+                                V_[j][stepToUse][i-1] += thisDerivative; // zeroth row of V is t =0 not t_0
+                            }
+                        }
+                    }
+                }
+            }
 
+            // V_[.][currentStep+1] is now complete if the step was simulated:
+            // apply the adjoint of the step and read off the vegas
+            if (flowsFound && currentStep <= finalStepDone)
+            {
+                Size step = currentStep;
+                Size alive = alive_[step];
+                const Matrix& A = pseudoRootStructure_->pseudoRoot(step);
+                const Real* oldRates = LIBORRates_[step];
+                const Real* newRates = LIBORRates_[step+1];
+                const Real* Z = gaussians_[step];
+
+                // the drift of rate j is sum_{k=alive}^{j} g_k C_jk with
+                // g_k = tau_k (L_k+d_k)/(1+tau_k L_k) at the start of the step
+                for (Size k=alive; k < numberRates_; ++k)
+                {
+                    Real oneOverDF = 1.0+taus_[k]*oldRates[k];
+                    driftFactors_[k] = taus_[k]*(oldRates[k]+displacements_[k])/oneOverDF;
+                    driftFactorDerivatives_[k] = taus_[k]*(1.0-taus_[k]*displacements_[k])/(oneOverDF*oneOverDF);
+                }
 
+                for (Size i=0; i < numberProducts_; ++i)
+                {
+                    Real* Vnew = V_[i][step+1];
+                    Real* Vold = V_[i][step];
 
+                    // W_j = dP/dL_j (L_j+d_j) is the adjoint of the log-rate at the end of the step;
+                    // partials_[f][k] = sum_{j>=k} W_j A_jf
+                    for (Size k=alive; k < numberRates_; ++k)
+                        W_[k] = Vnew[k]*(newRates[k]+displacements_[k]);
 
+                    for (Size f=0; f < factors_; ++f)
+                    {
+                        Real sum = 0.0;
+                        for (Integer k=numberRates_-1; k >= static_cast<Integer>(alive); --k)
+                        {
+                            sum += W_[k]*A[k][f];
+                            partials_[f][k] = sum;
+                        }
+                    }
+
+                    // rates that have already reset are frozen
+                    for (Size k=0; k < alive; ++k)
+                        Vold[k] = Vnew[k];
+
+                    for (Size k=alive; k < numberRates_; ++k)
+                    {
+                        Real summandTerm = 0.0;
+                        for (Size f=0; f < factors_; ++f)
+                            summandTerm += A[k][f]*partials_[f][k];
+
+                        Vold[k] = Vnew[k]*(newRates[k]+displacements_[k])/(oldRates[k]+displacements_[k])
+                                + driftFactorDerivatives_[k]*summandTerm;
+                    }
+
+                    // the pseudo-root element A_mf enters the drifts of rates m,...,n-1,
+                    // the variance correction and the diffusion of rate m only
+                    Real* vegas = &values[i*entriesPerProduct+1+numberRates_+step*numberRates_*factors_];
+
+                    for (Size f=0; f < factors_; ++f)
+                    {
+                        Real e = 0.0; // sum_{k=alive}^{m-1} g_k A_kf
+                        for (Size m=alive; m < numberRates_; ++m)
+                        {
+                            Real a = A[m][f];
+                            vegas[m*factors_+f] = (W_[m]*(e + (driftFactors_[m]-1.0)*a + Z[f])
+                                                   + driftFactors_[m]*partials_[f][m])*initialNumeraireValue_;
+                            e += driftFactors_[m]*a;
+                        }
+                    }
+                }
+            }
+        }
+
+        // write prices and deltas into values
+
+        for (Size i=0; i < numberProducts_; ++i)
+        {
+            values[i*entriesPerProduct] = numerairesHeld_[i]*initialNumeraireValue_;
+            for (Size j=0; j < numberRates_; ++j)
+                values[i*entriesPerProduct+1+j] = V_[i][0][j]*initialNumeraireValue_;
+        }
+    }
+
+    void PathwiseVegasAdjointAccountingEngine::accumulateValues(std::vector<Real>& means,
+                                                                std::vector<Real>& errors,
+                                                                Size numberOfPaths,
+                                                                bool elementary)
+    {
+        Size inDataPerProduct = 1+numberRates_+numberElementaryVegas_;
+        Size outDataPerProduct = elementary ? inDataPerProduct : 1+numberRates_+numberBumps_;
+
+        std::vector<Real> values(numberProducts_*outDataPerProduct);
+        std::vector<Real> sums(values.size(),0.0);
+        std::vector<Real> sumsqs(values.size(),0.0);
+
+        for (Size n=0; n<numberOfPaths; ++n)
+        {
+            singlePathValues(elementaryValues_);
+
+            if (elementary)
+                std::copy(elementaryValues_.begin(), elementaryValues_.end(), values.begin());
+            else
+                for (Size p=0; p < numberProducts_; ++p)
+                {
+                    const Real* in = &elementaryValues_[p*inDataPerProduct];
+                    Real* out = &values[p*outDataPerProduct];
+
+                    std::copy(in, in+1+numberRates_, out);
+
+                    for (Size b=0; b < numberBumps_; ++b)
+                    {
+                        Real thisVega = 0.0;
+                        for (Size l=0; l < bumpEntries_[b].size(); ++l)
+                            thisVega += bumpEntries_[b][l].second*in[1+numberRates_+bumpEntries_[b][l].first];
+                        out[1+numberRates_+b] = thisVega;
+                    }
+                }
+
+            for (Size j=0; j < values.size(); ++j)
+            {
+                sums[j] += values[j];
+                sumsqs[j] += values[j]*values[j];
+            }
+        }
+
+        means.resize(values.size());
+        errors.resize(values.size());
+
+        for (Size j=0; j < values.size(); ++j)
+        {
+            means[j] = sums[j]/numberOfPaths;
+            Real meanSq = sumsqs[j]/numberOfPaths;
+            Real variance = std::max(meanSq - means[j]*means[j], 0.0);
+            errors[j] = std::sqrt(variance/numberOfPaths);
+        }
+    }
+
+    void PathwiseVegasAdjointAccountingEngine::multiplePathValuesElementary(std::vector<Real>& means,
+                                                                            std::vector<Real>& errors,
+                                                                            Size numberOfPaths)
+    {
+        accumulateValues(means, errors, numberOfPaths, true);
+    }
+
+    void PathwiseVegasAdjointAccountingEngine::multiplePathValues(std::vector<Real>& means,
+                                                                  std::vector<Real>& errors,
+                                                                  Size numberOfPaths)
+    {
+        accumulateValues(means, errors, numberOfPaths, false);
+    }
+
+} // end of namespace
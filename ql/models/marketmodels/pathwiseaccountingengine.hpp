@@ -51,9 +51,8 @@ namespace QuantLib {
 
         void multiplePathValues(SequenceStatisticsInc& stats,
                                 Size numberOfPaths);
+        Real singlePathValues(std::vector<Real>& values);
       private:
-          Real singlePathValues(std::vector<Real>& values);
-
         boost::shared_ptr<LogNormalFwdRateEuler> evolver_;
         Clone<MarketModelPathwiseMultiProduct> product_;
         boost::shared_ptr<MarketModel> pseudoRootStructure_;
@@ -272,6 +271,96 @@ namespace QuantLib {
 */
     };
 
+   //! Engine collecting cash flows along a market-model simulation for doing adjoint pathwise computation of Deltas and vegas
+    // The derivatives of the deflated cash flows are propagated backwards through the exact adjoint of each
+    // log-Euler step, and the sensitivities to every pseudo-root element of a step are read off
+    // the adjoint vector of that step. Nothing is stored per vega, so that all deltas and all elementary vegas cost
+    // O(rates*factors) operations per step and product, i.e., a fixed multiple of a valuation
+    // regardless of the number of bumps; vega bumps are applied path by path using their non-zero entries only.
+    // note only works with displaced LMM evolved with LogNormalFwdRateEuler in the money-market measure
+    // This is tested in MarketModelTest::testAdjointPathwiseVegas
+
+    class PathwiseVegasAdjointAccountingEngine
+    {
+      public:
+        PathwiseVegasAdjointAccountingEngine(const boost::shared_ptr<LogNormalFwdRateEuler>& evolver, // method relies heavily on LMM Euler
+                         const Clone<MarketModelPathwiseMultiProduct>& product,
+                         const boost::shared_ptr<MarketModel>& pseudoRootStructure, // we need pseudo-roots and displacements
+                         const std::vector<std::vector<Matrix> >& vegaBumps, // may be empty if only elementary vegas are needed
+                         Real initialNumeraireValue);
+
+        //! Use to get vegas with respect to VegaBumps
+        /*! For each product the results are the price, the deltas and
+            the vegas, together with their standard errors.
+        */
+        void multiplePathValues(std::vector<Real>& means,
+                                std::vector<Real>& errors,
+                                Size numberOfPaths);
+
+        //! Use to get vegas with respect to pseudo-root-elements
+        /*! For each product the results are the price, the deltas and
+            the vegas with respect to each pseudo-root element, indexed
+            by step, rate and factor.
+        */
+        void multiplePathValuesElementary(std::vector<Real>& means,
+                                          std::vector<Real>& errors,
+                                          Size numberOfPaths);
+
+      private:
+        void singlePathValues(std::vector<Real>& values);
+        void accumulateValues(std::vector<Real>& means,
+                              std::vector<Real>& errors,
+                              Size numberOfPaths,
+                              bool elementary);
+
+        boost::shared_ptr<LogNormalFwdRateEuler> evolver_;
+        Clone<MarketModelPathwiseMultiProduct> product_;
+        boost::shared_ptr<MarketModel> pseudoRootStructure_;
+
+        Real initialNumeraireValue_;
+        Size numberProducts_;
+        Size numberRates_;
+        Size numberCashFlowTimes_;
+        Size numberSteps_;
+        Size factors_;
+        Size numberBumps_;
+        Size numberElementaryVegas_;
+
+        bool doDeflation_;
+
+        std::vector<Time> taus_;
+        std::vector<Spread> displacements_;
+        std::vector<Size> alive_;
+
+        // non-zero entries of the vega bumps, as pairs of elementary vega index and weight
+        std::vector<std::vector<std::pair<Size,Real> > > bumpEntries_;
+
+        // workspace
+        std::vector<Real> numerairesHeld_;
+        std::vector<Size> numberCashFlowsThisStep_;
+        std::vector<std::vector<MarketModelPathwiseMultiProduct::CashFlow> >
+                                                         cashFlowsGenerated_;
+        std::vector<MarketModelPathwiseDiscounter> discounters_;
+
+        std::vector<Matrix> V_;  // one V for each product, with components for each time step and rate
+
+        Matrix LIBORRates_; // dimensions are step and rate number, row 0 holds the initial rates
+        Matrix Discounts_; // dimensions are step and rate number, goes from 0 to n. P(t_0, t_j)
+        Matrix gaussians_; // dimensions are step and factor
+
+        std::vector<Real> driftFactors_, driftFactorDerivatives_, W_;
+        Matrix partials_; // dimensions are factor and rate
+        std::vector<Real> E_;
+
+        std::vector<Real> deflatorAndDerivatives_;
+        std::vector<Real> elementaryValues_;
+
+        std::vector<std::vector<Size> > numberCashFlowsThisIndex_;
+        std::vector<Matrix> totalCashFlowsThisIndex_; // need product cross times cross which sensitivity
+
+        std::vector<std::vector<Size> > cashFlowIndicesThisStep_;
+    };
+
 }
 
 #endif
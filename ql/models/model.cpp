@@ -22,6 +22,7 @@
 #include <ql/math/optimization/problem.hpp>
 #include <ql/math/optimization/projection.hpp>
 #include <ql/math/optimization/projectedconstraint.hpp>
+#include <string>
 
 using std::vector;
 using boost::shared_ptr;
@@ -30,12 +31,33 @@ namespace QuantLib {
 
     namespace {
         void no_deletion(CalibratedModel*) {}
+
+        std::vector<boost::shared_ptr<CalibrationHelperBase> >
+        toBase(const std::vector<boost::shared_ptr<CalibrationHelper> >& h) {
+            std::vector<boost::shared_ptr<CalibrationHelperBase> > tmp;
+            for (Size i=0; i<h.size(); ++i) {
+                tmp.push_back(
+                    boost::static_pointer_cast<CalibrationHelperBase>(h[i]));
+            }
+            return tmp;
+        }
     }
 
+    CalibratedModel::CalibrationReplica::CalibrationReplica(
+        const boost::shared_ptr<CalibratedModel>& model,
+        const std::vector<boost::shared_ptr<CalibrationHelperBase> >& helpers)
+    : model(model), helpers(helpers) {}
+
+    CalibratedModel::CalibrationReplica::CalibrationReplica(
+        const boost::shared_ptr<CalibratedModel>& model,
+        const std::vector<boost::shared_ptr<CalibrationHelper> >& helpers)
+    : model(model), helpers(toBase(helpers)) {}
+
     CalibratedModel::CalibratedModel(Size nArguments)
     : arguments_(nArguments),
       constraint_(new PrivateConstraint(arguments_)),
-      shortRateEndCriteria_(EndCriteria::None) {}
+      shortRateEndCriteria_(EndCriteria::None),
+      parallelHelpers_(false) {}
 
     class CalibratedModel::CalibrationFunction : public CostFunction {
       public:
@@ -44,39 +66,122 @@ namespace QuantLib {
                   const std::vector<boost::shared_ptr<CalibrationHelperBase> >&
                                                                   instruments,
                   const std::vector<Real>& weights,
-                  const Projection& projection)
+                  const Projection& projection,
+                  const std::vector<CalibrationReplica>& replicas =
+                                            std::vector<CalibrationReplica>())
         : model_(model, no_deletion), instruments_(instruments),
-          weights_(weights), projection_(projection) { }
+          weights_(weights), projection_(projection), replicas_(replicas) { }
 
         virtual ~CalibrationFunction() {}
 
         virtual Real value(const Array& params) const {
             model_->setParams(projection_.include(params));
-            Real value = 0.0;
-            for (Size i=0; i<instruments_.size(); i++) {
-                Real diff = instruments_[i]->calibrationError();
-                value += diff*diff*weights_[i];
-            }
-            return std::sqrt(value);
+            return norm(calibrationErrors(instruments_));
         }
 
         virtual Disposable<Array> values(const Array& params) const {
             model_->setParams(projection_.include(params));
-            Array values(instruments_.size());
-            for (Size i=0; i<instruments_.size(); i++) {
-                values[i] = instruments_[i]->calibrationError()
-                           *std::sqrt(weights_[i]);
-            }
-            return values;
+            return weighted(calibrationErrors(instruments_));
+        }
+
+        virtual void batchValue(const std::vector<Array>& params,
+                                Array& y) const {
+            std::vector<Array> e;
+            calibrationErrors(params, e);
+            y = Array(params.size());
+            for (Size i=0; i<params.size(); ++i)
+                y[i] = norm(e[i]);
+        }
+
+        virtual void batchValues(const std::vector<Array>& params,
+                                 std::vector<Array>& y) const {
+            calibrationErrors(params, y);
+            for (Size i=0; i<params.size(); ++i)
+                y[i] = weighted(y[i]);
         }
 
         virtual Real finiteDifferenceEpsilon() const { return 1e-6; }
 
       private:
+        Real norm(const Array& errors) const {
+            Real value = 0.0;
+            for (Size i=0; i<errors.size(); i++)
+                value += errors[i]*errors[i]*weights_[i];
+            return std::sqrt(value);
+        }
+
+        Disposable<Array> weighted(const Array& errors) const {
+            Array values(errors.size());
+            for (Size i=0; i<errors.size(); i++)
+                values[i] = errors[i]*std::sqrt(weights_[i]);
+            return values;
+        }
+
+        // calibration errors of the given helpers at the current
+        // model parameters
+        Disposable<Array> calibrationErrors(
+            const std::vector<boost::shared_ptr<CalibrationHelperBase> >&
+                                                        instruments) const {
+            Array errors(instruments.size());
+            if (!model_->parallelHelpers_) {
+                for (Size i=0; i<instruments.size(); i++)
+                    errors[i] = instruments[i]->calibrationError();
+                return errors;
+            }
+
+            std::vector<std::string> failures(instruments.size());
+            #pragma omp parallel for schedule(dynamic)
+            for (long i=0; i<long(instruments.size()); ++i) {
+                // exceptions must not escape the parallel region
+                try {
+                    errors[i] = instruments[i]->calibrationError();
+                } catch (std::exception& e) {
+                    failures[i] = e.what();
+                } catch (...) {
+                    failures[i] = "unknown error";
+                }
+            }
+            for (Size i=0; i<instruments.size(); i++)
+                QL_REQUIRE(failures[i].empty(), failures[i]);
+            return errors;
+        }
+
+        // calibration errors at several points; the points are
+        // distributed between the model and its replicas
+        void calibrationErrors(const std::vector<Array>& params,
+                    std::vector<Array>& errors) const {
+            errors.resize(params.size());
+            const Size workers = replicas_.size() + 1;
+            std::vector<std::string> failures(workers);
+            #pragma omp parallel for schedule(static,1) if(workers > 1)
+            for (long w=0; w<long(workers); ++w) {
+                try {
+                    CalibratedModel* model = model_.get();
+                    const std::vector<boost::shared_ptr<
+                        CalibrationHelperBase> >* instruments = &instruments_;
+                    if (w > 0) {
+                        model = replicas_[w-1].model.get();
+                        instruments = &replicas_[w-1].helpers;
+                    }
+                    for (Size i=w; i<params.size(); i+=workers) {
+                        model->setParams(projection_.include(params[i]));
+                        errors[i] = calibrationErrors(*instruments);
+                    }
+                } catch (std::exception& e) {
+                    failures[w] = e.what();
+                } catch (...) {
+                    failures[w] = "unknown error";
+                }
+            }
+            for (Size w=0; w<workers; ++w)
+                QL_REQUIRE(failures[w].empty(), failures[w]);
+        }
+
         boost::shared_ptr<CalibratedModel> model_;
         const std::vector<boost::shared_ptr<CalibrationHelperBase> >& instruments_;
         std::vector<Real> weights_;
         const Projection projection_;
+        std::vector<CalibrationReplica> replicas_;
     };
 
     void CalibratedModel::calibrate(
@@ -86,13 +191,8 @@ namespace QuantLib {
         const Constraint& additionalConstraint,
         const std::vector<Real>& weights,
         const std::vector<bool>& fixParameters) {
-        std::vector<boost::shared_ptr<CalibrationHelperBase> > tmp;
-        for(Size i=0;i<instruments.size();++i) {
-            tmp.push_back(boost::static_pointer_cast<CalibrationHelperBase>(
-                instruments[i]));
-        }
-        calibrate(tmp, method, endCriteria, additionalConstraint, weights,
-                  fixParameters);
+        calibrate(toBase(instruments), method, endCriteria,
+                  additionalConstraint, weights, fixParameters);
     }
 
     void CalibratedModel::calibrate(
@@ -117,13 +217,26 @@ namespace QuantLib {
             weights.empty() ? vector<Real>(instruments.size(), 1.0): weights;
 
         Array prms = params();
+        for (Size i=0; i<replicas_.size(); ++i) {
+            QL_REQUIRE(replicas_[i].helpers.size() == instruments.size(),
+                       "mismatch between number of instruments (" <<
+                       instruments.size() << ") and helpers of replica " <<
+                       i << " (" << replicas_[i].helpers.size() << ")");
+            QL_REQUIRE(replicas_[i].model->params().size() == prms.size(),
+                       "mismatch between number of parameters (" <<
+                       prms.size() << ") and parameters of replica " <<
+                       i << " (" << replicas_[i].model->params().size() <<
+                       ")");
+        }
         vector<bool> all(prms.size(), false);
         Projection proj(prms,fixParameters.size()>0 ? fixParameters : all);
-        CalibrationFunction f(this,instruments,w,proj);
+        CalibrationFunction f(this,instruments,w,proj,replicas_);
         ProjectedConstraint pc(c,proj);
         Problem prob(f, pc, proj.project(prms));
         shortRateEndCriteria_ = method.minimize(prob, endCriteria);
         Array result(prob.currentValue());
+        for (Size i=0; i<replicas_.size(); ++i)
+            replicas_[i].model->setParams(proj.include(result));
         setParams(proj.include(result));
         problemValues_ = prob.values(result);
 
@@ -132,12 +245,7 @@ namespace QuantLib {
 
     Real CalibratedModel::value(const Array& params,
        const std::vector<boost::shared_ptr<CalibrationHelper> >& instruments) {
-        std::vector<boost::shared_ptr<CalibrationHelperBase> > tmp;
-        for(Size i=0;i<instruments.size();++i) {
-            tmp.push_back(boost::static_pointer_cast<CalibrationHelperBase>(
-                instruments[i]));
-        }
-        return value(params,tmp);
+        return value(params, toBase(instruments));
     }
 
     Real CalibratedModel::value(const Array& params,
@@ -162,6 +270,20 @@ namespace QuantLib {
         return params;
     }
 
+    void CalibratedModel::enableParallelHelpers(bool flag) {
+        parallelHelpers_ = flag;
+    }
+
+    void CalibratedModel::setCalibrationReplicas(
+                            const std::vector<CalibrationReplica>& replicas) {
+        for (Size i=0; i<replicas.size(); ++i) {
+            QL_REQUIRE(replicas[i].model, "null model in replica " << i);
+            QL_REQUIRE(replicas[i].model.get() != this,
+                       "model given as its own replica");
+        }
+        replicas_ = replicas;
+    }
+
     void CalibratedModel::setParams(const Array& params) {
         Array::const_iterator p = params.begin();
         for (Size i=0; i<arguments_.size(); ++i) {
@@ -85,6 +85,26 @@ namespace QuantLib {
     //! Calibrated model class
     class CalibratedModel : public virtual Observer, public virtual Observable {
       public:
+        //! copy of a model with its own calibration helpers
+        /*! The helpers must correspond one to one, and in the same
+            order, to the ones passed to calibrate(); they must not
+            share pricing engines with them.
+        */
+        struct CalibrationReplica {
+            CalibrationReplica() {}
+            CalibrationReplica(
+                const boost::shared_ptr<CalibratedModel>& model,
+                const std::vector<boost::shared_ptr<CalibrationHelperBase> >&
+                                                                    helpers);
+            // for backward compatibility
+            CalibrationReplica(
+                const boost::shared_ptr<CalibratedModel>& model,
+                const std::vector<boost::shared_ptr<CalibrationHelper> >&
+                                                                    helpers);
+            boost::shared_ptr<CalibratedModel> model;
+            std::vector<boost::shared_ptr<CalibrationHelperBase> > helpers;
+        };
+
         CalibratedModel(Size nArguments);
 
         void update() {
@@ -131,6 +151,37 @@ namespace QuantLib {
 
         virtual void setParams(const Array& params);
 
+        /*! \name Parallel calibration
+
+            These settings take effect when the library is compiled
+            with OpenMP support; otherwise the calibration runs
+            serially and gives the same results.
+        */
+        //@{
+        /*! If set, the calibration errors of the helpers are computed
+            concurrently.  This is only safe if the helpers do not
+            share pricing engines or other state modified during
+            pricing, e.g., if each helper has its own engine.
+        */
+        void enableParallelHelpers(bool flag = true);
+        bool parallelHelpers() const { return parallelHelpers_; }
+        /*! When the optimization method asks for the cost function at
+            several points at once, as LevenbergMarquardt does for its
+            finite-difference Jacobian and the population-based
+            methods do for their populations, the points are shared
+            between this model and the given replicas and evaluated
+            concurrently.  The replicas must have the same parameters
+            as this model and must not share mutable state with it
+            or with each other; after calibration they are set to the
+            calibrated parameters.
+        */
+        void setCalibrationReplicas(
+                          const std::vector<CalibrationReplica>& replicas);
+        const std::vector<CalibrationReplica>& calibrationReplicas() const {
+            return replicas_;
+        }
+        //@}
+
       protected:
         virtual void generateArguments() {}
         std::vector<Parameter> arguments_;
@@ -144,6 +195,8 @@ namespace QuantLib {
         //! Calibration cost function class
         class CalibrationFunction;
         friend class CalibrationFunction;
+        bool parallelHelpers_;
+        std::vector<CalibrationReplica> replicas_;
     };
 
     //! Abstract short-rate model class
@@ -20,27 +20,43 @@
 #include <ql/models/volatility/constantestimator.hpp>
 
 namespace QuantLib {
-    TimeSeries<Volatility>
-    ConstantEstimator::calculate(const TimeSeries<Volatility>& volatilitySeries) {
-        TimeSeries<Volatility> retval;
-        const std::vector<Volatility> u = volatilitySeries.values();
-        TimeSeries<Volatility>::const_iterator prev, next, cur, start;
-        cur = volatilitySeries.begin();
-        std::advance(cur, size_);
-        // ICK.  This could probably be made a lot more efficient
-        for (Size i=size_; i < volatilitySeries.size(); i++) {
-            Size j;
-            Real sumu2=0.0, sumu=0.0;
-            for (j=i-size_; j <i; j++) {
-                sumu += u[j];
-                sumu2 += u[j]*u[j];
+
+    namespace {
+
+        template <class Series>
+        Series calculateSeries(const Series& volatilitySeries, Size size) {
+            Series retval;
+            typename Series::const_value_iterator first =
+                volatilitySeries.cbegin_values();
+            typename Series::const_iterator cur = volatilitySeries.begin();
+            std::advance(cur, size);
+            // ICK.  This could probably be made a lot more efficient
+            for (Size i=size; i < volatilitySeries.size(); i++) {
+                typename Series::const_value_iterator u = first;
+                Real sumu2=0.0, sumu=0.0;
+                for (Size j=0; j<size; ++j, ++u) {
+                    sumu += *u;
+                    sumu2 += (*u)*(*u);
+                }
+                Real s = std::sqrt(sumu2/(Real)size - sumu*sumu / (Real) size /
+                                   (Real) (size+1));
+                retval[cur->first] = s;
+                ++cur;
+                ++first;
             }
-            Real s = std::sqrt(sumu2/(Real)size_ - sumu*sumu / (Real) size_ /
-                               (Real) (size_+1));
-            retval[cur->first] = s;
-            ++cur;
+            return retval;
         }
-        return retval;
+
+    }
+
+    TimeSeries<Volatility>
+    ConstantEstimator::calculate(const TimeSeries<Volatility>& volatilitySeries) {
+        return calculateSeries(volatilitySeries, size_);
+    }
+
+    ConstantEstimator::flat_time_series
+    ConstantEstimator::calculate(const flat_time_series& volatilitySeries) {
+        return calculateSeries(volatilitySeries, size_);
     }
 
 }
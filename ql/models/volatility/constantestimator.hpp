@@ -39,7 +39,9 @@ namespace QuantLib {
         ConstantEstimator(Size size)
         : size_(size) {}
         TimeSeries<Volatility> calculate(const TimeSeries<Volatility>&);
+        flat_time_series calculate(const flat_time_series&);
         void calibrate(const TimeSeries<Volatility>&) {}
+        void calibrate(const flat_time_series&) {}
     };
 
 }
@@ -370,23 +370,40 @@ namespace QuantLib {
 
     }
 
+    namespace {
+
+        template <class Series>
+        Series calculateSeries(const Series& quoteSeries,
+                               Real alpha, Real beta, Real omega) {
+            Series retval;
+            typename Series::const_iterator cur = quoteSeries.cbegin();
+            Real u = cur->second;
+            Real sigma2 = u*u;
+            while (++cur != quoteSeries.end()) {
+                sigma2 = omega + alpha * u * u + beta * sigma2;
+                retval[cur->first] = std::sqrt(sigma2);
+                u = cur->second;
+            }
+            sigma2 = omega + alpha * u * u + beta * sigma2;
+            --cur;
+            typename Series::const_iterator prev = cur;
+            retval[cur->first + (cur->first - (--prev)->first) ] =
+                std::sqrt(sigma2);
+            return retval;
+        }
+
+    }
+
     Garch11::time_series
     Garch11::calculate(const time_series& quoteSeries,
                        Real alpha, Real beta, Real omega) {
-        time_series retval;
-        const_iterator cur = quoteSeries.cbegin();
-        Real u = cur->second;
-        Real sigma2 = u*u;
-        while (++cur != quoteSeries.end()) {
-            sigma2 = omega + alpha * u * u + beta * sigma2;
-            retval[cur->first] = std::sqrt(sigma2);
-            u = cur->second;
-        }
-        sigma2 = omega + alpha * u * u + beta * sigma2;
-        --cur;
-        const_iterator prev = cur;
-        retval[cur->first + (cur->first - (--prev)->first) ] = std::sqrt(sigma2);
-        return retval;
+        return calculateSeries(quoteSeries, alpha, beta, omega);
+    }
+
+    Garch11::flat_time_series
+    Garch11::calculate(const flat_time_series& quoteSeries,
+                       Real alpha, Real beta, Real omega) {
+        return calculateSeries(quoteSeries, alpha, beta, omega);
     }
 
 
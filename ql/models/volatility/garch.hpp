@@ -63,6 +63,11 @@ namespace QuantLib {
         : alpha_(0), beta_(0), vl_(0), logLikelihood_(0), mode_(mode) {
             calibrate(qs);
         };
+
+        Garch11(const flat_time_series& qs, Mode mode = BestOfTwo)
+        : alpha_(0), beta_(0), vl_(0), logLikelihood_(0), mode_(mode) {
+            calibrate(qs);
+        };
         //@}
 
         //! \name Inspectors
@@ -83,12 +88,20 @@ namespace QuantLib {
         void calibrate(const time_series& quoteSeries) {
             calibrate(quoteSeries.cbegin_values(), quoteSeries.cend_values());
         }
+        flat_time_series calculate(const flat_time_series& quoteSeries) {
+            return calculate(quoteSeries, alpha(), beta(), omega());
+        }
+        void calibrate(const flat_time_series& quoteSeries) {
+            calibrate(quoteSeries.cbegin_values(), quoteSeries.cend_values());
+        }
         //@}
 
         //! \name Additional interface
         //@{
         static time_series calculate(const time_series& quoteSeries,
                                      Real alpha, Real beta, Real omega);
+        static flat_time_series calculate(const flat_time_series& quoteSeries,
+                                          Real alpha, Real beta, Real omega);
 
         void calibrate(const time_series& quoteSeries,
                        OptimizationMethod& method,
@@ -105,6 +118,21 @@ namespace QuantLib {
                       method, endCriteria, initialGuess);
         }
 
+        void calibrate(const flat_time_series& quoteSeries,
+                       OptimizationMethod& method,
+                       const EndCriteria& endCriteria) {
+            calibrate(quoteSeries.cbegin_values(), quoteSeries.cend_values(),
+                      method, endCriteria);
+        }
+
+        void calibrate(const flat_time_series& quoteSeries,
+                       OptimizationMethod& method,
+                       const EndCriteria& endCriteria,
+                       const Array& initialGuess) {
+            calibrate(quoteSeries.cbegin_values(), quoteSeries.cend_values(),
+                      method, endCriteria, initialGuess);
+        }
+
         template <typename ForwardIterator>
         void calibrate(ForwardIterator begin, ForwardIterator end) {
             std::vector<Volatility> r2;
@@ -48,8 +48,16 @@ namespace QuantLib {
         yearFraction_(y) {}
         TimeSeries<Volatility>
         calculate(const TimeSeries<IntervalPrice> &quoteSeries) {
-            TimeSeries<Volatility> retval;
-            TimeSeries<IntervalPrice>::const_iterator prev, next, cur, start;
+            return calculateSeries<TimeSeries<Volatility> >(quoteSeries);
+        }
+        flat_time_series calculate(const flat_quote_series &quoteSeries) {
+            return calculateSeries<flat_time_series>(quoteSeries);
+        }
+    private:
+        template <class Result, class Series>
+        Result calculateSeries(const Series &quoteSeries) {
+            Result retval;
+            typename Series::const_iterator prev, next, cur, start;
             start = quoteSeries.begin();
             for (cur = start; cur != quoteSeries.end(); ++cur) {
                 retval[cur->first] =
@@ -84,10 +92,20 @@ namespace QuantLib {
         GarmanKlassOpenClose(Real y, Real marketOpenFraction,
                              Real a) :
         T(y), f_(marketOpenFraction), a_(a) {};
+        typedef typename T::flat_time_series flat_time_series;
+        typedef typename T::flat_quote_series flat_quote_series;
         TimeSeries<Volatility>
         calculate(const TimeSeries<IntervalPrice> &quoteSeries) {
-            TimeSeries<Volatility> retval;
-            TimeSeries<IntervalPrice>::const_iterator prev, next, cur, start;
+            return calculateSeries<TimeSeries<Volatility> >(quoteSeries);
+        }
+        flat_time_series calculate(const flat_quote_series &quoteSeries) {
+            return calculateSeries<flat_time_series>(quoteSeries);
+        }
+    private:
+        template <class Result, class Series>
+        Result calculateSeries(const Series &quoteSeries) {
+            Result retval;
+            typename Series::const_iterator prev, next, cur, start;
             start = quoteSeries.begin();
             ++start;
             for (cur = start; cur != quoteSeries.end(); ++cur) {
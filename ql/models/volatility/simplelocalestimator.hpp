@@ -41,8 +41,16 @@ namespace QuantLib {
         yearFraction_(y) {}
         TimeSeries<Volatility>
         calculate(const TimeSeries<Real> &quoteSeries) {
-            TimeSeries<Volatility> retval;
-            TimeSeries<Real>::const_iterator prev, next, cur, start;
+            return calculateSeries<TimeSeries<Volatility> >(quoteSeries);
+        }
+        flat_time_series calculate(const flat_quote_series &quoteSeries) {
+            return calculateSeries<flat_time_series>(quoteSeries);
+        }
+      private:
+        template <class Result, class Series>
+        Result calculateSeries(const Series &quoteSeries) const {
+            Result retval;
+            typename Series::const_iterator prev, next, cur, start;
             start = quoteSeries.begin();
             ++start;
             for (cur = start; cur != quoteSeries.end(); ++cur) {
@@ -181,6 +181,7 @@ namespace QuantLib {
         MakeMCDiscreteArithmeticAPEngine& withMaxSamples(Size samples);
         MakeMCDiscreteArithmeticAPEngine& withSeed(BigNatural seed);
         MakeMCDiscreteArithmeticAPEngine& withAntitheticVariate(bool b = true);
+        MakeMCDiscreteArithmeticAPEngine& withBatchSize(Size batchSize);
         MakeMCDiscreteArithmeticAPEngine& withControlVariate(bool b = true);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
@@ -191,6 +192,7 @@ namespace QuantLib {
         Real tolerance_;
         bool brownianBridge_;
         BigNatural seed_;
+        Size batchSize_;
     };
 
     template <class RNG, class S>
@@ -199,7 +201,8 @@ namespace QuantLib {
              const boost::shared_ptr<GeneralizedBlackScholesProcess>& process)
     : process_(process), antithetic_(false), controlVariate_(false),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), brownianBridge_(true), seed_(0) {}
+      tolerance_(Null<Real>()), brownianBridge_(true), seed_(0),
+      batchSize_(Null<Size>()) {}
 
     template <class RNG, class S>
     inline MakeMCDiscreteArithmeticAPEngine<RNG,S>&
@@ -251,6 +254,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCDiscreteArithmeticAPEngine<RNG,S>&
+    MakeMCDiscreteArithmeticAPEngine<RNG,S>::withBatchSize(Size batchSize) {
+        batchSize_ = batchSize;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline MakeMCDiscreteArithmeticAPEngine<RNG,S>&
     MakeMCDiscreteArithmeticAPEngine<RNG,S>::withControlVariate(bool b) {
@@ -262,13 +272,16 @@ namespace QuantLib {
     inline
     MakeMCDiscreteArithmeticAPEngine<RNG,S>::operator boost::shared_ptr<PricingEngine>()
                                                                       const {
-        return boost::shared_ptr<PricingEngine>(new
+        boost::shared_ptr<MCDiscreteArithmeticAPEngine<RNG,S> > engine(new
             MCDiscreteArithmeticAPEngine<RNG,S>(process_,
                                                 brownianBridge_,
                                                 antithetic_, controlVariate_,
                                                 samples_, tolerance_,
                                                 maxSamples_,
                                                 seed_));
+        if (batchSize_ != Null<Size>())
+            engine->setBatchSize(batchSize_);
+        return engine;
     }
 
 
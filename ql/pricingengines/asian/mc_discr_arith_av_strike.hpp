@@ -133,6 +133,7 @@ namespace QuantLib {
         MakeMCDiscreteArithmeticASEngine& withMaxSamples(Size samples);
         MakeMCDiscreteArithmeticASEngine& withSeed(BigNatural seed);
         MakeMCDiscreteArithmeticASEngine& withAntitheticVariate(bool b = true);
+        MakeMCDiscreteArithmeticASEngine& withBatchSize(Size batchSize);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
       private:
@@ -142,6 +143,7 @@ namespace QuantLib {
         Real tolerance_;
         bool brownianBridge_;
         BigNatural seed_;
+        Size batchSize_;
     };
 
     template <class RNG, class S>
@@ -150,7 +152,8 @@ namespace QuantLib {
              const boost::shared_ptr<GeneralizedBlackScholesProcess>& process)
     : process_(process), antithetic_(false),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), brownianBridge_(true), seed_(0) {}
+      tolerance_(Null<Real>()), brownianBridge_(true), seed_(0),
+      batchSize_(Null<Size>()) {}
 
     template <class RNG, class S>
     inline MakeMCDiscreteArithmeticASEngine<RNG,S>&
@@ -202,17 +205,27 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCDiscreteArithmeticASEngine<RNG,S>&
+    MakeMCDiscreteArithmeticASEngine<RNG,S>::withBatchSize(Size batchSize) {
+        batchSize_ = batchSize;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCDiscreteArithmeticASEngine<RNG,S>::
     operator boost::shared_ptr<PricingEngine>() const {
-        return boost::shared_ptr<PricingEngine>(
-            new MCDiscreteArithmeticASEngine<RNG,S>(process_,
-                                                    brownianBridge_,
-                                                    antithetic_,
-                                                    samples_, tolerance_,
-                                                    maxSamples_,
-                                                    seed_));
+        boost::shared_ptr<MCDiscreteArithmeticASEngine<RNG,S> > engine(new
+            MCDiscreteArithmeticASEngine<RNG,S>(process_,
+                                                brownianBridge_,
+                                                antithetic_,
+                                                samples_, tolerance_,
+                                                maxSamples_,
+                                                seed_));
+        if (batchSize_ != Null<Size>())
+            engine->setBatchSize(batchSize_);
+        return engine;
     }
 
 }
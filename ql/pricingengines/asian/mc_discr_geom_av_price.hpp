@@ -144,6 +144,7 @@ namespace QuantLib {
         MakeMCDiscreteGeometricAPEngine& withMaxSamples(Size samples);
         MakeMCDiscreteGeometricAPEngine& withSeed(BigNatural seed);
         MakeMCDiscreteGeometricAPEngine& withAntitheticVariate(bool b = true);
+        MakeMCDiscreteGeometricAPEngine& withBatchSize(Size batchSize);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
       private:
@@ -153,6 +154,7 @@ namespace QuantLib {
         Real tolerance_;
         bool brownianBridge_;
         BigNatural seed_;
+        Size batchSize_;
     };
 
     template <class RNG, class S>
@@ -161,7 +163,8 @@ namespace QuantLib {
              const boost::shared_ptr<GeneralizedBlackScholesProcess>& process)
     : process_(process), antithetic_(false),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), brownianBridge_(true), seed_(0) {}
+      tolerance_(Null<Real>()), brownianBridge_(true), seed_(0),
+      batchSize_(Null<Size>()) {}
 
     template <class RNG, class S>
     inline MakeMCDiscreteGeometricAPEngine<RNG,S>&
@@ -213,17 +216,27 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCDiscreteGeometricAPEngine<RNG,S>&
+    MakeMCDiscreteGeometricAPEngine<RNG,S>::withBatchSize(Size batchSize) {
+        batchSize_ = batchSize;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCDiscreteGeometricAPEngine<RNG,S>::operator boost::shared_ptr<PricingEngine>()
                                                                       const {
-        return boost::shared_ptr<PricingEngine>(new
+        boost::shared_ptr<MCDiscreteGeometricAPEngine<RNG,S> > engine(new
             MCDiscreteGeometricAPEngine<RNG,S>(process_,
                                                brownianBridge_,
                                                antithetic_,
                                                samples_, tolerance_,
                                                maxSamples_,
                                                seed_));
+        if (batchSize_ != Null<Size>())
+            engine->setBatchSize(batchSize_);
+        return engine;
     }
 
 }
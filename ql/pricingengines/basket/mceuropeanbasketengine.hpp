@@ -111,6 +111,7 @@ namespace QuantLib {
         MakeMCEuropeanBasketEngine& withStepsPerYear(Size steps);
         MakeMCEuropeanBasketEngine& withBrownianBridge(bool b = true);
         MakeMCEuropeanBasketEngine& withAntitheticVariate(bool b = true);
+        MakeMCEuropeanBasketEngine& withBatchSize(Size batchSize);
         MakeMCEuropeanBasketEngine& withSamples(Size samples);
         MakeMCEuropeanBasketEngine& withAbsoluteTolerance(Real tolerance);
         MakeMCEuropeanBasketEngine& withMaxSamples(Size samples);
@@ -123,6 +124,7 @@ namespace QuantLib {
         Size steps_, stepsPerYear_, samples_, maxSamples_;
         Real tolerance_;
         BigNatural seed_;
+        Size batchSize_;
     };
 
 
@@ -214,7 +216,8 @@ namespace QuantLib {
     : process_(process), brownianBridge_(false), antithetic_(false),
       steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), seed_(0) {}
+      tolerance_(Null<Real>()), seed_(0),
+      batchSize_(Null<Size>()) {}
 
     template <class RNG, class S>
     inline MakeMCEuropeanBasketEngine<RNG,S>&
@@ -244,6 +247,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCEuropeanBasketEngine<RNG,S>&
+    MakeMCEuropeanBasketEngine<RNG,S>::withBatchSize(Size batchSize) {
+        batchSize_ = batchSize;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline MakeMCEuropeanBasketEngine<RNG,S>&
     MakeMCEuropeanBasketEngine<RNG,S>::withSamples(Size samples) {
@@ -287,7 +297,7 @@ namespace QuantLib {
                    "number of steps not given");
         QL_REQUIRE(steps_ == Null<Size>() || stepsPerYear_ == Null<Size>(),
                    "number of steps overspecified");
-        return boost::shared_ptr<PricingEngine>(new
+        boost::shared_ptr<MCEuropeanBasketEngine<RNG,S> > engine(new
             MCEuropeanBasketEngine<RNG,S>(process_,
                                           steps_,
                                           stepsPerYear_,
@@ -296,6 +306,9 @@ namespace QuantLib {
                                           samples_, tolerance_,
                                           maxSamples_,
                                           seed_));
+        if (batchSize_ != Null<Size>())
+            engine->setBatchSize(batchSize_);
+        return engine;
     }
 
 }
@@ -341,6 +341,274 @@ namespace QuantLib {
             forward, blackPrice, discount, displacement, guess, accuracy, maxIterations);
     }
 
+    namespace {
+
+        /* Householder iteration of order 3 on the undiscounted price c
+           of the out-of-the-money option as a function of the standard
+           deviation s.  With x = log(F/K), c is convex below the
+           inflection point s_c = sqrt(2|x|) and concave above it; the
+           iteration is run on an objective chosen according to the
+           region of the target price p:
+           - below c(s_c), on log(c) - log(p), since c vanishes faster
+             than any power of s when s goes to zero;
+           - between c(s_c) and the midpoint to the upper bound U of
+             the price, on c - p;
+           - above, on log(U - p) - log(U - c), since c approaches U
+             exponentially fast when s grows.
+           Initial guesses are taken from the tangent at s_c or from
+           the asymptotic behavior of c.  A bracket of the root is
+           kept, and a Newton step or a bisection is used when a step
+           goes in the wrong direction or leaves the bracket.
+
+           With v = dc/ds and a = x^2/s^3 - s/4, the derivatives of c
+           are c'' = v*a and c''' = v*(a^2 - 3x^2/s^4 - 1/4).
+        */
+        class BlackImpliedStdDevSolver {
+          public:
+            BlackImpliedStdDevSolver(Option::Type otmType,
+                                     Real strike,
+                                     Real forward,
+                                     Real undiscountedPrice)
+            : theta_(otmType), strike_(strike), forward_(forward),
+              price_(undiscountedPrice),
+              upperBound_(otmType == Option::Call ? forward : strike),
+              x_(std::log(forward/strike)) {}
+
+            Real solve(Real accuracy, Natural maxIterations) const {
+                if (price_ == 0.0)
+                    return 0.0;
+
+                Real s, lo = 0.0, hi = QL_MAX_REAL;
+                Region region;
+                Real sc = std::sqrt(2.0*std::fabs(x_));
+                Real cc = (x_ == 0.0 ? 0.0 : price(sc));
+                Real vc = (x_ == 0.0 ? 0.0 : vega(sc));
+
+                if (price_ < cc) {
+                    region = Lower;
+                    hi = sc;
+                    // the tangent at s_c is below the convex price,
+                    // hence its intersection bounds the root from above
+                    Real tangent = sc - (cc - price_)/vc;
+                    if (tangent > 0.0)
+                        hi = tangent;
+                    // for small s, log(c/sqrt(FK)) is approximately
+                    // -x^2/(2s^2) - s^2/8 + log(s^3/(sqrt(2pi)(x^2-s^4/4)));
+                    // a few fixed-point iterations on the first term
+                    // give a guess, which is compared with the tangent
+                    // bound since the expansion degrades near the money.
+                    Real x2 = x_*x_;
+                    Real logRatio =
+                        std::log(price_/std::sqrt(forward_*strike_));
+                    s = std::sqrt(x2/(-2.0*logRatio));
+                    for (Size k=0; k<4; ++k) {
+                        Real s2 = s*s;
+                        Real den = x2 - 0.25*s2*s2;
+                        if (den <= 0.0)
+                            break;
+                        Real rhs = -logRatio - 0.125*s2
+                            + std::log(s2*s/(M_SQRT2*M_SQRTPI*den));
+                        if (rhs <= 0.0)
+                            break;
+                        s = std::sqrt(0.5*x2/rhs);
+                    }
+                    s = std::max(std::min(s, hi), sc*QL_EPSILON);
+                    if (tangent > 0.0 && s < tangent) {
+                        Real c = price(s);
+                        if (c > price_) {
+                            hi = s;
+                        } else if (c <= 0.0 ||
+                                   std::log(price_/c) >
+                                   std::log(price(tangent)/price_)) {
+                            lo = s;
+                            s = tangent;
+                        }
+                    }
+                } else if (price_ <= 0.5*(cc + upperBound_)) {
+                    region = Middle;
+                    lo = sc;
+                    if (x_ == 0.0) {
+                        // exact at the money: c = F*(2N(s/2)-1)
+                        s = 2.0*InverseCumulativeNormal::standard_value(
+                                             0.5*(price_/forward_ + 1.0));
+                    } else {
+                        // the tangent at s_c is above the concave price,
+                        // hence its intersection bounds the root from below
+                        s = lo = sc + (price_ - cc)/vc;
+                    }
+                } else {
+                    region = Upper;
+                    lo = sc;
+                    // from U - c ~ (F+K)*N(-s/2) for large s
+                    s = -2.0*InverseCumulativeNormal::standard_value(
+                              (upperBound_ - price_)/(forward_ + strike_));
+                    s = std::max(s, sc);
+                }
+
+                Real lastStep = QL_MAX_REAL;
+                for (Natural i=0; i<maxIterations; ++i) {
+                    Real v = vega(s);
+                    Real a = x_*x_/(s*s*s) - 0.25*s;
+                    Real h2 = a;
+                    Real h3 = a*a - 3.0*x_*x_/(s*s*s*s) - 0.25;
+                    // objective divided by its first derivative
+                    Real f, roundOff;
+                    if (region == Lower) {
+                        Real c = price(s, &roundOff);
+                        if (c <= 0.0 || v <= 0.0) {
+                            // underflow: move right
+                            lo = s;
+                            s = 0.5*(lo+hi);
+                            continue;
+                        }
+                        Real r = v/c;
+                        f = (std::log(c) - std::log(price_))/r;
+                        h2 = a - r;
+                        h3 += r*(2.0*r - 3.0*a);
+                    } else if (region == Middle) {
+                        if (v <= 0.0) {
+                            // underflow: move left
+                            hi = s;
+                            s = 0.5*(lo+hi);
+                            continue;
+                        }
+                        f = (price(s, &roundOff) - price_)/v;
+                    } else {
+                        Real u = distanceToUpperBound(s);
+                        if (u <= 0.0 || v <= 0.0) {
+                            // underflow: move left
+                            hi = s;
+                            s = 0.5*(lo+hi);
+                            continue;
+                        }
+                        roundOff = upperBound_;
+                        Real q = v/u;
+                        f = (std::log(upperBound_ - price_) - std::log(u))/q;
+                        h2 = a + q;
+                        h3 += q*(2.0*q + 3.0*a);
+                    }
+                    if (f == 0.0)
+                        return s;
+                    if (f < 0.0)
+                        lo = std::max(lo, s);
+                    else
+                        hi = std::min(hi, s);
+
+                    Real nu = -f;
+                    Real step = nu*(1.0 + 0.5*h2*nu)/
+                                (1.0 + nu*(h2 + h3*nu/6.0));
+                    // far from the root, the higher-order terms can
+                    // point the wrong way; fall back to Newton
+                    if (!(step*nu > 0.0))
+                        step = nu;
+                    // steps below the error caused by the round-off in
+                    // the price, e.g., far out of the money, are noise
+                    Real tolerance = std::max(accuracy*s,
+                                              4.0*QL_EPSILON*roundOff/v);
+                    if (std::fabs(step) <= tolerance)
+                        return s + step;
+                    // the estimate above can be optimistic; steps that
+                    // stop decreasing near the root are noise as well
+                    if (std::fabs(lastStep) <= 1.0e-6*s &&
+                        std::fabs(step) >= 0.5*std::fabs(lastStep))
+                        return s;
+                    lastStep = step;
+                    Real next = s + step;
+                    if (!(next > lo && next < hi))
+                        next = (hi < QL_MAX_REAL ? 0.5*(lo+hi) : 2.0*s);
+                    s = next;
+                }
+                QL_FAIL("implied standard deviation not found after "
+                        << maxIterations << " iterations (last value: "
+                        << s << ")");
+            }
+          private:
+            enum Region { Lower, Middle, Upper };
+            // also returns the magnitude of the terms of the difference
+            Real price(Real s, Real* roundOff = 0) const {
+                Real d1 = x_/s + 0.5*s, d2 = d1 - s;
+                Real a = forward_*N_(theta_*d1), b = strike_*N_(theta_*d2);
+                if (roundOff)
+                    *roundOff = a + b;
+                return std::max(theta_*(a - b), 0.0);
+            }
+            // U - c, computed without cancellation
+            Real distanceToUpperBound(Real s) const {
+                Real d1 = x_/s + 0.5*s, d2 = d1 - s;
+                return forward_*N_(-d1) + strike_*N_(d2);
+            }
+            Real vega(Real s) const {
+                return forward_*N_.derivative(x_/s + 0.5*s);
+            }
+            Real theta_, strike_, forward_, price_, upperBound_, x_;
+            CumulativeNormalDistribution N_;
+        };
+
+    }
+
+    Real blackFormulaImpliedStdDevHouseholder(Option::Type optionType,
+                                              Real strike,
+                                              Real forward,
+                                              Real blackPrice,
+                                              Real discount,
+                                              Real displacement,
+                                              Real accuracy,
+                                              Natural maxIterations)
+    {
+        checkParameters(strike, forward, displacement);
+        QL_REQUIRE(discount>0.0,
+                   "discount (" << discount << ") must be positive");
+        QL_REQUIRE(blackPrice>=0.0,
+                   "option price (" << blackPrice << ") must be non-negative");
+        QL_REQUIRE(strike+displacement>0.0,
+                   "strike + displacement (" << strike << " + "
+                   << displacement << ") must be positive");
+        // check the price of the "other" option implied by put-call paity
+        Real otherOptionPrice = blackPrice - optionType*(forward-strike)*discount;
+        QL_REQUIRE(otherOptionPrice>=0.0,
+                   "negative " << Option::Type(-1*optionType) <<
+                   " price (" << otherOptionPrice <<
+                   ") implied by put-call parity. No solution exists for " <<
+                   optionType << " strike " << strike <<
+                   ", forward " << forward <<
+                   ", price " << blackPrice <<
+                   ", deflator " << discount);
+
+        // solve for the out-of-the-money option
+        if ((optionType==Option::Put && strike>forward) ||
+            (optionType==Option::Call && strike<forward)) {
+            optionType = Option::Type(-1*optionType);
+            blackPrice = otherOptionPrice;
+        }
+
+        strike = strike + displacement;
+        forward = forward + displacement;
+
+        Real undiscountedPrice = blackPrice/discount;
+        Real upperBound = (optionType==Option::Call ? forward : strike);
+        QL_REQUIRE(undiscountedPrice < upperBound,
+                   "undiscounted " << optionType << " price ("
+                   << undiscountedPrice << ") must be lower than "
+                   << upperBound);
+
+        BlackImpliedStdDevSolver solver(optionType, strike, forward,
+                                        undiscountedPrice);
+        return solver.solve(accuracy, maxIterations);
+    }
+
+    Real blackFormulaImpliedStdDevHouseholder(
+                        const boost::shared_ptr<PlainVanillaPayoff>& payoff,
+                        Real forward,
+                        Real blackPrice,
+                        Real discount,
+                        Real displacement,
+                        Real accuracy,
+                        Natural maxIterations) {
+        return blackFormulaImpliedStdDevHouseholder(
+            payoff->optionType(), payoff->strike(), forward, blackPrice,
+            discount, displacement, accuracy, maxIterations);
+    }
+
     Real blackFormulaCashItmProbability(Option::Type optionType,
                                         Real strike,
                                         Real forward,
@@ -611,5 +879,235 @@ namespace QuantLib {
                                      stdDev, discount);
     }
 
+    void blackFormula(Option::Type optionType,
+                      const std::vector<Real>& strikes,
+                      Real forward,
+                      const std::vector<Real>& stdDevs,
+                      std::vector<Real>& results,
+                      Real discount,
+                      Real displacement)
+    {
+        QL_REQUIRE(strikes.size() == stdDevs.size(),
+                   "mismatch between number of strikes ("
+                   << strikes.size() << ") and standard deviations ("
+                   << stdDevs.size() << ")");
+        QL_REQUIRE(displacement >= 0.0,
+                   "displacement (" << displacement
+                   << ") must be non-negative");
+        QL_REQUIRE(forward + displacement > 0.0,
+                   "forward + displacement (" << forward << " + "
+                   << displacement << ") must be positive");
+        QL_REQUIRE(discount>0.0,
+                   "discount (" << discount << ") must be positive");
+
+        const Size n = strikes.size();
+        results.resize(n);
+        const Real shiftedForward = forward + displacement;
+        CumulativeNormalDistribution phi;
+        for (Size i=0; i<n; ++i) {
+            const Real strike = strikes[i], stdDev = stdDevs[i];
+            QL_REQUIRE(strike + displacement >= 0.0,
+                       "strike + displacement (" << strike << " + "
+                       << displacement << ") must be non-negative");
+            QL_REQUIRE(stdDev>=0.0,
+                       "stdDev (" << stdDev << ") must be non-negative");
+            if (stdDev==0.0) {
+                results[i] = std::max((forward-strike)*optionType,
+                                      Real(0.0))*discount;
+                continue;
+            }
+            const Real shiftedStrike = strike + displacement;
+            if (shiftedStrike==0.0) {
+                results[i] = (optionType==Option::Call ?
+                              shiftedForward*discount : 0.0);
+                continue;
+            }
+            Real d1 = std::log(shiftedForward/shiftedStrike)/stdDev
+                    + 0.5*stdDev;
+            Real d2 = d1 - stdDev;
+            Real result = discount * optionType *
+                (shiftedForward*phi(optionType*d1) -
+                 shiftedStrike*phi(optionType*d2));
+            QL_ENSURE(result>=0.0,
+                      "negative value (" << result << ") for " <<
+                      stdDev << " stdDev, " <<
+                      optionType << " option, " <<
+                      shiftedStrike << " strike , " <<
+                      shiftedForward << " forward");
+            results[i] = result;
+        }
+    }
+
+    void blackFormulaStdDevDerivative(const std::vector<Real>& strikes,
+                                      Real forward,
+                                      const std::vector<Real>& stdDevs,
+                                      std::vector<Real>& results,
+                                      Real discount,
+                                      Real displacement)
+    {
+        QL_REQUIRE(strikes.size() == stdDevs.size(),
+                   "mismatch between number of strikes ("
+                   << strikes.size() << ") and standard deviations ("
+                   << stdDevs.size() << ")");
+        QL_REQUIRE(displacement >= 0.0,
+                   "displacement (" << displacement
+                   << ") must be non-negative");
+        QL_REQUIRE(forward + displacement > 0.0,
+                   "forward + displacement (" << forward << " + "
+                   << displacement << ") must be positive");
+        QL_REQUIRE(discount>0.0,
+                   "discount (" << discount << ") must be positive");
+
+        const Size n = strikes.size();
+        results.resize(n);
+        const Real shiftedForward = forward + displacement;
+        CumulativeNormalDistribution phi;
+        for (Size i=0; i<n; ++i) {
+            const Real strike = strikes[i] + displacement;
+            const Real stdDev = stdDevs[i];
+            QL_REQUIRE(strike >= 0.0,
+                       "strike + displacement (" << strikes[i] << " + "
+                       << displacement << ") must be non-negative");
+            QL_REQUIRE(stdDev>=0.0,
+                       "stdDev (" << stdDev << ") must be non-negative");
+            if (stdDev==0.0 || strike==0.0) {
+                results[i] = 0.0;
+                continue;
+            }
+            Real d1 = std::log(shiftedForward/strike)/stdDev + .5*stdDev;
+            results[i] = discount * shiftedForward * phi.derivative(d1);
+        }
+    }
+
+    void blackFormulaImpliedStdDev(Option::Type optionType,
+                                   const std::vector<Real>& strikes,
+                                   Real forward,
+                                   const std::vector<Real>& blackPrices,
+                                   std::vector<Real>& stdDevs,
+                                   Real discount,
+                                   Real displacement,
+                                   Real accuracy,
+                                   Natural maxIterations)
+    {
+        QL_REQUIRE(strikes.size() == blackPrices.size(),
+                   "mismatch between number of strikes ("
+                   << strikes.size() << ") and prices ("
+                   << blackPrices.size() << ")");
+        const Size n = strikes.size();
+        stdDevs.resize(n);
+        for (Size i=0; i<n; ++i)
+            stdDevs[i] = blackFormulaImpliedStdDevHouseholder(
+                optionType, strikes[i], forward, blackPrices[i],
+                discount, displacement, accuracy, maxIterations);
+    }
+
+    void bachelierBlackFormula(Option::Type optionType,
+                               const std::vector<Real>& strikes,
+                               Real forward,
+                               const std::vector<Real>& stdDevs,
+                               std::vector<Real>& results,
+                               Real discount)
+    {
+        QL_REQUIRE(strikes.size() == stdDevs.size(),
+                   "mismatch between number of strikes ("
+                   << strikes.size() << ") and standard deviations ("
+                   << stdDevs.size() << ")");
+        QL_REQUIRE(discount>0.0,
+                   "discount (" << discount << ") must be positive");
+
+        const Size n = strikes.size();
+        results.resize(n);
+        CumulativeNormalDistribution phi;
+        for (Size i=0; i<n; ++i) {
+            const Real stdDev = stdDevs[i];
+            QL_REQUIRE(stdDev>=0.0,
+                       "stdDev (" << stdDev << ") must be non-negative");
+            Real d = (forward-strikes[i])*optionType;
+            if (stdDev==0.0) {
+                results[i] = discount*std::max(d, 0.0);
+                continue;
+            }
+            Real h = d/stdDev;
+            Real result = discount*(stdDev*phi.derivative(h) + d*phi(h));
+            QL_ENSURE(result>=0.0,
+                      "negative value (" << result << ") for " <<
+                      stdDev << " stdDev, " <<
+                      optionType << " option, " <<
+                      strikes[i] << " strike , " <<
+                      forward << " forward");
+            results[i] = result;
+        }
+    }
+
+    void bachelierBlackFormulaStdDevDerivative(
+                                      const std::vector<Real>& strikes,
+                                      Real forward,
+                                      const std::vector<Real>& stdDevs,
+                                      std::vector<Real>& results,
+                                      Real discount)
+    {
+        QL_REQUIRE(strikes.size() == stdDevs.size(),
+                   "mismatch between number of strikes ("
+                   << strikes.size() << ") and standard deviations ("
+                   << stdDevs.size() << ")");
+        QL_REQUIRE(discount>0.0,
+                   "discount (" << discount << ") must be positive");
+
+        const Size n = strikes.size();
+        results.resize(n);
+        CumulativeNormalDistribution phi;
+        for (Size i=0; i<n; ++i) {
+            const Real stdDev = stdDevs[i];
+            QL_REQUIRE(stdDev>=0.0,
+                       "stdDev (" << stdDev << ") must be non-negative");
+            results[i] = (stdDev==0.0) ? 0.0 :
+                discount*phi.derivative((forward-strikes[i])/stdDev);
+        }
+    }
+
+    void bachelierBlackFormulaImpliedVol(Option::Type optionType,
+                                         const std::vector<Real>& strikes,
+                                         Real forward,
+                                         Real tte,
+                                         const std::vector<Real>& prices,
+                                         std::vector<Real>& vols,
+                                         Real discount)
+    {
+        QL_REQUIRE(strikes.size() == prices.size(),
+                   "mismatch between number of strikes ("
+                   << strikes.size() << ") and prices ("
+                   << prices.size() << ")");
+        QL_REQUIRE(discount>0.0,
+                   "discount (" << discount << ") must be positive");
+
+        const Size n = strikes.size();
+        vols.resize(n);
+        const Real sqrtT = std::sqrt(tte);
+        CumulativeNormalDistribution phi;
+        for (Size i=0; i<n; ++i) {
+            Real vol = bachelierBlackFormulaImpliedVol(
+                optionType, strikes[i], forward, tte, prices[i], discount);
+            // the approximation is accurate to about 1e-10 relative;
+            // Newton steps on the undiscounted price polish it
+            Real target = prices[i]/discount;
+            Real d = (forward-strikes[i])*optionType;
+            for (Size k=0; k<2 && vol>0.0; ++k) {
+                Real s = vol*sqrtT, h = d/s;
+                Real vega = phi.derivative(h);
+                Real error = s*vega + d*phi(h) - target;
+                if (error == 0.0 || vega == 0.0)
+                    break;
+                Real next = (s - error/vega)/sqrtT;
+                if (!(next > 0.0))
+                    break;
+                Real s1 = next*sqrtT, h1 = d/s1;
+                Real error1 = s1*phi.derivative(h1) + d*phi(h1) - target;
+                if (std::fabs(error1) >= std::fabs(error))
+                    break;
+                vol = next;
+            }
+            vols[i] = vol;
+        }
+    }
 
 }
@@ -33,6 +33,7 @@
 
 #include <ql/option.hpp>
 #include <ql/instruments/payoffs.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -144,6 +145,40 @@ namespace QuantLib {
                         Real accuracy = 1.0e-6,
                         Natural maxIterations = 100);
 
+    /*! Black 1976 implied standard deviation,
+        i.e. volatility*sqrt(timeToMaturity).
+
+        The out-of-the-money option price is inverted by Householder
+        iterations of order 3, run on the price or on its logarithm
+        on either side of the inflection point of the price as a
+        function of the standard deviation, in the spirit of P.
+        Jaeckel, "Let's be rational", Wilmott (2015).  It usually
+        converges to the required relative accuracy in two or three
+        iterations and doesn't need an initial guess.
+    */
+    Real blackFormulaImpliedStdDevHouseholder(Option::Type optionType,
+                                              Real strike,
+                                              Real forward,
+                                              Real blackPrice,
+                                              Real discount = 1.0,
+                                              Real displacement = 0.0,
+                                              Real accuracy = 1.0e-14,
+                                              Natural maxIterations = 32);
+
+    /*! Black 1976 implied standard deviation,
+        i.e. volatility*sqrt(timeToMaturity).
+
+        \see the overload taking the option type and strike.
+    */
+    Real blackFormulaImpliedStdDevHouseholder(
+                        const boost::shared_ptr<PlainVanillaPayoff>& payoff,
+                        Real forward,
+                        Real blackPrice,
+                        Real discount = 1.0,
+                        Real displacement = 0.0,
+                        Real accuracy = 1.0e-14,
+                        Natural maxIterations = 32);
+
 
     /*! Black 1976 probability of being in the money (in the bond martingale
         measure), i.e. N(d2).
@@ -299,6 +334,75 @@ namespace QuantLib {
                                                 Real stdDev,
                                                 Real discount = 1.0);
 
+    /*! \name Batch calculations
+
+        The following functions apply the corresponding scalar
+        formula to a strip of strikes with the same forward, discount
+        and displacement, writing the results (resized if needed) in
+        the output vector.  Checks and constants are factored out of
+        the loop.
+    */
+    //@{
+    //! Black 1976 formula on a strip of strikes
+    void blackFormula(Option::Type optionType,
+                      const std::vector<Real>& strikes,
+                      Real forward,
+                      const std::vector<Real>& stdDevs,
+                      std::vector<Real>& results,
+                      Real discount = 1.0,
+                      Real displacement = 0.0);
+
+    //! Black 1976 standard deviation derivative on a strip of strikes
+    void blackFormulaStdDevDerivative(const std::vector<Real>& strikes,
+                                      Real forward,
+                                      const std::vector<Real>& stdDevs,
+                                      std::vector<Real>& results,
+                                      Real discount = 1.0,
+                                      Real displacement = 0.0);
+
+    /*! Black 1976 implied standard deviations on a strip of strikes;
+        \see blackFormulaImpliedStdDevHouseholder
+    */
+    void blackFormulaImpliedStdDev(Option::Type optionType,
+                                   const std::vector<Real>& strikes,
+                                   Real forward,
+                                   const std::vector<Real>& blackPrices,
+                                   std::vector<Real>& stdDevs,
+                                   Real discount = 1.0,
+                                   Real displacement = 0.0,
+                                   Real accuracy = 1.0e-14,
+                                   Natural maxIterations = 32);
+
+    //! Bachelier formula on a strip of strikes
+    void bachelierBlackFormula(Option::Type optionType,
+                               const std::vector<Real>& strikes,
+                               Real forward,
+                               const std::vector<Real>& stdDevs,
+                               std::vector<Real>& results,
+                               Real discount = 1.0);
+
+    //! Bachelier standard deviation derivative on a strip of strikes
+    void bachelierBlackFormulaStdDevDerivative(
+                                      const std::vector<Real>& strikes,
+                                      Real forward,
+                                      const std::vector<Real>& stdDevs,
+                                      std::vector<Real>& results,
+                                      Real discount = 1.0);
+
+    /*! Bachelier implied volatilities on a strip of strikes.  The
+        approximation by Choi, Kim and Kwak is polished by at most two
+        Newton steps, each accepted only if it reduces the pricing
+        error.
+    */
+    void bachelierBlackFormulaImpliedVol(Option::Type optionType,
+                                         const std::vector<Real>& strikes,
+                                         Real forward,
+                                         Real tte,
+                                         const std::vector<Real>& prices,
+                                         std::vector<Real>& vols,
+                                         Real discount = 1.0);
+    //@}
+
 }
 
 #endif
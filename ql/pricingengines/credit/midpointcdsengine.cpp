@@ -44,7 +44,6 @@ namespace QuantLib {
         QL_REQUIRE(!probability_.empty(),
                    "no probability term structure set");
 
-        Date today = Settings::instance().evaluationDate();
         Date settlementDate = discountCurve_->referenceDate();
 
         // Upfront Flow NPV and accrual rebate NPV. Either we are on-the-run (no flow)
@@ -68,65 +67,53 @@ namespace QuantLib {
 		results_.upfrontNPV = upfPVO1 * arguments_.upfrontPayment->amount();
 		results_.upfrontPV01 = upfPVO1;
 
-        results_.couponLegNPV  = 0.0;
-        results_.defaultLegNPV = 0.0;
-        for (Size i=0; i<arguments_.leg.size(); ++i) {
-            if (arguments_.leg[i]->hasOccurred(settlementDate,
-                                               includeSettlementDateFlows_))
-                continue;
+        std::vector<bool> alive(arguments_.leg.size());
+        for (Size i=0; i<arguments_.leg.size(); ++i)
+            alive[i] = !arguments_.leg[i]->hasOccurred(
+                                               settlementDate,
+                                               includeSettlementDateFlows_);
+        updatePeriods(alive);
 
-            boost::shared_ptr<FixedRateCoupon> coupon =
-                boost::dynamic_pointer_cast<FixedRateCoupon>(arguments_.leg[i]);
+        const Size n = periods_.coupons.size();
+        std::vector<Probability> S;
+        probability_->survivalProbability(periods_.survivalTimes, S);
+        std::vector<DiscountFactor> D;
+        discountCurve_->discount(periods_.discountTimes, D);
 
+        results_.couponLegNPV  = 0.0;
+        results_.defaultLegNPV = 0.0;
+        for (Size i=0; i<n; ++i) {
             // In order to avoid a few switches, we calculate the NPV
             // of both legs as a positive quantity. We'll give them
             // the right sign at the end.
 
-            Date paymentDate = coupon->date(),
-                 startDate = coupon->accrualStartDate(),
-                 endDate = coupon->accrualEndDate();
-            // this is the only point where it might not coincide
-            if (i==0)
-                startDate = arguments_.protectionStart;
-            Date effectiveStartDate =
-                (startDate <= today && today <= endDate) ? today : startDate;
-            Date defaultDate = // mid-point
-                effectiveStartDate + (endDate-effectiveStartDate)/2;
-
-            Probability S = probability_->survivalProbability(paymentDate);
-            Probability P = probability_->defaultProbability(
-                                                effectiveStartDate,
-                                                endDate);
+            Probability P = 1.0 - S[n+i];
+            if (periods_.startIndex[i] != Null<Size>())
+                P -= 1.0 - S[periods_.startIndex[i]];
 
             // on one side, we add the fixed rate payments in case of
             // survival...
-            results_.couponLegNPV +=
-                S * coupon->amount() *
-                discountCurve_->discount(paymentDate);
+            results_.couponLegNPV += S[i] * periods_.amounts[i] * D[i];
             // ...possibly including accrual in case of default.
             if (arguments_.settlesAccrual) {
                 if (arguments_.paysAtDefaultTime) {
                     results_.couponLegNPV +=
-                        P * coupon->accruedAmount(defaultDate) *
-                        discountCurve_->discount(defaultDate);
+                        P * periods_.accruals[i] * D[n+i];
                 } else {
                     // pays at the end
                     results_.couponLegNPV +=
-                        P * coupon->amount() *
-                        discountCurve_->discount(paymentDate);
+                        P * periods_.amounts[i] * D[i];
                 }
             }
 
             // on the other side, we add the payment in case of default.
-            Real claim = arguments_.claim->amount(defaultDate,
+            Real claim = arguments_.claim->amount(periods_.defaultDates[i],
                                                   arguments_.notional,
                                                   recoveryRate_);
             if (arguments_.paysAtDefaultTime) {
-                results_.defaultLegNPV +=
-                    P * claim * discountCurve_->discount(defaultDate);
+                results_.defaultLegNPV += P * claim * D[n+i];
             } else {
-                results_.defaultLegNPV +=
-                    P * claim * discountCurve_->discount(paymentDate);
+                results_.defaultLegNPV += P * claim * D[i];
             }
         }
 
@@ -182,5 +169,98 @@ namespace QuantLib {
         }
     }
 
-}
+    void MidPointCdsEngine::updatePeriods(
+                                    const std::vector<bool>& alive) const {
+        Date today = Settings::instance().evaluationDate();
+        Periods& p = periods_;
+        if (p.leg == arguments_.leg && p.alive == alive && p.today == today
+            && p.protectionStart == arguments_.protectionStart
+            && p.probabilityReference == probability_->referenceDate()
+            && p.discountReference == discountCurve_->referenceDate()
+            && p.probabilityDayCounter == probability_->dayCounter()
+            && p.discountDayCounter == discountCurve_->dayCounter()
+            && p.settlesAccrual == arguments_.settlesAccrual
+            && p.paysAtDefaultTime == arguments_.paysAtDefaultTime)
+            return;
+
+        p.leg = arguments_.leg;
+        p.alive = alive;
+        p.today = today;
+        p.protectionStart = arguments_.protectionStart;
+        p.probabilityReference = probability_->referenceDate();
+        p.discountReference = discountCurve_->referenceDate();
+        p.probabilityDayCounter = probability_->dayCounter();
+        p.discountDayCounter = discountCurve_->dayCounter();
+        p.settlesAccrual = arguments_.settlesAccrual;
+        p.paysAtDefaultTime = arguments_.paysAtDefaultTime;
+
+        p.coupons.clear();
+        p.defaultDates.clear();
+        p.amounts.clear();
+        p.accruals.clear();
+        std::vector<Time> paymentTimes, endTimes, startTimes;
+        std::vector<Time> discountPaymentTimes, discountDefaultTimes;
+        std::vector<Size> startIndex;
+        for (Size i=0; i<p.leg.size(); ++i) {
+            if (!alive[i])
+                continue;
+
+            boost::shared_ptr<FixedRateCoupon> coupon =
+                boost::dynamic_pointer_cast<FixedRateCoupon>(p.leg[i]);
+            QL_REQUIRE(coupon, "fixed-rate coupon required");
+
+            Date paymentDate = coupon->date(),
+                 startDate = coupon->accrualStartDate(),
+                 endDate = coupon->accrualEndDate();
+            // this is the only point where it might not coincide
+            if (i==0)
+                startDate = p.protectionStart;
+            Date effectiveStartDate =
+                (startDate <= today && today <= endDate) ? today : startDate;
+            Date defaultDate = // mid-point
+                effectiveStartDate + (endDate-effectiveStartDate)/2;
+            QL_REQUIRE(effectiveStartDate <= endDate,
+                       "initial date (" << effectiveStartDate << ") "
+                       "later than final date (" << endDate << ")");
+
+            p.coupons.push_back(coupon);
+            p.defaultDates.push_back(defaultDate);
+            p.amounts.push_back(coupon->amount());
+            p.accruals.push_back(p.settlesAccrual && p.paysAtDefaultTime ?
+                                 coupon->accruedAmount(defaultDate) : 0.0);
 
+            paymentTimes.push_back(
+                              probability_->timeFromReference(paymentDate));
+            endTimes.push_back(probability_->timeFromReference(endDate));
+            if (effectiveStartDate < p.probabilityReference) {
+                startIndex.push_back(Null<Size>());
+            } else {
+                startIndex.push_back(startTimes.size());
+                startTimes.push_back(
+                       probability_->timeFromReference(effectiveStartDate));
+            }
+            discountPaymentTimes.push_back(
+                            discountCurve_->timeFromReference(paymentDate));
+            if (p.paysAtDefaultTime)
+                discountDefaultTimes.push_back(
+                            discountCurve_->timeFromReference(defaultDate));
+        }
+
+        const Size n = p.coupons.size();
+        p.survivalTimes = paymentTimes;
+        p.survivalTimes.insert(p.survivalTimes.end(),
+                               endTimes.begin(), endTimes.end());
+        p.survivalTimes.insert(p.survivalTimes.end(),
+                               startTimes.begin(), startTimes.end());
+        p.startIndex = startIndex;
+        for (Size i=0; i<n; ++i) {
+            if (p.startIndex[i] != Null<Size>())
+                p.startIndex[i] += 2*n;
+        }
+        p.discountTimes = discountPaymentTimes;
+        p.discountTimes.insert(p.discountTimes.end(),
+                               discountDefaultTimes.begin(),
+                               discountDefaultTimes.end());
+    }
+
+}
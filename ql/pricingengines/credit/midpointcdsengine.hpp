@@ -27,9 +27,22 @@
 #define quantlib_mid_point_cds_engine_hpp
 
 #include <ql/instruments/creditdefaultswap.hpp>
+#include <ql/cashflows/fixedratecoupon.hpp>
 
 namespace QuantLib {
 
+    //! Mid-point engine for credit default swaps
+    /*! Default is assumed to occur, if at all, in the middle of each
+        coupon period.
+
+        The coupon periods of the priced swap, i.e., their amounts,
+        accruals and curve times, only depend on the curves through
+        their reference dates and day counters.  They are calculated
+        once and reused while these and the swap are unchanged, so
+        that the repricings of a swap on moving curves (e.g., by the
+        bootstrap of a default curve on CDS helpers) only evaluate
+        the curves, in a single batch per curve.
+    */
     class MidPointCdsEngine : public CreditDefaultSwap::engine {
       public:
         MidPointCdsEngine(
@@ -39,10 +52,32 @@ namespace QuantLib {
               boost::optional<bool> includeSettlementDateFlows = boost::none);
         void calculate() const;
       private:
+        // coupon periods still to be paid and their curve times
+        struct Periods {
+            Leg leg;
+            std::vector<bool> alive;
+            Date today, protectionStart;
+            Date probabilityReference, discountReference;
+            DayCounter probabilityDayCounter, discountDayCounter;
+            bool settlesAccrual, paysAtDefaultTime;
+            std::vector<boost::shared_ptr<FixedRateCoupon> > coupons;
+            std::vector<Date> defaultDates;
+            std::vector<Real> amounts, accruals;
+            /* survival times at the payment dates, at the ends and at
+               the (effective) starts of the periods; the starts before
+               the reference date have no probability of default and
+               are not included. */
+            std::vector<Time> survivalTimes;
+            std::vector<Size> startIndex;
+            // discount times at the payment and default dates
+            std::vector<Time> discountTimes;
+        };
+        void updatePeriods(const std::vector<bool>& alive) const;
         Handle<DefaultProbabilityTermStructure> probability_;
         Real recoveryRate_;
         Handle<YieldTermStructure> discountCurve_;
         boost::optional<bool> includeSettlementDateFlows_;
+        mutable Periods periods_;
     };
 
 }
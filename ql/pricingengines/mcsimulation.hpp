@@ -55,6 +55,12 @@ namespace QuantLib {
         result_type value(Real tolerance,
                           Size maxSamples = QL_MAX_INTEGER,
                           Size minSamples = 1023) const;
+        /*! add fixed size batches of samples until the required
+            absolute tolerance is reached; see valueInBatches() */
+        result_type valueInBatches(Real tolerance,
+                                   Size batchSize,
+                                   Size maxSamples = QL_MAX_INTEGER,
+                                   Size minSamples = 1023) const;
         //! simulate a fixed number of samples
         result_type valueWithSamples(Size samples) const;
         //! error estimated using the samples simulated so far
@@ -65,11 +71,14 @@ namespace QuantLib {
         void calculate(Real requiredTolerance,
                        Size requiredSamples,
                        Size maxSamples) const;
+        /*! if a batch size is set, calculate() reaches a required
+            tolerance through valueInBatches() instead of value() */
+        void setBatchSize(Size batchSize) { batchSize_ = batchSize; }
       protected:
         McSimulation(bool antitheticVariate,
                      bool controlVariate)
         : antitheticVariate_(antitheticVariate),
-          controlVariate_(controlVariate) {}
+          controlVariate_(controlVariate), batchSize_(Null<Size>()) {}
         virtual boost::shared_ptr<path_pricer_type> pathPricer() const = 0;
         virtual boost::shared_ptr<path_generator_type> pathGenerator()
                                                                    const = 0;
@@ -97,6 +106,7 @@ namespace QuantLib {
         
         mutable boost::shared_ptr<MonteCarloModel<MC,RNG,S> > mcModel_;
         bool antitheticVariate_, controlVariate_;
+        Size batchSize_;
     };
 
 
@@ -139,6 +149,71 @@ namespace QuantLib {
     }
 
 
+    /*! The samples are simulated in rounds of RNG::maxNumberOfThreads
+        batches of batchSize samples each. The batches of one round run
+        concurrently (when OpenMP is enabled), batch k always drawing
+        from the generator stream k. After each round the batches are
+        added to the sample accumulator in stream order and the error
+        estimate is checked after each batch, so that the simulation
+        stops as soon as the tolerance is reached. The result therefore
+        only depends on the seed and the batch size, but not on the
+        number of threads actually used or their scheduling.
+    */
+    template <template <class> class MC, class RNG, class S>
+    inline typename McSimulation<MC,RNG,S>::result_type
+        McSimulation<MC,RNG,S>::valueInBatches(Real tolerance,
+                                               Size batchSize,
+                                               Size maxSamples,
+                                               Size minSamples) const {
+        QL_REQUIRE(batchSize > 0, "batch size must be positive");
+
+        const Size streams = RNG::maxNumberOfThreads;
+        std::vector<std::vector<std::pair<result_type, Real> > >
+            batches(streams);
+
+        Size sampleNumber = mcModel_->sampleAccumulator().samples();
+        result_type error = result_type();
+        bool converged = false;
+        if (sampleNumber >= minSamples) {
+            error = result_type(mcModel_->sampleAccumulator().errorEstimate());
+            converged = maxError(error) <= tolerance;
+        }
+
+        while (!converged) {
+            QL_REQUIRE(sampleNumber<maxSamples,
+                       "max number of samples (" << maxSamples
+                       << ") reached, while error (" << error
+                       << ") is still above tolerance (" << tolerance << ")");
+
+            std::vector<Size> size(streams, 0);
+            for (Size k=0, left=maxSamples-sampleNumber;
+                 k<streams && left>0; ++k) {
+                size[k] = std::min(batchSize, left);
+                left -= size[k];
+            }
+
+#pragma omp parallel for schedule(static,1) if(RNG::maxNumberOfThreads > 1)
+            for (Size k=0; k<streams; ++k) {
+                mcModel_->simulateBatch(size[k],
+                                        static_cast<unsigned int>(k),
+                                        batches[k]);
+            }
+
+            for (Size k=0; k<streams && size[k]>0 && !converged; ++k) {
+                mcModel_->addBatch(batches[k]);
+                sampleNumber += size[k];
+                if (sampleNumber >= minSamples) {
+                    error = result_type(
+                        mcModel_->sampleAccumulator().errorEstimate());
+                    converged = maxError(error) <= tolerance;
+                }
+            }
+        }
+
+        return result_type(mcModel_->sampleAccumulator().mean());
+    }
+
+
     template <template <class> class MC, class RNG, class S>
     inline typename McSimulation<MC,RNG,S>::result_type
         McSimulation<MC,RNG,S>::valueWithSamples(Size samples) const {
@@ -196,7 +271,13 @@ namespace QuantLib {
         }
 
         if (requiredTolerance != Null<Real>()) {
-            if (maxSamples != Null<Size>())
+            if (batchSize_ != Null<Size>()) {
+                if (maxSamples != Null<Size>())
+                    this->valueInBatches(requiredTolerance, batchSize_,
+                                         maxSamples);
+                else
+                    this->valueInBatches(requiredTolerance, batchSize_);
+            } else if (maxSamples != Null<Size>())
                 this->value(requiredTolerance, maxSamples);
             else
                 this->value(requiredTolerance);
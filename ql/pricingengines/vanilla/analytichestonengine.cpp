@@ -32,6 +32,8 @@
 #include <ql/instruments/payoffs.hpp>
 #include <ql/pricingengines/vanilla/analytichestonengine.hpp>
 
+#include <algorithm>
+
 #if defined(QL_PATCH_MSVC)
 #pragma warning(disable: 4180)
 #endif
@@ -105,6 +107,8 @@ namespace QuantLib {
             Size j);
 
         Real operator()(Real phi)      const;
+        //! strike-independent part of the exponent for phi != 0
+        std::complex<Real> exponent(Real phi) const;
 
     private:
         const Size j_;
@@ -204,7 +208,8 @@ namespace QuantLib {
     }
 
 
-    Real AnalyticHestonEngine::Fj_Helper::operator()(Real phi) const
+    std::complex<Real>
+    AnalyticHestonEngine::Fj_Helper::exponent(Real phi) const
     {
         const Real rpsig(rsigma_*phi);
 
@@ -214,57 +219,27 @@ namespace QuantLib {
                       *std::complex<Real>(-phi, (j_== 1)? 1 : -1));
         const std::complex<Real> ex = std::exp(-d*term_);
         const std::complex<Real> addOnTerm
-            = engine_ > 0 ? engine_->addOnTerm(phi, term_, j_) : Real(0.0);
+            = engine_ != 0 ? engine_->addOnTerm(phi, term_, j_) : Real(0.0);
 
         if (cpxLog_ == Gatheral) {
-            if (phi != 0.0) {
-                if (sigma_ > 1e-5) {
-                    const std::complex<Real> p = (t1-d)/(t1+d);
-                    const std::complex<Real> g
-                                            = std::log((1.0 - p*ex)/(1.0 - p));
-
-                    return
-                        std::exp(v0_*(t1-d)*(1.0-ex)/(sigma2_*(1.0-ex*p))
-                                 + (kappa_*theta_)/sigma2_*((t1-d)*term_-2.0*g)
-                                 + std::complex<Real>(0.0, phi*(dd_-sx_))
-                                 + addOnTerm
-                                 ).imag()/phi;
-                }
-                else {
-                    const std::complex<Real> td = phi/(2.0*t1)
-                                   *std::complex<Real>(-phi, (j_== 1)? 1 : -1);
-                    const std::complex<Real> p = td*sigma2_/(t1+d);
-                    const std::complex<Real> g = p*(1.0-ex);
-
-                    return
-                        std::exp(v0_*td*(1.0-ex)/(1.0-p*ex)
-                                 + (kappa_*theta_)*(td*term_-2.0*g/sigma2_)
-                                 + std::complex<Real>(0.0, phi*(dd_-sx_))
-                                 + addOnTerm
-                                 ).imag()/phi;
-                }
+            if (sigma_ > 1e-5) {
+                const std::complex<Real> p = (t1-d)/(t1+d);
+                const std::complex<Real> g
+                                        = std::log((1.0 - p*ex)/(1.0 - p));
+
+                return v0_*(t1-d)*(1.0-ex)/(sigma2_*(1.0-ex*p))
+                       + (kappa_*theta_)/sigma2_*((t1-d)*term_-2.0*g)
+                       + addOnTerm;
             }
             else {
-                // use l'Hospital's rule to get lim_{phi->0}
-                if (j_ == 1) {
-                    const Real kmr = rsigma_-kappa_;
-                    if (std::fabs(kmr) > 1e-7) {
-                        return dd_-sx_
-                            + (std::exp(kmr*term_)*kappa_*theta_
-                               -kappa_*theta_*(kmr*term_+1.0) ) / (2*kmr*kmr)
-                            - v0_*(1.0-std::exp(kmr*term_)) / (2.0*kmr);
-                    }
-                    else
-                        // \kappa = \rho * \sigma
-                        return dd_-sx_ + 0.25*kappa_*theta_*term_*term_
-                                       + 0.5*v0_*term_;
-                }
-                else {
-                    return dd_-sx_
-                        - (std::exp(-kappa_*term_)*kappa_*theta_
-                           +kappa_*theta_*(kappa_*term_-1.0))/(2*kappa_*kappa_)
-                        - v0_*(1.0-std::exp(-kappa_*term_))/(2*kappa_);
-                }
+                const std::complex<Real> td = phi/(2.0*t1)
+                               *std::complex<Real>(-phi, (j_== 1)? 1 : -1);
+                const std::complex<Real> p = td*sigma2_/(t1+d);
+                const std::complex<Real> g = p*(1.0-ex);
+
+                return v0_*td*(1.0-ex)/(1.0-p*ex)
+                       + (kappa_*theta_)*(td*term_-2.0*g/sigma2_)
+                       + addOnTerm;
             }
         }
         else if (cpxLog_ == BranchCorrection) {
@@ -310,17 +285,45 @@ namespace QuantLib {
             g_km1_ = g.imag();
             g += std::complex<Real>(0, 2*b_*M_PI);
 
-            return std::exp(v0_*(t1+d)*(ex-1.0)/(sigma2_*(ex-p))
-                            + (kappa_*theta_)/sigma2_*((t1+d)*term_-2.0*g)
-                            + std::complex<Real>(0,phi*(dd_-sx_))
-                            + addOnTerm
-                            ).imag()/phi;
+            return v0_*(t1+d)*(ex-1.0)/(sigma2_*(ex-p))
+                   + (kappa_*theta_)/sigma2_*((t1+d)*term_-2.0*g)
+                   + addOnTerm;
         }
         else {
             QL_FAIL("unknown complex logarithm formula");
         }
     }
 
+    Real AnalyticHestonEngine::Fj_Helper::operator()(Real phi) const
+    {
+        if (cpxLog_ == Gatheral && phi == 0.0) {
+            // use l'Hospital's rule to get lim_{phi->0}
+            if (j_ == 1) {
+                const Real kmr = rsigma_-kappa_;
+                if (std::fabs(kmr) > 1e-7) {
+                    return dd_-sx_
+                        + (std::exp(kmr*term_)*kappa_*theta_
+                           -kappa_*theta_*(kmr*term_+1.0) ) / (2*kmr*kmr)
+                        - v0_*(1.0-std::exp(kmr*term_)) / (2.0*kmr);
+                }
+                else
+                    // \kappa = \rho * \sigma
+                    return dd_-sx_ + 0.25*kappa_*theta_*term_*term_
+                                   + 0.5*v0_*term_;
+            }
+            else {
+                return dd_-sx_
+                    - (std::exp(-kappa_*term_)*kappa_*theta_
+                       +kappa_*theta_*(kappa_*term_-1.0))/(2*kappa_*kappa_)
+                    - v0_*(1.0-std::exp(-kappa_*term_))/(2*kappa_);
+            }
+        }
+
+        return std::exp(exponent(phi)
+                        + std::complex<Real>(0.0, phi*(dd_-sx_))
+                        ).imag()/phi;
+    }
+
     AnalyticHestonEngine::AnalyticHestonEngine(
                               const boost::shared_ptr<HestonModel>& model,
                               Size integrationOrder)
@@ -411,6 +414,138 @@ namespace QuantLib {
         }
     }
 
+    void AnalyticHestonEngine::update() {
+        nodes_.clear();
+        GenericModelEngine<HestonModel,
+                           VanillaOption::arguments,
+                           VanillaOption::results>::update();
+    }
+
+    const AnalyticHestonEngine::Nodes&
+    AnalyticHestonEngine::nodes(Time term) const {
+        // the cached values are invalidated when the parameters change
+        // even if the notification is deferred
+        const Array params = model_->params();
+        if (params.size() != nodesParams_.size()
+            || !std::equal(params.begin(), params.end(),
+                           nodesParams_.begin())) {
+            nodes_.clear();
+            nodesParams_ = params;
+        }
+
+        std::map<Time, Nodes>::const_iterator i = nodes_.find(term);
+        if (i != nodes_.end())
+            return i->second;
+
+        if (nodes_.size() >= maxCachedTerms)
+            nodes_.clear();
+
+        const Real kappa = model_->kappa(), theta = model_->theta();
+        const Real sigma = model_->sigma(), v0 = model_->v0();
+        const Real rho = model_->rho();
+        const Real c_inf = std::min(10.0, std::max(0.0001,
+                std::sqrt(1.0-square<Real>()(rho))/sigma))
+                *(v0 + kappa*theta*term);
+
+        Nodes& n = nodes_[term];
+        std::vector<Real> w;
+        integration_->quadrature(c_inf, n.phi, w);
+        const Size size = n.phi.size();
+        n.weight1.resize(size); n.angle1.resize(size);
+        n.weight2.resize(size); n.angle2.resize(size);
+
+        // the nodes are visited in the same order as in the quadrature,
+        // which is required by the branch correction
+        Fj_Helper f1(kappa, theta, sigma, v0, 1.0, rho, this,
+                     cpxLog_, term, 1.0, 1.0, 1);
+        Fj_Helper f2(kappa, theta, sigma, v0, 1.0, rho, this,
+                     cpxLog_, term, 1.0, 1.0, 2);
+        for (Size k=0; k<size; ++k) {
+            const Real phi = n.phi[k];
+            const std::complex<Real> z1 = f1.exponent(phi);
+            n.weight1[k] = w[k]*std::exp(z1.real())/phi;
+            n.angle1[k] = z1.imag();
+            const std::complex<Real> z2 = f2.exponent(phi);
+            n.weight2[k] = w[k]*std::exp(z2.real())/phi;
+            n.angle2[k] = z2.imag();
+        }
+        return n;
+    }
+
+    Real AnalyticHestonEngine::nodesValue(const Nodes& n,
+                                          Real riskFreeDiscount,
+                                          Real dividendDiscount,
+                                          Real spotPrice,
+                                          Real strikePrice,
+                                          Option::Type type) {
+        // Im(exp(z + i*phi*(dd-sx))) = exp(Re z)*sin(Im z + phi*(dd-sx))
+        const Real ratio = riskFreeDiscount/dividendDiscount;
+        const Real shift = std::log(spotPrice) - std::log(ratio)
+                         - std::log(strikePrice);
+        Real p1 = 0.0, p2 = 0.0;
+        for (Size k=0; k<n.phi.size(); ++k) {
+            const Real a = n.phi[k]*shift;
+            p1 += n.weight1[k]*std::sin(n.angle1[k] + a);
+            p2 += n.weight2[k]*std::sin(n.angle2[k] + a);
+        }
+        p1 /= M_PI;
+        p2 /= M_PI;
+
+        switch (type) {
+          case Option::Call:
+            return spotPrice*dividendDiscount*(p1+0.5)
+                - strikePrice*riskFreeDiscount*(p2+0.5);
+          case Option::Put:
+            return spotPrice*dividendDiscount*(p1-0.5)
+                - strikePrice*riskFreeDiscount*(p2-0.5);
+          default:
+            QL_FAIL("unknown option type");
+        }
+    }
+
+    void AnalyticHestonEngine::calculateStrip(
+                                    const Date& exerciseDate,
+                                    const std::vector<Real>& strikes,
+                                    const std::vector<Option::Type>& types,
+                                    std::vector<Real>& values) const {
+        QL_REQUIRE(strikes.size() == types.size(),
+                   "mismatch between number of strikes ("
+                   << strikes.size() << ") and option types ("
+                   << types.size() << ")");
+
+        const boost::shared_ptr<HestonProcess>& process = model_->process();
+
+        const Real riskFreeDiscount =
+            process->riskFreeRate()->discount(exerciseDate);
+        const Real dividendDiscount =
+            process->dividendYield()->discount(exerciseDate);
+
+        const Real spotPrice = process->s0()->value();
+        QL_REQUIRE(spotPrice > 0.0, "negative or null underlying given");
+
+        const Time term = process->time(exerciseDate);
+
+        values.resize(strikes.size());
+        if (integration_->isAdaptiveIntegration()) {
+            for (Size i=0; i<strikes.size(); ++i) {
+                Size evaluations;
+                doCalculation(riskFreeDiscount, dividendDiscount,
+                              spotPrice, strikes[i], term,
+                              model_->kappa(), model_->theta(),
+                              model_->sigma(), model_->v0(), model_->rho(),
+                              PlainVanillaPayoff(types[i], strikes[i]),
+                              *integration_, cpxLog_, this,
+                              values[i], evaluations);
+            }
+        } else {
+            const Nodes& n = nodes(term);
+            for (Size i=0; i<strikes.size(); ++i)
+                values[i] = nodesValue(n, riskFreeDiscount,
+                                       dividendDiscount, spotPrice,
+                                       strikes[i], types[i]);
+        }
+    }
+
     void AnalyticHestonEngine::calculate() const
     {
         // this is a european option pricer
@@ -435,22 +570,30 @@ namespace QuantLib {
         const Real strikePrice = payoff->strike();
         const Real term = process->time(arguments_.exercise->lastDate());
 
-        doCalculation(riskFreeDiscount,
-                      dividendDiscount,
-                      spotPrice,
-                      strikePrice,
-                      term,
-                      model_->kappa(),
-                      model_->theta(),
-                      model_->sigma(),
-                      model_->v0(),
-                      model_->rho(),
-                      *payoff,
-                      *integration_,
-                      cpxLog_,
-                      this,
-                      results_.value,
-                      evaluations_);
+        if (!integration_->isAdaptiveIntegration()) {
+            results_.value = nodesValue(nodes(term),
+                                        riskFreeDiscount, dividendDiscount,
+                                        spotPrice, strikePrice,
+                                        payoff->optionType());
+            evaluations_ = 2*integration_->numberOfEvaluations();
+        } else {
+            doCalculation(riskFreeDiscount,
+                          dividendDiscount,
+                          spotPrice,
+                          strikePrice,
+                          term,
+                          model_->kappa(),
+                          model_->theta(),
+                          model_->sigma(),
+                          model_->v0(),
+                          model_->rho(),
+                          *payoff,
+                          *integration_,
+                          cpxLog_,
+                          this,
+                          results_.value,
+                          evaluations_);
+        }
     }
 
 
@@ -546,6 +689,28 @@ namespace QuantLib {
         }
     }
 
+    void AnalyticHestonEngine::Integration::quadrature(
+                                        Real c_inf,
+                                        std::vector<Real>& phi,
+                                        std::vector<Real>& weights) const {
+        QL_REQUIRE(gaussianQuadrature_,
+                   "quadrature nodes not available for adaptive integration");
+        const Array& x = gaussianQuadrature_->x();
+        const Array& w = gaussianQuadrature_->weights();
+        phi.clear();
+        weights.clear();
+        // same order and change of variable as in calculate()
+        for (Integer i = x.size()-1; i >= 0; --i) {
+            if (intAlgo_ == GaussLaguerre) {
+                phi.push_back(x[i]);
+                weights.push_back(w[i]);
+            } else if ((x[i]+1.0)*c_inf > QL_EPSILON) {
+                phi.push_back(-std::log(0.5*x[i]+0.5)/c_inf);
+                weights.push_back(w[i]/((x[i]+1.0)*c_inf));
+            }
+        }
+    }
+
     bool AnalyticHestonEngine::Integration::isAdaptiveIntegration() const {
         return intAlgo_ == GaussLobatto
             || intAlgo_ == GaussKronrod
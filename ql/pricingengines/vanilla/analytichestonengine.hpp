@@ -33,6 +33,8 @@
 
 #include <boost/function.hpp>
 #include <complex>
+#include <map>
+#include <vector>
 
 namespace QuantLib {
 
@@ -103,8 +105,26 @@ namespace QuantLib {
 
 
         void calculate() const;
+        void update();
         Size numberOfEvaluations() const;
 
+        /*! Values of European plain-vanilla options with the given
+            strikes and types and a common exercise date.
+
+            With a non-adaptive integration, the parts of the
+            integrands not depending on the strike are evaluated once
+            at the quadrature nodes for each exercise time, and cached
+            until the model parameters change; each option then costs
+            a sine per node.  The same cache is used by calculate(),
+            so that calibrating to several strikes per maturity
+            through HestonModelHelper benefits from it as well.  With
+            adaptive integration, the options are priced one by one.
+        */
+        virtual void calculateStrip(const Date& exerciseDate,
+                                    const std::vector<Real>& strikes,
+                                    const std::vector<Option::Type>& types,
+                                    std::vector<Real>& values) const;
+
         static void doCalculation(Real riskFreeDiscount,
                                              Real dividendDiscount,
                                              Real spotPrice,
@@ -120,17 +140,35 @@ namespace QuantLib {
 
       protected:
         // call back for extended stochastic volatility
-        // plus jump diffusion engines like bates model
+        // plus jump diffusion engines like bates model.
+        // Its results are cached per exercise time; engines whose
+        // add-on term depends on data other than the model parameters
+        // must call AnalyticHestonEngine::update() when they change.
         virtual std::complex<Real> addOnTerm(Real phi,
                                              Time t,
                                              Size j) const;
 
       private:
         class Fj_Helper;
+        // strike-independent part of the integrands at the nodes
+        struct Nodes {
+            std::vector<Real> phi;
+            std::vector<Real> weight1, angle1, weight2, angle2;
+        };
+        enum { maxCachedTerms = 128 };
+        const Nodes& nodes(Time term) const;
+        static Real nodesValue(const Nodes& nodes,
+                               Real riskFreeDiscount,
+                               Real dividendDiscount,
+                               Real spotPrice,
+                               Real strikePrice,
+                               Option::Type type);
 
         mutable Size evaluations_;
         const ComplexLogFormula cpxLog_;
         const boost::shared_ptr<Integration> integration_;
+        mutable Array nodesParams_;
+        mutable std::map<Time, Nodes> nodes_;
     };
 
 
@@ -160,6 +198,14 @@ namespace QuantLib {
         Real calculate(Real c_inf,
                        const boost::function1<Real, Real>& f) const;
 
+        /*! nodes, in the Fourier variable, and weights of a
+            non-adaptive integration, in the order in which they are
+            evaluated by calculate()
+        */
+        void quadrature(Real c_inf,
+                        std::vector<Real>& phi,
+                        std::vector<Real>& weights) const;
+
         Size numberOfEvaluations() const;
         bool isAdaptiveIntegration() const;
 
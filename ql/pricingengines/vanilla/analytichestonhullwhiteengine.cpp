@@ -52,8 +52,21 @@ namespace QuantLib {
     }
 
     void AnalyticHestonHullWhiteEngine::calculate() const {
+        calculateM(model_->process()->time(arguments_.exercise->lastDate()));
+        AnalyticHestonEngine::calculate();
+    }
+
+    void AnalyticHestonHullWhiteEngine::calculateStrip(
+                                    const Date& exerciseDate,
+                                    const std::vector<Real>& strikes,
+                                    const std::vector<Option::Type>& types,
+                                    std::vector<Real>& values) const {
+        calculateM(model_->process()->time(exerciseDate));
+        AnalyticHestonEngine::calculateStrip(exerciseDate, strikes,
+                                             types, values);
+    }
 
-        const Real t = model_->process()->time(arguments_.exercise->lastDate());
+    void AnalyticHestonHullWhiteEngine::calculateM(Time t) const {
         if (a_*t > std::pow(QL_EPSILON, 0.25)) {
             m_ = sigma_*sigma_/(2*a_*a_)
                 *(t+2/a_*std::exp(-a_*t)-1/(2*a_)*std::exp(-2*a_*t)-3/(2*a_));
@@ -62,8 +75,6 @@ namespace QuantLib {
             // low-a algebraic limit
             m_ = 0.5*sigma_*sigma_*t*t*t*(1/3.0-0.25*a_*t+7/60.0*a_*a_*t*t);
         }
-
-        AnalyticHestonEngine::calculate();
     }
 
 }
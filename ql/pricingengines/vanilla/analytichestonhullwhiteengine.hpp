@@ -78,6 +78,10 @@ namespace QuantLib {
 
         void update();
         void calculate() const;
+        void calculateStrip(const Date& exerciseDate,
+                            const std::vector<Real>& strikes,
+                            const std::vector<Option::Type>& types,
+                            std::vector<Real>& values) const;
 
       protected:
         std::complex<Real> addOnTerm(Real phi, Time t, Size j) const;
@@ -85,6 +89,7 @@ namespace QuantLib {
         const boost::shared_ptr<HullWhite> hullWhiteModel_;
 
       private:
+        void calculateM(Time t) const;
         mutable Real m_;
         mutable Real a_, sigma_;
     };
@@ -65,7 +65,9 @@ namespace QuantLib {
              LsmBasisSystem::PolynomType polynomType,
              Size nCalibrationSamples = Null<Size>(),
              boost::optional<bool> antitheticVariateCalibration = boost::none,
-             BigNatural seedCalibration = Null<Size>());
+             BigNatural seedCalibration = Null<Size>(),
+             LsmCalibrationStorage::Type calibrationStorage =
+                 LsmCalibrationStorage::Paths);
 
         void calculate() const;
         
@@ -80,6 +82,7 @@ namespace QuantLib {
       private:
         const Size polynomOrder_;
         const LsmBasisSystem::PolynomType polynomType_;
+        const LsmCalibrationStorage::Type calibrationStorage_;
     };
 
     class AmericanPathPricer : public EarlyExercisePathPricer<Path>  {
@@ -123,6 +126,8 @@ namespace QuantLib {
         MakeMCAmericanEngine& withCalibrationSamples(Size calibrationSamples);
         MakeMCAmericanEngine& withAntitheticVariateCalibration(bool b = true);
         MakeMCAmericanEngine& withSeedCalibration(BigNatural seed);
+        MakeMCAmericanEngine& withCalibrationStorage(
+                                               LsmCalibrationStorage::Type);
 
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
@@ -137,6 +142,7 @@ namespace QuantLib {
         LsmBasisSystem::PolynomType polynomType_;
         boost::optional<bool> antitheticCalibration_;
         BigNatural seedCalibration_;
+        LsmCalibrationStorage::Type calibrationStorage_;
     };
 
     template <class RNG, class S, class RNG_Calibration>
@@ -147,14 +153,16 @@ namespace QuantLib {
         Size maxSamples, BigNatural seed, Size polynomOrder,
         LsmBasisSystem::PolynomType polynomType, Size nCalibrationSamples,
         boost::optional<bool> antitheticVariateCalibration,
-        BigNatural seedCalibration)
+        BigNatural seedCalibration,
+        LsmCalibrationStorage::Type calibrationStorage)
         : MCLongstaffSchwartzEngine<VanillaOption::engine, SingleVariate, RNG,
                                     S, RNG_Calibration>(
               process, timeSteps, timeStepsPerYear, false, antitheticVariate,
               controlVariate, requiredSamples, requiredTolerance, maxSamples,
               seed, nCalibrationSamples, false, antitheticVariateCalibration,
               seedCalibration),
-          polynomOrder_(polynomOrder), polynomType_(polynomType) {}
+          polynomOrder_(polynomOrder), polynomType_(polynomType),
+          calibrationStorage_(calibrationStorage) {}
 
     template <class RNG, class S, class RNG_Calibration>
     inline void MCAmericanEngine<RNG, S, RNG_Calibration>::calculate() const {
@@ -196,7 +204,8 @@ namespace QuantLib {
              new LongstaffSchwartzPathPricer<Path>(
                                       this->timeGrid(),
                                       earlyExercisePathPricer,
-                                      *(process->riskFreeRate())));
+                                      *(process->riskFreeRate()),
+                                      calibrationStorage_));
     }
 
     template <class RNG, class S, class RNG_Calibration>
@@ -265,7 +274,8 @@ namespace QuantLib {
           samples_(Null<Size>()), maxSamples_(Null<Size>()),
           calibrationSamples_(2048), tolerance_(Null<Real>()), seed_(0),
           polynomOrder_(2), polynomType_(LsmBasisSystem::Monomial),
-          antitheticCalibration_(boost::none), seedCalibration_(Null<Size>()) {}
+          antitheticCalibration_(boost::none), seedCalibration_(Null<Size>()),
+          calibrationStorage_(LsmCalibrationStorage::Paths) {}
 
     template <class RNG, class S, class RNG_Calibration>
     inline MakeMCAmericanEngine<RNG, S, RNG_Calibration> &
@@ -373,6 +383,14 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S, class RNG_Calibration>
+    inline MakeMCAmericanEngine<RNG, S, RNG_Calibration> &
+    MakeMCAmericanEngine<RNG, S, RNG_Calibration>::withCalibrationStorage(
+        LsmCalibrationStorage::Type storage) {
+        calibrationStorage_ = storage;
+        return *this;
+    }
+
     template <class RNG, class S, class RNG_Calibration>
     inline MakeMCAmericanEngine<RNG, S, RNG_Calibration>::
     operator boost::shared_ptr<PricingEngine>() const {
@@ -393,7 +411,8 @@ namespace QuantLib {
                                      polynomType_,
                                      calibrationSamples_,
                                      antitheticCalibration_,
-                                     seedCalibration_));
+                                     seedCalibration_,
+                                     calibrationStorage_));
     }
 
 }
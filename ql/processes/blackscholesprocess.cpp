@@ -47,6 +47,23 @@ namespace QuantLib {
         registerWith(blackVolatility_);
     }
 
+    GeneralizedBlackScholesProcess::GeneralizedBlackScholesProcess(
+             const Handle<Quote>& x0,
+             const Handle<YieldTermStructure>& dividendTS,
+             const Handle<YieldTermStructure>& riskFreeTS,
+             const Handle<BlackVolTermStructure>& blackVolTS,
+             const Handle<LocalVolTermStructure>& localVolTS,
+             const boost::shared_ptr<discretization>& disc)
+    : StochasticProcess1D(disc), x0_(x0), riskFreeRate_(riskFreeTS),
+      dividendYield_(dividendTS), blackVolatility_(blackVolTS),
+      externalLocalVolTS_(localVolTS), updated_(false) {
+        registerWith(x0_);
+        registerWith(riskFreeRate_);
+        registerWith(dividendYield_);
+        registerWith(blackVolatility_);
+        registerWith(externalLocalVolTS_);
+    }
+
     Real GeneralizedBlackScholesProcess::x0() const {
         return x0_->value();
     }
@@ -158,6 +175,12 @@ namespace QuantLib {
 
     const Handle<LocalVolTermStructure>&
     GeneralizedBlackScholesProcess::localVolatility() const {
+        if (!externalLocalVolTS_.empty()) {
+            isStrikeIndependent_ = false;
+            updated_ = true;
+            return externalLocalVolTS_;
+        }
+
         if (!updated_) {
             isStrikeIndependent_=true;
 
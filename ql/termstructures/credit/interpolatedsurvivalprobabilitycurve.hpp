@@ -79,6 +79,9 @@ namespace QuantLib {
         //! \name DefaultProbabilityTermStructure implementation
         //@{
         Probability survivalProbabilityImpl(Time) const;
+        void survivalProbabilitiesImpl(
+                               const std::vector<Time>& times,
+                               std::vector<Probability>& probabilities) const;
         Real defaultDensityImpl(Time) const;
         //@}
         mutable std::vector<Date> dates_;
@@ -142,6 +145,40 @@ namespace QuantLib {
         return sMax * std::exp(- hazardMax * (t-tMax));
     }
 
+    template <class T>
+    void InterpolatedSurvivalProbabilityCurve<T>::survivalProbabilitiesImpl(
+                              const std::vector<Time>& times,
+                              std::vector<Probability>& probabilities) const {
+        Time tMax = this->times_.back();
+        bool extrapolated = false;
+        for (Size i=0; i<times.size() && !extrapolated; ++i)
+            extrapolated = times[i] > tMax;
+        if (!extrapolated) {
+            this->interpolation_.values(times, probabilities, true);
+            return;
+        }
+
+        std::vector<Time> t;
+        std::vector<Probability> p;
+        t.reserve(times.size());
+        for (Size i=0; i<times.size(); ++i) {
+            if (times[i] <= tMax)
+                t.push_back(times[i]);
+        }
+        this->interpolation_.values(t, p, true);
+
+        // flat hazard rate extrapolation
+        Probability sMax = this->data_.back();
+        Rate hazardMax = - this->interpolation_.derivative(tMax) / sMax;
+        for (Size i=0, j=0; i<times.size(); ++i) {
+            if (times[i] <= tMax)
+                probabilities[i] = p[j++];
+            else
+                probabilities[i] =
+                    sMax * std::exp(- hazardMax * (times[i]-tMax));
+        }
+    }
+
     template <class T>
     Real
     InterpolatedSurvivalProbabilityCurve<T>::defaultDensityImpl(Time t) const {
@@ -159,6 +159,9 @@ namespace QuantLib {
         //@}
         // methods
         Probability survivalProbabilityImpl(Time) const;
+        void survivalProbabilitiesImpl(
+                               const std::vector<Time>& times,
+                               std::vector<Probability>& probabilities) const;
         Real defaultDensityImpl(Time) const;
         Real hazardRateImpl(Time) const;
         // data members
@@ -224,6 +227,14 @@ namespace QuantLib {
         return base_curve::survivalProbabilityImpl(t);
     }
 
+    template <class C, class I, template <class> class B>
+    inline void PiecewiseDefaultCurve<C,I,B>::survivalProbabilitiesImpl(
+                              const std::vector<Time>& times,
+                              std::vector<Probability>& probabilities) const {
+        calculate();
+        base_curve::survivalProbabilitiesImpl(times, probabilities);
+    }
+
     template <class C, class I, template <class> class B>
     inline Real PiecewiseDefaultCurve<C,I,B>::defaultDensityImpl(Time t) const {
         calculate();
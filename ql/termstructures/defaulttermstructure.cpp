@@ -87,21 +87,58 @@ namespace QuantLib {
                                                      bool extrapolate) const {
         checkRange(t, extrapolate);
 
+        if (!jumps_.empty())
+            return jumpEffect(t) * survivalProbabilityImpl(t);
+
+        return survivalProbabilityImpl(t);
+    }
+
+    Probability DefaultProbabilityTermStructure::jumpEffect(Time t) const {
+        Probability jumpEffect = 1.0;
+        for (Size i=0; i<nJumps_ && jumpTimes_[i]<t; ++i) {
+            QL_REQUIRE(jumps_[i]->isValid(),
+                       "invalid " << io::ordinal(i+1) << " jump quote");
+            DiscountFactor thisJump = jumps_[i]->value();
+            QL_REQUIRE(thisJump > 0.0 && thisJump <= 1.0,
+                       "invalid " << io::ordinal(i+1) << " jump value: " <<
+                       thisJump);
+            jumpEffect *= thisJump;
+        }
+        return jumpEffect;
+    }
+
+    void DefaultProbabilityTermStructure::survivalProbability(
+                                    const std::vector<Time>& times,
+                                    std::vector<Probability>& probabilities,
+                                    bool extrapolate) const {
+        if (times.empty()) {
+            probabilities.clear();
+            return;
+        }
+
+        // checking the extremes is enough
+        Time tMin = times[0], tMax = times[0];
+        for (Size i=1; i<times.size(); ++i) {
+            tMin = std::min(tMin, times[i]);
+            tMax = std::max(tMax, times[i]);
+        }
+        checkRange(tMin, extrapolate);
+        checkRange(tMax, extrapolate);
+
+        probabilities.resize(times.size());
+        survivalProbabilitiesImpl(times, probabilities);
+
         if (!jumps_.empty()) {
-            Probability jumpEffect = 1.0;
-            for (Size i=0; i<nJumps_ && jumpTimes_[i]<t; ++i) {
-                QL_REQUIRE(jumps_[i]->isValid(),
-                           "invalid " << io::ordinal(i+1) << " jump quote");
-                DiscountFactor thisJump = jumps_[i]->value();
-                QL_REQUIRE(thisJump > 0.0 && thisJump <= 1.0,
-                           "invalid " << io::ordinal(i+1) << " jump value: " <<
-                           thisJump);
-                jumpEffect *= thisJump;
-            }
-            return jumpEffect * survivalProbabilityImpl(t);
+            for (Size i=0; i<times.size(); ++i)
+                probabilities[i] *= jumpEffect(times[i]);
         }
+    }
 
-        return survivalProbabilityImpl(t);
+    void DefaultProbabilityTermStructure::survivalProbabilitiesImpl(
+                              const std::vector<Time>& times,
+                              std::vector<Probability>& probabilities) const {
+        for (Size i=0; i<times.size(); ++i)
+            probabilities[i] = survivalProbabilityImpl(times[i]);
     }
 
     Probability DefaultProbabilityTermStructure::defaultProbability(
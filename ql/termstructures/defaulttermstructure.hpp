@@ -133,6 +133,20 @@ namespace QuantLib {
                         bool extrapolate = false) const;
         //@}
 
+        /*! \name Batch calculations
+
+            These methods return the same results as the corresponding
+            methods above for each of the passed times.  Range checks
+            are performed once for the whole batch, and curves can
+            override survivalProbabilitiesImpl() to evaluate all times
+            in a single pass; this is faster when the times are sorted.
+        */
+        //@{
+        void survivalProbability(const std::vector<Time>& times,
+                                 std::vector<Probability>& probabilities,
+                                 bool extrapolate = false) const;
+        //@}
+
         //! \name Jump inspectors
         //@{
         const std::vector<Date>& jumpDates() const;
@@ -155,10 +169,18 @@ namespace QuantLib {
         virtual Probability survivalProbabilityImpl(Time) const = 0;
         //! default density calculation
         virtual Real defaultDensityImpl(Time) const = 0;
+        /*! survival probabilities for a batch of times; the default
+            implementation calls survivalProbabilityImpl(Time) for
+            each of them.
+        */
+        virtual void survivalProbabilitiesImpl(
+                               const std::vector<Time>& times,
+                               std::vector<Probability>& probabilities) const;
         //@}
       private:
         // methods
         void setJumps();
+        Probability jumpEffect(Time t) const;
         // data members
         std::vector<Handle<Quote> > jumps_;
         std::vector<Date> jumpDates_;
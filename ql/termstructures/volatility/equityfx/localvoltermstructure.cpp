@@ -54,6 +54,29 @@ namespace QuantLib {
         return localVolImpl(t, underlyingLevel);
     }
 
+    void LocalVolTermStructure::localVol(
+                                    Time t,
+                                    const std::vector<Real>& underlyingLevels,
+                                    std::vector<Volatility>& vols,
+                                    bool extrapolate) const {
+        checkRange(t, extrapolate);
+        if (!extrapolate && !allowsExtrapolation()) {
+            for (Size i=0; i<underlyingLevels.size(); ++i)
+                checkStrike(underlyingLevels[i], extrapolate);
+        }
+        localVolsImpl(t, underlyingLevels, vols);
+    }
+
+    void LocalVolTermStructure::localVolsImpl(
+                                    Time t,
+                                    const std::vector<Real>& strikes,
+                                    std::vector<Volatility>& vols) const {
+        const Size n = strikes.size();
+        vols.resize(n);
+        for (Size i=0; i<n; ++i)
+            vols[i] = localVolImpl(t, strikes[i]);
+    }
+
     void LocalVolTermStructure::accept(AcyclicVisitor& v) {
         Visitor<LocalVolTermStructure>* v1 =
             dynamic_cast<Visitor<LocalVolTermStructure>*>(&v);
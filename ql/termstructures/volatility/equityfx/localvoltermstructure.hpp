@@ -70,6 +70,19 @@ namespace QuantLib {
                             Real underlyingLevel,
                             bool extrapolate = false) const;
         //@}
+        /*! \name Batch calculations
+
+            These methods return the same results as the corresponding
+            methods above for each of the passed underlying levels at a
+            given time.  Surfaces can override localVolsImpl() to share
+            the work depending on time only among the levels.
+        */
+        //@{
+        void localVol(Time t,
+                      const std::vector<Real>& underlyingLevels,
+                      std::vector<Volatility>& vols,
+                      bool extrapolate = false) const;
+        //@}
         //! \name Visitability
         //@{
         virtual void accept(AcyclicVisitor&);
@@ -85,6 +98,13 @@ namespace QuantLib {
         //@{
         //! local vol calculation
         virtual Volatility localVolImpl(Time t, Real strike) const = 0;
+        /*! local vols for a batch of strikes; the default
+            implementation calls localVolImpl(Time, Real) for each
+            of them.
+        */
+        virtual void localVolsImpl(Time t,
+                                   const std::vector<Real>& strikes,
+                                   std::vector<Volatility>& vols) const;
         //@}
     };
 
@@ -0,0 +1,224 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/termstructures/volatility/equityfx/tabulatedlocalvolsurface.hpp>
+#include <boost/math/special_functions/fpclassify.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    TabulatedLocalVolSurface::TabulatedLocalVolSurface(
+                          const Handle<LocalVolTermStructure>& localVol,
+                          const std::vector<Time>& times,
+                          Real minStrike, Real maxStrike,
+                          Size strikeGridPoints,
+                          Size smoothingPasses)
+    : localVol_(localVol), times_(times), strikes_(strikeGridPoints),
+      logMinStrike_(0.0), dLogStrike_(0.0),
+      smoothingPasses_(smoothingPasses) {
+
+        QL_REQUIRE(!times_.empty(), "no times given");
+        QL_REQUIRE(times_.front() >= 0.0,
+                   "negative time (" << times_.front() << ") given");
+        for (Size i=1; i<times_.size(); ++i)
+            QL_REQUIRE(times_[i] > times_[i-1],
+                       "times must be sorted and unique");
+        QL_REQUIRE(minStrike > 0.0,
+                   "non-positive minimum strike (" << minStrike << ") given");
+        QL_REQUIRE(maxStrike > minStrike,
+                   "maximum strike (" << maxStrike << ") must be greater "
+                   "than minimum strike (" << minStrike << ")");
+        QL_REQUIRE(strikeGridPoints >= 2,
+                   "at least two strike grid points required");
+
+        logMinStrike_ = std::log(minStrike);
+        dLogStrike_ = (std::log(maxStrike) - logMinStrike_)
+                    / (strikeGridPoints-1);
+        for (Size j=0; j<strikeGridPoints; ++j)
+            strikes_[j] = std::exp(logMinStrike_ + j*dLogStrike_);
+        strikes_.front() = minStrike;
+        strikes_.back() = maxStrike;
+
+        registerWith(localVol_);
+    }
+
+    const Date& TabulatedLocalVolSurface::referenceDate() const {
+        return localVol_->referenceDate();
+    }
+
+    Calendar TabulatedLocalVolSurface::calendar() const {
+        return localVol_->calendar();
+    }
+
+    Natural TabulatedLocalVolSurface::settlementDays() const {
+        return localVol_->settlementDays();
+    }
+
+    DayCounter TabulatedLocalVolSurface::dayCounter() const {
+        return localVol_->dayCounter();
+    }
+
+    Date TabulatedLocalVolSurface::maxDate() const {
+        return localVol_->maxDate();
+    }
+
+    Real TabulatedLocalVolSurface::minStrike() const {
+        return strikes_.front();
+    }
+
+    Real TabulatedLocalVolSurface::maxStrike() const {
+        return strikes_.back();
+    }
+
+    void TabulatedLocalVolSurface::update() {
+        TermStructure::update();
+        LazyObject::update();
+    }
+
+    void TabulatedLocalVolSurface::performCalculations() const {
+        const Size nTimes = times_.size(), nStrikes = strikes_.size();
+        vols_ = Matrix(nTimes, nStrikes, 0.0);
+        std::vector<char> valid(nTimes*nStrikes, 0);
+
+        // lazy dependencies of the underlying surface are calculated
+        // here, before the grid is filled concurrently
+        try {
+            localVol_->localVol(times_.front(), strikes_[nStrikes/2], true);
+        } catch (std::exception&) {}
+
+        #pragma omp parallel for schedule(dynamic)
+        for (long i=0; i<long(nTimes); ++i) {
+            for (Size j=0; j<nStrikes; ++j) {
+                try {
+                    const Volatility vol =
+                        localVol_->localVol(times_[i], strikes_[j], true);
+                    if (vol >= 0.0 && (boost::math::isfinite)(vol)) {
+                        vols_[i][j] = vol;
+                        valid[i*nStrikes+j] = 1;
+                    }
+                } catch (...) {}
+            }
+        }
+
+        // repair the illegal nodes of each time slice...
+        std::vector<char> validSlice(nTimes, 0);
+        for (Size i=0; i<nTimes; ++i) {
+            const char* v = &valid[i*nStrikes];
+            Size prev = Null<Size>();
+            for (Size j=0; j<nStrikes; ++j) {
+                if (!v[j])
+                    continue;
+                if (prev == Null<Size>()) {
+                    for (Size k=0; k<j; ++k)
+                        vols_[i][k] = vols_[i][j];
+                } else {
+                    for (Size k=prev+1; k<j; ++k)
+                        vols_[i][k] = vols_[i][prev]
+                            + (vols_[i][j]-vols_[i][prev])*(k-prev)/(j-prev);
+                }
+                prev = j;
+            }
+            if (prev != Null<Size>()) {
+                for (Size k=prev+1; k<nStrikes; ++k)
+                    vols_[i][k] = vols_[i][prev];
+                validSlice[i] = 1;
+            }
+        }
+
+        // ...and replace the illegal slices with the nearest valid one
+        Size first = 0;
+        while (first < nTimes && !validSlice[first])
+            ++first;
+        QL_REQUIRE(first < nTimes,
+                   "no valid local volatility found on the grid");
+        for (Size i=0; i<nTimes; ++i) {
+            if (!validSlice[i]) {
+                const Size from = (i < first) ? first : i-1;
+                std::copy(vols_.row_begin(from), vols_.row_end(from),
+                          vols_.row_begin(i));
+            }
+        }
+
+        // smooth the local variances in log-strike; the end nodes
+        // are reflected, so that flat wings stay flat
+        if (smoothingPasses_ > 0) {
+            std::vector<Real> var(nStrikes), smoothed(nStrikes);
+            for (Size i=0; i<nTimes; ++i) {
+                for (Size j=0; j<nStrikes; ++j)
+                    var[j] = vols_[i][j]*vols_[i][j];
+                for (Size pass=0; pass<smoothingPasses_; ++pass) {
+                    for (Size j=0; j<nStrikes; ++j) {
+                        const Real left = var[j > 0 ? j-1 : 1];
+                        const Real right =
+                            var[j < nStrikes-1 ? j+1 : nStrikes-2];
+                        smoothed[j] = 0.25*left + 0.5*var[j] + 0.25*right;
+                    }
+                    var.swap(smoothed);
+                }
+                for (Size j=0; j<nStrikes; ++j)
+                    vols_[i][j] = std::sqrt(var[j]);
+            }
+        }
+    }
+
+    void TabulatedLocalVolSurface::locate(Time t,
+                                          Matrix::const_row_iterator& early,
+                                          Matrix::const_row_iterator& late,
+                                          Real& weight) const {
+        const Matrix& vols = vols_;
+        if (t <= times_.front()) {
+            early = late = vols.row_begin(0);
+            weight = 0.0;
+        } else if (t >= times_.back()) {
+            early = late = vols.row_begin(times_.size()-1);
+            weight = 0.0;
+        } else {
+            const Size i = std::upper_bound(times_.begin(), times_.end(), t)
+                         - times_.begin();
+            early = vols.row_begin(i-1);
+            late = vols.row_begin(i);
+            weight = (t - times_[i-1])/(times_[i] - times_[i-1]);
+        }
+    }
+
+    Volatility TabulatedLocalVolSurface::localVolImpl(Time t,
+                                                      Real strike) const {
+        calculate();
+
+        Matrix::const_row_iterator early, late;
+        Real weight;
+        locate(t, early, late, weight);
+        return interpolate(early, late, weight, strike);
+    }
+
+    void TabulatedLocalVolSurface::localVolsImpl(
+                                    Time t,
+                                    const std::vector<Real>& strikes,
+                                    std::vector<Volatility>& vols) const {
+        calculate();
+
+        Matrix::const_row_iterator early, late;
+        Real weight;
+        locate(t, early, late, weight);
+
+        const Size n = strikes.size();
+        vols.resize(n);
+        for (Size i=0; i<n; ++i)
+            vols[i] = interpolate(early, late, weight, strikes[i]);
+    }
+
+}
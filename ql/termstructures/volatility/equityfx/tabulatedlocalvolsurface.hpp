@@ -0,0 +1,155 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file tabulatedlocalvolsurface.hpp
+    \brief Local volatility surface tabulated on a (time, log-strike) grid
+*/
+
+#ifndef quantlib_tabulated_local_vol_surface_hpp
+#define quantlib_tabulated_local_vol_surface_hpp
+
+#include <ql/patterns/lazyobject.hpp>
+#include <ql/math/matrix.hpp>
+#include <ql/termstructures/volatility/equityfx/localvoltermstructure.hpp>
+
+namespace QuantLib {
+
+    //! Local volatility surface tabulated on a grid
+    /*! The local volatility of the underlying surface (usually a
+        LocalVolSurface evaluating Dupire's formula on an implied
+        volatility surface) is calculated once on a grid of the
+        given times and of strikes equally spaced in log-strike.
+        Volatilities are then bilinearly interpolated in time and
+        log-strike and extrapolated flat outside the grid, so that
+        each lookup costs a few multiplications instead of several
+        Black-variance interpolations.
+
+        Grid nodes where the underlying surface fails or returns a
+        negative or non-finite volatility, e.g., because of calendar
+        or butterfly arbitrage in the implied surface, are replaced
+        by linear interpolation between the nearest valid nodes at
+        the same time, or by the nearest valid time slice.
+
+        The repaired local variances can then be smoothed in
+        log-strike by the given number of passes of a 1-2-1 kernel,
+        which damps the spikes that Dupire's formula produces where
+        the implied surface is barely arbitrage-free.  Each pass
+        replaces a node by a convex combination of its neighbours,
+        so that the smoothed variances stay positive and within the
+        range of the repaired ones; any such local volatility
+        defines an arbitrage-free diffusion.
+
+        The table is recalculated when the underlying surface
+        notifies a change.
+
+        \warning the first lookup triggers the calculation of the
+                 table; when the surface is shared among threads,
+                 it should be calculated, e.g., by a first call to
+                 localVol(), before they start.
+    */
+    class TabulatedLocalVolSurface : public LocalVolTermStructure,
+                                     public LazyObject {
+      public:
+        TabulatedLocalVolSurface(
+                          const Handle<LocalVolTermStructure>& localVol,
+                          const std::vector<Time>& times,
+                          Real minStrike, Real maxStrike,
+                          Size strikeGridPoints,
+                          Size smoothingPasses = 0);
+        //! \name TermStructure interface
+        //@{
+        const Date& referenceDate() const;
+        Calendar calendar() const;
+        Natural settlementDays() const;
+        DayCounter dayCounter() const;
+        Date maxDate() const;
+        //@}
+        //! \name VolatilityTermStructure interface
+        //@{
+        Real minStrike() const;
+        Real maxStrike() const;
+        //@}
+        //! \name Observer interface
+        //@{
+        void update();
+        //@}
+        //! \name Inspectors
+        //@{
+        const std::vector<Time>& times() const;
+        const std::vector<Real>& strikes() const;
+        //! local volatilities on the grid, one row per time
+        const Matrix& localVolMatrix() const;
+        //@}
+      protected:
+        Volatility localVolImpl(Time t, Real strike) const;
+        void localVolsImpl(Time t,
+                           const std::vector<Real>& strikes,
+                           std::vector<Volatility>& vols) const;
+        void performCalculations() const;
+      private:
+        void locate(Time t,
+                    Matrix::const_row_iterator& early,
+                    Matrix::const_row_iterator& late,
+                    Real& weight) const;
+        Volatility interpolate(Matrix::const_row_iterator early,
+                               Matrix::const_row_iterator late,
+                               Real weight, Real strike) const;
+        Handle<LocalVolTermStructure> localVol_;
+        std::vector<Time> times_;
+        std::vector<Real> strikes_;
+        Real logMinStrike_, dLogStrike_;
+        Size smoothingPasses_;
+        mutable Matrix vols_;
+    };
+
+
+    // inline definitions
+
+    inline const std::vector<Time>&
+    TabulatedLocalVolSurface::times() const {
+        return times_;
+    }
+
+    inline const std::vector<Real>&
+    TabulatedLocalVolSurface::strikes() const {
+        return strikes_;
+    }
+
+    inline const Matrix& TabulatedLocalVolSurface::localVolMatrix() const {
+        calculate();
+        return vols_;
+    }
+
+    inline Volatility TabulatedLocalVolSurface::interpolate(
+                                        Matrix::const_row_iterator early,
+                                        Matrix::const_row_iterator late,
+                                        Real weight, Real strike) const {
+        const Size n = strikes_.size();
+        Real u = (strike > strikes_.front())
+            ? (std::log(strike) - logMinStrike_)/dLogStrike_ : 0.0;
+        u = std::min(u, Real(n-1));
+        const Size j = std::min(Size(u), n-2);
+        const Real w = u - j;
+
+        const Real e = early[j] + w*(early[j+1]-early[j]);
+        const Real l = late[j] + w*(late[j+1]-late[j]);
+        return e + weight*(l-e);
+    }
+
+}
+
+#endif
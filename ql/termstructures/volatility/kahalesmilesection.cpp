@@ -261,6 +261,56 @@ namespace QuantLib {
         return vol;
     }
 
+    void KahaleSmileSection::optionPrices(const std::vector<Rate>& strikes,
+                                          std::vector<Real>& results,
+                                          Option::Type type,
+                                          Real discount) const {
+        results.resize(strikes.size());
+        std::vector<Size> core;
+        std::vector<Rate> coreStrikes;
+        for (Size j = 0; j < strikes.size(); ++j) {
+            Real shifted_strike = std::max(strikes[j] + shift(), QL_KAHALE_EPS);
+            Size i = index(shifted_strike);
+            if (isCore(i)) {
+                core.push_back(j);
+                coreStrikes.push_back(strikes[j]);
+            } else {
+                Real c = cFunctions_[i]->operator()(shifted_strike);
+                results[j] = discount *
+                    (type == Option::Call ? c : c + shifted_strike - f_);
+            }
+        }
+        if (!core.empty()) {
+            std::vector<Real> corePrices;
+            source_->optionPrices(coreStrikes, corePrices, type, discount);
+            for (Size j = 0; j < core.size(); ++j)
+                results[core[j]] = corePrices[j];
+        }
+    }
+
+    void KahaleSmileSection::volatilitiesImpl(
+                                    const std::vector<Rate>& strikes,
+                                    std::vector<Volatility>& results) const {
+        results.resize(strikes.size());
+        std::vector<Size> core;
+        std::vector<Rate> coreStrikes;
+        for (Size j = 0; j < strikes.size(); ++j) {
+            Real shifted_strike = std::max(strikes[j] + shift(), QL_KAHALE_EPS);
+            if (isCore(index(shifted_strike))) {
+                core.push_back(j);
+                coreStrikes.push_back(strikes[j]);
+            } else {
+                results[j] = volatilityImpl(strikes[j]);
+            }
+        }
+        if (!core.empty()) {
+            std::vector<Volatility> coreVols;
+            source_->volatilities(coreStrikes, coreVols);
+            for (Size j = 0; j < core.size(); ++j)
+                results[core[j]] = coreVols[j];
+        }
+    }
+
     Size KahaleSmileSection::index(Rate strike) const {
         int i =
             static_cast<int>(std::upper_bound(k_.begin(), k_.end(), strike) -
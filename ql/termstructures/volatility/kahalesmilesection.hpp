@@ -166,12 +166,25 @@ namespace QuantLib {
 
         Real optionPrice(Rate strike, Option::Type type = Option::Call,
                          Real discount = 1.0) const;
+        /*! wing strikes are priced through the c functions, while
+            core strikes (unless interpolating) are passed to the
+            source section as a single strip. */
+        void optionPrices(const std::vector<Rate>& strikes,
+                          std::vector<Real>& results,
+                          Option::Type type = Option::Call,
+                          Real discount = 1.0) const;
 
       protected:
         Volatility volatilityImpl(Rate strike) const;
+        void volatilitiesImpl(const std::vector<Rate>& strikes,
+                              std::vector<Volatility>& results) const;
 
       private:
         Size index(Rate strike) const;
+        bool isCore(Size i) const {
+            return !interpolate_ &&
+                   !(i == 0 || i == rightIndex_ - leftIndex_ + 1);
+        }
         void compute();
         boost::shared_ptr<SmileSection> source_;
         std::vector<Real> moneynessGrid_, k_, c_;
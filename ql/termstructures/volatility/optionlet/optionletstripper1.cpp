@@ -25,11 +25,9 @@
 #include <ql/termstructures/volatility/optionlet/optionletstripper1.hpp>
 #include <ql/instruments/makecapfloor.hpp>
 #include <ql/pricingengines/capfloor/blackcapfloorengine.hpp>
-#include <ql/pricingengine.hpp>
-#include <ql/pricingengines/capfloor/bacheliercapfloorengine.hpp>
 #include <ql/pricingengines/blackformula.hpp>
 #include <ql/indexes/iborindex.hpp>
-#include <ql/quotes/simplequote.hpp>
+#include <ql/settings.hpp>
 #include <ql/utilities/dataformatters.hpp>
 
 using boost::shared_ptr;
@@ -42,12 +40,15 @@ OptionletStripper1::OptionletStripper1(
     Natural maxIter, const Handle< YieldTermStructure > &discount,
     const VolatilityType type, const Real displacement, bool dontThrow)
     : OptionletStripper(termVolSurface, index, discount, type, displacement),
-      volQuotes_(nOptionletTenors_,
-                 std::vector< shared_ptr< SimpleQuote > >(nStrikes_)),
+      stripped_(false),
       floatingSwitchStrike_(switchStrike == Null< Rate >() ? true : false),
-      capFlooMatrixNotInitialized_(true), switchStrike_(switchStrike),
+      switchStrike_(switchStrike),
       accuracy_(accuracy), maxIter_(maxIter), dontThrow_(dontThrow) {
 
+        QL_REQUIRE(volatilityType_ == ShiftedLognormal ||
+                   volatilityType_ == Normal,
+                   "unknown volatility type: " << volatilityType_);
+
         capFloorPrices_ = Matrix(nOptionletTenors_, nStrikes_);
         optionletPrices_ = Matrix(nOptionletTenors_, nStrikes_);
         capletVols_ = Matrix(nOptionletTenors_, nStrikes_);
@@ -56,12 +57,22 @@ OptionletStripper1::OptionletStripper1(
         Real firstGuess = 0.14; // guess is only used for shifted lognormal vols
         optionletStDevs_ = Matrix(nOptionletTenors_, nStrikes_, firstGuess);
 
-        capFloors_ = CapFloorMatrix(nOptionletTenors_);
-        capFloorEngines_ = std::vector<std::vector<boost::shared_ptr<PricingEngine> > >(nOptionletTenors_);
+        caplets_ = std::vector<Caplets>(nOptionletTenors_);
+        optionletAnnuities_ = std::vector<DiscountFactor>(nOptionletTenors_);
+    }
+
+    bool OptionletStripper1::Caplets::operator==(const Caplets& c) const {
+        return weights == c.weights && forwards == c.forwards &&
+               times == c.times && spreads == c.spreads &&
+               gearings == c.gearings;
     }
 
     void OptionletStripper1::performCalculations() const {
 
+        // a failed calculation leaves the results inconsistent
+        bool previouslyStripped = stripped_;
+        stripped_ = false;
+
         // update dates
         const Date& referenceDate = termVolSurface_->referenceDate();
         const DayCounter& dc = termVolSurface_->dayCounter();
@@ -69,6 +80,16 @@ OptionletStripper1::OptionletStripper1(
                     BlackCapFloorEngine(// discounting does not matter here
                                         iborIndex_->forwardingTermStructure(),
                                         0.20, dc));
+        const Handle<YieldTermStructure>& discountCurve =
+            discount_.empty() ?
+                iborIndex_->forwardingTermStructure() :
+                discount_;
+        // the same conventions as the Black and Bachelier cap engines
+        const Date today = Settings::instance().evaluationDate();
+        const Date settlement = discountCurve->referenceDate();
+
+        std::vector<Caplets> caplets(nOptionletTenors_);
+        std::vector<DiscountFactor> optionletAnnuities(nOptionletTenors_);
         for (Size i=0; i<nOptionletTenors_; ++i) {
             CapFloor temp = MakeCapFloor(CapFloor::Cap,
                                          capFloorLengths_[i],
@@ -84,110 +105,192 @@ OptionletStripper1::OptionletStripper1(
             optionletTimes_[i] = dc.yearFraction(referenceDate,
                                                  optionletDates_[i]);
             atmOptionletRate_[i] = lFRC->indexFixing();
+            optionletAnnuities[i] = optionletAccrualPeriods_[i] *
+                discountCurve->discount(optionletPaymentDates_[i]);
+
+            const Leg& leg = temp.floatingLeg();
+            for (Size k=0; k<leg.size(); ++k) {
+                shared_ptr<FloatingRateCoupon> c =
+                    boost::dynamic_pointer_cast<FloatingRateCoupon>(leg[k]);
+                QL_REQUIRE(c, "non-FloatingRateCoupon given");
+                // expired caplets are discarded
+                if (c->date() <= settlement)
+                    continue;
+                caplets[i].weights.push_back(c->nominal() * c->gearing() *
+                                             discountCurve->discount(c->date()) *
+                                             c->accrualPeriod());
+                caplets[i].forwards.push_back(c->date() >= today ?
+                                              c->adjustedFixing() :
+                                              Null<Rate>());
+                caplets[i].times.push_back(c->fixingDate() > today ?
+                                           dc.yearFraction(today,
+                                                           c->fixingDate()) :
+                                           0.0);
+                caplets[i].spreads.push_back(c->spread());
+                caplets[i].gearings.push_back(c->gearing());
+            }
         }
 
+        Rate switchStrike = switchStrike_;
         if (floatingSwitchStrike_) {
             Rate averageAtmOptionletRate = 0.0;
             for (Size i=0; i<nOptionletTenors_; ++i) {
                 averageAtmOptionletRate += atmOptionletRate_[i];
             }
-            switchStrike_ = averageAtmOptionletRate / nOptionletTenors_;
+            switchStrike = averageAtmOptionletRate / nOptionletTenors_;
         }
 
-        const Handle<YieldTermStructure>& discountCurve =
-            discount_.empty() ?
-                iborIndex_->forwardingTermStructure() :
-                discount_;
-
         const std::vector<Rate>& strikes = termVolSurface_->strikes();
-        // initialize CapFloorMatrix
-        if (capFlooMatrixNotInitialized_) {
-            for (Size i = 0; i < nOptionletTenors_; ++i) {
-                capFloors_[i].resize(nStrikes_);
-                capFloorEngines_[i].resize(nStrikes_);
+        Matrix capFloorVols(nOptionletTenors_, nStrikes_);
+        for (Size j=0; j<nStrikes_; ++j)
+            for (Size i=0; i<nOptionletTenors_; ++i)
+                capFloorVols[i][j] = termVolSurface_->volatility(
+                    capFloorLengths_[i], strikes[j], true);
+
+        // only the columns whose inputs changed are stripped again
+        bool sameCaplets = previouslyStripped &&
+            switchStrike == switchStrike_ &&
+            caplets == caplets_ &&
+            optionletAnnuities == optionletAnnuities_;
+        std::vector<Size> columns;
+        for (Size j=0; j<nStrikes_; ++j) {
+            bool changed = !sameCaplets;
+            for (Size i=0; i<nOptionletTenors_ && !changed; ++i)
+                changed = capFloorVols[i][j] != capFloorVols_[i][j];
+            if (changed)
+                columns.push_back(j);
+        }
+
+        switchStrike_ = switchStrike;
+        caplets_.swap(caplets);
+        optionletAnnuities_.swap(optionletAnnuities);
+        capFloorVols_ = capFloorVols;
+
+        // prices and stripping are independent across tenors and
+        // strikes, respectively; exceptions must not escape the
+        // parallel regions
+        std::vector<std::string> errors(
+                           std::max(nOptionletTenors_, columns.size()));
+
+        #pragma omp parallel for schedule(dynamic)
+        for (long i=0; i<long(nOptionletTenors_); ++i) {
+            try {
+                priceCapFloors(i, columns);
+            } catch (std::exception& e) {
+                errors[i] = e.what();
+            } catch (...) {
+                errors[i] = "unknown error";
             }
-            // construction might go here
-            for (Size j=0; j<nStrikes_; ++j) {
-                for (Size i=0; i<nOptionletTenors_; ++i) {
-                    volQuotes_[i][j] = shared_ptr<SimpleQuote>(new
-                                                                SimpleQuote());
-                    if (volatilityType_ == ShiftedLognormal) {
-                        capFloorEngines_[i][j]=boost::shared_ptr<BlackCapFloorEngine>(
-                          new BlackCapFloorEngine(
-                              discountCurve, Handle<Quote>(volQuotes_[i][j]),
-                              dc, displacement_));
-                    } else if (volatilityType_ == Normal) {
-                        capFloorEngines_[i][j]=boost::shared_ptr<BachelierCapFloorEngine>(
-                          new BachelierCapFloorEngine(
-                              discountCurve, Handle<Quote>(volQuotes_[i][j]),
-                              dc));
-                    } else {
-                      QL_FAIL("unknown volatility type: " << volatilityType_);
-                    }
-                }
+        }
+        for (Size i=0; i<nOptionletTenors_; ++i)
+            QL_REQUIRE(errors[i].empty(), errors[i]);
+
+        #pragma omp parallel for schedule(dynamic)
+        for (long m=0; m<long(columns.size()); ++m) {
+            try {
+                stripColumn(columns[m]);
+            } catch (std::exception& e) {
+                errors[m] = e.what();
+            } catch (...) {
+                errors[m] = "unknown error";
             }
-            capFlooMatrixNotInitialized_ = false;
         }
+        for (Size m=0; m<columns.size(); ++m)
+            QL_REQUIRE(errors[m].empty(), errors[m]);
 
-        for (Size j=0; j<nStrikes_; ++j) {
-            // using out-of-the-money options
-            CapFloor::Type capFloorType =
-                strikes[j] < switchStrike_ ? CapFloor::Floor : CapFloor::Cap;
-            Option::Type optionletType =
-                strikes[j] < switchStrike_ ? Option::Put : Option::Call;
+        stripped_ = true;
+    }
 
-            Real previousCapFloorPrice = 0.0;
-            for (Size i=0; i<nOptionletTenors_; ++i) {
+    void OptionletStripper1::priceCapFloors(
+                                const Size i,
+                                const std::vector<Size>& columns) const {
+        const std::vector<Rate>& strikes = termVolSurface_->strikes();
+        const Caplets& caplets = caplets_[i];
 
-                capFloorVols_[i][j] = termVolSurface_->volatility(
-                    capFloorLengths_[i], strikes[j], true);
-                volQuotes_[i][j]->setValue(capFloorVols_[i][j]);
-                capFloors_[i][j] =
-                    MakeCapFloor(capFloorType, capFloorLengths_[i],
-                                 iborIndex_, strikes[j], -0 * Days)
-                        .withPricingEngine(capFloorEngines_[i][j]);
-                capFloorPrices_[i][j] = capFloors_[i][j]->NPV();
-                optionletPrices_[i][j] = capFloorPrices_[i][j] -
-                                                        previousCapFloorPrice;
-                previousCapFloorPrice = capFloorPrices_[i][j];
-                DiscountFactor d =
-                    discountCurve->discount(optionletPaymentDates_[i]);
-                DiscountFactor optionletAnnuity=optionletAccrualPeriods_[i]*d;
-                try {
-                  if (volatilityType_ == ShiftedLognormal) {
-                    optionletStDevs_[i][j] = blackFormulaImpliedStdDev(
-                        optionletType, strikes[j], atmOptionletRate_[i],
-                        optionletPrices_[i][j], optionletAnnuity, displacement_,
-                        optionletStDevs_[i][j], accuracy_, maxIter_);
-                  } else if (volatilityType_ == Normal) {
-                    optionletStDevs_[i][j] =
-                        std::sqrt(optionletTimes_[i]) *
-                        bachelierBlackFormulaImpliedVol(
-                            optionletType, strikes[j], atmOptionletRate_[i],
-                            optionletTimes_[i], optionletPrices_[i][j],
-                            optionletAnnuity);
-                  } else {
-                    QL_FAIL("Unknown volatility type: " << volatilityType_);
-                  }
-                }
-                catch (std::exception &e) {
-                    if(dontThrow_)
-                        optionletStDevs_[i][j]=0.0;
-                    else
-                        QL_FAIL("could not bootstrap optionlet:"
-                            "\n type:    " << optionletType <<
-                            "\n strike:  " << io::rate(strikes[j]) <<
-                            "\n atm:     " << io::rate(atmOptionletRate_[i]) <<
-                            "\n price:   " << optionletPrices_[i][j] <<
-                            "\n annuity: " << optionletAnnuity <<
-                            "\n expiry:  " << optionletDates_[i] <<
-                            "\n error:   " << e.what());
+        // using out-of-the-money options
+        std::vector<Size> floors, caps;
+        for (Size m=0; m<columns.size(); ++m) {
+            Size j = columns[m];
+            capFloorPrices_[i][j] = 0.0;
+            if (strikes[j] < switchStrike_)
+                floors.push_back(j);
+            else
+                caps.push_back(j);
+        }
+
+        std::vector<Real> capletStrikes, stdDevs, values;
+        for (Size n=0; n<2; ++n) {
+            const std::vector<Size>& js = n == 0 ? floors : caps;
+            const Option::Type type = n == 0 ? Option::Put : Option::Call;
+            if (js.empty())
+                continue;
+            capletStrikes.resize(js.size());
+            stdDevs.resize(js.size());
+            for (Size k=0; k<caplets.weights.size(); ++k) {
+                const Time t = caplets.times[k];
+                for (Size m=0; m<js.size(); ++m) {
+                    const Volatility v = capFloorVols_[i][js[m]];
+                    capletStrikes[m] = (strikes[js[m]] - caplets.spreads[k]) /
+                                       caplets.gearings[k];
+                    stdDevs[m] = t > 0.0 ? std::sqrt(v*v*t) : 0.0;
                 }
-                optionletVolatilities_[i][j] = optionletStDevs_[i][j] /
-                                                std::sqrt(optionletTimes_[i]);
+                if (volatilityType_ == ShiftedLognormal)
+                    blackFormula(type, capletStrikes, caplets.forwards[k],
+                                 stdDevs, values, caplets.weights[k],
+                                 displacement_);
+                else
+                    bachelierBlackFormula(type, capletStrikes,
+                                          caplets.forwards[k], stdDevs,
+                                          values, caplets.weights[k]);
+                for (Size m=0; m<js.size(); ++m)
+                    capFloorPrices_[i][js[m]] += values[m];
             }
         }
+    }
 
+    void OptionletStripper1::stripColumn(const Size j) const {
+        const Rate strike = termVolSurface_->strikes()[j];
+        // using out-of-the-money options
+        Option::Type optionletType =
+            strike < switchStrike_ ? Option::Put : Option::Call;
+
+        Real previousCapFloorPrice = 0.0;
+        for (Size i=0; i<nOptionletTenors_; ++i) {
+            optionletPrices_[i][j] = capFloorPrices_[i][j] -
+                                                    previousCapFloorPrice;
+            previousCapFloorPrice = capFloorPrices_[i][j];
+            DiscountFactor optionletAnnuity = optionletAnnuities_[i];
+            try {
+              if (volatilityType_ == ShiftedLognormal) {
+                optionletStDevs_[i][j] = blackFormulaImpliedStdDev(
+                    optionletType, strike, atmOptionletRate_[i],
+                    optionletPrices_[i][j], optionletAnnuity, displacement_,
+                    optionletStDevs_[i][j], accuracy_, maxIter_);
+              } else {
+                optionletStDevs_[i][j] =
+                    std::sqrt(optionletTimes_[i]) *
+                    bachelierBlackFormulaImpliedVol(
+                        optionletType, strike, atmOptionletRate_[i],
+                        optionletTimes_[i], optionletPrices_[i][j],
+                        optionletAnnuity);
+              }
+            }
+            catch (std::exception &e) {
+                if(dontThrow_)
+                    optionletStDevs_[i][j]=0.0;
+                else
+                    QL_FAIL("could not bootstrap optionlet:"
+                        "\n type:    " << optionletType <<
+                        "\n strike:  " << io::rate(strike) <<
+                        "\n atm:     " << io::rate(atmOptionletRate_[i]) <<
+                        "\n price:   " << optionletPrices_[i][j] <<
+                        "\n annuity: " << optionletAnnuity <<
+                        "\n expiry:  " << optionletDates_[i] <<
+                        "\n error:   " << e.what());
+            }
+            optionletVolatilities_[i][j] = optionletStDevs_[i][j] /
+                                            std::sqrt(optionletTimes_[i]);
+        }
     }
 
     const Matrix &OptionletStripper1::capletVols() const {
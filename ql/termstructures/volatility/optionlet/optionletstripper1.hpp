@@ -33,15 +33,21 @@
 
 namespace QuantLib {
 
-    class SimpleQuote;
     class CapFloor;
-    class PricingEngine;
 
     typedef std::vector<std::vector<boost::shared_ptr<CapFloor> > > CapFloorMatrix;
 
     /*! Helper class to strip optionlet (i.e. caplet/floorlet) volatilities
         (a.k.a. forward-forward volatilities) from the (cap/floor) term
         volatilities of a CapFloorTermVolSurface.
+
+        Cap and floor prices are obtained directly from the Black (or
+        Bachelier) formula on the caplets of each cap length, priced
+        on all strikes at once; the strike columns are then stripped
+        in parallel when OpenMP is enabled.  When recalculating, only
+        the strike columns whose term volatilities changed are
+        stripped again, unless the caplet schedule, forwards or
+        discounts changed too.
     */
     class OptionletStripper1 : public OptionletStripper {
       public:
@@ -66,15 +72,22 @@ namespace QuantLib {
         void performCalculations() const;
         //@}
       private:
+        // strike-independent data of the caplets of a cap
+        struct Caplets {
+            std::vector<Real> weights, forwards, times, spreads, gearings;
+            bool operator==(const Caplets&) const;
+        };
+        void priceCapFloors(Size i, const std::vector<Size>& columns) const;
+        void stripColumn(Size j) const;
+
         mutable Matrix capFloorPrices_, optionletPrices_;
         mutable Matrix capFloorVols_;
         mutable Matrix optionletStDevs_, capletVols_;
 
-        mutable CapFloorMatrix capFloors_;
-        mutable std::vector<std::vector<boost::shared_ptr<SimpleQuote> > > volQuotes_;
-        mutable std::vector<std::vector<boost::shared_ptr<PricingEngine> > > capFloorEngines_;
+        mutable std::vector<Caplets> caplets_;
+        mutable std::vector<DiscountFactor> optionletAnnuities_;
+        mutable bool stripped_;
         bool floatingSwitchStrike_;
-        mutable bool capFlooMatrixNotInitialized_;
         mutable Rate switchStrike_;
         Real accuracy_;
         Natural maxIter_;
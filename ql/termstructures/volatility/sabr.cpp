@@ -27,6 +27,61 @@
 
 namespace QuantLib {
 
+    namespace {
+
+        // Hagan's expansion, with the terms not depending on the
+        // strike computed once
+        class SabrExpansion {
+          public:
+            SabrExpansion(Time expiryTime,
+                          Real alpha, Real beta, Real nu, Real rho)
+            : expiryTime_(expiryTime), alpha_(alpha), rho_(rho),
+              oneMinusBeta_(1.0-beta), nuOverAlpha_(nu/alpha),
+              oneMinusRho_(1.0-rho),
+              c1_(oneMinusBeta_*oneMinusBeta_*alpha*alpha),
+              c2_(0.25*rho*beta*nu*alpha),
+              c3_((2.0-3.0*rho*rho)*(nu*nu/24.0)),
+              c4_(3.0*rho*rho-2.0) {}
+            Real operator()(Rate strike, Rate forward) const {
+                const Real A = std::pow(forward*strike, oneMinusBeta_);
+                const Real sqrtA= std::sqrt(A);
+                Real logM;
+                if (!close(forward, strike))
+                    logM = std::log(forward/strike);
+                else {
+                    const Real epsilon = (forward-strike)/strike;
+                    logM = epsilon - .5 * epsilon * epsilon ;
+                }
+                const Real z = nuOverAlpha_*sqrtA*logM;
+                const Real B = 1.0-2.0*rho_*z+z*z;
+                const Real C = oneMinusBeta_*oneMinusBeta_*logM*logM;
+                const Real tmp = (std::sqrt(B)+z-rho_)/oneMinusRho_;
+                const Real xx = std::log(tmp);
+                const Real D = sqrtA*(1.0+C/24.0+C*C/1920.0);
+                const Real d = 1.0 + expiryTime_ *
+                    (c1_/(24.0*A) + c2_/sqrtA + c3_);
+
+                Real multiplier;
+                // computations become precise enough if the square of z
+                // worth slightly more than the precision machine (hence
+                // the m)
+                static const Real m = 10;
+                if (std::fabs(z*z)>QL_EPSILON * m)
+                    multiplier = z/xx;
+                else {
+                    multiplier = 1.0 - 0.5*rho_*z - c4_*z*z/12.0;
+                }
+                return (alpha_/D)*multiplier*d;
+            }
+          private:
+            Time expiryTime_;
+            Real alpha_, rho_;
+            Real oneMinusBeta_, nuOverAlpha_, oneMinusRho_;
+            Real c1_, c2_, c3_, c4_;
+        };
+
+    }
+
     Real unsafeSabrVolatility(Rate strike,
                               Rate forward,
                               Time expiryTime,
@@ -34,37 +89,8 @@ namespace QuantLib {
                               Real beta,
                               Real nu,
                               Real rho) {
-        const Real oneMinusBeta = 1.0-beta;
-        const Real A = std::pow(forward*strike, oneMinusBeta);
-        const Real sqrtA= std::sqrt(A);
-        Real logM;
-        if (!close(forward, strike))
-            logM = std::log(forward/strike);
-        else {
-            const Real epsilon = (forward-strike)/strike;
-            logM = epsilon - .5 * epsilon * epsilon ;
-        }
-        const Real z = (nu/alpha)*sqrtA*logM;
-        const Real B = 1.0-2.0*rho*z+z*z;
-        const Real C = oneMinusBeta*oneMinusBeta*logM*logM;
-        const Real tmp = (std::sqrt(B)+z-rho)/(1.0-rho);
-        const Real xx = std::log(tmp);
-        const Real D = sqrtA*(1.0+C/24.0+C*C/1920.0);
-        const Real d = 1.0 + expiryTime *
-            (oneMinusBeta*oneMinusBeta*alpha*alpha/(24.0*A)
-                                + 0.25*rho*beta*nu*alpha/sqrtA
-                                    +(2.0-3.0*rho*rho)*(nu*nu/24.0));
-
-        Real multiplier;
-        // computations become precise enough if the square of z worth
-        // slightly more than the precision machine (hence the m)
-        static const Real m = 10;
-        if (std::fabs(z*z)>QL_EPSILON * m)
-            multiplier = z/xx;
-        else {
-            multiplier = 1.0 - 0.5*rho*z - (3.0*rho*rho-2.0)*z*z/12.0;
-        }
-        return (alpha/D)*multiplier*d;
+        return SabrExpansion(expiryTime, alpha, beta, nu, rho)(strike,
+                                                               forward);
     }
 
     Real unsafeShiftedSabrVolatility(Rate strike,
@@ -81,6 +107,22 @@ namespace QuantLib {
 
     }
 
+    void unsafeShiftedSabrVolatility(const std::vector<Rate>& strikes,
+                                     Rate forward,
+                                     Time expiryTime,
+                                     Real alpha,
+                                     Real beta,
+                                     Real nu,
+                                     Real rho,
+                                     Real shift,
+                                     std::vector<Volatility>& results) {
+        const SabrExpansion expansion(expiryTime, alpha, beta, nu, rho);
+        const Rate shiftedForward = forward + shift;
+        results.resize(strikes.size());
+        for (Size i=0; i<strikes.size(); ++i)
+            results[i] = expansion(strikes[i]+shift, shiftedForward);
+    }
+
     void validateSabrParameters(Real alpha,
                                 Real beta,
                                 Real nu,
@@ -132,4 +174,27 @@ namespace QuantLib {
                                              alpha, beta, nu, rho,shift);
     }
 
+    void shiftedSabrVolatility(const std::vector<Rate>& strikes,
+                               Rate forward,
+                               Time expiryTime,
+                               Real alpha,
+                               Real beta,
+                               Real nu,
+                               Real rho,
+                               Real shift,
+                               std::vector<Volatility>& results) {
+        for (Size i=0; i<strikes.size(); ++i)
+            QL_REQUIRE(strikes[i] + shift > 0.0,
+                       "strike+shift must be positive: "
+                       << io::rate(strikes[i]) << "+" << io::rate(shift)
+                       << " not allowed");
+        QL_REQUIRE(forward + shift > 0.0, "at the money forward rate + shift must be "
+                   "positive: " << io::rate(forward) << " " << io::rate(shift) << " not allowed");
+        QL_REQUIRE(expiryTime>=0.0, "expiry time must be non-negative: "
+                                   << expiryTime << " not allowed");
+        validateSabrParameters(alpha, beta, nu, rho);
+        unsafeShiftedSabrVolatility(strikes, forward, expiryTime,
+                                    alpha, beta, nu, rho, shift, results);
+    }
+
 }
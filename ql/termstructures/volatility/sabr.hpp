@@ -28,6 +28,7 @@
 #define quantlib_sabr_hpp
 
 #include <ql/types.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -65,6 +66,36 @@ namespace QuantLib {
                                  Real rho,
                                  Real shift);
 
+    /*! \name Batch calculations
+
+        The following functions compute the shifted SABR volatility on
+        a strip of strikes, writing the results (resized if needed) in
+        the output vector.  The terms of the expansion not depending on
+        the strike are computed once; the results are the same as those
+        of the scalar versions.
+    */
+    //@{
+    void unsafeShiftedSabrVolatility(const std::vector<Rate>& strikes,
+                                     Rate forward,
+                                     Time expiryTime,
+                                     Real alpha,
+                                     Real beta,
+                                     Real nu,
+                                     Real rho,
+                                     Real shift,
+                                     std::vector<Volatility>& results);
+
+    void shiftedSabrVolatility(const std::vector<Rate>& strikes,
+                               Rate forward,
+                               Time expiryTime,
+                               Real alpha,
+                               Real beta,
+                               Real nu,
+                               Real rho,
+                               Real shift,
+                               std::vector<Volatility>& results);
+    //@}
+
     void validateSabrParameters(Real alpha,
                                 Real beta,
                                 Real nu,
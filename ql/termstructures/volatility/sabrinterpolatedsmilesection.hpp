@@ -90,8 +90,14 @@ namespace QuantLib {
         Real maxStrike () const;
         Real atmLevel() const;
         //@}
+        void optionPrices(const std::vector<Rate>& strikes,
+                          std::vector<Real>& results,
+                          Option::Type type = Option::Call,
+                          Real discount=1.0) const;
         Real varianceImpl(Rate strike) const;
         Volatility volatilityImpl(Rate strike) const;
+        void volatilitiesImpl(const std::vector<Rate>& strikes,
+                              std::vector<Volatility>& results) const;
          //! \name Inspectors
         //@{
         Real alpha() const;
@@ -141,6 +147,27 @@ namespace QuantLib {
         return (*sabrInterpolation_)(strike, true);
     }
 
+    inline void SabrInterpolatedSmileSection::volatilitiesImpl(
+                                    const std::vector<Rate>& strikes,
+                                    std::vector<Volatility>& results) const {
+        calculate();
+        shiftedSabrVolatility(strikes, sabrInterpolation_->forward(),
+                              sabrInterpolation_->expiry(),
+                              sabrInterpolation_->alpha(),
+                              sabrInterpolation_->beta(),
+                              sabrInterpolation_->nu(),
+                              sabrInterpolation_->rho(),
+                              shift(), results);
+    }
+
+    inline void SabrInterpolatedSmileSection::optionPrices(
+                                    const std::vector<Rate>& strikes,
+                                    std::vector<Real>& results,
+                                    Option::Type type,
+                                    Real discount) const {
+        blackOptionPrices(strikes, results, type, discount);
+    }
+
     inline Real SabrInterpolatedSmileSection::alpha() const {
         calculate();
         return sabrInterpolation_->alpha();
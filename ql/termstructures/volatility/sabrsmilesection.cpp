@@ -78,4 +78,22 @@ namespace QuantLib {
         return unsafeShiftedSabrVolatility(strike, forward_, exerciseTime(),
                                            alpha_, beta_, nu_, rho_, shift_);
      }
+
+     void SabrSmileSection::volatilitiesImpl(
+                                    const std::vector<Rate>& strikes,
+                                    std::vector<Volatility>& results) const {
+        std::vector<Rate> floored(strikes.size());
+        for (Size i=0; i<strikes.size(); ++i)
+            floored[i] = std::max(0.00001 - shift(), strikes[i]);
+        unsafeShiftedSabrVolatility(floored, forward_, exerciseTime(),
+                                    alpha_, beta_, nu_, rho_, shift_,
+                                    results);
+     }
+
+     void SabrSmileSection::optionPrices(const std::vector<Rate>& strikes,
+                                         std::vector<Real>& results,
+                                         Option::Type type,
+                                         Real discount) const {
+        blackOptionPrices(strikes, results, type, discount);
+     }
 }
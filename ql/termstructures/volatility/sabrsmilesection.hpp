@@ -45,9 +45,15 @@ namespace QuantLib {
         Real minStrike () const { return -shift_; }
         Real maxStrike () const { return QL_MAX_REAL; }
         Real atmLevel() const { return forward_; }
+        void optionPrices(const std::vector<Rate>& strikes,
+                          std::vector<Real>& results,
+                          Option::Type type = Option::Call,
+                          Real discount=1.0) const;
       protected:
         Real varianceImpl(Rate strike) const;
         Volatility volatilityImpl(Rate strike) const;
+        void volatilitiesImpl(const std::vector<Rate>& strikes,
+                              std::vector<Volatility>& results) const;
       private:
         Real alpha_, beta_, nu_, rho_, forward_, shift_;
     };
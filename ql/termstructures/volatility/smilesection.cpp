@@ -84,6 +84,47 @@ namespace QuantLib {
             return bachelierBlackFormula(type,strike,atm,sqrt(variance(strike)),discount);
     }
 
+    void SmileSection::optionPrices(const std::vector<Rate>& strikes,
+                                    std::vector<Real>& results,
+                                    Option::Type type,
+                                    Real discount) const {
+        results.resize(strikes.size());
+        for (Size i=0; i<strikes.size(); ++i)
+            results[i] = optionPrice(strikes[i], type, discount);
+    }
+
+    void SmileSection::volatilitiesImpl(
+                                    const std::vector<Rate>& strikes,
+                                    std::vector<Volatility>& results) const {
+        results.resize(strikes.size());
+        for (Size i=0; i<strikes.size(); ++i)
+            results[i] = volatilityImpl(strikes[i]);
+    }
+
+    void SmileSection::blackOptionPrices(const std::vector<Rate>& strikes,
+                                         std::vector<Real>& results,
+                                         Option::Type type,
+                                         Real discount) const {
+        Real atm = atmLevel();
+        QL_REQUIRE(atm != Null<Real>(),
+                   "smile section must provide atm level to compute option price");
+        std::vector<Real> stdDevs;
+        volatilities(strikes, stdDevs);
+        const Time t = exerciseTime();
+        if (volatilityType() == ShiftedLognormal) {
+            const Real s = shift();
+            for (Size i=0; i<strikes.size(); ++i)
+                stdDevs[i] = fabs(strikes[i]+s) < QL_EPSILON ?
+                    0.2 : sqrt(stdDevs[i]*stdDevs[i]*t);
+            blackFormula(type, strikes, atm, stdDevs, results, discount, s);
+        } else {
+            for (Size i=0; i<strikes.size(); ++i)
+                stdDevs[i] = sqrt(stdDevs[i]*stdDevs[i]*t);
+            bachelierBlackFormula(type, strikes, atm, stdDevs, results,
+                                  discount);
+        }
+    }
+
     Real SmileSection::digitalOptionPrice(Rate strike,
                                           Option::Type type,
                                           Real discount,
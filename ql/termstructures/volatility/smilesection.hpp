@@ -30,6 +30,7 @@
 #include <ql/utilities/null.hpp>
 #include <ql/option.hpp>
 #include <ql/termstructures/volatility/volatilitytype.hpp>
+#include <vector>
 
 namespace QuantLib {
 
@@ -78,10 +79,37 @@ namespace QuantLib {
                              Real discount=1.0,
                              Real gap=1.0E-4) const;
         Volatility volatility(Rate strike, VolatilityType type, Real shift=0.0) const;
+        /*! \name Batch calculations
+
+            Volatilities and option prices on a strip of strikes; the
+            results vector is resized if needed.  The default
+            implementations loop over the scalar methods; sections
+            with a closed-form smile override them so that the
+            strike-independent work is done once per strip.
+        */
+        //@{
+        void volatilities(const std::vector<Rate>& strikes,
+                          std::vector<Volatility>& results) const;
+        virtual void optionPrices(const std::vector<Rate>& strikes,
+                                  std::vector<Real>& results,
+                                  Option::Type type = Option::Call,
+                                  Real discount=1.0) const;
+        //@}
       protected:
         virtual void initializeExerciseTime() const;
         virtual Real varianceImpl(Rate strike) const;
         virtual Volatility volatilityImpl(Rate strike) const = 0;
+        virtual void volatilitiesImpl(const std::vector<Rate>& strikes,
+                                      std::vector<Volatility>& results) const;
+        /*! batch version of the default optionPrice(), based on
+            volatilities(); it can be used by derived classes whose
+            variance is given by the square of their volatility
+            times the exercise time.
+        */
+        void blackOptionPrices(const std::vector<Rate>& strikes,
+                               std::vector<Real>& results,
+                               Option::Type type,
+                               Real discount) const;
       private:
         bool isFloating_;
         mutable Date referenceDate_;
@@ -103,6 +131,12 @@ namespace QuantLib {
         return volatilityImpl(strike);
     }
 
+    inline void SmileSection::volatilities(
+                                    const std::vector<Rate>& strikes,
+                                    std::vector<Volatility>& results) const {
+        volatilitiesImpl(strikes, results);
+    }
+
     inline const Date& SmileSection::referenceDate() const {
         QL_REQUIRE(referenceDate_!=Date(),
                    "referenceDate not available for this instance");
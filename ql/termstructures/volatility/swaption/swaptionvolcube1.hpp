@@ -39,6 +39,7 @@
 #include <ql/quote.hpp>
 
 #include <boost/make_shared.hpp>
+#include <string>
 
 #ifndef SWAPTIONVOLCUBE_VEGAWEIGHTED_TOL
     #define SWAPTIONVOLCUBE_VEGAWEIGHTED_TOL 15.0e-4
@@ -53,6 +54,17 @@ namespace QuantLib {
     class EndCriteria;
     class OptimizationMethod;
 
+    /*! The smiles at the nodes of the cube are fitted concurrently
+        when OpenMP is enabled, unless an optimization method is
+        passed; such a method would be shared by all the fits.
+
+        The results of each fit are kept, and a node is fitted
+        again only if its forward, shift, volatilities or parameter
+        guess changed.  If warmStart is set, such a fit starts from
+        the previous solution at the node for the parameters that
+        are not fixed, and falls back to the guess if this does not
+        give an acceptable fit.
+    */
     template<class Model>
     class SwaptionVolCube1x : public SwaptionVolatilityCube {
         class Cube {
@@ -130,7 +142,8 @@ namespace QuantLib {
             const bool useMaxError = false,
             const Size maxGuesses = 50,
             const bool backwardFlat = false,
-            const Real cutoffStrike = 0.0001);
+            const Real cutoffStrike = 0.0001,
+            const bool warmStart = false);
         //! \name LazyObject interface
         //@{
         void performCalculations() const;
@@ -163,13 +176,42 @@ namespace QuantLib {
                            const Period& swapTenor);
         void updateAfterRecalibration();
      protected:
+        // inputs and results of the smile fit at a node of the cube
+        struct NodeCalibration {
+            NodeCalibration() : calibrated(false) {}
+            Time optionTime, swapLength;
+            Rate forward;
+            Real shift;
+            std::vector<Real> strikes, volatilities, guess;
+            // alpha, beta, nu, rho, forward, rms error, max error,
+            // end criteria
+            std::vector<Real> result;
+            std::string error;
+            bool calibrated;
+            bool sameInputs(const NodeCalibration& o) const {
+                return optionTime == o.optionTime
+                    && swapLength == o.swapLength
+                    && forward == o.forward && shift == o.shift
+                    && strikes == o.strikes
+                    && volatilities == o.volatilities
+                    && guess == o.guess;
+            }
+        };
         void registerWithParametersGuess();
         void setParameterGuess() const;
         boost::shared_ptr<SmileSection> smileSection(
                                     Time optionTime,
                                     Time swapLength,
                                     const Cube& sabrParametersCube) const;
-        Cube sabrCalibration(const Cube &marketVolCube) const;
+        NodeCalibration nodeInputs(const Cube& marketVolCube,
+                                   Size j, Size k) const;
+        void calibrateNode(NodeCalibration& node,
+                           const std::vector<Real>* startingPoint) const;
+        void calibrateNodes(std::vector<NodeCalibration>& nodes,
+                            const std::vector<NodeCalibration>& previous)
+                                                                       const;
+        Cube sabrCalibration(const Cube &marketVolCube,
+                             std::vector<NodeCalibration>& nodes) const;
         void fillVolatilityCube() const;
         void createSparseSmiles() const;
         std::vector<Real> spreadVolInterpolation(const Date& atmOptionDate,
@@ -194,6 +236,8 @@ namespace QuantLib {
         const Size maxGuesses_;
         const bool backwardFlat_;
         const Real cutoffStrike_;
+        const bool warmStart_;
+        mutable std::vector<NodeCalibration> sparseNodes_, denseNodes_;
 
         class PrivateObserver : public Observer {
           public:
@@ -231,7 +275,8 @@ namespace QuantLib {
         const boost::shared_ptr<OptimizationMethod> &optMethod,
         const Real errorAccept, const bool useMaxError, const Size maxGuesses,
         const bool backwardFlat,
-        const Real cutoffStrike)
+        const Real cutoffStrike,
+        const bool warmStart)
         : SwaptionVolatilityCube(atmVolStructure, optionTenors, swapTenors,
                                  strikeSpreads, volSpreads, swapIndexBase,
                                  shortSwapIndexBase, vegaWeightedSmileFit),
@@ -240,7 +285,8 @@ namespace QuantLib {
           isAtmCalibrated_(isAtmCalibrated), endCriteria_(endCriteria),
           optMethod_(optMethod),
           useMaxError_(useMaxError), maxGuesses_(maxGuesses),
-          backwardFlat_(backwardFlat), cutoffStrike_(cutoffStrike) {
+          backwardFlat_(backwardFlat), cutoffStrike_(cutoffStrike),
+          warmStart_(warmStart) {
 
         // the current implementations are all lognormal, if we have
         // a normal one, we can move this check to the implementing classes
@@ -311,7 +357,7 @@ namespace QuantLib {
         }
         marketVolCube_.updateInterpolators();
 
-        sparseParameters_ = sabrCalibration(marketVolCube_);
+        sparseParameters_ = sabrCalibration(marketVolCube_, sparseNodes_);
         //parametersGuess_ = sparseParameters_;
         sparseParameters_.updateInterpolators();
         //parametersGuess_.updateInterpolators();
@@ -319,7 +365,8 @@ namespace QuantLib {
 
         if(isAtmCalibrated_){
             fillVolatilityCube();
-            denseParameters_ = sabrCalibration(volCubeAtmCalibrated_);
+            denseParameters_ = sabrCalibration(volCubeAtmCalibrated_,
+                                               denseNodes_);
             denseParameters_.updateInterpolators();
         }
     }
@@ -328,15 +375,136 @@ namespace QuantLib {
         volCubeAtmCalibrated_ = marketVolCube_;
         if(isAtmCalibrated_){
             fillVolatilityCube();
-            denseParameters_ = sabrCalibration(volCubeAtmCalibrated_);
+            denseParameters_ = sabrCalibration(volCubeAtmCalibrated_,
+                                               denseNodes_);
             denseParameters_.updateInterpolators();
         }
         notifyObservers();
     }
 
+    template <class Model>
+    typename SwaptionVolCube1x<Model>::NodeCalibration
+    SwaptionVolCube1x<Model>::nodeInputs(const Cube& marketVolCube,
+                                         Size j, Size k) const {
+
+        const std::vector<Time>& optionTimes = marketVolCube.optionTimes();
+        const std::vector<Time>& swapLengths = marketVolCube.swapLengths();
+        const std::vector<Date>& optionDates = marketVolCube.optionDates();
+        const std::vector<Period>& swapTenors = marketVolCube.swapTenors();
+        const std::vector<Matrix>& tmpMarketVolCube = marketVolCube.points();
+
+        NodeCalibration node;
+        node.optionTime = optionTimes[j];
+        node.swapLength = swapLengths[k];
+        node.forward = atmStrike(optionDates[j], swapTenors[k]);
+        node.shift = atmVol_->shift(optionTimes[j], swapLengths[k]);
+        for (Size i=0; i<nStrikes_; i++){
+            Real strike = node.forward+strikeSpreads_[i];
+            if(strike + node.shift >=cutoffStrike_) {
+                node.strikes.push_back(strike);
+                node.volatilities.push_back(tmpMarketVolCube[i][j][k]);
+            }
+        }
+        node.guess = parametersGuess_.operator()(optionTimes[j],
+                                                 swapLengths[k]);
+        return node;
+    }
+
+    template <class Model>
+    void SwaptionVolCube1x<Model>::calibrateNode(
+                        NodeCalibration& node,
+                        const std::vector<Real>* startingPoint) const {
+
+        // fixed parameters always come from the guess
+        std::vector<Real> start(node.guess);
+        if (startingPoint != 0) {
+            for (Size i=0; i<4; ++i)
+                if (!isParameterFixed_[i])
+                    start[i] = (*startingPoint)[i];
+        }
+
+        const boost::shared_ptr<typename Model::Interpolation> sabrInterpolation =
+            boost::shared_ptr<typename Model::Interpolation>(new
+                                  (typename Model::Interpolation)(node.strikes.begin(), node.strikes.end(),
+                                  node.volatilities.begin(),
+                                  node.optionTime, node.forward,
+                                  start[0], start[1],
+                                  start[2], start[3],
+                                  isParameterFixed_[0],
+                                  isParameterFixed_[1],
+                                  isParameterFixed_[2],
+                                  isParameterFixed_[3],
+                                  vegaWeightedSmileFit_,
+                                  endCriteria_,
+                                  optMethod_,
+                                  errorAccept_,
+                                  useMaxError_,
+                                  maxGuesses_,
+                                  node.shift));
+        sabrInterpolation->update();
+
+        node.result.resize(8);
+        node.result[0] = sabrInterpolation->alpha();
+        node.result[1] = sabrInterpolation->beta();
+        node.result[2] = sabrInterpolation->nu();
+        node.result[3] = sabrInterpolation->rho();
+        node.result[4] = node.forward;
+        node.result[5] = sabrInterpolation->rmsError();
+        node.result[6] = sabrInterpolation->maxError();
+        node.result[7] = sabrInterpolation->endCriteria();
+
+        // a warm start that does not give an acceptable fit is
+        // retried from the guess
+        if (startingPoint != 0
+            && (node.result[7] == EndCriteria::MaxIterations
+                || (useMaxError_ ? node.result[6] : node.result[5])
+                                                   >= maxErrorTolerance_))
+            calibrateNode(node, 0);
+    }
+
+    template <class Model>
+    void SwaptionVolCube1x<Model>::calibrateNodes(
+                    std::vector<NodeCalibration>& nodes,
+                    const std::vector<NodeCalibration>& previous) const {
+
+        // nodes whose inputs did not change keep their results
+        std::vector<Size> toBeCalibrated;
+        for (Size n=0; n<nodes.size(); ++n) {
+            if (n < previous.size() && previous[n].calibrated
+                && nodes[n].sameInputs(previous[n])) {
+                nodes[n].result = previous[n].result;
+                nodes[n].calibrated = true;
+            } else {
+                toBeCalibrated.push_back(n);
+            }
+        }
+
+        // the fits are independent, unless they share a user-provided
+        // optimization method
+        #pragma omp parallel for schedule(dynamic) if(!optMethod_)
+        for (long m=0; m<long(toBeCalibrated.size()); ++m) {
+            const Size n = toBeCalibrated[m];
+            // exceptions must not escape the parallel region
+            try {
+                const bool warm = warmStart_ && n < previous.size()
+                    && previous[n].calibrated
+                    && previous[n].optionTime == nodes[n].optionTime
+                    && previous[n].swapLength == nodes[n].swapLength;
+                calibrateNode(nodes[n], warm ? &previous[n].result : 0);
+                nodes[n].calibrated = true;
+            } catch (std::exception& e) {
+                nodes[n].error = e.what();
+            } catch (...) {
+                nodes[n].error = "unknown error";
+            }
+        }
+    }
+
     template <class Model>
     typename SwaptionVolCube1x<Model>::Cube
-    SwaptionVolCube1x<Model>::sabrCalibration(const Cube &marketVolCube) const {
+    SwaptionVolCube1x<Model>::sabrCalibration(
+                            const Cube &marketVolCube,
+                            std::vector<NodeCalibration>& previous) const {
 
         const std::vector<Time>& optionTimes = marketVolCube.optionTimes();
         const std::vector<Time>& swapLengths = marketVolCube.swapLengths();
@@ -351,58 +519,33 @@ namespace QuantLib {
         Matrix maxErrors(alphas);
         Matrix endCriteria(alphas);
 
-        const std::vector<Matrix>& tmpMarketVolCube = marketVolCube.points();
+        // inputs are collected serially, since they might trigger
+        // the calculation of term structures
+        std::vector<NodeCalibration> nodes;
+        nodes.reserve(optionTimes.size()*swapLengths.size());
+        for (Size j=0; j<optionTimes.size(); j++)
+            for (Size k=0; k<swapLengths.size(); k++)
+                nodes.push_back(nodeInputs(marketVolCube, j, k));
 
-        std::vector<Real> strikes(strikeSpreads_.size());
-        std::vector<Real> volatilities(strikeSpreads_.size());
+        if (previous.size() != nodes.size())
+            previous.clear();
+        calibrateNodes(nodes, previous);
 
         for (Size j=0; j<optionTimes.size(); j++) {
             for (Size k=0; k<swapLengths.size(); k++) {
-                Rate atmForward = atmStrike(optionDates[j], swapTenors[k]);
-                Real shiftTmp = atmVol_->shift(optionTimes[j], swapLengths[k]);
-                strikes.clear();
-                volatilities.clear();
-                for (Size i=0; i<nStrikes_; i++){
-                    Real strike = atmForward+strikeSpreads_[i];
-                    if(strike + shiftTmp >=cutoffStrike_) {
-                        strikes.push_back(strike);
-                        volatilities.push_back(tmpMarketVolCube[i][j][k]);
-                    }
-                }
-
-                const std::vector<Real>& guess = parametersGuess_.operator()(
-                    optionTimes[j], swapLengths[k]);
-
-                const boost::shared_ptr<typename Model::Interpolation> sabrInterpolation =
-                    boost::shared_ptr<typename Model::Interpolation>(new
-                                          (typename Model::Interpolation)(strikes.begin(), strikes.end(),
-                                          volatilities.begin(),
-                                          optionTimes[j], atmForward,
-                                          guess[0], guess[1],
-                                          guess[2], guess[3],
-                                          isParameterFixed_[0],
-                                          isParameterFixed_[1],
-                                          isParameterFixed_[2],
-                                          isParameterFixed_[3],
-                                          vegaWeightedSmileFit_,
-                                          endCriteria_,
-                                          optMethod_,
-                                          errorAccept_,
-                                          useMaxError_,
-                                          maxGuesses_,
-                                          shiftTmp));
-                sabrInterpolation->update();
-
-                Real rmsError = sabrInterpolation->rmsError();
-                Real maxError = sabrInterpolation->maxError();
-                alphas     [j][k] = sabrInterpolation->alpha();
-                betas      [j][k] = sabrInterpolation->beta();
-                nus        [j][k] = sabrInterpolation->nu();
-                rhos       [j][k] = sabrInterpolation->rho();
-                forwards   [j][k] = atmForward;
+                const NodeCalibration& node = nodes[j*swapLengths.size()+k];
+                QL_REQUIRE(node.error.empty(), node.error);
+
+                Real rmsError = node.result[5];
+                Real maxError = node.result[6];
+                alphas     [j][k] = node.result[0];
+                betas      [j][k] = node.result[1];
+                nus        [j][k] = node.result[2];
+                rhos       [j][k] = node.result[3];
+                forwards   [j][k] = node.forward;
                 errors     [j][k] = rmsError;
                 maxErrors  [j][k] = maxError;
-                endCriteria[j][k] = sabrInterpolation->endCriteria();
+                endCriteria[j][k] = node.result[7];
 
                 QL_ENSURE(endCriteria[j][k]!=EndCriteria::MaxIterations,
                           "global swaptions calibration failed: "
@@ -433,6 +576,9 @@ namespace QuantLib {
 
             }
         }
+        // the results are kept only if the whole cube was calibrated
+        previous.swap(nodes);
+
         Cube sabrParametersCube(optionDates, swapTenors,
                                 optionTimes, swapLengths, 8,
                                 true, backwardFlat_);
@@ -463,57 +609,14 @@ namespace QuantLib {
                            swapTenor) - swapTenors.begin();
         QL_REQUIRE(k != swapTenors.size(), "swap tenor not found");
 
-        std::vector<Real> calibrationResult(8,0.);
-        const std::vector<Matrix>& tmpMarketVolCube = marketVolCube.points();
-
-        std::vector<Real> strikes(strikeSpreads_.size());
-        std::vector<Real> volatilities(strikeSpreads_.size());
+        std::vector<NodeCalibration> nodes;
+        for (Size j=0; j<optionTimes.size(); j++)
+            nodes.push_back(nodeInputs(marketVolCube, j, k));
+        calibrateNodes(nodes, std::vector<NodeCalibration>());
 
         for (Size j=0; j<optionTimes.size(); j++) {
-            Rate atmForward = atmStrike(optionDates[j], swapTenors[k]);
-            Real shiftTmp = atmVol_->shift(optionTimes[j], swapLengths[k]);
-            strikes.clear();
-            volatilities.clear();
-            for (Size i=0; i<nStrikes_; i++){
-                Real strike = atmForward+strikeSpreads_[i];
-                if(strike+shiftTmp>=cutoffStrike_) {
-                    strikes.push_back(strike);
-                    volatilities.push_back(tmpMarketVolCube[i][j][k]);
-                }
-            }
-
-            const std::vector<Real>& guess = parametersGuess_.operator()(
-                optionTimes[j], swapLengths[k]);
-
-                const boost::shared_ptr<typename Model::Interpolation> sabrInterpolation =
-                    boost::shared_ptr<typename Model::Interpolation>(new
-                                          (typename Model::Interpolation)(strikes.begin(), strikes.end(),
-                                      volatilities.begin(),
-                                      optionTimes[j], atmForward,
-                                      guess[0], guess[1],
-                                      guess[2], guess[3],
-                                      isParameterFixed_[0],
-                                      isParameterFixed_[1],
-                                      isParameterFixed_[2],
-                                      isParameterFixed_[3],
-                                      vegaWeightedSmileFit_,
-                                      endCriteria_,
-                                      optMethod_,
-                                      errorAccept_,
-                                      useMaxError_,
-                                      maxGuesses_,
-                                      shiftTmp));
-
-            sabrInterpolation->update();
-            Real interpolationError = sabrInterpolation->rmsError();
-            calibrationResult[0]=sabrInterpolation->alpha();
-            calibrationResult[1]=sabrInterpolation->beta();
-            calibrationResult[2]=sabrInterpolation->nu();
-            calibrationResult[3]=sabrInterpolation->rho();
-            calibrationResult[4]=atmForward;
-            calibrationResult[5]=interpolationError;
-            calibrationResult[6]=sabrInterpolation->maxError();
-            calibrationResult[7]=sabrInterpolation->endCriteria();
+            QL_REQUIRE(nodes[j].error.empty(), nodes[j].error);
+            const std::vector<Real>& calibrationResult = nodes[j].result;
 
             QL_ENSURE(calibrationResult[7]!=EndCriteria::MaxIterations,
                       "section calibration failed: "
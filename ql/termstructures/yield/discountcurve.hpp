@@ -95,6 +95,8 @@ namespace QuantLib {
         //! \name YieldTermStructure implementation
         //@{
         DiscountFactor discountImpl(Time) const;
+        void discountsImpl(const std::vector<Time>& times,
+                           std::vector<DiscountFactor>& discounts) const;
         //@}
         mutable std::vector<Date> dates_;
       private:
@@ -168,6 +170,39 @@ namespace QuantLib {
         return dMax * std::exp(- instFwdMax * (t-tMax));
     }
 
+    template <class T>
+    void InterpolatedDiscountCurve<T>::discountsImpl(
+                               const std::vector<Time>& times,
+                               std::vector<DiscountFactor>& discounts) const {
+        Time tMax = this->times_.back();
+        bool extrapolated = false;
+        for (Size i=0; i<times.size() && !extrapolated; ++i)
+            extrapolated = times[i] > tMax;
+        if (!extrapolated) {
+            this->interpolation_.values(times, discounts, true);
+            return;
+        }
+
+        std::vector<Time> t;
+        std::vector<DiscountFactor> d;
+        t.reserve(times.size());
+        for (Size i=0; i<times.size(); ++i) {
+            if (times[i] <= tMax)
+                t.push_back(times[i]);
+        }
+        this->interpolation_.values(t, d, true);
+
+        // flat fwd extrapolation
+        DiscountFactor dMax = this->data_.back();
+        Rate instFwdMax = - this->interpolation_.derivative(tMax) / dMax;
+        for (Size i=0, j=0; i<times.size(); ++i) {
+            if (times[i] <= tMax)
+                discounts[i] = d[j++];
+            else
+                discounts[i] = dMax * std::exp(- instFwdMax * (times[i]-tMax));
+        }
+    }
+
     template <class T>
     InterpolatedDiscountCurve<T>::InterpolatedDiscountCurve(
                                     const DayCounter& dayCounter,
@@ -84,6 +84,8 @@ namespace QuantLib {
         //! \name YieldTermStructure implementation
         //@{
         DiscountFactor discountImpl(Time) const;
+        void discountsImpl(const std::vector<Time>& times,
+                           std::vector<DiscountFactor>& discounts) const;
         //@}
 
         Handle<Quote> forward_;
@@ -103,6 +105,14 @@ namespace QuantLib {
         calculate();
         return rate_.discountFactor(t);
     }
+
+    inline void FlatForward::discountsImpl(
+                               const std::vector<Time>& times,
+                               std::vector<DiscountFactor>& discounts) const {
+        calculate();
+        for (Size i=0; i<times.size(); ++i)
+            discounts[i] = rate_.discountFactor(times[i]);
+    }
   
     inline void FlatForward::performCalculations() const {
         rate_ = InterestRate(forward_->value(), dayCounter(),
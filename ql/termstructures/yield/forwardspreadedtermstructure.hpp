@@ -66,6 +66,8 @@ namespace QuantLib {
         Rate forwardImpl(Time t) const;
         /* This method must disappear should the spread become a curve */
         Rate zeroYieldImpl(Time t) const;
+        void zeroYieldsImpl(const std::vector<Time>& times,
+                            std::vector<Rate>& rates) const;
         //@}
       private:
         Handle<YieldTermStructure> originalCurve_;
@@ -126,6 +128,16 @@ namespace QuantLib {
             + spread_->value();
     }
 
+    inline void ForwardSpreadedTermStructure::zeroYieldsImpl(
+                                        const std::vector<Time>& times,
+                                        std::vector<Rate>& rates) const {
+        originalCurve_->zeroRate(times, rates, Continuous, NoFrequency,
+                                 true);
+        Spread spread = spread_->value();
+        for (Size i=0; i<times.size(); ++i)
+            rates[i] += spread;
+    }
+
 }
 
 #endif
@@ -103,6 +103,8 @@ namespace QuantLib {
         //! \name ZeroYieldStructure implementation
         //@{
         Rate zeroYieldImpl(Time t) const;
+        void zeroYieldsImpl(const std::vector<Time>& times,
+                            std::vector<Rate>& rates) const;
         //@}
         mutable std::vector<Date> dates_;
       private:
@@ -170,6 +172,40 @@ namespace QuantLib {
         return (zMax * tMax + instFwdMax * (t-tMax)) / t;
     }
 
+    template <class T>
+    void InterpolatedZeroCurve<T>::zeroYieldsImpl(
+                                        const std::vector<Time>& times,
+                                        std::vector<Rate>& rates) const {
+        Time tMax = this->times_.back();
+        bool extrapolated = false;
+        for (Size i=0; i<times.size() && !extrapolated; ++i)
+            extrapolated = times[i] > tMax;
+        if (!extrapolated) {
+            this->interpolation_.values(times, rates, true);
+            return;
+        }
+
+        std::vector<Time> t;
+        std::vector<Rate> z;
+        t.reserve(times.size());
+        for (Size i=0; i<times.size(); ++i) {
+            if (times[i] <= tMax)
+                t.push_back(times[i]);
+        }
+        this->interpolation_.values(t, z, true);
+
+        // flat fwd extrapolation
+        Rate zMax = this->data_.back();
+        Rate instFwdMax = zMax + tMax * this->interpolation_.derivative(tMax);
+        for (Size i=0, j=0; i<times.size(); ++i) {
+            if (times[i] <= tMax)
+                rates[i] = z[j++];
+            else
+                rates[i] = (zMax * tMax + instFwdMax * (times[i]-tMax))
+                         / times[i];
+        }
+    }
+
     template <class T>
     InterpolatedZeroCurve<T>::InterpolatedZeroCurve(
                                     const DayCounter& dayCounter,
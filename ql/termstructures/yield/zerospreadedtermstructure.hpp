@@ -66,6 +66,8 @@ namespace QuantLib {
       protected:
         //! returns the spreaded zero yield rate
         Rate zeroYieldImpl(Time) const;
+        void zeroYieldsImpl(const std::vector<Time>& times,
+                            std::vector<Rate>& rates) const;
         //! returns the spreaded forward rate
         /* This method must disappear should the spread become a curve */
         Rate forwardImpl(Time) const;
@@ -138,6 +140,22 @@ namespace QuantLib {
         return spreadedRate.equivalentRate(Continuous, NoFrequency, t);
     }
 
+    inline void ZeroSpreadedTermStructure::zeroYieldsImpl(
+                                        const std::vector<Time>& times,
+                                        std::vector<Rate>& rates) const {
+        // the original rates are calculated in a single pass
+        std::vector<Rate> zeroRates;
+        originalCurve_->zeroRate(times, zeroRates, comp_, freq_, true);
+        DayCounter dc = originalCurve_->dayCounter();
+        Spread spread = spread_->value();
+        for (Size i=0; i<times.size(); ++i) {
+            InterestRate spreadedRate(zeroRates[i] + spread, dc,
+                                      comp_, freq_);
+            rates[i] = spreadedRate.equivalentRate(Continuous, NoFrequency,
+                                                   times[i]);
+        }
+    }
+
     inline Rate ZeroSpreadedTermStructure::forwardImpl(Time t) const {
         return originalCurve_->forwardRate(t, t, comp_, freq_, true)
             + spread_->value();
@@ -76,6 +76,11 @@ namespace QuantLib {
         //@{
         //! zero-yield calculation
         virtual Rate zeroYieldImpl(Time) const = 0;
+        /*! zero yields for a batch of non-null times; the default
+            implementation calls zeroYieldImpl(Time) for each of them.
+        */
+        virtual void zeroYieldsImpl(const std::vector<Time>& times,
+                                    std::vector<Rate>& rates) const;
         //@}
 
         //! \name YieldTermStructure implementation
@@ -84,6 +89,8 @@ namespace QuantLib {
             from the zero yield.
         */
         DiscountFactor discountImpl(Time) const;
+        void discountsImpl(const std::vector<Time>& times,
+                           std::vector<DiscountFactor>& discounts) const;
         //@}
     };
 
@@ -97,6 +104,35 @@ namespace QuantLib {
         return DiscountFactor(std::exp(-r*t));
     }
 
+    inline void ZeroYieldStructure::zeroYieldsImpl(
+                                        const std::vector<Time>& times,
+                                        std::vector<Rate>& rates) const {
+        for (Size i=0; i<times.size(); ++i)
+            rates[i] = zeroYieldImpl(times[i]);
+    }
+
+    inline void ZeroYieldStructure::discountsImpl(
+                               const std::vector<Time>& times,
+                               std::vector<DiscountFactor>& discounts) const {
+        // null times are skipped as in discountImpl
+        std::vector<Time> t;
+        t.reserve(times.size());
+        for (Size i=0; i<times.size(); ++i) {
+            if (times[i] != 0.0)
+                t.push_back(times[i]);
+        }
+        std::vector<Rate> r(t.size());
+        zeroYieldsImpl(t, r);
+        for (Size i=0, j=0; i<times.size(); ++i) {
+            if (times[i] == 0.0) {
+                discounts[i] = 1.0;
+            } else {
+                discounts[i] = DiscountFactor(std::exp(-r[j]*t[j]));
+                ++j;
+            }
+        }
+    }
+
 }
 
 #endif
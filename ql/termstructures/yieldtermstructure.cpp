@@ -93,6 +93,11 @@ namespace QuantLib {
         if (jumps_.empty())
             return discountImpl(t);
 
+        return jumpEffect(t) * discountImpl(t);
+
+    }
+
+    DiscountFactor YieldTermStructure::jumpEffect(Time t) const {
         DiscountFactor jumpEffect = 1.0;
         for (Size i=0; i<nJumps_; ++i) {
             if (jumpTimes_[i]>0 && jumpTimes_[i]<t) {
@@ -105,8 +110,109 @@ namespace QuantLib {
                 jumpEffect *= thisJump;
             }
         }
-        return jumpEffect * discountImpl(t);
+        return jumpEffect;
+    }
 
+    void YieldTermStructure::discount(const std::vector<Time>& times,
+                                      std::vector<DiscountFactor>& discounts,
+                                      bool extrapolate) const {
+        if (times.empty()) {
+            discounts.clear();
+            return;
+        }
+
+        // checking the extremes is enough
+        Time tMin = times[0], tMax = times[0];
+        for (Size i=1; i<times.size(); ++i) {
+            tMin = std::min(tMin, times[i]);
+            tMax = std::max(tMax, times[i]);
+        }
+        checkRange(tMin, extrapolate);
+        checkRange(tMax, extrapolate);
+
+        discounts.resize(times.size());
+        discountsImpl(times, discounts);
+
+        if (!jumps_.empty()) {
+            for (Size i=0; i<times.size(); ++i)
+                discounts[i] *= jumpEffect(times[i]);
+        }
+    }
+
+    void YieldTermStructure::discountsImpl(
+                               const std::vector<Time>& times,
+                               std::vector<DiscountFactor>& discounts) const {
+        for (Size i=0; i<times.size(); ++i)
+            discounts[i] = discountImpl(times[i]);
+    }
+
+    void YieldTermStructure::zeroRate(const std::vector<Time>& times,
+                                      std::vector<Rate>& rates,
+                                      Compounding comp,
+                                      Frequency freq,
+                                      bool extrapolate) const {
+        std::vector<Time> t(times);
+        for (Size i=0; i<t.size(); ++i) {
+            if (t[i]==0.0) t[i] = dt;
+        }
+        std::vector<DiscountFactor> discounts;
+        discount(t, discounts, extrapolate);
+
+        DayCounter dc = dayCounter();
+        rates.resize(t.size());
+        for (Size i=0; i<t.size(); ++i)
+            rates[i] = InterestRate::impliedRate(1.0/discounts[i],
+                                                 dc, comp, freq,
+                                                 t[i]).rate();
+    }
+
+    void YieldTermStructure::forwardRate(const std::vector<Time>& t1,
+                                         const std::vector<Time>& t2,
+                                         std::vector<Rate>& rates,
+                                         Compounding comp,
+                                         Frequency freq,
+                                         bool extrapolate) const {
+        QL_REQUIRE(t1.size() == t2.size(),
+                   "mismatch between start (" << t1.size() << ") and "
+                   "end (" << t2.size() << ") times");
+        Size n = t1.size();
+        rates.resize(n);
+        if (n == 0)
+            return;
+
+        // instantaneous forwards are calculated as in the scalar
+        // method and are skipped in the batch calculation
+        std::vector<Time> starts, ends;
+        std::vector<Size> indices;
+        starts.reserve(n);
+        ends.reserve(n);
+        indices.reserve(n);
+        for (Size i=0; i<n; ++i) {
+            if (t2[i]==t1[i]) {
+                rates[i] = forwardRate(t1[i], t2[i], comp, freq,
+                                       extrapolate).rate();
+            } else {
+                QL_REQUIRE(t2[i]>t1[i],
+                           "t2 (" << t2[i] << ") < t1 (" << t1[i] << ")");
+                starts.push_back(t1[i]);
+                ends.push_back(t2[i]);
+                indices.push_back(i);
+            }
+        }
+        if (indices.empty())
+            return;
+
+        std::vector<DiscountFactor> startDiscounts, endDiscounts;
+        discount(starts, startDiscounts, extrapolate);
+        discount(ends, endDiscounts, extrapolate);
+
+        DayCounter dc = dayCounter();
+        for (Size j=0; j<indices.size(); ++j) {
+            Size i = indices[j];
+            Real compound = startDiscounts[j]/endDiscounts[j];
+            rates[i] = InterestRate::impliedRate(compound, dc, comp, freq,
+                                                 t2[i]-t1[i]).rate();
+        }
     }
 
     InterestRate YieldTermStructure::zeroRate(const Date& d,
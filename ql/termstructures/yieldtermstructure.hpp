@@ -146,6 +146,33 @@ namespace QuantLib {
                                  bool extrapolate = false) const;
         //@}
 
+        /*! \name Batch calculations
+
+            These methods return the same results as the corresponding
+            methods above for each of the passed times.  Range checks
+            are performed once for the whole batch, and curves can
+            override discountsImpl() to evaluate all times in a
+            single pass; this is faster when the times are sorted.
+        */
+        //@{
+        void discount(const std::vector<Time>& times,
+                      std::vector<DiscountFactor>& discounts,
+                      bool extrapolate = false) const;
+        //! zero-yield rates, with the same day counter as the curve
+        void zeroRate(const std::vector<Time>& times,
+                      std::vector<Rate>& rates,
+                      Compounding comp,
+                      Frequency freq = Annual,
+                      bool extrapolate = false) const;
+        //! forward rates between the times t1[i] and t2[i]
+        void forwardRate(const std::vector<Time>& t1,
+                         const std::vector<Time>& t2,
+                         std::vector<Rate>& rates,
+                         Compounding comp,
+                         Frequency freq = Annual,
+                         bool extrapolate = false) const;
+        //@}
+
         //! \name Jump inspectors
         //@{
         const std::vector<Date>& jumpDates() const;
@@ -168,10 +195,16 @@ namespace QuantLib {
         //@{
         //! discount factor calculation
         virtual DiscountFactor discountImpl(Time) const = 0;
+        /*! discount factors for a batch of times; the default
+            implementation calls discountImpl(Time) for each of them.
+        */
+        virtual void discountsImpl(const std::vector<Time>& times,
+                                   std::vector<DiscountFactor>& discounts) const;
         //@}
       private:
         // methods
         void setJumps();
+        DiscountFactor jumpEffect(Time t) const;
         // data members
         std::vector<Handle<Quote> > jumps_;
         std::vector<Date> jumpDates_;
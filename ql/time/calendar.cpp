@@ -22,9 +22,217 @@
 
 #include <ql/time/calendar.hpp>
 #include <ql/errors.hpp>
+#include <algorithm>
+#include <exception>
 
 namespace QuantLib {
 
+    namespace {
+
+        inline Size popCount(boost::uint64_t x) {
+            #if defined(__GNUC__)
+            return __builtin_popcountll(x);
+            #else
+            x = x - ((x >> 1) & 0x5555555555555555ULL);
+            x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+            x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+            return Size((x * 0x0101010101010101ULL) >> 56);
+            #endif
+        }
+
+        // position of the k-th (starting from 0) set bit of x
+        inline Size selectBit(boost::uint64_t x, Size k) {
+            for (Size i=0; i<k; ++i)
+                x &= x-1;
+            #if defined(__GNUC__)
+            return __builtin_ctzll(x);
+            #else
+            Size n = 0;
+            while ((x & 1) == 0) {
+                x >>= 1;
+                ++n;
+            }
+            return n;
+            #endif
+        }
+
+        // bits from 0 to n-1 set
+        inline boost::uint64_t lowBits(Size n) {
+            return n >= 64 ? ~boost::uint64_t(0)
+                           : (boost::uint64_t(1) << n) - 1;
+        }
+
+    }
+
+    Calendar::Impl::~Impl() {
+        for (Size i=0; i<dependencies_.size(); ++i) {
+            Impl& d = *dependencies_[i];
+            detail::MutexLock lock(d.dependentsMutex_);
+            d.dependents_.erase(std::find(d.dependents_.begin(),
+                                          d.dependents_.end(), this));
+        }
+    }
+
+    void Calendar::Impl::dependOn(const Calendar& c) {
+        QL_REQUIRE(c.impl_, "no implementation provided");
+        Impl& d = *c.impl_;
+        detail::MutexLock lock(d.dependentsMutex_);
+        d.dependents_.push_back(this);
+        dependencies_.push_back(c.impl_);
+    }
+
+    void Calendar::Impl::invalidateBusinessDays() {
+        ++businessDaysVersion_;
+        businessDays.clear();
+        detail::MutexLock lock(dependentsMutex_);
+        for (Size i=0; i<dependents_.size(); ++i)
+            dependents_[i]->invalidateBusinessDays();
+    }
+
+    Calendar::BusinessDayTable::BusinessDayTable()
+    : size_((Date::maxDate()-Date::minDate())/DaysPerBlock + 1),
+      blocks_(new detail::AtomicPointer<const Block>[size_]) {}
+
+    Calendar::BusinessDayTable::~BusinessDayTable() {
+        clear();
+    }
+
+    void Calendar::BusinessDayTable::clear() {
+        detail::MutexLock lock(mutex_);
+        for (Size i=0; i<size_; ++i) {
+            delete blocks_[i].load();
+            blocks_[i].store(0);
+        }
+    }
+
+    const Calendar::BusinessDayTable::Block&
+    Calendar::BusinessDayTable::build(const Impl& impl, Size i) const {
+        // the block is computed outside the lock, since the rules of
+        // joint calendars query other calendars
+        Block* b = new Block();
+        BigInteger first = Date::minDate().serialNumber() + i*DaysPerBlock;
+        BigInteger last = Date::maxDate().serialNumber();
+        try {
+            for (Size j=0; j<DaysPerBlock && first+BigInteger(j)<=last; ++j) {
+                if (computeBusinessDay(impl, Date(first+j)))
+                    b->words[j/64] |= boost::uint64_t(1) << (j%64);
+            }
+            for (Size w=0; w<WordsPerBlock; ++w) {
+                b->rank[w] = b->count;
+                b->count += popCount(b->words[w]);
+            }
+            b->state = Built;
+        } catch (std::exception&) {
+            b->state = Unavailable;
+        }
+
+        detail::MutexLock lock(mutex_);
+        // another thread might have published it in the meantime
+        const Block* current = blocks_[i].load();
+        if (current != 0) {
+            delete b;
+            return *current;
+        }
+        blocks_[i].store(b);
+        return *b;
+    }
+
+    Size Calendar::BusinessDayTable::businessDaysBefore(const Block& b,
+                                                        Size bit) {
+        if (bit == DaysPerBlock)
+            return b.count;
+        return b.rank[bit/64] + popCount(b.words[bit/64] & lowBits(bit%64));
+    }
+
+    bool Calendar::BusinessDayTable::advance(const Impl& impl,
+                                             Date& d, Integer n) const {
+        BigInteger origin = Date::minDate().serialNumber();
+        BigInteger last = Date::maxDate() - Date::minDate();
+        BigInteger day = d.serialNumber() - origin;
+        if (day < 0 || day > last)
+            return false;
+
+        if (n > 0) {
+            Size remaining = n;
+            for (BigInteger pos = day+1; pos <= last; ) {
+                Size i = pos / DaysPerBlock, bit = pos % DaysPerBlock;
+                const Block& b = block(impl, i);
+                if (b.state != Built)
+                    return false;
+                if (bit == 0 && b.count < remaining) {
+                    // skip the whole block
+                    remaining -= b.count;
+                    pos += DaysPerBlock;
+                    continue;
+                }
+                Size w = bit / 64;
+                boost::uint64_t word = b.words[w] & ~lowBits(bit%64);
+                Size c = popCount(word);
+                if (c >= remaining) {
+                    d = Date(origin + i*DaysPerBlock + w*64
+                             + selectBit(word, remaining-1));
+                    return true;
+                }
+                remaining -= c;
+                pos = i*DaysPerBlock + (w+1)*64;
+            }
+        } else if (n < 0) {
+            Size remaining = -n;
+            for (BigInteger pos = day-1; pos >= 0; ) {
+                Size i = pos / DaysPerBlock, bit = pos % DaysPerBlock;
+                const Block& b = block(impl, i);
+                if (b.state != Built)
+                    return false;
+                if (bit == DaysPerBlock-1 && b.count < remaining) {
+                    remaining -= b.count;
+                    pos -= DaysPerBlock;
+                    continue;
+                }
+                Size w = bit / 64;
+                boost::uint64_t word = b.words[w] & lowBits(bit%64+1);
+                Size c = popCount(word);
+                if (c >= remaining) {
+                    d = Date(origin + i*DaysPerBlock + w*64
+                             + selectBit(word, c-remaining));
+                    return true;
+                }
+                remaining -= c;
+                pos = BigInteger(i*DaysPerBlock + w*64) - 1;
+            }
+        } else {
+            return true;
+        }
+        return false;
+    }
+
+    bool Calendar::BusinessDayTable::count(const Impl& impl,
+                                           const Date& from, const Date& to,
+                                           BigInteger& result) const {
+        BigInteger origin = Date::minDate().serialNumber();
+        BigInteger last = Date::maxDate() - Date::minDate();
+        BigInteger first = from.serialNumber() - origin;
+        BigInteger lastDay = to.serialNumber() - origin;
+        if (first < 0 || lastDay > last || first > lastDay)
+            return false;
+
+        Size firstBlock = first / DaysPerBlock;
+        Size finalBlock = lastDay / DaysPerBlock;
+        for (Size i=firstBlock; i<=finalBlock; ++i) {
+            if (block(impl, i).state != Built)
+                return false;
+        }
+
+        Size bit1 = first % DaysPerBlock, bit2 = lastDay % DaysPerBlock + 1;
+        result = BigInteger(businessDaysBefore(block(impl, finalBlock),
+                                               bit2))
+               - BigInteger(businessDaysBefore(block(impl, firstBlock),
+                                               bit1));
+        for (Size i=firstBlock; i<finalBlock; ++i)
+            result += block(impl, i).count;
+
+        return true;
+    }
+
     void Calendar::addHoliday(const Date& d) {
         QL_REQUIRE(impl_, "no implementation provided");
         // if d was a genuine holiday previously removed, revert the change
@@ -33,6 +241,7 @@ namespace QuantLib {
         // Otherwise, add it.
         if (impl_->isBusinessDay(d))
             impl_->addedHolidays.insert(d);
+        impl_->invalidateBusinessDays();
     }
 
     void Calendar::removeHoliday(const Date& d) {
@@ -43,6 +252,7 @@ namespace QuantLib {
         // Otherwise, add it.
         if (!impl_->isBusinessDay(d))
             impl_->removedHolidays.insert(d);
+        impl_->invalidateBusinessDays();
     }
 
     Date Calendar::adjust(const Date& d,
@@ -99,7 +309,10 @@ namespace QuantLib {
         if (n == 0) {
             return adjust(d,c);
         } else if (unit == Days) {
+            QL_REQUIRE(impl_, "no implementation provided");
             Date d1 = d;
+            if (impl_->businessDays.advance(*impl_, d1, n))
+                return d1;
             if (n > 0) {
                 while (n > 0) {
                     d1++;
@@ -141,23 +354,18 @@ namespace QuantLib {
                                              const Date& to,
                                              bool includeFirst,
                                              bool includeLast) const {
+        QL_REQUIRE(impl_, "no implementation provided");
         BigInteger wd = 0;
         if (from != to) {
-            if (from < to) {
+            Date first = std::min(from, to), last = std::max(from, to);
+            if (!impl_->businessDays.count(*impl_, first, last, wd)) {
                 // the last one is treated separately to avoid
                 // incrementing Date::maxDate()
-                for (Date d = from; d < to; ++d) {
-                    if (isBusinessDay(d))
-                        ++wd;
-                }
-                if (isBusinessDay(to))
-                    ++wd;
-            } else if (from > to) {
-                for (Date d = to; d < from; ++d) {
+                for (Date d = first; d < last; ++d) {
                     if (isBusinessDay(d))
                         ++wd;
                 }
-                if (isBusinessDay(from))
+                if (isBusinessDay(last))
                     ++wd;
             }
 
@@ -29,7 +29,12 @@
 #include <ql/errors.hpp>
 #include <ql/time/date.hpp>
 #include <ql/time/businessdayconvention.hpp>
+#include <ql/utilities/atomicpointer.hpp>
+#include <ql/utilities/mutex.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/scoped_array.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/cstdint.hpp>
 #include <set>
 #include <vector>
 #include <string>
@@ -37,6 +42,7 @@
 namespace QuantLib {
 
     class Period;
+    class ScheduleCache;
 
     //! %calendar class
     /*! This class provides methods for determining whether a date is a
@@ -57,17 +63,95 @@ namespace QuantLib {
               invocation.
     */
     class Calendar {
+        // identifies calendars by their implementation
+        friend class ScheduleCache;
       protected:
+        class Impl;
+        //! lazily-built table of the business days of a calendar
+        /*! The days between Date::minDate() and Date::maxDate() are
+            grouped in blocks of 512 days, each holding one bit per
+            day and the number of business days preceding each 64-day
+            word.  A block is computed from the calendar rules (and
+            from the added and removed holidays) the first time it is
+            needed; blocks that cannot be computed, e.g., because the
+            calendar is not defined for some of their days, are
+            marked as unavailable and queries on them fall back to
+            the calendar rules.
+
+            Blocks are never modified once built, and are published
+            through atomic pointers; therefore, the table can be
+            queried concurrently.  Blocks are discarded when the
+            business days of the calendar change; as for the sets of
+            added and removed holidays, this must not happen while
+            the calendar is being used by other threads.
+        */
+        class BusinessDayTable : private boost::noncopyable {
+          public:
+            BusinessDayTable();
+            ~BusinessDayTable();
+            bool isBusinessDay(const Impl&, const Date&) const;
+            /*! moves the date forward (backward for negative n) by
+                the given number of business days; returns false,
+                leaving the date unchanged, if the result is outside
+                the available blocks.
+            */
+            bool advance(const Impl&, Date&, Integer n) const;
+            /*! counts the business days between the two dates, both
+                included; returns false if the range is not covered
+                by available blocks.
+            */
+            bool count(const Impl&, const Date& from, const Date& to,
+                       BigInteger& result) const;
+            //! discards all blocks
+            void clear();
+          private:
+            enum { DaysPerBlock = 512, WordsPerBlock = 8 };
+            enum BlockState { Built, Unavailable };
+            struct Block {
+                BlockState state;
+                boost::uint64_t words[WordsPerBlock];
+                // business days in the block before each word
+                unsigned short rank[WordsPerBlock];
+                unsigned short count;
+            };
+            const Block& block(const Impl&, Size i) const;
+            const Block& build(const Impl&, Size i) const;
+            static Size businessDaysBefore(const Block&, Size bit);
+            Size size_;
+            boost::scoped_array<detail::AtomicPointer<const Block> > blocks_;
+            mutable detail::Mutex mutex_;
+        };
         //! abstract base class for calendar implementations
-        class Impl {
+        class Impl : private boost::noncopyable {
           public:
-            virtual ~Impl() {}
+            Impl() : businessDaysVersion_(0) {}
+            virtual ~Impl();
             virtual std::string name() const = 0;
             virtual bool isBusinessDay(const Date&) const = 0;
             virtual bool isWeekend(Weekday) const = 0;
             std::set<Date> addedHolidays, removedHolidays;
+            mutable BusinessDayTable businessDays;
+            //! incremented whenever the business days change
+            BigNatural businessDaysVersion() const;
+            /*! to be called whenever the business days change; it
+                also invalidates the calendars depending on this one.
+            */
+            void invalidateBusinessDays();
+          protected:
+            /*! declares that the business days of this calendar
+                depend on those of the given one, so that changes in
+                the latter are propagated.
+            */
+            void dependOn(const Calendar&);
+          private:
+            BigNatural businessDaysVersion_;
+            std::vector<boost::shared_ptr<Impl> > dependencies_;
+            std::vector<Impl*> dependents_;
+            mutable detail::Mutex dependentsMutex_;
         };
         boost::shared_ptr<Impl> impl_;
+      private:
+        static bool computeBusinessDay(const Impl&, const Date&);
       public:
         /*! The default constructor returns a calendar with a null
             implementation, which is therefore unusable except as a
@@ -145,6 +229,14 @@ namespace QuantLib {
                                        bool includeLast = false) const;
         //@}
 
+        /*! Returns a counter incremented whenever the business days
+            of the calendar change, e.g., when a holiday is added to
+            it or to a calendar it depends on; classes caching
+            calendar-dependent results can use it to detect that
+            their cache is stale.
+        */
+        BigNatural businessDaysVersion() const;
+
       protected:
         //! partial calendar implementation
         /*! This class provides the means of determining the Easter
@@ -189,6 +281,15 @@ namespace QuantLib {
         return !impl_;
     }
 
+    inline BigNatural Calendar::businessDaysVersion() const {
+        QL_REQUIRE(impl_, "no implementation provided");
+        return impl_->businessDaysVersion();
+    }
+
+    inline BigNatural Calendar::Impl::businessDaysVersion() const {
+        return businessDaysVersion_;
+    }
+
     inline std::string Calendar::name() const {
         QL_REQUIRE(impl_, "no implementation provided");
         return impl_->name();
@@ -196,11 +297,35 @@ namespace QuantLib {
 
     inline bool Calendar::isBusinessDay(const Date& d) const {
         QL_REQUIRE(impl_, "no implementation provided");
-        if (impl_->addedHolidays.find(d) != impl_->addedHolidays.end())
+        return impl_->businessDays.isBusinessDay(*impl_, d);
+    }
+
+    inline bool Calendar::computeBusinessDay(const Impl& impl,
+                                             const Date& d) {
+        if (impl.addedHolidays.find(d) != impl.addedHolidays.end())
             return false;
-        if (impl_->removedHolidays.find(d) != impl_->removedHolidays.end())
+        if (impl.removedHolidays.find(d) != impl.removedHolidays.end())
             return true;
-        return impl_->isBusinessDay(d);
+        return impl.isBusinessDay(d);
+    }
+
+    inline const Calendar::BusinessDayTable::Block&
+    Calendar::BusinessDayTable::block(const Impl& impl, Size i) const {
+        const Block* b = blocks_[i].load();
+        return b != 0 ? *b : build(impl, i);
+    }
+
+    inline bool Calendar::BusinessDayTable::isBusinessDay(
+                                                      const Impl& impl,
+                                                      const Date& d) const {
+        BigInteger day = d.serialNumber() - Date::minDate().serialNumber();
+        if (day < 0 || day > Date::maxDate() - Date::minDate())
+            return computeBusinessDay(impl, d);
+        const Block& b = block(impl, day / DaysPerBlock);
+        if (b.state != Built)
+            return computeBusinessDay(impl, d);
+        Size bit = day % DaysPerBlock;
+        return ((b.words[bit/64] >> (bit%64)) & 1) != 0;
     }
 
     inline bool Calendar::isEndOfMonth(const Date& d) const {
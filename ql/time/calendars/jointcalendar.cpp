@@ -30,6 +30,8 @@ namespace QuantLib {
     : rule_(r), calendars_(2) {
         calendars_[0] = c1;
         calendars_[1] = c2;
+        for (Size i=0; i<calendars_.size(); ++i)
+            dependOn(calendars_[i]);
     }
 
     JointCalendar::Impl::Impl(const Calendar& c1,
@@ -40,6 +42,8 @@ namespace QuantLib {
         calendars_[0] = c1;
         calendars_[1] = c2;
         calendars_[2] = c3;
+        for (Size i=0; i<calendars_.size(); ++i)
+            dependOn(calendars_[i]);
     }
 
     JointCalendar::Impl::Impl(const Calendar& c1,
@@ -52,6 +56,8 @@ namespace QuantLib {
         calendars_[1] = c2;
         calendars_[2] = c3;
         calendars_[3] = c4;
+        for (Size i=0; i<calendars_.size(); ++i)
+            dependOn(calendars_[i]);
     }
 
     std::string JointCalendar::Impl::name() const {
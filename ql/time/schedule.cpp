@@ -20,6 +20,7 @@
 */
 
 #include <ql/time/schedule.hpp>
+#include <ql/time/schedulecache.hpp>
 #include <ql/time/imm.hpp>
 #include <ql/settings.hpp>
 
@@ -105,12 +106,41 @@ namespace QuantLib {
                        bool endOfMonth,
                        const Date& first,
                        const Date& nextToLast)
-    : tenor_(tenor), calendar_(cal), convention_(convention),
-      terminationDateConvention_(terminationDateConvention), rule_(rule),
-      endOfMonth_(allowsEndOfMonth(tenor) ? endOfMonth : false),
-      firstDate_(first==effectiveDate ? Date() : first),
-      nextToLastDate_(nextToLast==terminationDate ? Date() : nextToLast)
     {
+        ScheduleCache& cache = ScheduleCache::instance();
+        // schedules with a null effective date depend on the
+        // evaluation date and are never cached
+        if (cache.enabled() && effectiveDate != Date()) {
+            *this = *cache.schedule(effectiveDate, terminationDate, tenor,
+                                    cal, convention,
+                                    terminationDateConvention, rule,
+                                    endOfMonth, first, nextToLast);
+        } else {
+            generate(effectiveDate, terminationDate, tenor, cal,
+                     convention, terminationDateConvention, rule,
+                     endOfMonth, first, nextToLast);
+        }
+    }
+
+    void Schedule::generate(Date effectiveDate,
+                            const Date& terminationDate,
+                            const Period& tenor,
+                            const Calendar& cal,
+                            BusinessDayConvention convention,
+                            BusinessDayConvention terminationDateConvention,
+                            DateGeneration::Rule rule,
+                            bool endOfMonth,
+                            const Date& first,
+                            const Date& nextToLast) {
+        tenor_ = tenor;
+        calendar_ = cal;
+        convention_ = convention;
+        terminationDateConvention_ = terminationDateConvention;
+        rule_ = rule;
+        endOfMonth_ = allowsEndOfMonth(tenor) ? endOfMonth : false;
+        firstDate_ = first==effectiveDate ? Date() : first;
+        nextToLastDate_ = nextToLast==terminationDate ? Date() : nextToLast;
+
         // sanity checks
         QL_REQUIRE(terminationDate != Date(), "null termination date");
 
@@ -439,6 +469,24 @@ namespace QuantLib {
 
     }
 
+    Schedule Schedule::generated(const Date& effectiveDate,
+                                 const Date& terminationDate,
+                                 const Period& tenor,
+                                 const Calendar& calendar,
+                                 BusinessDayConvention convention,
+                                 BusinessDayConvention
+                                                  terminationDateConvention,
+                                 DateGeneration::Rule rule,
+                                 bool endOfMonth,
+                                 const Date& firstDate,
+                                 const Date& nextToLastDate) {
+        Schedule result;
+        result.generate(effectiveDate, terminationDate, tenor, calendar,
+                        convention, terminationDateConvention, rule,
+                        endOfMonth, firstDate, nextToLastDate);
+        return result;
+    }
+
 
     Schedule Schedule::until(const Date& truncationDate) const {
         Schedule result = *this;
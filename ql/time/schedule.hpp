@@ -53,7 +53,12 @@ namespace QuantLib {
                  boost::optional<DateGeneration::Rule> rule = boost::none,
                  boost::optional<bool> endOfMonth = boost::none,
                  const std::vector<bool>& isRegular = std::vector<bool>(0));
-        /*! rule based constructor */
+        /*! rule based constructor
+
+            \note If the ScheduleCache is enabled, the dates are
+                  copied from a cached schedule when one was generated
+                  with the same arguments.
+        */
         Schedule(Date effectiveDate,
                  const Date& terminationDate,
                  const Period& tenor,
@@ -102,6 +107,29 @@ namespace QuantLib {
         Schedule until(const Date& truncationDate) const;
         //@}
       private:
+        friend class ScheduleCache;
+        void generate(Date effectiveDate,
+                      const Date& terminationDate,
+                      const Period& tenor,
+                      const Calendar& calendar,
+                      BusinessDayConvention convention,
+                      BusinessDayConvention terminationDateConvention,
+                      DateGeneration::Rule rule,
+                      bool endOfMonth,
+                      const Date& firstDate,
+                      const Date& nextToLastDate);
+        // rule-based generation bypassing the cache
+        static Schedule generated(const Date& effectiveDate,
+                                  const Date& terminationDate,
+                                  const Period& tenor,
+                                  const Calendar& calendar,
+                                  BusinessDayConvention convention,
+                                  BusinessDayConvention
+                                                  terminationDateConvention,
+                                  DateGeneration::Rule rule,
+                                  bool endOfMonth,
+                                  const Date& firstDate,
+                                  const Date& nextToLastDate);
         boost::optional<Period> tenor_;
         Calendar calendar_;
         BusinessDayConvention convention_;
@@ -0,0 +1,165 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/time/schedulecache.hpp>
+#include <functional>
+
+namespace QuantLib {
+
+    bool ScheduleCache::Key::operator<(const Key& k) const {
+        if (effectiveDate != k.effectiveDate)
+            return effectiveDate < k.effectiveDate;
+        if (terminationDate != k.terminationDate)
+            return terminationDate < k.terminationDate;
+        if (tenorLength != k.tenorLength)
+            return tenorLength < k.tenorLength;
+        if (tenorUnits != k.tenorUnits)
+            return tenorUnits < k.tenorUnits;
+        if (convention != k.convention)
+            return convention < k.convention;
+        if (terminationDateConvention != k.terminationDateConvention)
+            return terminationDateConvention < k.terminationDateConvention;
+        if (rule != k.rule)
+            return rule < k.rule;
+        if (endOfMonth != k.endOfMonth)
+            return endOfMonth < k.endOfMonth;
+        if (firstDate != k.firstDate)
+            return firstDate < k.firstDate;
+        if (nextToLastDate != k.nextToLastDate)
+            return nextToLastDate < k.nextToLastDate;
+        if (calendarVersion != k.calendarVersion)
+            return calendarVersion < k.calendarVersion;
+        return std::less<const void*>()(calendarImpl, k.calendarImpl);
+    }
+
+    ScheduleCache::ScheduleCache()
+    : capacity_(0), hits_(0), misses_(0) {}
+
+    void ScheduleCache::setCapacity(Size capacity) {
+        detail::MutexLock lock(mutex_);
+        capacity_ = capacity;
+        trim();
+    }
+
+    Size ScheduleCache::capacity() const {
+        detail::MutexLock lock(mutex_);
+        return capacity_;
+    }
+
+    bool ScheduleCache::enabled() const {
+        return capacity() > 0;
+    }
+
+    boost::shared_ptr<const Schedule> ScheduleCache::schedule(
+                         const Date& effectiveDate,
+                         const Date& terminationDate,
+                         const Period& tenor,
+                         const Calendar& calendar,
+                         BusinessDayConvention convention,
+                         BusinessDayConvention terminationDateConvention,
+                         DateGeneration::Rule rule,
+                         bool endOfMonth,
+                         const Date& firstDate,
+                         const Date& nextToLastDate) {
+        if (!enabled() || effectiveDate == Date())
+            return boost::shared_ptr<const Schedule>(new Schedule(
+                Schedule::generated(effectiveDate, terminationDate, tenor,
+                                    calendar, convention,
+                                    terminationDateConvention, rule,
+                                    endOfMonth, firstDate, nextToLastDate)));
+
+        Key key;
+        key.effectiveDate = effectiveDate.serialNumber();
+        key.terminationDate = terminationDate.serialNumber();
+        key.tenorLength = tenor.length();
+        key.tenorUnits = tenor.units();
+        key.calendar = calendar;
+        key.calendarImpl = calendar.impl_.get();
+        key.calendarVersion =
+            calendar.empty() ? 0 : calendar.businessDaysVersion();
+        key.convention = convention;
+        key.terminationDateConvention = terminationDateConvention;
+        key.rule = rule;
+        key.endOfMonth = endOfMonth;
+        key.firstDate = firstDate.serialNumber();
+        key.nextToLastDate = nextToLastDate.serialNumber();
+
+        {
+            detail::MutexLock lock(mutex_);
+            std::map<Key, entry_list::iterator>::iterator i =
+                index_.find(key);
+            if (i != index_.end()) {
+                entries_.splice(entries_.begin(), entries_, i->second);
+                ++hits_;
+                return i->second->second;
+            }
+            ++misses_;
+        }
+
+        // the schedule is generated without holding the lock;
+        // exceptions are not cached and propagate to the caller
+        boost::shared_ptr<const Schedule> result;
+        result = boost::shared_ptr<const Schedule>(new Schedule(
+            Schedule::generated(effectiveDate, terminationDate, tenor,
+                                calendar, convention,
+                                terminationDateConvention, rule,
+                                endOfMonth, firstDate, nextToLastDate)));
+
+        detail::MutexLock lock(mutex_);
+        // another thread might have stored it in the meantime
+        if (index_.find(key) == index_.end() && capacity_ > 0) {
+            entries_.push_front(Entry(key, result));
+            index_[key] = entries_.begin();
+            trim();
+        }
+        return result;
+    }
+
+    Size ScheduleCache::size() const {
+        detail::MutexLock lock(mutex_);
+        return index_.size();
+    }
+
+    void ScheduleCache::clear() {
+        detail::MutexLock lock(mutex_);
+        index_.clear();
+        entries_.clear();
+    }
+
+    Size ScheduleCache::hits() const {
+        detail::MutexLock lock(mutex_);
+        return hits_;
+    }
+
+    Size ScheduleCache::misses() const {
+        detail::MutexLock lock(mutex_);
+        return misses_;
+    }
+
+    void ScheduleCache::resetStatistics() {
+        detail::MutexLock lock(mutex_);
+        hits_ = misses_ = 0;
+    }
+
+    void ScheduleCache::trim() {
+        while (entries_.size() > capacity_) {
+            index_.erase(entries_.back().first);
+            entries_.pop_back();
+        }
+    }
+
+}
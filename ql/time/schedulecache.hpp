@@ -0,0 +1,125 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file schedulecache.hpp
+    \brief cache of rule-based schedules
+*/
+
+#ifndef quantlib_schedule_cache_hpp
+#define quantlib_schedule_cache_hpp
+
+#include <ql/time/schedule.hpp>
+#include <ql/patterns/singleton.hpp>
+#include <ql/utilities/mutex.hpp>
+#include <boost/shared_ptr.hpp>
+#include <list>
+#include <map>
+
+namespace QuantLib {
+
+    //! cache of rule-based schedules
+    /*! When enabled, the rule-based Schedule constructor copies its
+        dates from a cached schedule generated with the same
+        arguments (effective and termination dates, tenor, calendar,
+        conventions, rule, end-of-month flag, first and next-to-last
+        dates) instead of running the generation algorithm again.
+        This pays off when the same schedules are built repeatedly,
+        e.g., by the helpers of a curve being rebuilt.
+
+        The cache holds at most the given number of schedules and
+        discards the least recently used ones when full.  Cached
+        schedules are shared and never modified.  Calendars are
+        identified by their implementation, which is kept alive by
+        the cache, and by the version of their business days, so
+        that schedules generated before a holiday was added are no
+        longer returned.  Schedules with a null effective date
+        depend on the evaluation date and are never cached.
+
+        The cache is disabled by default; it can be enabled by
+        setting a positive capacity.  Its methods can be called
+        concurrently; they are serialized by a mutex, which is not
+        held while a missing schedule is generated.
+    */
+    class ScheduleCache : public Singleton<ScheduleCache> {
+        friend class Singleton<ScheduleCache>;
+      private:
+        ScheduleCache();
+      public:
+        //! \name Settings
+        //@{
+        //! sets the maximum number of cached schedules; zero disables it
+        void setCapacity(Size capacity);
+        Size capacity() const;
+        bool enabled() const;
+        //@}
+        //! \name Cached schedules
+        //@{
+        /*! returns the cached schedule generated with the given
+            arguments, generating and storing it if needed.  If the
+            cache is disabled, a new schedule is returned each time.
+        */
+        boost::shared_ptr<const Schedule> schedule(
+                         const Date& effectiveDate,
+                         const Date& terminationDate,
+                         const Period& tenor,
+                         const Calendar& calendar,
+                         BusinessDayConvention convention,
+                         BusinessDayConvention terminationDateConvention,
+                         DateGeneration::Rule rule,
+                         bool endOfMonth,
+                         const Date& firstDate = Date(),
+                         const Date& nextToLastDate = Date());
+        //! number of cached schedules
+        Size size() const;
+        //! removes all cached schedules
+        void clear();
+        //@}
+        //! \name Statistics
+        //@{
+        Size hits() const;
+        Size misses() const;
+        void resetStatistics();
+        //@}
+      private:
+        struct Key {
+            BigInteger effectiveDate, terminationDate;
+            Integer tenorLength;
+            TimeUnit tenorUnits;
+            // the calendar keeps its implementation alive
+            Calendar calendar;
+            const void* calendarImpl;
+            BigNatural calendarVersion;
+            BusinessDayConvention convention, terminationDateConvention;
+            DateGeneration::Rule rule;
+            bool endOfMonth;
+            BigInteger firstDate, nextToLastDate;
+            bool operator<(const Key&) const;
+        };
+        typedef std::pair<Key, boost::shared_ptr<const Schedule> > Entry;
+        typedef std::list<Entry> entry_list;
+        void trim();
+        Size capacity_;
+        Size hits_, misses_;
+        // most recently used first
+        entry_list entries_;
+        std::map<Key, entry_list::iterator> index_;
+        mutable detail::Mutex mutex_;
+    };
+
+}
+
+#endif
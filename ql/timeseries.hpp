@@ -27,6 +27,7 @@
 
 #include <ql/time/date.hpp>
 #include <ql/utilities/null.hpp>
+#include <ql/utilities/flatmap.hpp>
 #include <ql/errors.hpp>
 #include <boost/iterator/transform_iterator.hpp>
 #include <boost/iterator/reverse_iterator.hpp>
@@ -45,6 +46,9 @@ namespace QuantLib {
 
         \pre The <c>Container</c> type must satisfy the requirements
              set by the C++ standard for associative containers.
+             FlatMap can also be used, in which case data are
+             stored contiguously; this is the preferred choice for
+             long series built in date order.
     */
     template <class T, class Container = std::map<Date, T> >
     class TimeSeries {
@@ -93,15 +97,16 @@ namespace QuantLib {
         //@{
         //! returns the (possibly null) datum corresponding to the given date
         T operator[](const Date& d) const {
-            if (values_.find(d) != values_.end())
-                return values_[d];
+            const_iterator i = values_.find(d);
+            if (i != values_.end())
+                return i->second;
             else
                 return Null<T>();
         }
         T& operator[](const Date& d) {
-            if (values_.find(d) == values_.end())
-                values_[d] = Null<T>();
-            return values_[d];
+            // inserts a null datum unless one is already stored
+            return values_.insert(
+                       container_value_type(d, Null<T>())).first->second;
         }
         //@}
 
@@ -277,12 +282,7 @@ namespace QuantLib {
     template <class T, class C>
     inline typename TimeSeries<T,C>::const_iterator
     TimeSeries<T,C>::find(const Date& d) {
-        const_iterator i = values_.find(d);
-        if (i == values_.end()) {
-            values_[d] = Null<T>();
-            i = values_.find(d);
-        }
-        return i;
+        return values_.insert(container_value_type(d, Null<T>())).first;
     }
 
     template <class T, class C>
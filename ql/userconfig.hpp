@@ -91,4 +91,11 @@
 //#    define QL_ENABLE_PARALLEL_UNIT_TEST_RUNNER
 #endif
 
+/* Define this to delegate matrix products, Cholesky and symmetric
+   eigenvalue decompositions to a BLAS/LAPACK library, which must
+   then be linked as well. */
+#ifndef QL_ENABLE_BLAS_LAPACK
+//#    define QL_ENABLE_BLAS_LAPACK
+#endif
+
 #endif
@@ -1,10 +1,13 @@
 /* This file is automatically generated; do not edit.     */
 /* Add the files to be included into Makefile.am instead. */
 
+#include <ql/utilities/atomicpointer.hpp>
 #include <ql/utilities/clone.hpp>
 #include <ql/utilities/dataformatters.hpp>
 #include <ql/utilities/dataparsers.hpp>
 #include <ql/utilities/disposable.hpp>
+#include <ql/utilities/flatmap.hpp>
+#include <ql/utilities/mutex.hpp>
 #include <ql/utilities/null.hpp>
 #include <ql/utilities/observablevalue.hpp>
 #include <ql/utilities/steppingiterator.hpp>
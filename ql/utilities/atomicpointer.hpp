@@ -0,0 +1,81 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file atomicpointer.hpp
+    \brief pointer published by one thread and read by others
+*/
+
+#ifndef quantlib_atomic_pointer_hpp
+#define quantlib_atomic_pointer_hpp
+
+#include <ql/utilities/mutex.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/version.hpp>
+
+// Boost.Atomic is available from Boost 1.53
+#if BOOST_VERSION >= 105300
+    #define QL_HAS_BOOST_ATOMIC
+    #include <boost/atomic.hpp>
+#endif
+
+namespace QuantLib {
+
+    namespace detail {
+
+        //! pointer published by one thread and read by others
+        /*! Loads have acquire and stores have release semantics, so
+            that a thread loading the pointer sees the pointee as it
+            was when it was stored.  The pointer is lock-free when
+            Boost.Atomic is available; with older Boost versions,
+            loads and stores lock a mutex instead.
+
+            The pointee is not owned.
+        */
+        template <class T>
+        class AtomicPointer : private boost::noncopyable {
+          public:
+            AtomicPointer() : p_(0) {}
+            T* load() const {
+                #if defined(QL_HAS_BOOST_ATOMIC)
+                return p_.load(boost::memory_order_acquire);
+                #else
+                MutexLock lock(mutex_);
+                return p_;
+                #endif
+            }
+            void store(T* p) {
+                #if defined(QL_HAS_BOOST_ATOMIC)
+                p_.store(p, boost::memory_order_release);
+                #else
+                MutexLock lock(mutex_);
+                p_ = p;
+                #endif
+            }
+          private:
+            #if defined(QL_HAS_BOOST_ATOMIC)
+            boost::atomic<T*> p_;
+            #else
+            mutable Mutex mutex_;
+            T* p_;
+            #endif
+        };
+
+    }
+
+}
+
+#endif
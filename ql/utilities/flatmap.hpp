@@ -0,0 +1,170 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file flatmap.hpp
+    \brief Associative container stored as a sorted vector
+*/
+
+#ifndef quantlib_flat_map_hpp
+#define quantlib_flat_map_hpp
+
+#include <ql/types.hpp>
+#include <algorithm>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace QuantLib {
+
+    //! Associative container stored as a sorted vector
+    /*! This class provides the subset of the std::map interface used
+        by TimeSeries, but stores its elements contiguously in a
+        vector sorted by key.  Lookups are binary searches; inserting
+        a key greater than all the stored ones is an amortized
+        constant-time append, while other insertions are linear in
+        the number of elements.  Iterators are random-access, so that
+        scans are cache-friendly and ranges can be advanced in
+        constant time.
+
+        It is meant for series that are mostly built in order and
+        then read, e.g.,
+        \code
+        TimeSeries<Real, FlatMap<Date, Real> > series;
+        \endcode
+
+        \warning As for std::vector, insertions and erasures
+                 invalidate iterators.  Keys must not be modified
+                 through non-const iterators.
+    */
+    template <class Key, class T, class Compare = std::less<Key> >
+    class FlatMap {
+      public:
+        typedef Key key_type;
+        typedef T mapped_type;
+        typedef std::pair<Key, T> value_type;
+        typedef Compare key_compare;
+      private:
+        typedef std::vector<value_type> container;
+      public:
+        typedef typename container::size_type size_type;
+        typedef typename container::iterator iterator;
+        typedef typename container::const_iterator const_iterator;
+        typedef typename container::reverse_iterator reverse_iterator;
+        typedef typename container::const_reverse_iterator
+                                                       const_reverse_iterator;
+
+        FlatMap() {}
+        template <class InputIterator>
+        FlatMap(InputIterator begin, InputIterator end) {
+            for (; begin != end; ++begin)
+                insert(*begin);
+        }
+
+        //! \name Iterators
+        //@{
+        iterator begin() { return data_.begin(); }
+        iterator end() { return data_.end(); }
+        const_iterator begin() const { return data_.begin(); }
+        const_iterator end() const { return data_.end(); }
+        reverse_iterator rbegin() { return data_.rbegin(); }
+        reverse_iterator rend() { return data_.rend(); }
+        const_reverse_iterator rbegin() const { return data_.rbegin(); }
+        const_reverse_iterator rend() const { return data_.rend(); }
+        //@}
+
+        //! \name Capacity
+        //@{
+        size_type size() const { return data_.size(); }
+        bool empty() const { return data_.empty(); }
+        void reserve(size_type n) { data_.reserve(n); }
+        //@}
+
+        //! \name Lookup
+        //@{
+        iterator lower_bound(const Key& k) {
+            return std::lower_bound(data_.begin(), data_.end(), k,
+                                    key_less());
+        }
+        const_iterator lower_bound(const Key& k) const {
+            return std::lower_bound(data_.begin(), data_.end(), k,
+                                    key_less());
+        }
+        iterator upper_bound(const Key& k) {
+            return std::upper_bound(data_.begin(), data_.end(), k,
+                                    key_less());
+        }
+        const_iterator upper_bound(const Key& k) const {
+            return std::upper_bound(data_.begin(), data_.end(), k,
+                                    key_less());
+        }
+        iterator find(const Key& k) {
+            iterator i = lower_bound(k);
+            return (i != data_.end() && !Compare()(k, i->first)) ?
+                i : data_.end();
+        }
+        const_iterator find(const Key& k) const {
+            const_iterator i = lower_bound(k);
+            return (i != data_.end() && !Compare()(k, i->first)) ?
+                i : data_.end();
+        }
+        size_type count(const Key& k) const {
+            return find(k) != data_.end() ? 1 : 0;
+        }
+        //@}
+
+        //! \name Modifiers
+        //@{
+        T& operator[](const Key& k) {
+            return insert(value_type(k, T())).first->second;
+        }
+        std::pair<iterator, bool> insert(const value_type& v) {
+            // fast path for in-order appends
+            if (data_.empty() || Compare()(data_.back().first, v.first)) {
+                data_.push_back(v);
+                return std::make_pair(data_.end()-1, true);
+            }
+            iterator i = lower_bound(v.first);
+            if (i != data_.end() && !Compare()(v.first, i->first))
+                return std::make_pair(i, false);
+            return std::make_pair(data_.insert(i, v), true);
+        }
+        void erase(iterator i) { data_.erase(i); }
+        size_type erase(const Key& k) {
+            iterator i = find(k);
+            if (i == data_.end())
+                return 0;
+            data_.erase(i);
+            return 1;
+        }
+        void clear() { data_.clear(); }
+        void swap(FlatMap& other) { data_.swap(other.data_); }
+        //@}
+      private:
+        struct key_less {
+            bool operator()(const value_type& v, const Key& k) const {
+                return Compare()(v.first, k);
+            }
+            bool operator()(const Key& k, const value_type& v) const {
+                return Compare()(k, v.first);
+            }
+        };
+        container data_;
+    };
+
+}
+
+#endif
@@ -0,0 +1,89 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file mutex.hpp
+    \brief mutex guarding the shared caches of the library
+*/
+
+#ifndef quantlib_mutex_hpp
+#define quantlib_mutex_hpp
+
+#include <ql/qldefines.hpp>
+#include <boost/noncopyable.hpp>
+
+#if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+    #include <boost/thread/mutex.hpp>
+#else
+    #include <boost/smart_ptr/detail/spinlock.hpp>
+#endif
+
+namespace QuantLib {
+
+    namespace detail {
+
+        #if defined(QL_ENABLE_THREAD_SAFE_OBSERVER_PATTERN)
+
+        //! mutex guarding the shared caches of the library
+        /*! Boost.Thread is linked when the thread-safe observer
+            pattern is enabled, so its mutex is used.
+        */
+        typedef boost::mutex Mutex;
+
+        //! scoped lock on a Mutex
+        typedef boost::mutex::scoped_lock MutexLock;
+
+        #else
+
+        //! mutex guarding the shared caches of the library
+        /*! Boost.Thread is only linked when the thread-safe observer
+            pattern is enabled; otherwise, the header-only spinlock
+            that Boost uses for the atomic access to shared pointers
+            is used, so that caches can be locked without linking a
+            thread library.  It works for threads started by OpenMP
+            as well as by client code, and is meant for the short
+            critical sections of the caches.
+        */
+        class Mutex : private boost::noncopyable {
+          public:
+            Mutex() {
+                boost::detail::spinlock unlocked = BOOST_DETAIL_SPINLOCK_INIT;
+                spinlock_ = unlocked;
+            }
+            void lock() { spinlock_.lock(); }
+            void unlock() { spinlock_.unlock(); }
+          private:
+            boost::detail::spinlock spinlock_;
+        };
+
+        //! scoped lock on a Mutex
+        class MutexLock : private boost::noncopyable {
+          public:
+            explicit MutexLock(Mutex& mutex) : mutex_(mutex) {
+                mutex_.lock();
+            }
+            ~MutexLock() { mutex_.unlock(); }
+          private:
+            Mutex& mutex_;
+        };
+
+        #endif
+
+    }
+
+}
+
+#endif
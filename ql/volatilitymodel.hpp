@@ -33,17 +33,52 @@ namespace QuantLib {
     template <class T>
     class LocalVolatilityEstimator {
       public:
+        typedef TimeSeries<T, FlatMap<Date, T> > flat_quote_series;
+        typedef TimeSeries<Volatility, FlatMap<Date, Volatility> >
+                                                            flat_time_series;
         virtual ~LocalVolatilityEstimator() {}
         virtual TimeSeries<Volatility>
         calculate(const TimeSeries<T> &quoteSeries) = 0;
+        /*! The default implementation copies the series; derived
+            classes should override it to work on the flat storage.
+        */
+        virtual flat_time_series
+        calculate(const flat_quote_series &quoteSeries) {
+            TimeSeries<Volatility> v =
+                calculate(TimeSeries<T>(quoteSeries.cbegin_time(),
+                                        quoteSeries.cend_time(),
+                                        quoteSeries.cbegin_values()));
+            return flat_time_series(v.cbegin_time(), v.cend_time(),
+                                    v.cbegin_values());
+        }
     };
 
     class VolatilityCompositor {
       public:
         typedef TimeSeries<Volatility> time_series;
+        typedef TimeSeries<Volatility, FlatMap<Date, Volatility> >
+                                                            flat_time_series;
         virtual ~VolatilityCompositor() {}
         virtual time_series calculate(const time_series& volatilitySeries) = 0;
         virtual void calibrate(const time_series& volatilitySeries) = 0;
+        /*! The default implementations of the flat-series overloads
+            copy the series; derived classes should override them to
+            work on the flat storage.
+        */
+        virtual flat_time_series calculate(
+                                   const flat_time_series& volatilitySeries) {
+            time_series v = calculate(toMapSeries(volatilitySeries));
+            return flat_time_series(v.cbegin_time(), v.cend_time(),
+                                    v.cbegin_values());
+        }
+        virtual void calibrate(const flat_time_series& volatilitySeries) {
+            calibrate(toMapSeries(volatilitySeries));
+        }
+      private:
+        static time_series toMapSeries(const flat_time_series& s) {
+            return time_series(s.cbegin_time(), s.cend_time(),
+                               s.cbegin_values());
+        }
     };
 
 }
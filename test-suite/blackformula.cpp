@@ -22,6 +22,7 @@
 #include "blackformula.hpp"
 #include "utilities.hpp"
 #include <ql/pricingengines/blackformula.hpp>
+#include <iomanip>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -117,6 +118,192 @@ void BlackFormulaTest::testChambersImpliedVol() {
     }
 }
 
+void BlackFormulaTest::testHouseholderImpliedStdDev() {
+
+    BOOST_TEST_MESSAGE("Testing Householder implied standard deviation...");
+
+    Option::Type types[] = {Option::Call, Option::Put};
+    Real displacements[] = {0.0000, 0.0010, 0.0050, 0.0100, 0.0200};
+    Real forwards[] = {-0.0010, 0.0000, 0.0050, 0.0100, 0.0200, 0.0500};
+    Real strikes[] = {-0.0100, -0.0050, -0.0010, 0.0000, 0.0010, 0.0050,
+                      0.0100,  0.0200,  0.0500,  0.1000};
+    Real stdDevs[] = {0.01, 0.05, 0.10, 0.15, 0.20, 0.30, 0.50, 0.60,
+                      0.70, 0.80, 1.00, 1.50, 2.00, 4.00, 8.00};
+    Real discounts[] = {1.00, 0.95, 0.80, 1.10};
+
+    // either the standard deviation is recovered, or the price is
+    // reproduced within the accuracy allowed by the cumulative normal
+    // distribution, whose error is absolute in the tails
+    Real stdDevTol = 1.0e-10;
+
+    for (Size i1 = 0; i1 < LENGTH(types); ++i1) {
+        for (Size i2 = 0; i2 < LENGTH(displacements); ++i2) {
+            for (Size i3 = 0; i3 < LENGTH(forwards); ++i3) {
+                for (Size i4 = 0; i4 < LENGTH(strikes); ++i4) {
+                    for (Size i5 = 0; i5 < LENGTH(stdDevs); ++i5) {
+                        for (Size i6 = 0; i6 < LENGTH(discounts); ++i6) {
+                            Real displacement = displacements[i2];
+                            Real forward = forwards[i3];
+                            Real strike = strikes[i4];
+                            if (forward + displacement <= 0.0 ||
+                                strike + displacement <= 0.0)
+                                continue;
+                            Real premium = blackFormula(
+                                types[i1], strike, forward, stdDevs[i5],
+                                discounts[i6], displacement);
+                            Real intrinsic = std::max(
+                                types[i1]*(forward-strike), 0.0)
+                                * discounts[i6];
+                            // no information left in the price
+                            if (premium - intrinsic <=
+                                1.0e-12*(forward+displacement))
+                                continue;
+                            Real iStdDev =
+                                blackFormulaImpliedStdDevHouseholder(
+                                    types[i1], strike, forward, premium,
+                                    discounts[i6], displacement);
+                            Real stdDevError =
+                                std::fabs(iStdDev - stdDevs[i5])/stdDevs[i5];
+                            Real iPremium = blackFormula(
+                                types[i1], strike, forward, iStdDev,
+                                discounts[i6], displacement);
+                            Real priceError =
+                                std::fabs(iPremium - premium)/premium;
+                            Real priceTol = std::max(1.0e-13,
+                                1.0e-15*(forward+displacement)
+                                * discounts[i6]/premium);
+                            if (stdDevError > stdDevTol &&
+                                priceError > priceTol)
+                                BOOST_ERROR(
+                                    "Failed to reproduce implied "
+                                    "standard deviation for "
+                                    << types[i1]
+                                    << std::setprecision(16)
+                                    << "\n    displacement: " << displacement
+                                    << "\n    forward:      " << forward
+                                    << "\n    strike:       " << strike
+                                    << "\n    discount:     " << discounts[i6]
+                                    << "\n    premium:      " << premium
+                                    << "\n    expected:     " << stdDevs[i5]
+                                    << "\n    calculated:   " << iStdDev
+                                    << "\n    price error:  " << priceError);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+void BlackFormulaTest::testBatchFormulas() {
+
+    BOOST_TEST_MESSAGE("Testing batch Black and Bachelier formulas...");
+
+    Real forward = 0.03, displacement = 0.01, discount = 0.97;
+    Real tte = 2.0;
+
+    std::vector<Real> strikes, stdDevs, normalStdDevs;
+    for (Size i=0; i<200; ++i) {
+        strikes.push_back(0.01 + 0.00025*i);
+        stdDevs.push_back(0.2 + 0.01*(i%50));
+        normalStdDevs.push_back((0.006 + 0.0002*(i%40))*std::sqrt(tte));
+    }
+
+    Option::Type types[] = {Option::Call, Option::Put};
+    std::vector<Real> prices, vegas, implied;
+    for (Size j=0; j<LENGTH(types); ++j) {
+        Option::Type type = types[j];
+
+        blackFormula(type, strikes, forward, stdDevs, prices,
+                     discount, displacement);
+        blackFormulaStdDevDerivative(strikes, forward, stdDevs, vegas,
+                                     discount, displacement);
+        blackFormulaImpliedStdDev(type, strikes, forward, prices, implied,
+                                  discount, displacement);
+        for (Size i=0; i<strikes.size(); ++i) {
+            Real expected = blackFormula(type, strikes[i], forward,
+                                         stdDevs[i], discount,
+                                         displacement);
+            if (prices[i] != expected)
+                BOOST_ERROR("batch Black price differs from scalar one:"
+                            << std::setprecision(16)
+                            << "\n    strike:     " << strikes[i]
+                            << "\n    batch:      " << prices[i]
+                            << "\n    scalar:     " << expected);
+            expected = blackFormulaStdDevDerivative(strikes[i], forward,
+                                                    stdDevs[i], discount,
+                                                    displacement);
+            if (vegas[i] != expected)
+                BOOST_ERROR("batch Black vega differs from scalar one:"
+                            << std::setprecision(16)
+                            << "\n    strike:     " << strikes[i]
+                            << "\n    batch:      " << vegas[i]
+                            << "\n    scalar:     " << expected);
+            expected = blackFormulaImpliedStdDevHouseholder(
+                type, strikes[i], forward, prices[i], discount,
+                displacement);
+            if (implied[i] != expected)
+                BOOST_ERROR("batch Black implied standard deviation "
+                            "differs from scalar one:"
+                            << std::setprecision(16)
+                            << "\n    strike:     " << strikes[i]
+                            << "\n    batch:      " << implied[i]
+                            << "\n    scalar:     " << expected);
+            if (std::fabs(implied[i] - stdDevs[i]) > 1.0e-10*stdDevs[i])
+                BOOST_ERROR("failed to reproduce Black standard deviation:"
+                            << std::setprecision(16)
+                            << "\n    strike:     " << strikes[i]
+                            << "\n    expected:   " << stdDevs[i]
+                            << "\n    calculated: " << implied[i]);
+        }
+
+        bachelierBlackFormula(type, strikes, forward, normalStdDevs,
+                              prices, discount);
+        bachelierBlackFormulaStdDevDerivative(strikes, forward,
+                                              normalStdDevs, vegas,
+                                              discount);
+        bachelierBlackFormulaImpliedVol(type, strikes, forward, tte,
+                                        prices, implied, discount);
+        for (Size i=0; i<strikes.size(); ++i) {
+            Real expected = bachelierBlackFormula(type, strikes[i], forward,
+                                                  normalStdDevs[i],
+                                                  discount);
+            if (prices[i] != expected)
+                BOOST_ERROR("batch Bachelier price differs from scalar one:"
+                            << std::setprecision(16)
+                            << "\n    strike:     " << strikes[i]
+                            << "\n    batch:      " << prices[i]
+                            << "\n    scalar:     " << expected);
+            expected = bachelierBlackFormulaStdDevDerivative(
+                strikes[i], forward, normalStdDevs[i], discount);
+            if (vegas[i] != expected)
+                BOOST_ERROR("batch Bachelier vega differs from scalar one:"
+                            << std::setprecision(16)
+                            << "\n    strike:     " << strikes[i]
+                            << "\n    batch:      " << vegas[i]
+                            << "\n    scalar:     " << expected);
+            Real vol = normalStdDevs[i]/std::sqrt(tte);
+            Real approximation = bachelierBlackFormulaImpliedVol(
+                type, strikes[i], forward, tte, prices[i], discount);
+            if (std::fabs(implied[i] - vol) >
+                std::max(std::fabs(approximation - vol), 1.0e-14))
+                BOOST_ERROR("batch Bachelier implied volatility is less "
+                            "accurate than the approximation:"
+                            << std::setprecision(16)
+                            << "\n    strike:        " << strikes[i]
+                            << "\n    expected:      " << vol
+                            << "\n    batch:         " << implied[i]
+                            << "\n    approximation: " << approximation);
+            if (std::fabs(implied[i] - vol) > 1.0e-12)
+                BOOST_ERROR("failed to reproduce Bachelier volatility:"
+                            << std::setprecision(16)
+                            << "\n    strike:     " << strikes[i]
+                            << "\n    expected:   " << vol
+                            << "\n    calculated: " << implied[i]);
+        }
+    }
+}
+
 test_suite* BlackFormulaTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Black formula tests");
 
@@ -124,6 +311,10 @@ test_suite* BlackFormulaTest::suite() {
         &BlackFormulaTest::testBachelierImpliedVol));
     suite->add(QUANTLIB_TEST_CASE(
         &BlackFormulaTest::testChambersImpliedVol));
+    suite->add(QUANTLIB_TEST_CASE(
+        &BlackFormulaTest::testHouseholderImpliedStdDev));
+    suite->add(QUANTLIB_TEST_CASE(
+        &BlackFormulaTest::testBatchFormulas));
 
     return suite;
 }
@@ -28,6 +28,8 @@ class BlackFormulaTest {
   public:
     static void testBachelierImpliedVol();
     static void testChambersImpliedVol();
+    static void testHouseholderImpliedStdDev();
+    static void testBatchFormulas();
     static boost::unit_test_framework::test_suite* suite();
 };
 
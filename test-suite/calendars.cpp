@@ -1723,6 +1723,166 @@ void CalendarTest::testBespokeCalendars() {
 
 }
 
+namespace {
+
+    // bypasses the business-day table and queries the calendar rules
+    class CalendarRules : public Calendar {
+      public:
+        explicit CalendarRules(const Calendar& c) : Calendar(c) {}
+        bool isBusinessDay(const Date& d) const {
+            if (impl_->addedHolidays.find(d) != impl_->addedHolidays.end())
+                return false;
+            if (impl_->removedHolidays.find(d)
+                != impl_->removedHolidays.end())
+                return true;
+            return impl_->isBusinessDay(d);
+        }
+    };
+
+    // business day for all the given calendars
+    bool isBusinessDayByRules(const std::vector<CalendarRules>& rules,
+                              const Date& d) {
+        for (Size i=0; i<rules.size(); ++i)
+            if (!rules[i].isBusinessDay(d))
+                return false;
+        return true;
+    }
+
+}
+
+void CalendarTest::testBusinessDayTable() {
+
+    BOOST_TEST_MESSAGE("Testing business-day table lookups...");
+
+    Calendar uk = UnitedKingdom();
+    std::vector<Calendar> calendars;
+    std::vector<std::vector<CalendarRules> > rules(4);
+    calendars.push_back(TARGET());
+    rules[0].push_back(CalendarRules(TARGET()));
+    calendars.push_back(UnitedStates(UnitedStates::NYSE));
+    rules[1].push_back(CalendarRules(UnitedStates(UnitedStates::NYSE)));
+    calendars.push_back(JointCalendar(TARGET(), uk));
+    rules[2].push_back(CalendarRules(TARGET()));
+    rules[2].push_back(CalendarRules(uk));
+    calendars.push_back(Russia(Russia::MOEX));
+    rules[3].push_back(CalendarRules(Russia(Russia::MOEX)));
+
+    // the MOEX calendar is only defined from 2012
+    Date start(3,January,2014), end(1,January,2030);
+
+    for (Size i=0; i<calendars.size(); ++i) {
+        const Calendar& c = calendars[i];
+        const std::vector<CalendarRules>& r = rules[i];
+
+        for (Date d = start-400; d < end+1100; ++d) {
+            if (c.isBusinessDay(d) != isBusinessDayByRules(r, d))
+                BOOST_ERROR(c.name() << ": wrong business day for " << d
+                            << "\n    table: " << c.isBusinessDay(d)
+                            << "\n    rules: "
+                            << isBusinessDayByRules(r, d));
+        }
+
+        for (Date d = start; d < end; d += 97) {
+            // compare with a day-by-day walk on the calendar rules
+            Integer steps[] = { 1, 5, -5, 45, -45, 300, -300 };
+            for (Size j=0; j<LENGTH(steps); ++j) {
+                Integer n = steps[j];
+                Date expected = d;
+                for (Integer k=0; k<std::abs(n); ++k) {
+                    do {
+                        expected += (n > 0 ? 1 : -1);
+                    } while (!isBusinessDayByRules(r, expected));
+                }
+                Date calculated = c.advance(d, n, Days);
+                if (calculated != expected)
+                    BOOST_ERROR(c.name() << ": advancing " << d
+                                << " by " << n << " business days:"
+                                << "\n    calculated: " << calculated
+                                << "\n    expected:   " << expected);
+            }
+
+            Date to = d + 1000;
+            BigInteger expected = 0;
+            for (Date e = d+1; e < to; ++e)
+                if (isBusinessDayByRules(r, e))
+                    ++expected;
+            BigInteger calculated = c.businessDaysBetween(d, to, false, false);
+            if (calculated != expected)
+                BOOST_ERROR(c.name() << ": business days between "
+                            << d << " and " << to << ":"
+                            << "\n    calculated: " << calculated
+                            << "\n    expected:   " << expected);
+            calculated = c.businessDaysBetween(to, d, false, false);
+            if (calculated != -expected)
+                BOOST_ERROR(c.name() << ": business days between "
+                            << to << " and " << d << ":"
+                            << "\n    calculated: " << calculated
+                            << "\n    expected:   " << -expected);
+        }
+    }
+
+    // a few known holidays
+    Date targetHolidays[] = { Date(25,December,2020), Date(2,April,2021),
+                              Date(1,May,2019), Date(26,December,2022) };
+    for (Size i=0; i<LENGTH(targetHolidays); ++i) {
+        if (calendars[0].isBusinessDay(targetHolidays[i]))
+            BOOST_ERROR(targetHolidays[i] << " not a holiday for "
+                        << calendars[0].name());
+    }
+    Date nyseHolidays[] = { Date(4,July,2023), Date(23,November,2023),
+                            Date(20,January,2020), Date(7,September,2015) };
+    for (Size i=0; i<LENGTH(nyseHolidays); ++i) {
+        if (calendars[1].isBusinessDay(nyseHolidays[i]))
+            BOOST_ERROR(nyseHolidays[i] << " not a holiday for "
+                        << calendars[1].name());
+    }
+    Date ukHolidays[] = { Date(27,August,2018), Date(25,May,2020) };
+    for (Size i=0; i<LENGTH(ukHolidays); ++i) {
+        if (calendars[2].isBusinessDay(ukHolidays[i]))
+            BOOST_ERROR(ukHolidays[i] << " not a holiday for "
+                        << calendars[2].name());
+    }
+
+    // dates for which the calendar is not defined are still reported
+    Calendar moex = Russia(Russia::MOEX);
+    BOOST_CHECK_THROW(moex.advance(Date(10,January,2012), -30, Days),
+                      Error);
+
+    // changes to a calendar are seen by the joint calendars using it,
+    // and only by them
+    Calendar target = calendars[0];
+    Calendar joint = calendars[2];
+    BigNatural targetVersion = target.businessDaysVersion();
+    BigNatural jointVersion = joint.businessDaysVersion();
+    Date d(15,March,2021);
+    if (!joint.isBusinessDay(d))
+        BOOST_FAIL(d << " expected to be a business day for "
+                   << joint.name());
+    Date next = joint.advance(d-1, 1, Days);
+    uk.addHoliday(d);
+    if (joint.isBusinessDay(d))
+        BOOST_ERROR("holiday added to " << uk.name()
+                    << " not seen by " << joint.name());
+    if (joint.advance(d-1, 1, Days) != next+1)
+        BOOST_ERROR("holiday added to " << uk.name()
+                    << " not seen when advancing on " << joint.name());
+    if (joint.businessDaysVersion() == jointVersion)
+        BOOST_ERROR("version of " << joint.name()
+                    << " not updated after adding a holiday to "
+                    << uk.name());
+    if (target.businessDaysVersion() != targetVersion)
+        BOOST_ERROR("version of " << target.name()
+                    << " updated after adding a holiday to "
+                    << uk.name());
+    uk.removeHoliday(d);
+    if (!joint.isBusinessDay(d))
+        BOOST_ERROR("holiday removed from " << uk.name()
+                    << " not seen by " << joint.name());
+    if (!target.isBusinessDay(d) || !uk.isBusinessDay(d))
+        BOOST_ERROR(d << " expected to be a business day for "
+                    << target.name() << " and " << uk.name());
+}
+
 test_suite* CalendarTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Calendar tests");
 
@@ -1756,6 +1916,7 @@ test_suite* CalendarTest::suite() {
 
     suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testEndOfMonth));
     suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testBusinessDaysBetween));
+    suite->add(QUANTLIB_TEST_CASE(&CalendarTest::testBusinessDayTable));
 
     return suite;
 }
@@ -20,6 +20,7 @@
 #include "cashflows.hpp"
 #include "utilities.hpp"
 #include <ql/cashflows/cashflows.hpp>
+#include <ql/cashflows/compiledleg.hpp>
 #include <ql/cashflows/simplecashflow.hpp>
 #include <ql/cashflows/fixedratecoupon.hpp>
 #include <ql/cashflows/floatingratecoupon.hpp>
@@ -29,8 +30,12 @@
 #include <ql/quotes/simplequote.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/schedule.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
+#include <ql/time/daycounters/thirty360.hpp>
+#include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/indexes/ibor/usdlibor.hpp>
 #include <ql/settings.hpp>
+#include <algorithm>
 
 using namespace QuantLib;
 using namespace boost;
@@ -264,11 +269,154 @@ void CashFlowsTest::testNullFixingDays() {
         .withFixingDays(Null<Natural>());
 }
 
+void CashFlowsTest::testCompiledLeg() {
+    BOOST_TEST_MESSAGE("Testing compiled-leg cash-flow analysis...");
+
+    SavedSettings backup;
+    IndexHistoryCleaner cleaner;
+
+    Date today(15, March, 2012);
+    Settings::instance().evaluationDate() = today;
+
+    Schedule schedule =
+        MakeSchedule()
+        .from(today-3*Months).to(today+5*Years)
+        .withFrequency(Semiannual)
+        .withCalendar(TARGET())
+        .withConvention(Following)
+        .backwards();
+
+    RelinkableHandle<YieldTermStructure> forecastCurve(
+                                    flatRate(today, 0.03, Actual360()));
+    boost::shared_ptr<IborIndex> index(new USDLibor(6*Months,
+                                                    forecastCurve));
+    // the first two coupons fix before today
+    index->addFixing(index->fixingDate(schedule[0]), 0.025);
+    index->addFixing(index->fixingDate(schedule[1]), 0.026);
+
+    Leg leg = FixedRateLeg(schedule)
+              .withNotionals(100.0)
+              .withCouponRates(0.04, Thirty360())
+              .withPaymentAdjustment(Following);
+    Leg floatingLeg = IborLeg(schedule, index)
+                      .withNotionals(100.0)
+                      .withSpreads(0.001);
+    leg.insert(leg.end(), floatingLeg.begin(), floatingLeg.end());
+    std::sort(leg.begin(), leg.end(), earlier_than<shared_ptr<CashFlow> >());
+    leg.push_back(shared_ptr<CashFlow>(
+                          new Redemption(200.0, schedule.endDate())));
+
+    CompiledLeg compiled(leg);
+    if (compiled.projectedFlows().size() != floatingLeg.size())
+        BOOST_ERROR("wrong number of projected flows: "
+                    << compiled.projectedFlows().size()
+                    << " instead of " << floatingLeg.size());
+
+    boost::shared_ptr<SimpleQuote> discountRate(new SimpleQuote(0.035));
+    boost::shared_ptr<YieldTermStructure> discountCurve =
+        flatRate(today, discountRate, Actual365Fixed());
+
+    Real tolerance = 1.0e-10;
+    Compounding compoundings[] = { Simple, Compounded, Continuous,
+                                   SimpleThenCompounded };
+    DayCounter yieldDayCounter = Thirty360();
+
+    // the second settlement date is a payment date
+    Date settlementDates[] = { today, schedule[1], today+1*Years };
+    bool includeFlows[] = { true, false };
+
+    for (Size i=0; i<LENGTH(settlementDates); ++i) {
+      for (Size j=0; j<LENGTH(includeFlows); ++j) {
+        Date settlement = settlementDates[i];
+        bool include = includeFlows[j];
+
+        Real expected = CashFlows::npv(leg, *discountCurve,
+                                       include, settlement);
+        Real calculated = CashFlows::npv(compiled, *discountCurve,
+                                         include, settlement);
+        if (std::fabs(expected-calculated) > tolerance)
+            BOOST_ERROR("npv mismatch at " << settlement << ":"
+                        << "\n    leg:      " << expected
+                        << "\n    compiled: " << calculated);
+
+        expected = CashFlows::bps(leg, *discountCurve,
+                                  include, settlement);
+        calculated = CashFlows::bps(compiled, *discountCurve,
+                                    include, settlement);
+        if (std::fabs(expected-calculated) > tolerance)
+            BOOST_ERROR("bps mismatch at " << settlement << ":"
+                        << "\n    leg:      " << expected
+                        << "\n    compiled: " << calculated);
+
+        Real price = CashFlows::npv(leg, *discountCurve,
+                                    include, settlement);
+
+        for (Size k=0; k<LENGTH(compoundings); ++k) {
+            InterestRate y(0.045, yieldDayCounter,
+                           compoundings[k], Semiannual);
+            expected = CashFlows::npv(leg, y, include, settlement);
+            calculated = CashFlows::npv(compiled, y, include, settlement);
+            if (std::fabs(expected-calculated) > tolerance)
+                BOOST_ERROR("yield-based npv mismatch at " << settlement
+                            << " with compounding " << compoundings[k]
+                            << ":"
+                            << "\n    leg:      " << expected
+                            << "\n    compiled: " << calculated);
+
+            Rate expectedYield =
+                CashFlows::yield(leg, price, yieldDayCounter,
+                                 compoundings[k], Semiannual,
+                                 include, settlement);
+            Rate calculatedYield =
+                CashFlows::yield(compiled, price, yieldDayCounter,
+                                 compoundings[k], Semiannual,
+                                 include, settlement);
+            if (std::fabs(expectedYield-calculatedYield) > 1.0e-8)
+                BOOST_ERROR("yield mismatch at " << settlement
+                            << " with compounding " << compoundings[k]
+                            << ":"
+                            << "\n    leg:      " << expectedYield
+                            << "\n    compiled: " << calculatedYield);
+
+            Spread expectedSpread =
+                CashFlows::zSpread(leg, price-1.0, discountCurve,
+                                   yieldDayCounter, compoundings[k],
+                                   Semiannual, include, settlement);
+            Spread calculatedSpread =
+                CashFlows::zSpread(compiled, price-1.0, discountCurve,
+                                   yieldDayCounter, compoundings[k],
+                                   Semiannual, include, settlement);
+            if (std::fabs(expectedSpread-calculatedSpread) > 1.0e-8)
+                BOOST_ERROR("z-spread mismatch at " << settlement
+                            << " with compounding " << compoundings[k]
+                            << ":"
+                            << "\n    leg:      " << expectedSpread
+                            << "\n    compiled: " << calculatedSpread);
+        }
+      }
+    }
+
+    // changes in the forecasting curve and in the discount curve
+    // must be reflected by the compiled leg
+    Real before = CashFlows::npv(compiled, *discountCurve, false);
+    discountRate->setValue(0.04);
+    forecastCurve.linkTo(flatRate(today, 0.05, Actual360()));
+    Real expected = CashFlows::npv(leg, *discountCurve, false);
+    Real calculated = CashFlows::npv(compiled, *discountCurve, false);
+    if (std::fabs(expected-calculated) > tolerance
+        || std::fabs(before-calculated) < 1.0e-4)
+        BOOST_ERROR("npv mismatch after curve changes:"
+                    << "\n    leg:      " << expected
+                    << "\n    compiled: " << calculated
+                    << "\n    before:   " << before);
+}
+
 test_suite* CashFlowsTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Cash flows tests");
     suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testSettings));
     suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testAccessViolation));
     suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testDefaultSettlementDate));
+    suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testCompiledLeg));
     #ifndef QL_USE_INDEXED_COUPON
     suite->add(QUANTLIB_TEST_CASE(&CashFlowsTest::testNullFixingDays));
     #endif
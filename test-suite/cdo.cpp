@@ -28,11 +28,14 @@
 #include <ql/experimental/credit/homogeneouspooldef.hpp>
 
 #include <ql/experimental/credit/gaussianlhplossmodel.hpp>
+#include <ql/experimental/credit/onefactorgaussiancopula.hpp>
+#include <ql/experimental/credit/onefactorstudentcopula.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/termstructures/credit/flathazardrate.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/daycounters/actual360.hpp>
 #include <ql/time/daycounters/actualactual.hpp>
+#include <ql/math/matrix.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/currencies/europe.hpp>
 
@@ -361,11 +364,213 @@ void CdoTest::testHW(unsigned dataSet) {
     }
 }
 
+void CdoTest::testTrancheLadderSharing() {
+
+    BOOST_TEST_MESSAGE ("Testing loss models shared by a tranche ladder...");
+
+    SavedSettings backup;
+
+    Size poolSize = 20;
+    Real recovery = 0.4;
+    vector<Real> nominals(poolSize, 100.0);
+    Date asofDate = Date(31, August, 2006);
+    Settings::instance().evaluationDate() = asofDate;
+
+    boost::shared_ptr<SimpleQuote> hazardRate(new SimpleQuote(0.01));
+    boost::shared_ptr<DefaultProbabilityTermStructure> ptr (
+               new FlatHazardRate (asofDate,
+                                   Handle<Quote>(hazardRate),
+                                   ActualActual()));
+    vector<pair<DefaultProbKey,
+           Handle<DefaultProbabilityTermStructure> > > probabilities;
+    probabilities.push_back(std::make_pair(
+        NorthAmericaCorpDefaultKey(EURCurrency(),
+                                   SeniorSec,
+                                   Period(0,Weeks),
+                                   10.),
+       Handle<DefaultProbabilityTermStructure>(ptr)));
+
+    boost::shared_ptr<Pool> pool (new Pool());
+    vector<string> names;
+    for (Size i=0; i<poolSize; ++i) {
+        ostringstream o;
+        o << "issuer-" << i;
+        names.push_back(o.str());
+        pool->add(names.back(), Issuer(probabilities),
+                  NorthAmericaCorpDefaultKey(
+                      EURCurrency(), QuantLib::SeniorSec, Period(), 1.));
+    }
+
+    Handle<Quote> hCorrelation(
+                     boost::shared_ptr<Quote>(new SimpleQuote(0.3)));
+    boost::shared_ptr<GaussianConstantLossLM> gaussKtLossLM(new
+        GaussianConstantLossLM(hCorrelation,
+        std::vector<Real>(poolSize, recovery),
+        LatentModelIntegrationType::GaussianQuadrature, poolSize,
+        GaussianCopulaPolicy::initTraits()));
+
+    Size numSims = 2000;
+    std::vector<boost::shared_ptr<DefaultLossModel> > sharedModels,
+        freshModels;
+    std::vector<std::string> modelNames;
+    modelNames.push_back("random default gaussian");
+    sharedModels.push_back(boost::shared_ptr<DefaultLossModel>(new
+        RandomDefaultLM<GaussianCopulaPolicy>(gaussKtLossLM, numSims)));
+    modelNames.push_back("inhomogeneous gaussian");
+    // one grid up to the top of the ladder, shared by all tranches
+    boost::shared_ptr<IHGaussPoolLossModel> poolModel(new
+        IHGaussPoolLossModel(gaussKtLossLM, 100, 5., -5, 15, 1.0));
+    sharedModels.push_back(poolModel);
+
+    std::vector<Date> dates;
+    for (Size i=1; i<=5; ++i)
+        dates.push_back(asofDate + i*Years);
+
+    std::vector<boost::shared_ptr<Basket> > tranches;
+    for (Size j = 0; j < LENGTH(hwAttachment); j++)
+        tranches.push_back(boost::shared_ptr<Basket>(
+            new Basket(asofDate, names, nominals, pool,
+                       hwAttachment[j], hwDetachment[j])));
+
+    for (Size k=0; k<2; ++k) {
+        for (Size im=0; im<sharedModels.size(); ++im) {
+            for (Size j=0; j<tranches.size(); ++j)
+                tranches[j]->setLossModel(sharedModels[im]);
+
+            // queried back and forth, as by the engines of a ladder
+            Matrix shared(tranches.size(), dates.size());
+            const Size misses = poolModel->distributionMisses();
+            const Size hits = poolModel->distributionHits();
+            for (Size i=0; i<dates.size(); ++i)
+                for (Size j=0; j<tranches.size(); ++j)
+                    shared[j][i] = tranches[j]->expectedTrancheLoss(dates[i]);
+
+            // the loss distribution is integrated once per date on the
+            // shared grid; the other tranches find it in the cache
+            if (sharedModels[im] == poolModel) {
+                const Size calculatedMisses =
+                    poolModel->distributionMisses() - misses;
+                const Size calculatedHits =
+                    poolModel->distributionHits() - hits;
+                if (calculatedMisses != dates.size()
+                    || calculatedHits != dates.size()*(tranches.size()-1))
+                    BOOST_ERROR("loss distributions not shared by the "
+                                "tranches of the ladder"
+                                << "\n    integrations: "
+                                << calculatedMisses
+                                << " (expected " << dates.size() << ")"
+                                << "\n    cache hits:   "
+                                << calculatedHits << " (expected "
+                                << dates.size()*(tranches.size()-1) << ")");
+            }
+
+            for (Size j=0; j<tranches.size(); ++j) {
+                boost::shared_ptr<DefaultLossModel> fresh = (im == 0) ?
+                    boost::shared_ptr<DefaultLossModel>(new
+                        RandomDefaultLM<GaussianCopulaPolicy>(gaussKtLossLM,
+                                                              numSims)) :
+                    boost::shared_ptr<DefaultLossModel>(new
+                        IHGaussPoolLossModel(gaussKtLossLM, 100, 5., -5, 15,
+                                             1.0));
+                tranches[j]->setLossModel(fresh);
+                for (Size i=0; i<dates.size(); ++i) {
+                    const Real expected =
+                        tranches[j]->expectedTrancheLoss(dates[i]);
+                    if (std::fabs(shared[j][i] - expected) > 1.0e-12)
+                        BOOST_ERROR("failed to reproduce the expected loss "
+                                    "of a tranche with a shared "
+                                    << modelNames[im] << " model"
+                                    << "\n    tranche:    [" 
+                                    << hwAttachment[j] << ", "
+                                    << hwDetachment[j] << "]"
+                                    << "\n    date:       " << dates[i]
+                                    << "\n    shared:     " << shared[j][i]
+                                    << "\n    fresh:      " << expected);
+                }
+            }
+        }
+        // the shared models must follow changes of the default curves
+        hazardRate->setValue(0.02);
+    }
+}
+
+
+void CdoTest::testOneFactorCopulaKernel() {
+
+    BOOST_TEST_MESSAGE ("Testing one-factor copula integration kernels...");
+
+    boost::shared_ptr<SimpleQuote> correlation(new SimpleQuote(0.3));
+    Handle<Quote> hCorrelation(correlation);
+
+    // grid on [-5, 5] with 50 steps
+    std::vector<boost::shared_ptr<OneFactorCopula> > copulas;
+    copulas.push_back(boost::shared_ptr<OneFactorCopula>(
+                          new OneFactorGaussianCopula(hCorrelation, 5.0, 50)));
+    copulas.push_back(boost::shared_ptr<OneFactorCopula>(
+                       new OneFactorStudentCopula(hCorrelation, 5, 5, 5.0, 50)));
+
+    std::vector<Real> probabilities;
+    probabilities.push_back(0.0);
+    for (Size i=1; i<10; i++)
+        probabilities.push_back(0.01*i*i);
+
+    Real tolerance = 1.0e-14;
+    for (Size iRho=0; iRho<2; iRho++) {
+        if (iRho == 1)
+            correlation->setValue(0.5);
+        for (Size iCopula=0; iCopula<copulas.size(); iCopula++) {
+            const Matrix& kernel =
+                copulas[iCopula]->conditionalProbabilities(probabilities);
+            if (kernel.rows() != 50 || kernel.columns() != 10)
+                BOOST_FAIL("wrong kernel size: " << kernel.rows()
+                           << " x " << kernel.columns());
+            for (Size k=0; k<kernel.rows(); k++) {
+                Real m = -5.0 + 0.2*(k+0.5);
+                for (Size i=0; i<kernel.columns(); i++) {
+                    Real expected = copulas[iCopula]->conditionalProbability(
+                                                       probabilities[i], m);
+                    if (std::fabs(kernel[k][i] - expected) > tolerance)
+                        BOOST_ERROR("conditional probability mismatch"
+                                    << "\n    copula:      " << iCopula
+                                    << "\n    correlation: "
+                                    << correlation->value()
+                                    << "\n    node:        " << k
+                                    << "\n    name:        " << i
+                                    << std::setprecision(12)
+                                    << "\n    kernel:      " << kernel[k][i]
+                                    << "\n    expected:    " << expected);
+                }
+            }
+        }
+    }
+
+    // tranches priced on the same schedule alternate between the
+    // probabilities of a few dates; each kernel is kept
+    std::vector<Real> later(probabilities);
+    for (Size i=0; i<later.size(); i++)
+        later[i] = std::min(2.0*later[i], 1.0);
+    for (Size iCopula=0; iCopula<copulas.size(); iCopula++) {
+        Size misses = copulas[iCopula]->kernelMisses();
+        for (Size k=0; k<3; k++) {
+            copulas[iCopula]->conditionalProbabilities(probabilities);
+            copulas[iCopula]->conditionalProbabilities(later);
+        }
+        if (copulas[iCopula]->kernelMisses() - misses != 1)
+            BOOST_ERROR("kernel recalculated for alternating dates"
+                        << "\n    copula: " << iCopula
+                        << "\n    misses: "
+                        << copulas[iCopula]->kernelMisses() - misses
+                        << "\n    expected: 1");
+    }
+}
+
 
 test_suite* CdoTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("CDO tests");
     for (unsigned i=0; i < LENGTH(hwData7); ++i)
         suite->add(QUANTLIB_TEST_CASE(
             boost::bind(&CdoTest::testHW, i)));
+    suite->add(QUANTLIB_TEST_CASE(&CdoTest::testTrancheLadderSharing));
+    suite->add(QUANTLIB_TEST_CASE(&CdoTest::testOneFactorCopulaKernel));
     return suite;
 }
@@ -28,6 +28,8 @@
 class CdoTest {
   public:
     static void testHW(unsigned dataSet);
+    static void testTrancheLadderSharing();
+    static void testOneFactorCopulaKernel();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -39,6 +39,8 @@
 #include <ql/time/schedule.hpp>
 #include <ql/utilities/dataformatters.hpp>
 #include <ql/instruments/makecms.hpp>
+#include <ql/termstructures/volatility/sabrsmilesection.hpp>
+#include <ql/termstructures/volatility/kahalesmilesection.hpp>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -494,10 +496,241 @@ void CmsTest::testParity() {
     }
 }
 
+void CmsTest::testSmileSectionStrips() {
+
+    BOOST_TEST_MESSAGE("Testing strip evaluation of smile sections...");
+
+    std::vector<Real> sabrParameters(4);
+    sabrParameters[0] = 0.03;
+    sabrParameters[1] = 0.6;
+    sabrParameters[2] = 0.4;
+    sabrParameters[3] = -0.2;
+    const Real forward = 0.03;
+
+    std::vector<shared_ptr<SmileSection> > sections;
+    sections.push_back(shared_ptr<SmileSection>(
+               new SabrSmileSection(5.0, forward, sabrParameters, 0.01)));
+    shared_ptr<SmileSection> sabr(
+               new SabrSmileSection(5.0, forward, sabrParameters));
+    sections.push_back(sabr);
+    std::vector<Real> money;
+    for (Real m = 0.25; m < 3.01; m += 0.25)
+        money.push_back(m);
+    sections.push_back(shared_ptr<SmileSection>(
+        new KahaleSmileSection(sabr, forward, false, false, false, money)));
+    sections.push_back(shared_ptr<SmileSection>(
+        new KahaleSmileSection(sabr, forward, true, false, false, money)));
+
+    std::vector<Rate> strikes;
+    for (Rate k = 0.0025; k < 0.15; k += 0.0025)
+        strikes.push_back(k);
+
+    const Real tol = 1.0e-14;
+    for (Size i=0; i<sections.size(); ++i) {
+        std::vector<Volatility> vols;
+        sections[i]->volatilities(strikes, vols);
+        std::vector<Real> calls, puts;
+        sections[i]->optionPrices(strikes, calls, Option::Call, 0.9);
+        sections[i]->optionPrices(strikes, puts, Option::Put, 0.9);
+        for (Size j=0; j<strikes.size(); ++j) {
+            Volatility vol = sections[i]->volatility(strikes[j]);
+            Real call = sections[i]->optionPrice(strikes[j], Option::Call, 0.9);
+            Real put = sections[i]->optionPrice(strikes[j], Option::Put, 0.9);
+            if (std::fabs(vols[j] - vol) > tol ||
+                std::fabs(calls[j] - call) > tol ||
+                std::fabs(puts[j] - put) > tol)
+                BOOST_FAIL("strip and single-strike results differ:"
+                           << "\n    section:    " << i
+                           << "\n    strike:     " << io::rate(strikes[j])
+                           << "\n    volatility: " << vols[j]
+                           << " vs " << vol
+                           << "\n    call:       " << calls[j]
+                           << " vs " << call
+                           << "\n    put:        " << puts[j]
+                           << " vs " << put);
+        }
+    }
+}
+
+void CmsTest::testLinearTsrIntegralsMemo() {
+
+    BOOST_TEST_MESSAGE("Testing memoized integrals in linear TSR pricer...");
+
+    CommonVars vars;
+
+    shared_ptr<SwapIndex> swapIndex(new
+        EuriborSwapIsdaFixA(10*Years,
+                            vars.iborIndex->forwardingTermStructure()));
+    Handle<Quote> meanReversion(shared_ptr<Quote>(new SimpleQuote(0.01)));
+
+    shared_ptr<CmsCouponPricer> plainPricer(
+        new LinearTsrPricer(vars.SabrVolCube1, meanReversion));
+    shared_ptr<CmsCouponPricer> memoPricer(
+        new LinearTsrPricer(vars.SabrVolCube1, meanReversion,
+                            Handle<YieldTermStructure>(),
+                            LinearTsrPricer::Settings().withIntegralsMemo()));
+
+    // coupons sharing the fixing date, with different payment dates
+    // and strikes, so that the memoized section and integrals are
+    // reused across them
+    Date startDate = vars.termStructure->referenceDate() + 5*Years;
+    Date endDate = startDate + 1*Years;
+    std::vector<shared_ptr<CappedFlooredCmsCoupon> > coupons;
+    for (Size i=0; i<3; ++i) {
+        Date paymentDate = endDate + (6*i)*Months;
+        for (Rate strike = 0.02; strike < 0.07; strike += 0.02) {
+            coupons.push_back(shared_ptr<CappedFlooredCmsCoupon>(
+                new CappedFlooredCmsCoupon(paymentDate, 1.0,
+                                           startDate, endDate,
+                                           swapIndex->fixingDays(),
+                                           swapIndex, 1.0, 0.0,
+                                           strike, Null<Rate>(),
+                                           startDate, endDate,
+                                           vars.iborIndex->dayCounter())));
+            coupons.push_back(shared_ptr<CappedFlooredCmsCoupon>(
+                new CappedFlooredCmsCoupon(paymentDate, 1.0,
+                                           startDate, endDate,
+                                           swapIndex->fixingDays(),
+                                           swapIndex, 1.0, 0.0,
+                                           Null<Rate>(), strike,
+                                           startDate, endDate,
+                                           vars.iborIndex->dayCounter())));
+        }
+    }
+
+    const Real tol = 1.0e-9;
+    for (Size k=0; k<2; ++k) {
+        if (k == 1) {
+            // the memo must be dropped when the market moves
+            vars.termStructure.linkTo(
+                flatRate(vars.termStructure->referenceDate(), 0.04,
+                         Actual365Fixed()));
+        }
+        for (Size i=0; i<coupons.size(); ++i) {
+            coupons[i]->setPricer(plainPricer);
+            Real plain = coupons[i]->price(vars.termStructure);
+            coupons[i]->setPricer(memoPricer);
+            Real memo = coupons[i]->price(vars.termStructure);
+            if (std::fabs(plain - memo) > tol)
+                BOOST_FAIL("memoized and plain prices differ:"
+                           << "\n    coupon:    " << i
+                           << "\n    scenario:  " << k
+                           << "\n    plain:     " << plain
+                           << "\n    memoized:  " << memo
+                           << "\n    tolerance: " << tol);
+        }
+    }
+}
+
+void CmsTest::testReplicationCache() {
+
+    BOOST_TEST_MESSAGE("Testing replication cache of CMS pricers...");
+
+    CommonVars vars;
+
+    Handle<Quote> meanReversion(shared_ptr<Quote>(new SimpleQuote(0.01)));
+
+    std::vector<shared_ptr<CmsCouponPricer> > plainPricers, cachedPricers;
+    plainPricers.push_back(shared_ptr<CmsCouponPricer>(
+        new NumericHaganPricer(vars.SabrVolCube1,
+                               GFunctionFactory::NonParallelShifts,
+                               meanReversion)));
+    shared_ptr<NumericHaganPricer> cachedHagan(
+        new NumericHaganPricer(vars.SabrVolCube1,
+                               GFunctionFactory::NonParallelShifts,
+                               meanReversion, 0.0, 1.0, 1.0e-6,
+                               QL_MAX_REAL, true));
+    cachedPricers.push_back(cachedHagan);
+    plainPricers.push_back(shared_ptr<CmsCouponPricer>(
+        new LinearTsrPricer(vars.SabrVolCube1, meanReversion)));
+    shared_ptr<LinearTsrPricer> cachedTsr(
+        new LinearTsrPricer(vars.SabrVolCube1, meanReversion,
+                            Handle<YieldTermStructure>(),
+                            LinearTsrPricer::Settings()
+                                .withReplicationCache()));
+    cachedPricers.push_back(cachedTsr);
+
+    // two trades with distinct (but equivalent) swap indexes and
+    // coupons sharing fixing and payment dates
+    std::vector<shared_ptr<CappedFlooredCmsCoupon> > coupons;
+    for (Size t=0; t<2; ++t) {
+        shared_ptr<SwapIndex> swapIndex(new
+            EuriborSwapIsdaFixA(10*Years,
+                                vars.iborIndex->forwardingTermStructure()));
+        for (Size i=1; i<=3; ++i) {
+            Date startDate = vars.termStructure->referenceDate() + i*Years;
+            Date endDate = startDate + 1*Years;
+            Rate cap = t == 0 ? Null<Rate>() : 0.06;
+            Rate floor = t == 0 ? Null<Rate>() : 0.02;
+            for (Real gearing = 1.0; gearing < 2.1; gearing += 1.0) {
+                coupons.push_back(shared_ptr<CappedFlooredCmsCoupon>(
+                    new CappedFlooredCmsCoupon(endDate, 1.0,
+                                               startDate, endDate,
+                                               swapIndex->fixingDays(),
+                                               swapIndex, gearing, 0.001,
+                                               cap, floor,
+                                               startDate, endDate,
+                                               vars.iborIndex->dayCounter())));
+            }
+        }
+    }
+
+    const Real tol = 1.0e-12;
+    for (Size p=0; p<plainPricers.size(); ++p) {
+        for (Size k=0; k<2; ++k) {
+            if (k == 1) {
+                // cached values must be discarded when the market moves
+                vars.termStructure.linkTo(
+                    flatRate(vars.termStructure->referenceDate(),
+                             0.04 + 0.01*p, Actual365Fixed()));
+            }
+            for (Size i=0; i<coupons.size(); ++i) {
+                coupons[i]->setPricer(plainPricers[p]);
+                Real plain = coupons[i]->price(vars.termStructure);
+                coupons[i]->setPricer(cachedPricers[p]);
+                Real cached = coupons[i]->price(vars.termStructure);
+                if (std::fabs(plain - cached) > tol)
+                    BOOST_FAIL("cached and plain prices differ:"
+                               << "\n    pricer:    " << p
+                               << "\n    coupon:    " << i
+                               << "\n    scenario:  " << k
+                               << "\n    plain:     " << plain
+                               << "\n    cached:    " << cached
+                               << "\n    tolerance: " << tol);
+            }
+        }
+    }
+
+    if (cachedHagan->replicationCache()->hits() == 0 ||
+        cachedTsr->replicationCache()->hits() == 0)
+        BOOST_FAIL("no replicated value reused:"
+                   << "\n    numeric Hagan pricer hits: "
+                   << cachedHagan->replicationCache()->hits()
+                   << "\n    linear TSR pricer hits:    "
+                   << cachedTsr->replicationCache()->hits());
+
+    // values are discarded when the evaluation date moves
+    const shared_ptr<CmsReplicationCache>& cache =
+        cachedTsr->replicationCache();
+    Size stored = cache->size();
+    Date today = Settings::instance().evaluationDate();
+    Settings::instance().evaluationDate() = today + 1;
+    coupons[0]->setPricer(cachedTsr);
+    coupons[0]->amount();
+    if (cache->size() >= stored)
+        BOOST_ERROR("cached values not discarded after moving the "
+                    "evaluation date:"
+                    << "\n    values before: " << stored
+                    << "\n    values after:  " << cache->size());
+}
+
 test_suite* CmsTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Cms tests");
     suite->add(QUANTLIB_TEST_CASE(&CmsTest::testFairRate));
     suite->add(QUANTLIB_TEST_CASE(&CmsTest::testCmsSwap));
     suite->add(QUANTLIB_TEST_CASE(&CmsTest::testParity));
+    suite->add(QUANTLIB_TEST_CASE(&CmsTest::testSmileSectionStrips));
+    suite->add(QUANTLIB_TEST_CASE(&CmsTest::testLinearTsrIntegralsMemo));
+    suite->add(QUANTLIB_TEST_CASE(&CmsTest::testReplicationCache));
     return suite;
 }
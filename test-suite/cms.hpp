@@ -30,6 +30,9 @@ class CmsTest {
     static void testFairRate();
     static void testParity();
     static void testCmsSwap();
+    static void testSmileSectionStrips();
+    static void testLinearTsrIntegralsMemo();
+    static void testReplicationCache();
     static boost::unit_test_framework::test_suite* suite();
 };
 
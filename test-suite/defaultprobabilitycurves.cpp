@@ -26,6 +26,7 @@
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/instruments/creditdefaultswap.hpp>
 #include <ql/pricingengines/credit/midpointcdsengine.hpp>
+#include <ql/cashflows/fixedratecoupon.hpp>
 #include <ql/math/interpolations/linearinterpolation.hpp>
 #include <ql/math/interpolations/backwardflatinterpolation.hpp>
 #include <ql/math/interpolations/loginterpolation.hpp>
@@ -386,6 +387,144 @@ void DefaultProbabilityCurveTest::testUpfrontBootstrap() {
         BOOST_ERROR("Cash-flow settings improperly modified");
 }
 
+namespace {
+
+    /* Mid-point values of the default and coupon legs of a running
+       CDS (no upfront, accrual paid at default), worked out period by
+       period with scalar curve calls; both returned as positive. */
+    std::pair<Real, Real> midPointLegs(
+                  const CreditDefaultSwap& cds,
+                  const Handle<DefaultProbabilityTermStructure>& probability,
+                  Real recoveryRate,
+                  const Handle<YieldTermStructure>& discountCurve) {
+        Date today = Settings::instance().evaluationDate();
+        Date settlementDate = discountCurve->referenceDate();
+        Real defaultLeg = 0.0, couponLeg = 0.0;
+        const Leg& leg = cds.coupons();
+        for (Size i=0; i<leg.size(); ++i) {
+            if (leg[i]->hasOccurred(settlementDate))
+                continue;
+            boost::shared_ptr<FixedRateCoupon> coupon =
+                boost::dynamic_pointer_cast<FixedRateCoupon>(leg[i]);
+            Date paymentDate = coupon->date(),
+                 startDate = i == 0 ? cds.protectionStartDate()
+                                    : coupon->accrualStartDate(),
+                 endDate = coupon->accrualEndDate();
+            Date effectiveStartDate =
+                (startDate <= today && today <= endDate) ? today : startDate;
+            Date defaultDate =
+                effectiveStartDate + (endDate-effectiveStartDate)/2;
+            Probability S = probability->survivalProbability(paymentDate);
+            Probability P =
+                probability->defaultProbability(effectiveStartDate, endDate);
+            couponLeg += S * coupon->amount() *
+                         discountCurve->discount(paymentDate);
+            couponLeg += P * coupon->accruedAmount(defaultDate) *
+                         discountCurve->discount(defaultDate);
+            defaultLeg += P * cds.notional() * (1.0 - recoveryRate) *
+                          discountCurve->discount(defaultDate);
+        }
+        return std::make_pair(defaultLeg, couponLeg);
+    }
+
+}
+
+void DefaultProbabilityCurveTest::testBatchSurvivalProbabilities() {
+    BOOST_TEST_MESSAGE("Testing batch survival probabilities...");
+
+    SavedSettings backup;
+
+    Calendar calendar = TARGET();
+    Date today = Settings::instance().evaluationDate();
+    DayCounter dayCounter = Thirty360();
+    Real recoveryRate = 0.4;
+
+    RelinkableHandle<YieldTermStructure> discountCurve;
+    discountCurve.linkTo(boost::shared_ptr<YieldTermStructure>(
+                                    new FlatForward(today,0.06,Actual360())));
+
+    std::vector<boost::shared_ptr<SimpleQuote> > quotes;
+    std::vector<boost::shared_ptr<DefaultProbabilityHelper> > helpers;
+    for (Integer n=1; n<=7; n+=2) {
+        quotes.push_back(boost::shared_ptr<SimpleQuote>(
+                                             new SimpleQuote(0.01+0.002*n)));
+        helpers.push_back(boost::shared_ptr<DefaultProbabilityHelper>(
+                new SpreadCdsHelper(Handle<Quote>(quotes.back()),
+                                    n*Years, 0, calendar, Quarterly,
+                                    Following, DateGeneration::TwentiethIMM,
+                                    dayCounter, recoveryRate,
+                                    discountCurve)));
+    }
+
+    std::vector<Handle<Quote> > jumps(1, Handle<Quote>(
+                           boost::shared_ptr<Quote>(new SimpleQuote(0.98))));
+    std::vector<Date> jumpDates(1, today + 2*Years);
+
+    std::vector<boost::shared_ptr<DefaultProbabilityTermStructure> > curves;
+    curves.push_back(boost::shared_ptr<DefaultProbabilityTermStructure>(
+        new PiecewiseDefaultCurve<SurvivalProbability,LogLinear>(
+                                          today, helpers, dayCounter)));
+    curves.push_back(boost::shared_ptr<DefaultProbabilityTermStructure>(
+        new PiecewiseDefaultCurve<HazardRate,BackwardFlat>(
+                                          today, helpers, dayCounter,
+                                          jumps, jumpDates)));
+
+    // unsorted, and extending beyond the last node
+    std::vector<Time> times;
+    for (Size i=0; i<40; ++i)
+        times.push_back(0.25*((7*i) % 40));
+
+    for (Size k=0; k<curves.size(); ++k) {
+        std::vector<Probability> batch;
+        curves[k]->survivalProbability(times, batch, true);
+        for (Size i=0; i<times.size(); ++i) {
+            Probability expected =
+                curves[k]->survivalProbability(times[i], true);
+            if (std::fabs(batch[i]-expected) > 1.0e-14)
+                BOOST_ERROR("batch survival probability mismatch"
+                            << "\n    curve:      " << k
+                            << "\n    time:       " << times[i]
+                            << std::setprecision(12)
+                            << "\n    batch:      " << batch[i]
+                            << "\n    expected:   " << expected);
+        }
+    }
+
+    // repricings on moving curves must match the period-by-period
+    // mid-point values
+    RelinkableHandle<DefaultProbabilityTermStructure> curve(curves[0]);
+    Date protectionStart = today + 1;
+    Schedule schedule(calendar.adjust(protectionStart), today + 4*Years,
+                      3*Months, calendar, Following, Unadjusted,
+                      DateGeneration::TwentiethIMM, false);
+    CreditDefaultSwap cds(Protection::Buyer, 1.0e6, 0.015, schedule,
+                          Following, dayCounter, true, true,
+                          protectionStart);
+    cds.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                  new MidPointCdsEngine(curve, recoveryRate, discountCurve)));
+
+    for (Size k=0; k<3; ++k) {
+        if (k == 1)
+            quotes[1]->setValue(0.025);
+        if (k == 2)
+            discountCurve.linkTo(boost::shared_ptr<YieldTermStructure>(
+                                  new FlatForward(today,0.04,Thirty360())));
+        std::pair<Real, Real> expected =
+            midPointLegs(cds, curve, recoveryRate, discountCurve);
+        if (std::fabs(cds.defaultLegNPV() - expected.first) > 1.0e-6
+            || std::fabs(-cds.couponLegNPV() - expected.second) > 1.0e-6)
+            BOOST_ERROR("failed to reproduce CDS legs on moving curves"
+                        << std::setprecision(12)
+                        << "\n    default leg:          "
+                        << cds.defaultLegNPV()
+                        << "\n    expected:             " << expected.first
+                        << "\n    coupon leg:           "
+                        << -cds.couponLegNPV()
+                        << "\n    expected:             "
+                        << expected.second);
+    }
+}
+
 
 test_suite* DefaultProbabilityCurveTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Default-probability curve tests");
@@ -405,5 +544,7 @@ test_suite* DefaultProbabilityCurveTest::suite() {
                 &DefaultProbabilityCurveTest::testSingleInstrumentBootstrap));
     suite->add(QUANTLIB_TEST_CASE(
                          &DefaultProbabilityCurveTest::testUpfrontBootstrap));
+    suite->add(QUANTLIB_TEST_CASE(
+               &DefaultProbabilityCurveTest::testBatchSurvivalProbabilities));
     return suite;
 }
@@ -38,9 +38,12 @@
 #include <ql/termstructures/yield/zerocurve.hpp>
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
 #include <ql/termstructures/volatility/equityfx/blackvariancesurface.hpp>
+#include <ql/termstructures/volatility/equityfx/localvolsurface.hpp>
+#include <ql/termstructures/volatility/equityfx/tabulatedlocalvolsurface.hpp>
 #include <ql/utilities/dataformatters.hpp>
 #include <boost/progress.hpp>
 #include <map>
+#include <limits>
 
 using namespace QuantLib;
 using namespace boost::unit_test_framework;
@@ -1513,6 +1516,251 @@ void EuropeanOptionTest::testLocalVolatility() {
     }
 }
 
+void EuropeanOptionTest::testTabulatedLocalVolatility() {
+    BOOST_TEST_MESSAGE("Testing tabulated local volatility...");
+
+    SavedSettings backup;
+
+    const Date today(5, July, 2002);
+    Settings::instance().evaluationDate() = today;
+
+    const DayCounter dayCounter = Actual365Fixed();
+    const Calendar calendar = TARGET();
+
+    const boost::shared_ptr<Quote> s0(new SimpleQuote(100.0));
+    const boost::shared_ptr<YieldTermStructure> rTS =
+        flatRate(today, 0.04, dayCounter);
+    const boost::shared_ptr<YieldTermStructure> qTS =
+        flatRate(today, 0.01, dayCounter);
+
+    // a smooth smile; with constant implied volatilities, the
+    // variances are linear in time and the bicubic interpolation
+    // doesn't introduce calendar arbitrage
+    Integer m[] = { 3, 6, 12, 24, 36 };
+    std::vector<Date> dates;
+    for (Size i=0; i < LENGTH(m); ++i)
+        dates.push_back(today + Period(m[i], Months));
+    // wide enough to cover the finite-difference grid below
+    std::vector<Real> strikes;
+    for (Integer i=-25; i <= 25; ++i)
+        strikes.push_back(100.0*std::exp(0.1*i));
+
+    Matrix blackVolMatrix(strikes.size(), dates.size());
+    for (Size i=0; i < strikes.size(); ++i)
+        for (Size j=0; j < dates.size(); ++j) {
+            const Real y = std::log(strikes[i]/100.0);
+            blackVolMatrix[i][j] = 0.2 + 0.1*y*y;
+        }
+
+    const boost::shared_ptr<BlackVarianceSurface> volTS(
+        new BlackVarianceSurface(today, calendar, dates, strikes,
+                                 blackVolMatrix, dayCounter));
+    volTS->setInterpolation<Bicubic>();
+
+    const boost::shared_ptr<LocalVolTermStructure> localVol(
+        new LocalVolSurface(Handle<BlackVolTermStructure>(volTS),
+                            Handle<YieldTermStructure>(rTS),
+                            Handle<YieldTermStructure>(qTS),
+                            Handle<Quote>(s0)));
+
+    std::vector<Time> times;
+    for (Size i=1; i <= 120; ++i)
+        times.push_back(i/40.0);
+    const boost::shared_ptr<TabulatedLocalVolSurface> table(
+        new TabulatedLocalVolSurface(Handle<LocalVolTermStructure>(localVol),
+                                     times, 10.0, 1000.0, 401));
+
+    // lookups between the grid nodes
+    const Real tolerance = 1.0e-3;
+    for (Size i=1; i < times.size()-1; i+=7) {
+        const Time t = 0.5*(times[i]+times[i+1]);
+        std::vector<Real> levels;
+        for (Real s=60.0; s <= 180.0; s+=2.5)
+            levels.push_back(s);
+
+        std::vector<Volatility> vols;
+        table->localVol(t, levels, vols, true);
+
+        for (Size j=0; j < levels.size(); ++j) {
+            const Volatility expected = localVol->localVol(t, levels[j], true);
+            const Volatility calculated = table->localVol(t, levels[j], true);
+
+            if (std::fabs(calculated - expected) > tolerance)
+                BOOST_FAIL("failed to reproduce local volatility"
+                           << "\n    time:       " << t
+                           << "\n    level:      " << levels[j]
+                           << "\n    calculated: " << calculated
+                           << "\n    expected:   " << expected);
+            if (vols[j] != calculated)
+                BOOST_FAIL("batch lookup differs from single lookup"
+                           << "\n    time:       " << t
+                           << "\n    level:      " << levels[j]
+                           << "\n    batch:      " << vols[j]
+                           << "\n    single:     " << calculated);
+        }
+    }
+
+    // finite-difference pricing with both surfaces
+    const boost::shared_ptr<GeneralizedBlackScholesProcess> process =
+        makeProcess(s0, qTS, rTS, volTS);
+    const boost::shared_ptr<GeneralizedBlackScholesProcess> tabulatedProcess(
+        new GeneralizedBlackScholesProcess(
+                            Handle<Quote>(s0),
+                            Handle<YieldTermStructure>(qTS),
+                            Handle<YieldTermStructure>(rTS),
+                            Handle<BlackVolTermStructure>(volTS),
+                            Handle<LocalVolTermStructure>(table)));
+
+    Real k[] = { 80.0, 100.0, 120.0 };
+    for (Size i=0; i < LENGTH(k); ++i) {
+        const boost::shared_ptr<StrikedTypePayoff> payoff(
+                                new PlainVanillaPayoff(Option::Call, k[i]));
+        const boost::shared_ptr<Exercise> exercise(
+                            new EuropeanExercise(today + Period(2, Years)));
+        EuropeanOption option(payoff, exercise);
+
+        option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                new FdBlackScholesVanillaEngine(process, 50, 200, 0,
+                                                FdmSchemeDesc::Douglas(),
+                                                true)));
+        const Real expected = option.NPV();
+
+        option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                new FdBlackScholesVanillaEngine(tabulatedProcess, 50, 200, 0,
+                                                FdmSchemeDesc::Douglas(),
+                                                true)));
+        const Real calculated = option.NPV();
+
+        if (std::fabs(calculated - expected) > tolerance*expected)
+            BOOST_FAIL("failed to reproduce local vol option price with "
+                       "tabulated local volatility"
+                       << "\n    strike:     " << k[i]
+                       << "\n    calculated: " << calculated
+                       << "\n    expected:   " << expected);
+    }
+}
+
+
+namespace {
+
+    // a local volatility linear in log-strike, except where it
+    // fails: a whole time slice, a strike range at the first time
+    // and the low-strike wing
+    class PatchyLocalVol : public LocalVolTermStructure {
+      public:
+        explicit PatchyLocalVol(const Date& referenceDate)
+        : LocalVolTermStructure(referenceDate, TARGET(), Following,
+                                Actual365Fixed()) {}
+        Date maxDate() const { return Date::maxDate(); }
+        Real minStrike() const { return 0.0; }
+        Real maxStrike() const { return QL_MAX_REAL; }
+        static Volatility smile(Real strike) {
+            return 0.2 + 0.05*std::log(strike/100.0);
+        }
+      protected:
+        Volatility localVolImpl(Time t, Real strike) const {
+            if (std::fabs(t - 1.0) < 1.0e-12)
+                return std::numeric_limits<Real>::quiet_NaN();
+            if (std::fabs(t - 0.5) < 1.0e-12 && strike > 80.0
+                                             && strike < 125.0)
+                QL_FAIL("negative local variance");
+            if (strike < 60.0)
+                return -0.1;
+            return smile(strike);
+        }
+    };
+
+}
+
+void EuropeanOptionTest::testTabulatedLocalVolatilityRepair() {
+    BOOST_TEST_MESSAGE("Testing repair and smoothing of tabulated "
+                       "local volatility...");
+
+    SavedSettings backup;
+
+    const Date today(5, July, 2002);
+    Settings::instance().evaluationDate() = today;
+
+    const Handle<LocalVolTermStructure> localVol(
+                            boost::shared_ptr<LocalVolTermStructure>(
+                                                new PatchyLocalVol(today)));
+
+    std::vector<Time> times;
+    for (Size i=1; i <= 4; ++i)
+        times.push_back(0.5*i);
+
+    TabulatedLocalVolSurface repaired(localVol, times, 50.0, 200.0, 41);
+    const std::vector<Real>& strikes = repaired.strikes();
+    const Matrix& vols = repaired.localVolMatrix();
+
+    // the valid nodes are kept and, the source being linear in
+    // log-strike, the nodes repaired by linear interpolation
+    // reproduce it; the low-strike wing is extrapolated flat from
+    // the first valid node, and the failing slice is copied from
+    // the previous one
+    Size firstValid = 0;
+    while (strikes[firstValid] < 60.0)
+        ++firstValid;
+    const Real tolerance = 1.0e-12;
+    for (Size i=0; i < times.size(); ++i) {
+        for (Size j=0; j < strikes.size(); ++j) {
+            const Volatility expected =
+                PatchyLocalVol::smile(strikes[std::max(j, firstValid)]);
+            if (std::fabs(vols[i][j] - expected) > tolerance)
+                BOOST_FAIL("failed to repair local volatility"
+                           << "\n    time:       " << times[i]
+                           << "\n    strike:     " << strikes[j]
+                           << "\n    calculated: " << vols[i][j]
+                           << "\n    expected:   " << expected);
+        }
+    }
+
+    // smoothing keeps the local variances positive and within the
+    // range of the repaired ones, and doesn't increase their
+    // variation in log-strike
+    TabulatedLocalVolSurface smoothed(localVol, times, 50.0, 200.0, 41, 5);
+    const Matrix& smoothedVols = smoothed.localVolMatrix();
+    for (Size i=0; i < times.size(); ++i) {
+        const Volatility minVol =
+            *std::min_element(vols.row_begin(i), vols.row_end(i));
+        const Volatility maxVol =
+            *std::max_element(vols.row_begin(i), vols.row_end(i));
+        Real variation = 0.0, smoothedVariation = 0.0;
+        for (Size j=0; j < strikes.size(); ++j) {
+            const Volatility vol = smoothedVols[i][j];
+            if (!(vol > 0.0) || vol < minVol - tolerance
+                             || vol > maxVol + tolerance)
+                BOOST_FAIL("smoothed local volatility out of range"
+                           << "\n    time:       " << times[i]
+                           << "\n    strike:     " << strikes[j]
+                           << "\n    smoothed:   " << vol
+                           << "\n    range:      [" << minVol
+                           << ", " << maxVol << "]");
+            if (j > 0) {
+                variation += std::fabs(vols[i][j] - vols[i][j-1]);
+                smoothedVariation +=
+                    std::fabs(smoothedVols[i][j] - smoothedVols[i][j-1]);
+            }
+        }
+        if (smoothedVariation > variation + tolerance)
+            BOOST_FAIL("smoothing increased the local volatility variation"
+                       << "\n    time:       " << times[i]
+                       << "\n    repaired:   " << variation
+                       << "\n    smoothed:   " << smoothedVariation);
+    }
+
+    // away from the kink at the first valid node, the smile is
+    // linear in log-strike and the smoothing is nearly neutral
+    const Real strike = 100.0;
+    const Volatility expected = PatchyLocalVol::smile(strike);
+    const Volatility calculated = smoothed.localVol(1.5, strike, true);
+    if (std::fabs(calculated - expected) > 1.0e-3)
+        BOOST_FAIL("smoothing distorted a regular smile"
+                   << "\n    strike:     " << strike
+                   << "\n    calculated: " << calculated
+                   << "\n    expected:   " << expected);
+}
+
 
 test_suite* EuropeanOptionTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("European option tests");
@@ -1541,6 +1789,10 @@ test_suite* EuropeanOptionTest::suite() {
     // FLOATING_POINT_EXCEPTION
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testPriceCurve));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testLocalVolatility));
+    suite->add(QUANTLIB_TEST_CASE(
+                        &EuropeanOptionTest::testTabulatedLocalVolatility));
+    suite->add(QUANTLIB_TEST_CASE(
+                  &EuropeanOptionTest::testTabulatedLocalVolatilityRepair));
 
     return suite;
 }
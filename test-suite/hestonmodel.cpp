@@ -22,12 +22,14 @@
 #include <ql/instruments/dividendbarrieroption.hpp>
 #include <ql/instruments/dividendvanillaoption.hpp>
 #include <ql/processes/hestonprocess.hpp>
+#include <ql/processes/batesprocess.hpp>
 #include <ql/math/integrals/gausslobattointegral.hpp>
 #include <ql/models/equity/hestonmodel.hpp>
 #include <ql/models/equity/hestonmodelhelper.hpp>
 #include <ql/models/equity/piecewisetimedependenthestonmodel.hpp>
 #include <ql/pricingengines/vanilla/analyticdividendeuropeanengine.hpp>
 #include <ql/pricingengines/vanilla/analytichestonengine.hpp>
+#include <ql/pricingengines/vanilla/batesengine.hpp>
 #include <ql/pricingengines/vanilla/hestonexpansionengine.hpp>
 #include <ql/pricingengines/vanilla/fdamericanengine.hpp>
 #include <ql/pricingengines/vanilla/fddividendeuropeanengine.hpp>
@@ -290,6 +292,63 @@ void HestonModelTest::testDAXCalibration() {
     }
 }
 
+void HestonModelTest::testParallelCalibration() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing Heston model calibration with replicas and "
+        "concurrent helpers...");
+
+    SavedSettings backup;
+
+    Date settlementDate(5, July, 2002);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    const Size nReplicas = 3;
+    std::vector<boost::shared_ptr<HestonModel> > models;
+    std::vector<std::vector<boost::shared_ptr<CalibrationHelper> > > options;
+    for (Size k = 0; k < nReplicas+2; ++k) {
+        CalibrationMarketData marketData = getDAXCalibrationMarketData();
+        models.push_back(boost::make_shared<HestonModel>(
+            boost::make_shared<HestonProcess>(
+                marketData.riskFreeTS, marketData.dividendYield,
+                marketData.s0, 0.1, 1.0, 0.1, 0.5, -0.5)));
+        options.push_back(marketData.options);
+        // one engine per helper, so that they can be priced concurrently
+        for (Size i = 0; i < options[k].size(); ++i)
+            options[k][i]->setPricingEngine(
+                boost::make_shared<AnalyticHestonEngine>(models[k], 64));
+    }
+
+    // reference calibration
+    const EndCriteria endCriteria(400, 40, 1.0e-8, 1.0e-8, 1.0e-8);
+    LevenbergMarquardt om(1e-8, 1e-8, 1e-8);
+    models[0]->calibrate(options[0], om, endCriteria);
+
+    std::vector<CalibratedModel::CalibrationReplica> replicas;
+    for (Size k = 2; k < nReplicas+2; ++k)
+        replicas.push_back(
+            CalibratedModel::CalibrationReplica(models[k], options[k]));
+    models[1]->setCalibrationReplicas(replicas);
+    models[1]->enableParallelHelpers();
+    models[1]->calibrate(options[1], om, endCriteria);
+
+    const Array expected = models[0]->params();
+    const Real tolerance = 1.0e-12;
+    for (Size k = 1; k < nReplicas+2; ++k) {
+        const Array calculated = models[k]->params();
+        for (Size i = 0; i < expected.size(); ++i) {
+            if (std::fabs(calculated[i] - expected[i]) > tolerance) {
+                BOOST_ERROR("Failed to reproduce serial calibration"
+                            << "\n    model:      " << k
+                            << "\n    parameter:  " << i
+                            << std::setprecision(16)
+                            << "\n    calculated: " << calculated[i]
+                            << "\n    expected:   " << expected[i]);
+            }
+        }
+    }
+}
+
 void HestonModelTest::testAnalyticVsBlack() {
     BOOST_TEST_MESSAGE("Testing analytic Heston engine against Black formula...");
 
@@ -1019,6 +1078,133 @@ void HestonModelTest::testMultipleStrikesEngine() {
 
 
 
+void HestonModelTest::testStrikeStrip() {
+    BOOST_TEST_MESSAGE("Testing strike strips with analytic Heston engines...");
+
+    SavedSettings backup;
+
+    const Date settlementDate(27, December, 2004);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    const DayCounter dayCounter = Actual365Fixed();
+    const Handle<YieldTermStructure> riskFreeTS(flatRate(0.05, dayCounter));
+    const Handle<YieldTermStructure> dividendTS(flatRate(0.02, dayCounter));
+    const Handle<Quote> s0(boost::make_shared<SimpleQuote>(100.0));
+
+    const boost::shared_ptr<HestonModel> hestonModel(
+        boost::make_shared<HestonModel>(
+            boost::make_shared<HestonProcess>(
+                riskFreeTS, dividendTS, s0, 0.04, 1.5, 0.05, 0.6, -0.7)));
+    const boost::shared_ptr<BatesModel> batesModel(
+        boost::make_shared<BatesModel>(
+            boost::make_shared<BatesProcess>(
+                riskFreeTS, dividendTS, s0, 0.04, 1.5, 0.05, 0.6, -0.7,
+                0.3, -0.1, 0.15)));
+
+    const boost::shared_ptr<AnalyticHestonEngine> engines[] = {
+        boost::make_shared<AnalyticHestonEngine>(hestonModel, 144),
+        boost::make_shared<AnalyticHestonEngine>(
+            hestonModel, AnalyticHestonEngine::BranchCorrection,
+            AnalyticHestonEngine::Integration::gaussLaguerre(144)),
+        boost::make_shared<AnalyticHestonEngine>(
+            hestonModel, AnalyticHestonEngine::Gatheral,
+            AnalyticHestonEngine::Integration::gaussLegendre(512)),
+        boost::make_shared<AnalyticHestonEngine>(hestonModel, 1e-10, 100000),
+        boost::make_shared<BatesEngine>(batesModel, 144)
+    };
+    // adaptive engines used as reference
+    const boost::shared_ptr<AnalyticHestonEngine> referenceEngines[] = {
+        engines[3],
+        engines[3],
+        engines[3],
+        engines[3],
+        boost::make_shared<BatesEngine>(batesModel, 1e-10, 100000)
+    };
+
+    const Integer maturities[] = { 1, 6, 24, 60 };
+
+    std::vector<Real> strikes;
+    std::vector<Option::Type> types;
+    for (Size i=0; i < 21; ++i) {
+        strikes.push_back(60.0 + 4.0*i);
+        types.push_back(i % 2 == 0 ? Option::Call : Option::Put);
+    }
+
+    // Gauss-Legendre converges more slowly on the mapped domain
+    const Real referenceTols[] = { 1e-6, 1e-6, 5e-4, 1e-6, 1e-6 };
+    const Real tol = 1e-12;
+
+    for (Size e=0; e < LENGTH(engines); ++e) {
+        for (Size i=0; i < LENGTH(maturities); ++i) {
+            const Date exerciseDate =
+                settlementDate + Period(maturities[i], Months);
+            const boost::shared_ptr<Exercise> exercise(
+                boost::make_shared<EuropeanExercise>(exerciseDate));
+
+            std::vector<Real> values;
+            engines[e]->calculateStrip(exerciseDate, strikes, types, values);
+
+            for (Size j=0; j < strikes.size(); ++j) {
+                VanillaOption option(
+                    boost::make_shared<PlainVanillaPayoff>(
+                        types[j], strikes[j]), exercise);
+
+                option.setPricingEngine(engines[e]);
+                const Real npv = option.NPV();
+
+                option.setPricingEngine(referenceEngines[e]);
+                const Real referenceNPV = option.NPV();
+
+                if (std::fabs(values[j] - npv) > tol
+                    || std::fabs(values[j] - referenceNPV)
+                                                    > referenceTols[e]) {
+                    BOOST_ERROR("failed to reproduce option price "
+                                "from strike strip"
+                                << "\n    engine:     " << e
+                                << "\n    maturity:   " << exerciseDate
+                                << "\n    strike:     " << strikes[j]
+                                << "\n    type:       " << types[j]
+                                << QL_FIXED << std::setprecision(12)
+                                << "\n    strip:      " << values[j]
+                                << "\n    npv:        " << npv
+                                << "\n    reference:  " << referenceNPV);
+                }
+            }
+        }
+    }
+
+    // the cached integrands must follow the model parameters
+    Array params = hestonModel->params();
+    params[3] = 0.3;
+    hestonModel->setParams(params);
+
+    const Date exerciseDate = settlementDate + Period(1, Years);
+    const boost::shared_ptr<Exercise> exercise(
+        boost::make_shared<EuropeanExercise>(exerciseDate));
+
+    std::vector<Real> values;
+    engines[0]->calculateStrip(exerciseDate, strikes, types, values);
+
+    for (Size j=0; j < strikes.size(); ++j) {
+        VanillaOption option(
+            boost::make_shared<PlainVanillaPayoff>(types[j], strikes[j]),
+            exercise);
+        option.setPricingEngine(engines[3]);
+        const Real referenceNPV = option.NPV();
+
+        if (std::fabs(values[j] - referenceNPV) > referenceTols[0]) {
+            BOOST_ERROR("failed to reproduce option price "
+                        "after change of model parameters"
+                        << "\n    strike:     " << strikes[j]
+                        << "\n    type:       " << types[j]
+                        << QL_FIXED << std::setprecision(12)
+                        << "\n    strip:      " << values[j]
+                        << "\n    reference:  " << referenceNPV);
+        }
+    }
+}
+
+
 void HestonModelTest::testAnalyticPiecewiseTimeDependent() {
     BOOST_TEST_MESSAGE("Testing analytic piecewise time dependent Heston prices...");
 
@@ -1512,6 +1698,7 @@ test_suite* HestonModelTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testBlackCalibration));
     // FLOATING_POINT_EXCEPTION
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testDAXCalibration));
+    suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testParallelCalibration));
     // FLOATING_POINT_EXCEPTION
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testAnalyticVsBlack));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testAnalyticVsCached));
@@ -1521,6 +1708,7 @@ test_suite* HestonModelTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testFdVanillaVsCached));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testMultipleStrikesEngine));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testMcVsCached));
+    suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testStrikeStrip));
     suite->add(QUANTLIB_TEST_CASE(
                     &HestonModelTest::testAnalyticPiecewiseTimeDependent));
     suite->add(QUANTLIB_TEST_CASE(
@@ -29,6 +29,7 @@ class HestonModelTest {
   public:
     static void testBlackCalibration();
     static void testDAXCalibration();
+    static void testParallelCalibration();
     static void testAnalyticVsBlack();
     static void testAnalyticVsCached();
     static void testKahlJaeckelCase();
@@ -37,6 +38,7 @@ class HestonModelTest {
     static void testFdVanillaVsCached();    
     static void testDifferentIntegrals();
     static void testMultipleStrikesEngine();
+    static void testStrikeStrip();
     static void testAnalyticPiecewiseTimeDependent();
     static void testDAXCalibrationOfTimeDependentModel();
     static void testAlanLewisReferencePrices();
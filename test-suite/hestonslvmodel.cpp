@@ -25,7 +25,9 @@
 
 #include <ql/quotes/simplequote.hpp>
 #include <ql/time/calendars/target.hpp>
+#include <ql/time/calendars/nullcalendar.hpp>
 #include <ql/time/daycounters/actualactual.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
 #include <ql/math/functional.hpp>
 #include <ql/math/solvers1d/brent.hpp>
 #include <ql/instruments/barrieroption.hpp>
@@ -2080,6 +2082,207 @@ void HestonSLVModelTest::testMonteCarloCalibration() {
 }
 
 
+void HestonSLVModelTest::testLeverageFunctionReuse() {
+    BOOST_TEST_MESSAGE(
+        "Testing reuse of the calibrated leverage function...");
+
+    SavedSettings backup;
+
+    const DayCounter dc = ActualActual();
+    const Date todaysDate(5, Jan, 2016);
+    const Date maturityDate = todaysDate + Period(1, Years);
+    Settings::instance().evaluationDate() = todaysDate;
+
+    const boost::shared_ptr<SimpleQuote> s0 =
+        boost::make_shared<SimpleQuote>(100.0);
+    const Handle<Quote> spot(s0);
+    const Handle<YieldTermStructure> rTS(flatRate(0.05, dc));
+    const Handle<YieldTermStructure> qTS(flatRate(0.02, dc));
+
+    const Handle<LocalVolTermStructure> localVol(
+        boost::make_shared<LocalConstantVol>(todaysDate, 0.3, dc));
+
+    const boost::shared_ptr<HestonModel> hestonModel =
+        boost::make_shared<HestonModel>(
+            boost::make_shared<HestonProcess>(
+                rTS, qTS, spot, 0.09, 1.0, 0.06, 0.4, -0.75));
+
+    const boost::shared_ptr<BrownianGeneratorFactory> factory(
+        new MTBrownianGeneratorFactory(1234ul));
+
+    HestonSLVMCModel model(localVol, Handle<HestonModel>(hestonModel),
+                           factory, maturityDate, 52, 51, 4096);
+
+    const boost::shared_ptr<LocalVolTermStructure> leverageFct =
+        model.leverageFunction();
+
+    // a notification without changes must not trigger a calibration
+    hestonModel->notifyObservers();
+    if (model.leverageFunction() != leverageFct)
+        BOOST_FAIL("leverage function recalibrated with unchanged inputs");
+
+    // a changed spot must trigger a calibration, and its result must
+    // be the same as the one of a fresh model
+    s0->setValue(101.0);
+    const boost::shared_ptr<LocalVolTermStructure> recalibratedFct =
+        model.leverageFunction();
+    if (recalibratedFct == leverageFct)
+        BOOST_FAIL("leverage function not recalibrated after spot change");
+
+    const boost::shared_ptr<LocalVolTermStructure> expectedFct =
+        HestonSLVMCModel(localVol, Handle<HestonModel>(hestonModel),
+                         factory, maturityDate, 52, 51, 4096)
+        .leverageFunction();
+
+    const Time times[] = { 0.1, 0.5, 0.9 };
+    const Real strikes[] = { 80.0, 100.0, 120.0 };
+    for (Size i=0; i < LENGTH(times); ++i) {
+        for (Size j=0; j < LENGTH(strikes); ++j) {
+            const Real calculated =
+                recalibratedFct->localVol(times[i], strikes[j], true);
+            const Real expected =
+                expectedFct->localVol(times[i], strikes[j], true);
+
+            if (calculated != expected)
+                BOOST_FAIL("failed to reproduce leverage function"
+                           << "\n time       : " << times[i]
+                           << "\n strike     : " << strikes[j]
+                           << "\n calculated : " << calculated
+                           << "\n expected   : " << expected);
+        }
+    }
+}
+
+
+namespace {
+
+    // flat local volatility, bumped at all times but the given ones
+    class OffGridBumpedLocalVol : public LocalVolTermStructure {
+      public:
+        OffGridBumpedLocalVol(const Date& referenceDate,
+                              const DayCounter& dc,
+                              const Handle<Quote>& bump)
+        : LocalVolTermStructure(referenceDate, NullCalendar(),
+                                Following, dc),
+          bump_(bump) {
+            registerWith(bump_);
+        }
+        Date maxDate() const { return Date::maxDate(); }
+        Real minStrike() const { return 0.0; }
+        Real maxStrike() const { return QL_MAX_REAL; }
+        void setUnbumpedTimes(const std::vector<Time>& times) {
+            times_ = times;
+            std::sort(times_.begin(), times_.end());
+        }
+      protected:
+        Volatility localVolImpl(Time t, Real) const {
+            if (std::binary_search(times_.begin(), times_.end(), t))
+                return 0.3;
+            return 0.3 + bump_->value();
+        }
+      private:
+        const Handle<Quote> bump_;
+        std::vector<Time> times_;
+    };
+
+}
+
+void HestonSLVModelTest::testFDMLeverageFunctionReuse() {
+    BOOST_TEST_MESSAGE(
+        "Testing reuse of the FDM calibrated leverage function...");
+
+    SavedSettings backup;
+
+    const DayCounter dc = Actual365Fixed();
+    const Date todaysDate(5, Jan, 2016);
+    const Date maturityDate = todaysDate + Period(6, Months);
+    Settings::instance().evaluationDate() = todaysDate;
+
+    const Handle<Quote> spot(boost::make_shared<SimpleQuote>(100.0));
+    const Handle<YieldTermStructure> rTS(flatRate(0.05, dc));
+    const Handle<YieldTermStructure> qTS(flatRate(0.02, dc));
+
+    const boost::shared_ptr<SimpleQuote> bump =
+        boost::make_shared<SimpleQuote>(0.0);
+    const boost::shared_ptr<OffGridBumpedLocalVol> bumpedLocalVol =
+        boost::make_shared<OffGridBumpedLocalVol>(
+            todaysDate, dc, Handle<Quote>(bump));
+    const Handle<LocalVolTermStructure> localVol(bumpedLocalVol);
+
+    const boost::shared_ptr<HestonModel> hestonModel =
+        boost::make_shared<HestonModel>(
+            boost::make_shared<HestonProcess>(
+                rTS, qTS, spot, 0.09, 1.0, 0.06, 0.4, -0.75));
+
+    const HestonSLVFokkerPlanckFdmParams params = {
+        101, 51, 200, 20, 2.0, 2,
+        0.1, 1e-4, 10000,
+        1e-5, 1e-5, 0.0000025, 1.0, 0.1, 0.9, 1e-5,
+        FdmHestonGreensFct::Gaussian,
+        FdmSquareRootFwdOp::Log,
+        FdmSchemeDesc::ModifiedCraigSneyd()
+    };
+
+    HestonSLVFDMModel model(
+        localVol, Handle<HestonModel>(hestonModel), maturityDate, params,
+        true);
+
+    const boost::shared_ptr<LocalVolTermStructure> leverageFct =
+        model.leverageFunction();
+
+    // a notification without changes must not trigger a calibration
+    hestonModel->notifyObservers();
+    if (model.leverageFunction() != leverageFct)
+        BOOST_FAIL("leverage function recalibrated with unchanged inputs");
+
+    // change the local volatility everywhere but at the calibration
+    // times, i.e., where the density of the local-vol process is
+    // evolved; this must trigger a calibration, whose result must be
+    // the same as the one of a fresh model
+    const std::list<HestonSLVFDMModel::LogEntry>& logEntries =
+        model.logEntries();
+    std::vector<Time> calibrationTimes(1, 0.0);
+    for (std::list<HestonSLVFDMModel::LogEntry>::const_iterator iter
+             = logEntries.begin(); iter != logEntries.end(); ++iter)
+        calibrationTimes.push_back(iter->t);
+    bumpedLocalVol->setUnbumpedTimes(calibrationTimes);
+
+    bump->setValue(0.1);
+    const boost::shared_ptr<LocalVolTermStructure> recalibratedFct =
+        model.leverageFunction();
+    if (recalibratedFct == leverageFct)
+        BOOST_FAIL("leverage function not recalibrated after "
+                   "local volatility change");
+
+    const boost::shared_ptr<LocalVolTermStructure> expectedFct =
+        HestonSLVFDMModel(localVol, Handle<HestonModel>(hestonModel),
+                          maturityDate, params).leverageFunction();
+
+    Real maxChange = 0.0;
+    for (Time t=0.1; t < 0.5; t+=0.1) {
+        for (Real strike=50.0; strike <= 200.0; strike+=5.0) {
+            const Real calculated =
+                recalibratedFct->localVol(t, strike, true);
+            const Real expected =
+                expectedFct->localVol(t, strike, true);
+
+            if (calculated != expected)
+                BOOST_FAIL("failed to reproduce leverage function"
+                           << "\n time       : " << t
+                           << "\n strike     : " << strike
+                           << "\n calculated : " << calculated
+                           << "\n expected   : " << expected);
+
+            maxChange = std::max(maxChange, std::fabs(calculated
+                - leverageFct->localVol(t, strike, true)));
+        }
+    }
+
+    if (maxChange == 0.0)
+        BOOST_FAIL("leverage function unaffected by local volatility change");
+}
+
+
 void HestonSLVModelTest::testForwardSkewSLV() {
     BOOST_TEST_MESSAGE("Testing the implied volatility skew of "
         "forward starting options in SLV model...");
@@ -2506,6 +2709,10 @@ test_suite* HestonSLVModelTest::experimental() {
         &HestonSLVModelTest::testMonteCarloVsFdmPricing));
     suite->add(QUANTLIB_TEST_CASE(
         &HestonSLVModelTest::testMonteCarloCalibration));
+    suite->add(QUANTLIB_TEST_CASE(
+        &HestonSLVModelTest::testLeverageFunctionReuse));
+    suite->add(QUANTLIB_TEST_CASE(
+        &HestonSLVModelTest::testFDMLeverageFunctionReuse));
     suite->add(QUANTLIB_TEST_CASE(
         &HestonSLVModelTest::testMoustacheGraph));
 
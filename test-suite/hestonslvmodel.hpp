@@ -43,6 +43,8 @@ public:
     static void testBarrierPricingMixedModels();
     static void testMonteCarloVsFdmPricing();
     static void testMonteCarloCalibration();
+    static void testLeverageFunctionReuse();
+    static void testFDMLeverageFunctionReuse();
     static void testMoustacheGraph();
     static void testForwardSkewSLV();
 
@@ -43,6 +43,11 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/models/marketmodels/evolvers/lognormalfwdrateballand.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalfwdratepc.hpp>
 #include <ql/models/marketmodels/evolvers/normalfwdratepc.hpp>
+#include <ql/models/marketmodels/evolvers/lognormalfwdrateeulerbatch.hpp>
+#include <ql/models/marketmodels/evolvers/lognormalfwdrateipcbatch.hpp>
+#include <ql/models/marketmodels/evolvers/lognormalfwdratepcbatch.hpp>
+#include <ql/models/marketmodels/evolvers/normalfwdratepcbatch.hpp>
+#include <ql/models/marketmodels/batchaccountingengine.hpp>
 #include <ql/models/marketmodels/discounter.hpp>
 #include <ql/models/marketmodels/models/abcdvol.hpp>
 #include <ql/models/marketmodels/models/flatvol.hpp>
@@ -63,6 +68,8 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/models/marketmodels/products/onestep/onestepoptionlets.hpp>
 #include <ql/models/marketmodels/forwardforwardmappings.hpp>
 #include <ql/models/marketmodels/proxygreekengine.hpp>
+#include <ql/models/marketmodels/parallelaccountingengine.hpp>
+#include <ql/models/marketmodels/evolverfactory.hpp>
 #include <ql/models/marketmodels/swapforwardmappings.hpp>
 #include <ql/models/marketmodels/models/fwdperiodadapter.hpp>
 #include <ql/models/marketmodels/models/fwdtocotswapadapter.hpp>
@@ -112,6 +119,10 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <boost/bind.hpp>
 #include <sstream>
 
+#if defined(_OPENMP)
+#include <omp.h>
+#endif
+
 #if defined(BOOST_MSVC)
 #include <float.h>
 //namespace { unsigned int u = _controlfp(_EM_INEXACT, _MCW_EM); }
@@ -4869,6 +4880,504 @@ void MarketModelTest::testCovariance() {
     }
 }
 
+void MarketModelTest::testParallelAccountingEngine() {
+
+    BOOST_TEST_MESSAGE("Testing multi-threaded accounting engine "
+                       "in a lognormal forward rate market model...");
+
+    setup();
+
+    std::vector<Rate> forwardStrikes(todaysForwards.size());
+    std::vector<boost::shared_ptr<Payoff> > optionletPayoffs(todaysForwards.size());
+    std::vector<boost::shared_ptr<StrikedTypePayoff> >
+        displacedPayoffs(todaysForwards.size());
+    for (Size i=0; i<todaysForwards.size(); ++i) {
+        forwardStrikes[i] = todaysForwards[i] + 0.01;
+        optionletPayoffs[i] = boost::shared_ptr<Payoff>(new
+            PlainVanillaPayoff(Option::Call, todaysForwards[i]));
+        displacedPayoffs[i] = boost::shared_ptr<StrikedTypePayoff>(new
+            PlainVanillaPayoff(Option::Call, todaysForwards[i]+displacement));
+    }
+
+    OneStepForwards forwards(rateTimes, accruals,
+        paymentTimes, forwardStrikes);
+    OneStepOptionlets optionlets(rateTimes, accruals,
+        paymentTimes, optionletPayoffs);
+
+    MultiProductComposite product;
+    product.add(forwards);
+    product.add(optionlets);
+    product.finalize();
+
+    EvolutionDescription evolution = product.evolution();
+    std::vector<Size> numeraires = makeMeasure(product, MoneyMarket);
+    boost::shared_ptr<MarketModel> marketModel =
+        makeMarketModel(true, evolution, todaysForwards.size(),
+                        ExponentialCorrelationAbcdVolatility);
+    Real initialNumeraireValue = todaysDiscounts[numeraires.front()];
+
+    boost::shared_ptr<MarketModelEvolverFactory> evolverFactory(
+        new GenericMarketModelEvolverFactory<LogNormalFwdRatePc>(
+                                                  marketModel, numeraires));
+    // a batch size not dividing the number of paths
+    Size batchSize = paths_/7 + 1;
+
+    // Sobol streams must reproduce the serial simulation
+    SobolBrownianGeneratorFactory generatorFactory(
+                                    SobolBrownianGenerator::Diagonal, seed_);
+    AccountingEngine serialEngine(evolverFactory->create(generatorFactory),
+                                  product, initialNumeraireValue);
+    SequenceStatisticsInc serialStats(product.numberOfProducts());
+    serialEngine.multiplePathValues(serialStats, paths_);
+
+    boost::shared_ptr<BrownianGeneratorStreamFactory> sobolStreams(
+        new SobolBrownianGeneratorStreamFactory(
+                                    SobolBrownianGenerator::Diagonal, seed_));
+    ParallelAccountingEngine parallelEngine(evolverFactory, sobolStreams,
+                                            product, initialNumeraireValue,
+                                            batchSize);
+    SequenceStatisticsInc parallelStats(product.numberOfProducts());
+    parallelEngine.multiplePathValues(parallelStats, paths_);
+
+    std::vector<Real> serialMeans = serialStats.mean();
+    std::vector<Real> parallelMeans = parallelStats.mean();
+    for (Size i=0; i<serialMeans.size(); ++i) {
+        if (std::fabs(serialMeans[i]-parallelMeans[i]) > 1.0e-12)
+            BOOST_ERROR("Sobol streams do not reproduce the serial "
+                        "simulation for product " << i << ":"
+                        << std::setprecision(12)
+                        << "\n    serial:   " << serialMeans[i]
+                        << "\n    parallel: " << parallelMeans[i]);
+    }
+
+    // MT streams must give correct and reproducible prices
+    boost::shared_ptr<BrownianGeneratorStreamFactory> mtStreams(
+                              new MTBrownianGeneratorStreamFactory(seed_));
+    ParallelAccountingEngine mtEngine(evolverFactory, mtStreams,
+                                      product, initialNumeraireValue,
+                                      batchSize);
+    SequenceStatisticsInc mtStats(product.numberOfProducts());
+    mtEngine.multiplePathValues(mtStats, paths_);
+    checkForwardsAndOptionlets(mtStats, forwardStrikes, displacedPayoffs,
+                               "parallel accounting engine, MT streams");
+
+#ifdef _OPENMP
+    int threads = omp_get_max_threads();
+    omp_set_num_threads(std::max(1, threads / 2));
+#endif
+    ParallelAccountingEngine mtEngine2(evolverFactory, mtStreams,
+                                       product, initialNumeraireValue,
+                                       batchSize);
+    SequenceStatisticsInc mtStats2(product.numberOfProducts());
+    mtEngine2.multiplePathValues(mtStats2, paths_);
+#ifdef _OPENMP
+    omp_set_num_threads(threads);
+#endif
+
+    std::vector<Real> means = mtStats.mean(), means2 = mtStats2.mean();
+    for (Size i=0; i<means.size(); ++i) {
+        if (means[i] != means2[i])
+            BOOST_ERROR("parallel simulation is not deterministic "
+                        "for product " << i << ":"
+                        << std::setprecision(16)
+                        << "\n    first run:  " << means[i]
+                        << "\n    second run: " << means2[i]);
+    }
+
+    // the pathwise and proxy-Greek engines must reproduce their
+    // serial counterparts on Sobol streams as well
+    MultiStepOptionlets stepOptionlets(rateTimes, accruals,
+                                       paymentTimes, optionletPayoffs);
+    MarketModelPathwiseMultiCaplet pathwiseCaplets(rateTimes, accruals,
+                                                   paymentTimes,
+                                                   todaysForwards);
+    EvolutionDescription stepEvolution = stepOptionlets.evolution();
+    std::vector<Size> stepNumeraires = moneyMarketMeasure(stepEvolution);
+    Real stepNumeraireValue = todaysDiscounts[stepNumeraires.front()];
+    boost::shared_ptr<MarketModel> stepModel =
+        makeMarketModel(true, stepEvolution, todaysForwards.size(),
+                        ExponentialCorrelationAbcdVolatility);
+    boost::shared_ptr<MarketModelEvolverFactory> eulerFactory(
+        new GenericMarketModelEvolverFactory<LogNormalFwdRateEuler>(
+                                               stepModel, stepNumeraires));
+
+    Size pathwiseSize = pathwiseCaplets.numberOfProducts() *
+                        (todaysForwards.size()+1);
+    PathwiseAccountingEngine serialPathwiseEngine(
+        boost::dynamic_pointer_cast<LogNormalFwdRateEuler>(
+                                    eulerFactory->create(generatorFactory)),
+        pathwiseCaplets, stepModel, stepNumeraireValue);
+    SequenceStatisticsInc serialPathwiseStats(pathwiseSize);
+    serialPathwiseEngine.multiplePathValues(serialPathwiseStats, paths_);
+
+    ParallelPathwiseAccountingEngine parallelPathwiseEngine(
+                                    eulerFactory, sobolStreams,
+                                    pathwiseCaplets, stepModel,
+                                    stepNumeraireValue, batchSize);
+    SequenceStatisticsInc parallelPathwiseStats(pathwiseSize);
+    parallelPathwiseEngine.multiplePathValues(parallelPathwiseStats, paths_);
+
+    serialMeans = serialPathwiseStats.mean();
+    parallelMeans = parallelPathwiseStats.mean();
+    for (Size i=0; i<serialMeans.size(); ++i) {
+        if (std::fabs(serialMeans[i]-parallelMeans[i]) > 1.0e-12)
+            BOOST_ERROR("parallel pathwise engine does not reproduce the "
+                        "serial one for value " << i << ":"
+                        << std::setprecision(12)
+                        << "\n    serial:   " << serialMeans[i]
+                        << "\n    parallel: " << parallelMeans[i]);
+    }
+
+    // forward deltas by central differences
+    std::vector<Size> startIndexOfConstraint, endIndexOfConstraint;
+    for (Size i=0; i<stepEvolution.evolutionTimes().size(); ++i) {
+        startIndexOfConstraint.push_back(i);
+        endIndexOfConstraint.push_back(i+1);
+    }
+    Spread forwardBump = 1.0e-6;
+    std::vector<std::vector<boost::shared_ptr<MarketModelEvolverFactory> > >
+        constrainedFactories(1);
+    constrainedFactories[0].push_back(
+        boost::shared_ptr<MarketModelEvolverFactory>(new
+            GenericMarketModelEvolverFactory<LogNormalFwdRateEulerConstrained>(
+                makeMarketModel(true, stepEvolution, todaysForwards.size(),
+                                ExponentialCorrelationAbcdVolatility,
+                                -forwardBump),
+                stepNumeraires)));
+    constrainedFactories[0].push_back(
+        boost::shared_ptr<MarketModelEvolverFactory>(new
+            GenericMarketModelEvolverFactory<LogNormalFwdRateEulerConstrained>(
+                makeMarketModel(true, stepEvolution, todaysForwards.size(),
+                                ExponentialCorrelationAbcdVolatility,
+                                forwardBump),
+                stepNumeraires)));
+    std::vector<std::vector<std::vector<Real> > > diffWeights(
+                          1, std::vector<std::vector<Real> >(
+                                            1, std::vector<Real>(3, 0.0)));
+    diffWeights[0][0][1] = -1.0/(2.0*forwardBump);
+    diffWeights[0][0][2] = 1.0/(2.0*forwardBump);
+
+    std::vector<std::vector<boost::shared_ptr<ConstrainedEvolver> > >
+        constrainedEvolvers(1);
+    for (Size j=0; j<constrainedFactories[0].size(); ++j) {
+        constrainedEvolvers[0].push_back(
+            boost::dynamic_pointer_cast<ConstrainedEvolver>(
+                     constrainedFactories[0][j]->create(generatorFactory)));
+        constrainedEvolvers[0].back()->setConstraintType(
+                               startIndexOfConstraint, endIndexOfConstraint);
+    }
+    ProxyGreekEngine serialProxyEngine(eulerFactory->create(generatorFactory),
+                                       constrainedEvolvers, diffWeights,
+                                       startIndexOfConstraint,
+                                       endIndexOfConstraint,
+                                       stepOptionlets, stepNumeraireValue);
+    SequenceStatisticsInc serialProxyStats(stepOptionlets.numberOfProducts());
+    std::vector<std::vector<SequenceStatisticsInc> > serialDeltaStats(
+                                            1, std::vector<SequenceStatisticsInc>(
+                                                   1, serialProxyStats));
+    serialProxyEngine.multiplePathValues(serialProxyStats, serialDeltaStats,
+                                         paths_);
+
+    ParallelProxyGreekEngine parallelProxyEngine(eulerFactory,
+                                                 constrainedFactories,
+                                                 diffWeights,
+                                                 startIndexOfConstraint,
+                                                 endIndexOfConstraint,
+                                                 sobolStreams, stepOptionlets,
+                                                 stepNumeraireValue,
+                                                 batchSize);
+    SequenceStatisticsInc parallelProxyStats(
+                                         stepOptionlets.numberOfProducts());
+    std::vector<std::vector<SequenceStatisticsInc> > parallelDeltaStats(
+                                          1, std::vector<SequenceStatisticsInc>(
+                                                   1, parallelProxyStats));
+    parallelProxyEngine.multiplePathValues(parallelProxyStats,
+                                           parallelDeltaStats, paths_);
+
+    serialMeans = serialProxyStats.mean();
+    parallelMeans = parallelProxyStats.mean();
+    std::vector<Real> serialDeltas = serialDeltaStats[0][0].mean();
+    std::vector<Real> parallelDeltas = parallelDeltaStats[0][0].mean();
+    for (Size i=0; i<serialMeans.size(); ++i) {
+        if (std::fabs(serialMeans[i]-parallelMeans[i]) > 1.0e-12
+            || std::fabs(serialDeltas[i]-parallelDeltas[i]) > 1.0e-10)
+            BOOST_ERROR("parallel proxy-Greek engine does not reproduce "
+                        "the serial one for product " << i << ":"
+                        << std::setprecision(12)
+                        << "\n    serial value:   " << serialMeans[i]
+                        << "\n    parallel value: " << parallelMeans[i]
+                        << "\n    serial delta:   " << serialDeltas[i]
+                        << "\n    parallel delta: " << parallelDeltas[i]);
+    }
+}
+
+namespace {
+
+    template <class Evolver, class BatchEvolver>
+    void checkBatchEvolver(const MarketModelMultiProduct& product,
+                           const boost::shared_ptr<MarketModel>& marketModel,
+                           const std::vector<Size>& numeraires,
+                           const std::string& config) {
+        const Size paths = 1000, batchSize = 40;
+        Real initialNumeraireValue = todaysDiscounts[numeraires.front()];
+
+        MTBrownianGeneratorFactory generatorFactory(seed_);
+        boost::shared_ptr<MarketModelEvolver> evolver(
+                   new Evolver(marketModel, generatorFactory, numeraires));
+        AccountingEngine engine(evolver, product, initialNumeraireValue);
+        SequenceStatisticsInc stats(product.numberOfProducts());
+        engine.multiplePathValues(stats, paths);
+
+        boost::shared_ptr<MarketModelBatchEvolver> batchEvolver(
+                              new BatchEvolver(marketModel, generatorFactory,
+                                               numeraires, batchSize));
+        BatchAccountingEngine batchEngine(batchEvolver, product,
+                                          initialNumeraireValue);
+        SequenceStatisticsInc batchStats(product.numberOfProducts());
+        batchEngine.multiplePathValues(batchStats, paths);
+
+        std::vector<Real> values = stats.mean();
+        std::vector<Real> batchValues = batchStats.mean();
+        for (Size i=0; i<values.size(); ++i) {
+            if (std::fabs(values[i]-batchValues[i]) > 1.0e-12)
+                BOOST_ERROR("batch evolver does not reproduce the "
+                            "single-path one (" << config << ")"
+                            << std::setprecision(12)
+                            << "\n    product:     " << i
+                            << "\n    single-path: " << values[i]
+                            << "\n    batch:       " << batchValues[i]);
+        }
+    }
+
+}
+
+void MarketModelTest::testBatchEvolvers() {
+
+    BOOST_TEST_MESSAGE("Testing batch evolvers "
+                       "in a forward rate market model...");
+
+    setup();
+
+    MultiProductComposite product;
+    std::vector<SubProductExpectedValues> subProductExpectedValues;
+    addForwards(product, subProductExpectedValues);
+    addOptionLets(product, subProductExpectedValues);
+    addCoinitialSwaps(product, subProductExpectedValues);
+    product.finalize();
+
+    EvolutionDescription evolution = product.evolution();
+    std::vector<Size> moneyMarket = makeMeasure(product, MoneyMarket);
+    std::vector<Size> terminal = makeMeasure(product, Terminal);
+
+    // reduced and full factors use different drift computations
+    Size testedFactors[] = { 3, todaysForwards.size() };
+    for (Size m=0; m<LENGTH(testedFactors); ++m) {
+        Size factors = testedFactors[m];
+        std::ostringstream config;
+        config << factors << " factors";
+
+        boost::shared_ptr<MarketModel> logNormalModel =
+            makeMarketModel(true, evolution, factors,
+                            ExponentialCorrelationAbcdVolatility);
+        checkBatchEvolver<LogNormalFwdRatePc, LogNormalFwdRatePcBatch>(
+            product, logNormalModel, moneyMarket, config.str() + ", Pc");
+        checkBatchEvolver<LogNormalFwdRateEuler, LogNormalFwdRateEulerBatch>(
+            product, logNormalModel, moneyMarket, config.str() + ", Euler");
+        checkBatchEvolver<LogNormalFwdRateIpc, LogNormalFwdRateIpcBatch>(
+            product, logNormalModel, terminal, config.str() + ", Ipc");
+
+        boost::shared_ptr<MarketModel> normalModel =
+            makeMarketModel(false, evolution, factors,
+                            ExponentialCorrelationAbcdVolatility);
+        checkBatchEvolver<NormalFwdRatePc, NormalFwdRatePcBatch>(
+            product, normalModel, moneyMarket, config.str() + ", NormalPc");
+    }
+}
+
+namespace {
+
+    std::vector<Real> adjointPathwiseValues(
+                      const boost::shared_ptr<MarketModel>& marketModel,
+                      const MarketModelPathwiseMultiProduct& product,
+                      const std::vector<std::vector<Matrix> >& vegaBumps,
+                      Size paths,
+                      bool elementary) {
+        MTBrownianGeneratorFactory generatorFactory(seed_);
+        std::vector<Size> numeraires =
+            moneyMarketMeasure(marketModel->evolution());
+        boost::shared_ptr<LogNormalFwdRateEuler> evolver(
+                new LogNormalFwdRateEuler(marketModel, generatorFactory,
+                                          numeraires));
+        PathwiseVegasAdjointAccountingEngine engine(
+                                  evolver, product, marketModel, vegaBumps,
+                                  todaysDiscounts[numeraires.front()]);
+        std::vector<Real> means, errors;
+        if (elementary)
+            engine.multiplePathValuesElementary(means, errors, paths);
+        else
+            engine.multiplePathValues(means, errors, paths);
+        return means;
+    }
+
+}
+
+void MarketModelTest::testAdjointPathwiseVegas() {
+
+    BOOST_TEST_MESSAGE("Testing adjoint pathwise vegas "
+                       "in a lognormal forward rate market model...");
+
+    setup();
+
+    // with common random numbers, the pathwise Greeks of smooth
+    // payoffs must equal the finite-difference ones up to the
+    // discretization error of the latter
+    const Size paths = 500, factors = 3;
+    const Real h = 1.0e-6, tolerance = 1.0e-6;
+
+    EvolutionDescription evolution(rateTimes);
+    boost::shared_ptr<MarketModel> flatVolModel =
+        makeMarketModel(true, evolution, factors,
+                        ExponentialCorrelationFlatVolatility);
+    Size numberRates = flatVolModel->numberOfRates();
+    Size numberSteps = flatVolModel->numberOfSteps();
+    std::vector<Matrix> pseudoRoots;
+    for (Size s=0; s<numberSteps; ++s)
+        pseudoRoots.push_back(flatVolModel->pseudoRoot(s));
+    std::vector<Spread> displacements(numberRates, 0.01);
+    boost::shared_ptr<MarketModel> marketModel(
+                        new PseudoRootFacade(pseudoRoots, rateTimes,
+                                             todaysForwards, displacements));
+
+    // one bump scaling all pseudo-roots and one elementary bump
+    std::vector<std::vector<Matrix> > vegaBumps(numberSteps);
+    for (Size s=0; s<numberSteps; ++s) {
+        vegaBumps[s].push_back(pseudoRoots[s]);
+        vegaBumps[s].push_back(Matrix(numberRates, factors, 0.0));
+    }
+    vegaBumps[1][1][3][2] = 1.0;
+
+    // strikes below minus the displacement make the caplets linear
+    std::vector<Rate> strikes(numberRates, -0.02);
+    MarketModelPathwiseMultiCaplet caplets(rateTimes, accruals,
+                                           paymentTimes, strikes);
+    MarketModelPathwiseMultiDeflatedCaplet deflatedCaplets(
+                              rateTimes, accruals, paymentTimes, strikes);
+    const MarketModelPathwiseMultiProduct* products[] = {
+        &caplets, &deflatedCaplets };
+
+    Size elementsPerProduct = 1+numberRates+numberSteps*numberRates*factors;
+    Size bumpedPerProduct = 1+numberRates+vegaBumps[0].size();
+
+    for (Size k=0; k<LENGTH(products); ++k) {
+        const MarketModelPathwiseMultiProduct& product = *products[k];
+        std::vector<Real> values =
+            adjointPathwiseValues(marketModel, product, vegaBumps,
+                                  paths, true);
+        std::vector<Real> bumpedValues =
+            adjointPathwiseValues(marketModel, product, vegaBumps,
+                                  paths, false);
+
+        Size testedProducts[] = { 0, 3, numberRates-1 };
+        for (Size i=0; i<LENGTH(testedProducts); ++i) {
+            Size p = testedProducts[i];
+            const Real* results = &values[p*elementsPerProduct];
+
+            // deltas
+            for (Size r=0; r<=p; r+=2) {
+                std::vector<Rate> upRates(todaysForwards),
+                                  downRates(todaysForwards);
+                upRates[r] += h;
+                downRates[r] -= h;
+                boost::shared_ptr<MarketModel> up(
+                      new PseudoRootFacade(pseudoRoots, rateTimes,
+                                           upRates, displacements));
+                boost::shared_ptr<MarketModel> down(
+                      new PseudoRootFacade(pseudoRoots, rateTimes,
+                                           downRates, displacements));
+                Real fdDelta =
+                    (adjointPathwiseValues(up, product, vegaBumps,
+                                           paths, true)[p*elementsPerProduct]
+                     - adjointPathwiseValues(down, product, vegaBumps,
+                                           paths, true)[p*elementsPerProduct])
+                    / (2.0*h);
+                if (std::fabs(results[1+r]-fdDelta) > tolerance)
+                    BOOST_ERROR("adjoint pathwise delta differs from "
+                                "finite-difference one"
+                                << std::setprecision(10)
+                                << "\n    product:           " << k
+                                << ", caplet " << p
+                                << "\n    rate:              " << r
+                                << "\n    adjoint:           " << results[1+r]
+                                << "\n    finite difference: " << fdDelta);
+            }
+
+            // elementary vegas
+            for (Size s=0; s<=std::min(p,numberSteps-1); s+=2) {
+                for (Size r=s; r<=p; r+=3) {
+                    for (Size f=0; f<factors; ++f) {
+                        std::vector<Matrix> upRoots(pseudoRoots),
+                                            downRoots(pseudoRoots);
+                        upRoots[s][r][f] += h;
+                        downRoots[s][r][f] -= h;
+                        boost::shared_ptr<MarketModel> up(
+                             new PseudoRootFacade(upRoots, rateTimes,
+                                                  todaysForwards,
+                                                  displacements));
+                        boost::shared_ptr<MarketModel> down(
+                             new PseudoRootFacade(downRoots, rateTimes,
+                                                  todaysForwards,
+                                                  displacements));
+                        Real fdVega =
+                            (adjointPathwiseValues(up, product, vegaBumps,
+                                    paths, true)[p*elementsPerProduct]
+                             - adjointPathwiseValues(down, product, vegaBumps,
+                                    paths, true)[p*elementsPerProduct])
+                            / (2.0*h);
+                        Real vega = results[1+numberRates+
+                                            (s*numberRates+r)*factors+f];
+                        if (std::fabs(vega-fdVega) > tolerance)
+                            BOOST_ERROR("adjoint pathwise vega differs from "
+                                        "finite-difference one"
+                                        << std::setprecision(10)
+                                        << "\n    product:           " << k
+                                        << ", caplet " << p
+                                        << "\n    element:           ("
+                                        << s << ", " << r << ", " << f << ")"
+                                        << "\n    adjoint:           " << vega
+                                        << "\n    finite difference: "
+                                        << fdVega);
+                    }
+                }
+            }
+
+            // bumped vegas are linear combinations of the elementary ones
+            const Real* bumped = &bumpedValues[p*bumpedPerProduct];
+            for (Size j=0; j<1+numberRates; ++j) {
+                if (bumped[j] != results[j])
+                    BOOST_ERROR("price or delta " << j << " of caplet " << p
+                                << " depends on the requested vegas");
+            }
+            for (Size b=0; b<vegaBumps[0].size(); ++b) {
+                Real vega = 0.0;
+                for (Size s=0; s<numberSteps; ++s)
+                    for (Size r=0; r<numberRates; ++r)
+                        for (Size f=0; f<factors; ++f)
+                            vega += vegaBumps[s][b][r][f] *
+                                results[1+numberRates+
+                                        (s*numberRates+r)*factors+f];
+                if (std::fabs(bumped[1+numberRates+b]-vega) > 1.0e-12)
+                    BOOST_ERROR("bumped vega " << b << " of caplet " << p
+                                << " is not the expected combination of "
+                                "elementary vegas"
+                                << std::setprecision(12)
+                                << "\n    bumped:     "
+                                << bumped[1+numberRates+b]
+                                << "\n    elementary: " << vega);
+            }
+        }
+    }
+}
+
 // --- Call the desired tests
 test_suite* MarketModelTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Market-model tests");
@@ -4879,6 +5388,7 @@ test_suite* MarketModelTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testPathwiseVegas));
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testPathwiseMarketVegas));
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testPathwiseGreeks));
+    suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testAdjointPathwiseVegas));
 
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testStochVolForwardsAndOptionlets));
 
@@ -4889,6 +5399,10 @@ test_suite* MarketModelTest::suite() {
 
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testCallableSwapNaif));
 
+    suite->add(QUANTLIB_TEST_CASE(
+                         &MarketModelTest::testParallelAccountingEngine));
+    suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testBatchEvolvers));
+
     MarketModelType marketModels[] = {
         ExponentialCorrelationFlatVolatility,
         ExponentialCorrelationAbcdVolatility };
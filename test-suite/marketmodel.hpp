@@ -39,6 +39,8 @@ class MarketModelTest {
     static void testOneStepForwardsAndOptionlets();
     static void testOneStepNormalForwardsAndOptionlets();
     static void testCallableSwapNaif();
+    static void testParallelAccountingEngine();
+    static void testBatchEvolvers();
     static void testCallableSwapLS();
     static void testCallableSwapAnderson(
         MarketModelType marketModel, unsigned testedFactor);
@@ -46,6 +48,7 @@ class MarketModelTest {
     static void testPathwiseGreeks();
     static void testPathwiseVegas();
     static void testPathwiseMarketVegas();
+    static void testAdjointPathwiseVegas();
     static void testStochVolForwardsAndOptionlets();
     static void testAbcdVolatilityIntegration();
     static void testAbcdVolatilityCompare();
@@ -600,6 +600,83 @@ void MatricesTest::testMoorePenroseInverse() {
     }
 
 }
+void MatricesTest::testBlockedKernels() {
+
+    BOOST_TEST_MESSAGE("Testing blocked matrix kernels...");
+
+    MersenneTwisterUniformRng rng(1234);
+
+    // sizes across and within the kernel blocks
+    Size sizes[][3] = { { 1, 1, 1 }, { 3, 200, 5 }, { 70, 130, 67 },
+                        { 129, 64, 65 } };
+
+    for (Size n=0; n<LENGTH(sizes); ++n) {
+        Size rows = sizes[n][0], inner = sizes[n][1], columns = sizes[n][2];
+        Matrix a(rows, inner), b(inner, columns);
+        for (Matrix::iterator i=a.begin(); i!=a.end(); ++i)
+            *i = rng.nextReal() - 0.5;
+        for (Matrix::iterator i=b.begin(); i!=b.end(); ++i)
+            *i = rng.nextReal() - 0.5;
+
+        Matrix c = a*b;
+        Real tol = 1.0e-12*inner;
+        for (Size i=0; i<rows; ++i) {
+            for (Size j=0; j<columns; ++j) {
+                Real expected = 0.0;
+                for (Size k=0; k<inner; ++k)
+                    expected += a[i][k]*b[k][j];
+                if (std::fabs(c[i][j] - expected) > tol)
+                    BOOST_FAIL("wrong matrix product: "
+                               << rows << "x" << inner << " times "
+                               << inner << "x" << columns
+                               << ", element (" << i << ", " << j << ") is "
+                               << c[i][j] << ", expected " << expected);
+            }
+        }
+
+        Matrix t = transpose(a);
+        if (t.rows() != inner || t.columns() != rows)
+            BOOST_FAIL("wrong size of transposed matrix");
+        for (Size i=0; i<rows; ++i)
+            for (Size j=0; j<inner; ++j)
+                if (t[j][i] != a[i][j])
+                    BOOST_FAIL("wrong transposed matrix: element ("
+                               << j << ", " << i << ") is " << t[j][i]
+                               << ", expected " << a[i][j]);
+    }
+
+    // spectral root of a large correlation matrix
+    Size size = 150;
+    Matrix correlation(size, size);
+    for (Size i=0; i<size; ++i)
+        for (Size j=0; j<size; ++j)
+            correlation[i][j] =
+                std::exp(-0.05*std::fabs(Real(i)-Real(j)));
+
+    Matrix root = pseudoSqrt(correlation, SalvagingAlgorithm::Spectral);
+    Matrix product = root*transpose(root);
+    for (Size i=0; i<size; ++i)
+        for (Size j=0; j<size; ++j)
+            if (std::fabs(product[i][j] - correlation[i][j]) > 1.0e-10)
+                BOOST_FAIL("wrong spectral pseudo-root: element ("
+                           << i << ", " << j << ") of its square is "
+                           << product[i][j] << ", expected "
+                           << correlation[i][j]);
+
+    Matrix cholesky = CholeskyDecomposition(correlation);
+    product = cholesky*transpose(cholesky);
+    for (Size i=0; i<size; ++i) {
+        for (Size j=i+1; j<size; ++j)
+            if (cholesky[i][j] != 0.0)
+                BOOST_FAIL("Cholesky factor is not lower triangular");
+        for (Size j=0; j<size; ++j)
+            if (std::fabs(product[i][j] - correlation[i][j]) > 1.0e-12)
+                BOOST_FAIL("wrong Cholesky decomposition: element ("
+                           << i << ", " << j << ") of its square is "
+                           << product[i][j] << ", expected "
+                           << correlation[i][j]);
+    }
+}
 
 test_suite* MatricesTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Matrix tests");
@@ -617,6 +694,7 @@ test_suite* MatricesTest::suite() {
     #endif
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testCholeskyDecomposition));
     suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testMoorePenroseInverse));
+    suite->add(QUANTLIB_TEST_CASE(&MatricesTest::testBlockedKernels));
     return suite;
 }
 
@@ -40,6 +40,7 @@ class MatricesTest {
     static void testOrthogonalProjection();
     static void testCholeskyDecomposition();
     static void testMoorePenroseInverse();
+    static void testBlockedKernels();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -81,7 +81,9 @@ namespace {
                             Real requiredTolerance,
                             Size maxSamples,
                             BigNatural seed,
-                            Size nCalibrationSamples = Null<Size>())
+                            Size nCalibrationSamples = Null<Size>(),
+                            LsmCalibrationStorage::Type storage =
+                                LsmCalibrationStorage::Paths)
         : MCLongstaffSchwartzEngine<VanillaOption::engine,
                                     MultiVariate,RNG>(processes,
                                                       timeSteps,
@@ -92,7 +94,8 @@ namespace {
                                                       requiredSamples,
                                                       requiredTolerance,
                                                       maxSamples,
-                                                      seed, nCalibrationSamples)
+                                                      seed, nCalibrationSamples),
+          storage_(storage)
         { }
 
       protected:
@@ -115,8 +118,12 @@ namespace {
                 new LongstaffSchwartzPathPricer<MultiPath>(
                     this->timeGrid(),
                     earlyExercisePathPricer,
-                    process->riskFreeRate().currentLink()));
+                    process->riskFreeRate().currentLink(),
+                    storage_));
         }
+
+      private:
+        const LsmCalibrationStorage::Type storage_;
     };
 
 }
@@ -315,6 +322,108 @@ void MCLongstaffSchwartzEngineTest::testAmericanMaxOption() {
     }
 }
 
+void MCLongstaffSchwartzEngineTest::testCompactCalibrationStorage() {
+
+    BOOST_TEST_MESSAGE("Testing Longstaff-Schwartz calibration with compact "
+                       "state storage...");
+
+    SavedSettings backup;
+
+    const Date today(15, May, 1998);
+    Settings::instance().evaluationDate() = today;
+    const Date maturity(16, May, 2001);
+    const DayCounter dayCounter = Actual365Fixed();
+
+    Handle<YieldTermStructure> riskFreeTS(
+        boost::shared_ptr<YieldTermStructure>(
+            new FlatForward(today, 0.05, dayCounter)));
+    Handle<YieldTermStructure> dividendTS(
+        boost::shared_ptr<YieldTermStructure>(
+            new FlatForward(today, 0.10, dayCounter)));
+    Handle<BlackVolTermStructure> volTS(
+        boost::shared_ptr<BlackVolTermStructure>(
+            new BlackConstantVol(today, NullCalendar(), 0.20, dayCounter)));
+    Handle<Quote> underlying(
+        boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+
+    boost::shared_ptr<GeneralizedBlackScholesProcess> process(
+        new GeneralizedBlackScholesProcess(underlying, dividendTS,
+                                           riskFreeTS, volTS));
+
+    boost::shared_ptr<Exercise> exercise(
+        new AmericanExercise(today, maturity));
+
+    const LsmCalibrationStorage::Type storages[] = {
+        LsmCalibrationStorage::States,
+        LsmCalibrationStorage::StatesSinglePrecision };
+    // the single precision states introduce small differences
+    // in the regression coefficients only
+    const Real tolerance[] = { 1.0E-8, 2.0E-3 };
+
+    // single asset
+    VanillaOption put(
+        boost::shared_ptr<StrikedTypePayoff>(
+            new PlainVanillaPayoff(Option::Put, 104.0)), exercise);
+
+    put.setPricingEngine(
+        MakeMCAmericanEngine<PseudoRandom>(process)
+        .withSteps(50)
+        .withSamples(4096)
+        .withSeed(42)
+        .withCalibrationSamples(4096));
+    const Real expected = put.NPV();
+
+    for (Size i = 0; i < LENGTH(storages); ++i) {
+        put.setPricingEngine(
+            MakeMCAmericanEngine<PseudoRandom>(process)
+            .withSteps(50)
+            .withSamples(4096)
+            .withSeed(42)
+            .withCalibrationSamples(4096)
+            .withCalibrationStorage(storages[i]));
+        const Real calculated = put.NPV();
+        if (std::fabs(calculated - expected) > tolerance[i]*expected)
+            BOOST_ERROR("Failed to reproduce american option price with "
+                        "compact calibration storage"
+                        << "\n    storage:    " << storages[i]
+                        << "\n    expected:   " << expected
+                        << "\n    calculated: " << calculated);
+    }
+
+    // multi asset
+    Matrix corr(2, 2, 0.0);
+    corr[0][0] = corr[1][1] = 1.0;
+    std::vector<boost::shared_ptr<StochasticProcess1D> > v(2, process);
+    boost::shared_ptr<StochasticProcessArray> processes(
+        new StochasticProcessArray(v, corr));
+
+    VanillaOption maxCall(
+        boost::shared_ptr<StrikedTypePayoff>(
+            new PlainVanillaPayoff(Option::Call, 100.0)), exercise);
+
+    maxCall.setPricingEngine(boost::shared_ptr<PricingEngine>(
+        new MCAmericanMaxEngine<PseudoRandom>(processes, 25, Null<Size>(),
+                                              false, true, false, 4096,
+                                              Null<Real>(), Null<Size>(),
+                                              42, 1024)));
+    const Real expectedMax = maxCall.NPV();
+
+    for (Size i = 0; i < LENGTH(storages); ++i) {
+        maxCall.setPricingEngine(boost::shared_ptr<PricingEngine>(
+            new MCAmericanMaxEngine<PseudoRandom>(processes, 25, Null<Size>(),
+                                                  false, true, false, 4096,
+                                                  Null<Real>(), Null<Size>(),
+                                                  42, 1024, storages[i])));
+        const Real calculated = maxCall.NPV();
+        if (std::fabs(calculated - expectedMax) > tolerance[i]*expectedMax)
+            BOOST_ERROR("Failed to reproduce american max option price with "
+                        "compact calibration storage"
+                        << "\n    storage:    " << storages[i]
+                        << "\n    expected:   " << expectedMax
+                        << "\n    calculated: " << calculated);
+    }
+}
+
 test_suite* MCLongstaffSchwartzEngineTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Longstaff Schwartz MC engine tests");
     // FLOATING_POINT_EXCEPTION
@@ -322,6 +431,8 @@ test_suite* MCLongstaffSchwartzEngineTest::suite() {
          &MCLongstaffSchwartzEngineTest::testAmericanOption));
     suite->add(QUANTLIB_TEST_CASE(
          &MCLongstaffSchwartzEngineTest::testAmericanMaxOption));
+    suite->add(QUANTLIB_TEST_CASE(
+         &MCLongstaffSchwartzEngineTest::testCompactCalibrationStorage));
     return suite;
 }
 
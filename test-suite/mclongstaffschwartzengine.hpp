@@ -29,6 +29,7 @@ class MCLongstaffSchwartzEngineTest {
   public:
     static void testAmericanOption();
     static void testAmericanMaxOption();
+    static void testCompactCalibrationStorage();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -34,6 +34,8 @@
 #include <ql/models/equity/hestonmodel.hpp>
 #include <ql/models/shortrate/onefactormodels/gsr.hpp>
 #include <ql/pricingengines/vanilla/mceuropeanhestonengine.hpp>
+#include <ql/pricingengines/vanilla/mceuropeanengine.hpp>
+#include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
 #include <ql/experimental/exoticoptions/analyticpdfhestonengine.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/calendars/nullcalendar.hpp>
@@ -469,6 +471,79 @@ void MonteCarloMultiThreadedTest::testDynamicCreatorWrapper() {
     }
 }
 
+void MonteCarloMultiThreadedTest::testBatchedSimulation() {
+
+    BOOST_TEST_MESSAGE("Testing batched Monte Carlo simulation with early "
+                       "stopping...");
+
+    SavedSettings backup;
+
+    Date today(27, December, 2004);
+    Settings::instance().evaluationDate() = today;
+    DayCounter dayCounter = Actual365Fixed();
+
+    boost::shared_ptr<GeneralizedBlackScholesProcess> process(
+        new GeneralizedBlackScholesProcess(
+            Handle<Quote>(boost::make_shared<SimpleQuote>(100.0)),
+            Handle<YieldTermStructure>(flatRate(today, 0.01, dayCounter)),
+            Handle<YieldTermStructure>(flatRate(today, 0.03, dayCounter)),
+            Handle<BlackVolTermStructure>(
+                flatVol(today, 0.20, dayCounter))));
+
+    VanillaOption option(
+        boost::make_shared<PlainVanillaPayoff>(Option::Call, 105.0),
+        boost::make_shared<EuropeanExercise>(today + 2 * Years));
+
+    option.setPricingEngine(
+        boost::make_shared<AnalyticEuropeanEngine>(process));
+    const Real expected = option.NPV();
+
+    const Real tolerance = 0.05;
+    const Size batchSize = 1000;
+
+    option.setPricingEngine(
+        MakeMCEuropeanEngine<PseudoRandomMultiThreaded>(process)
+            .withSteps(1)
+            .withAbsoluteTolerance(tolerance)
+            .withBatchSize(batchSize)
+            .withSeed(42));
+    const Real calculated = option.NPV();
+    const Real errorEstimate = option.errorEstimate();
+
+    if (errorEstimate > tolerance)
+        BOOST_ERROR("Batched simulation stopped above the required tolerance"
+                    << "\n    error estimate: " << errorEstimate
+                    << "\n    tolerance:      " << tolerance);
+
+    if (std::fabs(calculated - expected) > 3.0 * errorEstimate)
+        BOOST_ERROR("Failed to reproduce analytic price with batched "
+                    "simulation"
+                    << "\n    calculated: " << calculated << " +/- "
+                    << errorEstimate << "\n    expected:   " << expected);
+
+    // the result must not depend on the number of threads
+#ifdef _OPENMP
+    int threads = omp_get_max_threads();
+    omp_set_num_threads(std::max(1, threads / 2));
+#endif
+    option.setPricingEngine(
+        MakeMCEuropeanEngine<PseudoRandomMultiThreaded>(process)
+            .withSteps(1)
+            .withAbsoluteTolerance(tolerance)
+            .withBatchSize(batchSize)
+            .withSeed(42));
+    const Real recalculated = option.NPV();
+#ifdef _OPENMP
+    omp_set_num_threads(threads);
+#endif
+
+    if (recalculated != calculated)
+        BOOST_ERROR("Batched simulation is not deterministic"
+                    << std::setprecision(16)
+                    << "\n    first run:  " << calculated
+                    << "\n    second run: " << recalculated);
+}
+
 test_suite *MonteCarloMultiThreadedTest::suite() {
     test_suite *suite = BOOST_TEST_SUITE("Monte carlo multithreaded tests");
 
@@ -480,6 +555,8 @@ test_suite *MonteCarloMultiThreadedTest::suite() {
         QUANTLIB_TEST_CASE(&MonteCarloMultiThreadedTest::testAmericanOption));
     suite->add(
         QUANTLIB_TEST_CASE(&MonteCarloMultiThreadedTest::testBermudanSwaption));
+    suite->add(
+        QUANTLIB_TEST_CASE(&MonteCarloMultiThreadedTest::testBatchedSimulation));
 
     return suite;
 }
@@ -31,6 +31,7 @@ class MonteCarloMultiThreadedTest {
     static void testAmericanOption();
     static void testBermudanSwaption();
     static void testDynamicCreatorWrapper();
+    static void testBatchedSimulation();
     static boost::unit_test_framework::test_suite *suite();
 };
 
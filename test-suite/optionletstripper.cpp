@@ -829,6 +829,73 @@ void OptionletStripperTest::testSwitchStrike() {
                    << "\ntolerance:     " << io::rate(vars.tolerance));
 }
 
+void OptionletStripperTest::testIncrementalStripping() {
+    BOOST_TEST_MESSAGE("Testing incremental optionlet stripping after "
+                       "a term volatility change...");
+
+    CommonVars vars;
+    Settings::instance().evaluationDate() = Date(28, October, 2013);
+    vars.setCapFloorTermVolSurface();
+
+    std::vector<std::vector<Handle<Quote> > > volQuotes(
+                                                  vars.optionTenors.size());
+    std::vector<std::vector<boost::shared_ptr<SimpleQuote> > > quotes(
+                                                  vars.optionTenors.size());
+    for (Size i=0; i<vars.optionTenors.size(); ++i) {
+        for (Size j=0; j<vars.strikes.size(); ++j) {
+            quotes[i].push_back(boost::shared_ptr<SimpleQuote>(
+                                         new SimpleQuote(vars.termV[i][j])));
+            volQuotes[i].push_back(Handle<Quote>(quotes[i].back()));
+        }
+    }
+    boost::shared_ptr<CapFloorTermVolSurface> surface(
+        new CapFloorTermVolSurface(0, vars.calendar, Following,
+                                   vars.optionTenors, vars.strikes,
+                                   volQuotes, vars.dayCounter));
+
+    shared_ptr<IborIndex> iborIndex(new Euribor6M(vars.yieldTermStructure));
+
+    boost::shared_ptr<OptionletStripper1> stripper(
+        new OptionletStripper1(surface, iborIndex, Null<Rate>(),
+                               vars.accuracy));
+    // strip once, then move a single quote
+    stripper->optionletVolatilities(0);
+
+    const Size bumpedStrike = 5;
+    quotes[3][bumpedStrike]->setValue(vars.termV[3][bumpedStrike] + 0.005);
+    Matrix bumpedTermV = vars.termV;
+    bumpedTermV[3][bumpedStrike] += 0.005;
+
+    boost::shared_ptr<CapFloorTermVolSurface> bumpedSurface(
+        new CapFloorTermVolSurface(0, vars.calendar, Following,
+                                   vars.optionTenors, vars.strikes,
+                                   bumpedTermV, vars.dayCounter));
+    boost::shared_ptr<OptionletStripper1> freshStripper(
+        new OptionletStripper1(bumpedSurface, iborIndex, Null<Rate>(),
+                               vars.accuracy));
+
+    // restripped columns start from the previous solution, so they
+    // agree with a fresh stripping within its accuracy
+    const Real tolerance = 1.0e-5;
+    for (Size i=0; i<stripper->optionletMaturities(); ++i) {
+        const std::vector<Volatility>& vols =
+            stripper->optionletVolatilities(i);
+        const std::vector<Volatility>& expected =
+            freshStripper->optionletVolatilities(i);
+        for (Size j=0; j<vars.strikes.size(); ++j) {
+            Real error = std::fabs(vols[j] - expected[j]);
+            if (error > tolerance)
+                BOOST_FAIL("\nincrementally stripped volatility differs:"
+                           << "\noptionlet:  " << i
+                           << "\nstrike:     " << io::rate(vars.strikes[j])
+                           << "\nstripped:   " << io::volatility(vols[j])
+                           << "\nexpected:   " << io::volatility(expected[j])
+                           << "\nerror:      " << error
+                           << "\ntolerance:  " << tolerance);
+        }
+    }
+}
+
 test_suite* OptionletStripperTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("OptionletStripper Tests");
     suite->add(QUANTLIB_TEST_CASE(
@@ -841,6 +908,8 @@ test_suite* OptionletStripperTest::suite() {
                        &OptionletStripperTest::testTermVolatilityStripping2));
     suite->add(QUANTLIB_TEST_CASE(
                        &OptionletStripperTest::testSwitchStrike));
+    suite->add(QUANTLIB_TEST_CASE(
+                       &OptionletStripperTest::testIncrementalStripping));
     suite->add(QUANTLIB_TEST_CASE(
         &OptionletStripperTest::testTermVolatilityStrippingNormalVol));
     suite->add(
@@ -20,6 +20,8 @@
 #include "schedule.hpp"
 #include "utilities.hpp"
 #include <ql/time/schedule.hpp>
+#include <ql/time/schedulecache.hpp>
+#include <ql/time/calendars/bespokecalendar.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/calendars/japan.hpp>
 #include <ql/time/calendars/unitedstates.hpp>
@@ -288,6 +290,154 @@ void ScheduleTest::testFourWeeksTenor() {
     }
 }
 
+namespace {
+
+    void check_same_schedule(const Schedule& expected,
+                             const Schedule& calculated) {
+        if (expected.dates() != calculated.dates()
+            || expected.isRegular() != calculated.isRegular()
+            || expected.calendar() != calculated.calendar()
+            || expected.tenor() != calculated.tenor()
+            || expected.businessDayConvention()
+                                   != calculated.businessDayConvention()
+            || expected.rule() != calculated.rule()
+            || expected.endOfMonth() != calculated.endOfMonth()) {
+            BOOST_ERROR("cached schedule differs from generated one:"
+                        << "\n    start date: " << expected.startDate()
+                        << "\n    end date:   " << expected.endDate()
+                        << "\n    tenor:      " << expected.tenor());
+        }
+    }
+
+    class ScheduleCacheDisabler {
+      public:
+        ~ScheduleCacheDisabler() {
+            ScheduleCache::instance().setCapacity(0);
+            ScheduleCache::instance().clear();
+            ScheduleCache::instance().resetStatistics();
+        }
+    };
+
+}
+
+void ScheduleTest::testScheduleCache() {
+    BOOST_TEST_MESSAGE("Testing schedule cache...");
+
+    ScheduleCacheDisabler disabler;
+    ScheduleCache& cache = ScheduleCache::instance();
+
+    // reference schedules, generated with the cache disabled
+    cache.setCapacity(0);
+    std::vector<Schedule> expected;
+    std::vector<Period> tenors;
+    tenors.push_back(3*Months);
+    tenors.push_back(6*Months);
+    tenors.push_back(1*Years);
+    Date start(31, August, 2015);
+    for (Size i=0; i<tenors.size(); ++i) {
+        for (Integer years=1; years<=10; ++years) {
+            expected.push_back(
+                MakeSchedule().from(start).to(start + years*Years)
+                              .withCalendar(TARGET())
+                              .withTenor(tenors[i])
+                              .withConvention(ModifiedFollowing)
+                              .endOfMonth()
+                              .backwards());
+        }
+    }
+    if (cache.size() != 0 || cache.hits() != 0 || cache.misses() != 0)
+        BOOST_ERROR("disabled cache was used");
+
+    cache.setCapacity(100);
+    for (Size pass=0; pass<3; ++pass) {
+        Size k = 0;
+        for (Size i=0; i<tenors.size(); ++i) {
+            for (Integer years=1; years<=10; ++years, ++k) {
+                Schedule s =
+                    MakeSchedule().from(start).to(start + years*Years)
+                                  .withCalendar(TARGET())
+                                  .withTenor(tenors[i])
+                                  .withConvention(ModifiedFollowing)
+                                  .endOfMonth()
+                                  .backwards();
+                check_same_schedule(expected[k], s);
+            }
+        }
+    }
+    if (cache.misses() != expected.size() ||
+        cache.hits() != 2*expected.size())
+        BOOST_ERROR("unexpected cache statistics:"
+                    << "\n    hits:   " << cache.hits()
+                    << " (expected " << 2*expected.size() << ")"
+                    << "\n    misses: " << cache.misses()
+                    << " (expected " << expected.size() << ")");
+
+    // shared schedules
+    boost::shared_ptr<const Schedule> s1 =
+        cache.schedule(start, start + 5*Years, 6*Months, TARGET(),
+                       ModifiedFollowing, ModifiedFollowing,
+                       DateGeneration::Backward, true);
+    boost::shared_ptr<const Schedule> s2 =
+        cache.schedule(start, start + 5*Years, 6*Months, TARGET(),
+                       ModifiedFollowing, ModifiedFollowing,
+                       DateGeneration::Backward, true);
+    if (s1 != s2)
+        BOOST_ERROR("cached schedule not shared");
+    check_same_schedule(expected[14], *s1);
+
+    // different arguments must not hit the cache
+    boost::shared_ptr<const Schedule> s3 =
+        cache.schedule(start, start + 5*Years, 6*Months, TARGET(),
+                       ModifiedFollowing, ModifiedFollowing,
+                       DateGeneration::Backward, false);
+    if (s3 == s1 || s3->endOfMonth())
+        BOOST_ERROR("wrong schedule returned for different arguments");
+
+    // bounded size
+    cache.setCapacity(10);
+    if (cache.size() != 10)
+        BOOST_ERROR("cache not trimmed: " << cache.size()
+                    << " schedules instead of 10");
+
+    // changes in calendars invalidate the cache
+    Calendar calendar = TARGET();
+    Date holiday(30, November, 2015);
+    Schedule before =
+        MakeSchedule().from(start).to(start + 1*Years)
+                      .withCalendar(calendar).withTenor(3*Months)
+                      .withConvention(Following).backwards();
+    calendar.addHoliday(holiday);
+    Schedule after =
+        MakeSchedule().from(start).to(start + 1*Years)
+                      .withCalendar(calendar).withTenor(3*Months)
+                      .withConvention(Following).backwards();
+    calendar.removeHoliday(holiday);
+    if (before[1] != holiday || after[1] != holiday + 1)
+        BOOST_ERROR("added holiday not taken into account:"
+                    << "\n    before: " << before[1]
+                    << "\n    after:  " << after[1]
+                    << " (expected " << holiday + 1 << ")");
+
+    // unnamed bespoke calendars are told apart
+    BespokeCalendar noWeekends, sundays;
+    sundays.addWeekend(Sunday);
+    Date sunday(6, September, 2015);
+    Schedule plain =
+        MakeSchedule().from(sunday).to(sunday + 4*Weeks)
+                      .withCalendar(noWeekends).withTenor(1*Weeks)
+                      .withConvention(Following).forwards();
+    Schedule adjusted =
+        MakeSchedule().from(sunday).to(sunday + 4*Weeks)
+                      .withCalendar(sundays).withTenor(1*Weeks)
+                      .withConvention(Following).forwards();
+    if (plain[0] != sunday || adjusted[0] != sunday + 1)
+        BOOST_ERROR("wrong schedule for unnamed bespoke calendars:"
+                    << "\n    no weekends: " << plain[0]
+                    << " (expected " << sunday << ")"
+                    << "\n    sundays:     " << adjusted[0]
+                    << " (expected " << sunday + 1 << ")");
+}
+
 
 test_suite* ScheduleTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Schedule tests");
@@ -303,6 +453,7 @@ test_suite* ScheduleTest::suite() {
         &ScheduleTest::testDoubleFirstDateWithEomAdjustment));
     suite->add(QUANTLIB_TEST_CASE(&ScheduleTest::testDateConstructor));
     suite->add(QUANTLIB_TEST_CASE(&ScheduleTest::testFourWeeksTenor));
+    suite->add(QUANTLIB_TEST_CASE(&ScheduleTest::testScheduleCache));
     return suite;
 }
 
@@ -35,6 +35,7 @@ class ScheduleTest {
     static void testDoubleFirstDateWithEomAdjustment();
     static void testDateConstructor();
     static void testFourWeeksTenor();
+    static void testScheduleCache();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -442,6 +442,115 @@ void SwaptionVolatilityCubeTest::testObservability() {
     Settings::instance().evaluationDate() = referenceDate;
 }
 
+void SwaptionVolatilityCubeTest::testIncrementalSabrCalibration() {
+
+    BOOST_TEST_MESSAGE("Testing incremental recalibration of "
+                       "swaption volatility cube (sabr interpolation)...");
+
+    CommonVars vars;
+
+    std::vector<std::vector<Handle<Quote> > >
+        parametersGuess(vars.cube.tenors.options.size()*vars.cube.tenors.swaps.size());
+    for (Size i=0; i<vars.cube.tenors.options.size()*vars.cube.tenors.swaps.size(); i++) {
+        parametersGuess[i] = std::vector<Handle<Quote> >(4);
+        parametersGuess[i][0] =
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(0.2)));
+        parametersGuess[i][1] =
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(0.5)));
+        parametersGuess[i][2] =
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(0.4)));
+        parametersGuess[i][3] =
+            Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(0.0)));
+    }
+    std::vector<bool> isParameterFixed(4, false);
+
+    boost::shared_ptr<SwaptionVolCube1> volCube[2];
+    for (Size w=0; w<2; ++w) {
+        volCube[w] = boost::make_shared<SwaptionVolCube1>(
+                             vars.atmVolMatrix,
+                             vars.cube.tenors.options,
+                             vars.cube.tenors.swaps,
+                             vars.cube.strikeSpreads,
+                             vars.cube.volSpreadsHandle,
+                             vars.swapIndexBase,
+                             vars.shortSwapIndexBase,
+                             vars.vegaWeighedSmileFit,
+                             parametersGuess,
+                             isParameterFixed,
+                             true,
+                             boost::shared_ptr<EndCriteria>(),
+                             Null<Real>(),
+                             boost::shared_ptr<OptimizationMethod>(),
+                             Null<Real>(),
+                             false, 50, false, 0.0001,
+                             w == 1);
+        volCube[w]->enableExtrapolation();
+        volCube[w]->sparseSabrParameters();
+    }
+
+    // bump a single quote
+    boost::shared_ptr<SimpleQuote> quote =
+        boost::dynamic_pointer_cast<SimpleQuote>(
+                                   vars.cube.volSpreadsHandle[4][1].currentLink());
+    quote->setValue(quote->value() + 0.0010);
+
+    SwaptionVolCube1 freshCube(vars.atmVolMatrix,
+                               vars.cube.tenors.options,
+                               vars.cube.tenors.swaps,
+                               vars.cube.strikeSpreads,
+                               vars.cube.volSpreadsHandle,
+                               vars.swapIndexBase,
+                               vars.shortSwapIndexBase,
+                               vars.vegaWeighedSmileFit,
+                               parametersGuess,
+                               isParameterFixed,
+                               true);
+    freshCube.enableExtrapolation();
+
+    // without warm start, keeping the unchanged nodes must give
+    // the same results as a full calibration
+    Matrix expected = freshCube.sparseSabrParameters();
+    Matrix calculated = volCube[0]->sparseSabrParameters();
+    for (Size i=0; i<expected.rows(); ++i) {
+        for (Size j=0; j<expected.columns(); ++j) {
+            if (std::fabs(calculated[i][j] - expected[i][j]) > 1.0e-14)
+                BOOST_ERROR("failed to reproduce full calibration"
+                            << "\n    row:        " << i
+                            << "\n    column:     " << j
+                            << "\n    calculated: " << calculated[i][j]
+                            << "\n    expected:   " << expected[i][j]);
+        }
+    }
+
+    // with warm start, the smile might come from a different but
+    // equally good fit
+    Real tolerance = 3.0e-4;
+    vars.makeAtmVolTest(*volCube[1], tolerance);
+    for (Size i=0; i<vars.cube.tenors.options.size(); i++) {
+        for (Size j=0; j<vars.cube.tenors.swaps.size(); j++) {
+            for (Size k=0; k<vars.cube.strikeSpreads.size(); k++) {
+                Rate strike = freshCube.atmStrike(vars.cube.tenors.options[i],
+                                                  vars.cube.tenors.swaps[j])
+                    + vars.cube.strikeSpreads[k];
+                Volatility v0 = freshCube.volatility(vars.cube.tenors.options[i],
+                                                     vars.cube.tenors.swaps[j],
+                                                     strike);
+                Volatility v1 = volCube[1]->volatility(vars.cube.tenors.options[i],
+                                                       vars.cube.tenors.swaps[j],
+                                                       strike);
+                if (std::fabs(v0 - v1) > tolerance)
+                    BOOST_ERROR("failed to reproduce full calibration "
+                                "with warm start"
+                                << "\n    option tenor = " << vars.cube.tenors.options[i]
+                                << "\n    swap tenor = " << vars.cube.tenors.swaps[j]
+                                << "\n    strike = " << io::rate(strike)
+                                << "\n    expected = " << io::volatility(v0)
+                                << "\n    calculated = " << io::volatility(v1));
+            }
+        }
+    }
+}
+
 test_suite* SwaptionVolatilityCubeTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Swaption Volatility Cube tests");
 
@@ -458,6 +567,8 @@ test_suite* SwaptionVolatilityCubeTest::suite() {
 
     suite->add(QUANTLIB_TEST_CASE(
                              &SwaptionVolatilityCubeTest::testObservability));
+    suite->add(QUANTLIB_TEST_CASE(
+               &SwaptionVolatilityCubeTest::testIncrementalSabrCalibration));
 
     return suite;
 }
@@ -26,6 +26,10 @@
 #include <ql/termstructures/yield/impliedtermstructure.hpp>
 #include <ql/termstructures/yield/forwardspreadedtermstructure.hpp>
 #include <ql/termstructures/yield/zerospreadedtermstructure.hpp>
+#include <ql/termstructures/yield/zerocurve.hpp>
+#include <ql/termstructures/yield/discountcurve.hpp>
+#include <ql/math/interpolations/cubicinterpolation.hpp>
+#include <ql/math/interpolations/backwardflatinterpolation.hpp>
 #include <ql/experimental/yield/clonedyieldtermstructure.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/calendars/nullcalendar.hpp>
@@ -590,6 +594,123 @@ void TermStructureTest::testClonedYieldTermStructure() {
     }
 }
 
+void TermStructureTest::testBatchCalculations() {
+
+    BOOST_TEST_MESSAGE("Testing batch discount and rate calculations...");
+
+    CommonVars vars;
+
+    Date today = vars.termStructure->referenceDate();
+    Handle<YieldTermStructure> h(vars.termStructure);
+
+    // curves of the supported kinds, built on the bootstrapped one
+    std::vector<Date> dates;
+    std::vector<DiscountFactor> discounts;
+    std::vector<Rate> zeros;
+    for (Integer i=0; i<=30; i+=(i<5 ? 1 : 5)) {
+        Date d = today + i*Years;
+        dates.push_back(d);
+        discounts.push_back(vars.termStructure->discount(d));
+        zeros.push_back(vars.termStructure->zeroRate(d, Actual360(),
+                                                     Continuous));
+    }
+    std::vector<Handle<Quote> > jumps(1,
+        Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(0.995))));
+    std::vector<Date> jumpDates(1, today + 18*Months);
+
+    std::vector<boost::shared_ptr<YieldTermStructure> > curves;
+    curves.push_back(vars.termStructure);
+    curves.push_back(boost::shared_ptr<YieldTermStructure>(
+                       new FlatForward(today, 0.04, Actual360(),
+                                       Compounded, Semiannual)));
+    curves.push_back(boost::shared_ptr<YieldTermStructure>(
+                       new DiscountCurve(dates, discounts, Actual360(),
+                                         TARGET(), jumps, jumpDates)));
+    curves.push_back(boost::shared_ptr<YieldTermStructure>(
+                       new ZeroCurve(dates, zeros, Actual360())));
+    curves.push_back(boost::shared_ptr<YieldTermStructure>(
+                       new InterpolatedZeroCurve<Cubic>(dates, zeros,
+                                                        Actual360())));
+    curves.push_back(boost::shared_ptr<YieldTermStructure>(
+                       new InterpolatedZeroCurve<BackwardFlat>(dates, zeros,
+                                                               Actual360())));
+    curves.push_back(boost::shared_ptr<YieldTermStructure>(
+          new ZeroSpreadedTermStructure(h,
+              Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(0.01))),
+              Compounded, Semiannual)));
+    curves.push_back(boost::shared_ptr<YieldTermStructure>(
+          new ForwardSpreadedTermStructure(h,
+              Handle<Quote>(boost::shared_ptr<Quote>(new SimpleQuote(0.01))))));
+
+    // sorted times, including null times and extrapolation...
+    std::vector<Time> sorted(1, 0.0);
+    for (Time t=0.1; t<35.0; t+=0.37)
+        sorted.push_back(t);
+    sorted.push_back(vars.termStructure->maxTime());
+    // ...and shuffled ones
+    std::vector<Time> shuffled;
+    for (Size i=0; i<sorted.size(); ++i)
+        shuffled.push_back(sorted[(7*i) % sorted.size()]);
+
+    Real tolerance = 1.0e-12;
+    for (Size k=0; k<curves.size(); ++k) {
+        const boost::shared_ptr<YieldTermStructure>& curve = curves[k];
+        curve->enableExtrapolation();
+        for (Size pass=0; pass<2; ++pass) {
+            const std::vector<Time>& times = pass == 0 ? sorted : shuffled;
+
+            std::vector<DiscountFactor> d;
+            curve->discount(times, d);
+            std::vector<Rate> z;
+            curve->zeroRate(times, z, Compounded, Quarterly);
+            std::vector<Time> t1(times.begin(), times.end()-1),
+                              t2(times.begin()+1, times.end());
+            for (Size i=0; i<t1.size(); ++i) {
+                // forward rates need increasing times; the first
+                // pair gives an instantaneous forward
+                if (t2[i] < t1[i])
+                    std::swap(t1[i], t2[i]);
+            }
+            t2[0] = t1[0];
+            std::vector<Rate> f;
+            curve->forwardRate(t1, t2, f, Simple);
+
+            for (Size i=0; i<times.size(); ++i) {
+                DiscountFactor expected = curve->discount(times[i]);
+                if (std::fabs(d[i]-expected) > tolerance)
+                    BOOST_ERROR("batch discount mismatch for curve #" << k
+                                << " at t = " << times[i] << ":"
+                                << "\n    scalar: " << expected
+                                << "\n    batch:  " << d[i]);
+                Rate expectedRate =
+                    curve->zeroRate(times[i], Compounded, Quarterly);
+                if (std::fabs(z[i]-expectedRate) > tolerance)
+                    BOOST_ERROR("batch zero rate mismatch for curve #" << k
+                                << " at t = " << times[i] << ":"
+                                << "\n    scalar: " << expectedRate
+                                << "\n    batch:  " << z[i]);
+            }
+            for (Size i=0; i<t1.size(); ++i) {
+                Rate expected =
+                    curve->forwardRate(t1[i], t2[i], Simple);
+                if (std::fabs(f[i]-expected) > tolerance)
+                    BOOST_ERROR("batch forward rate mismatch for curve #"
+                                << k << " between t = " << t1[i]
+                                << " and t = " << t2[i] << ":"
+                                << "\n    scalar: " << expected
+                                << "\n    batch:  " << f[i]);
+            }
+        }
+    }
+
+    // range checks are performed on the whole batch
+    curves[1]->disableExtrapolation();
+    std::vector<Time> outOfRange(2, 1.0);
+    outOfRange[1] = -1.0;
+    std::vector<DiscountFactor> d;
+    BOOST_CHECK_THROW(curves[1]->discount(outOfRange, d), Error);
+}
+
 test_suite* TermStructureTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Term structure tests");
     suite->add(QUANTLIB_TEST_CASE(&TermStructureTest::testReferenceChange));
@@ -599,6 +720,7 @@ test_suite* TermStructureTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&TermStructureTest::testFSpreadedObs));
     suite->add(QUANTLIB_TEST_CASE(&TermStructureTest::testZSpreaded));
     suite->add(QUANTLIB_TEST_CASE(&TermStructureTest::testZSpreadedObs));
+    suite->add(QUANTLIB_TEST_CASE(&TermStructureTest::testBatchCalculations));
     suite->add(QUANTLIB_TEST_CASE(
                          &TermStructureTest::testCreateWithNullUnderlying));
     suite->add(QUANTLIB_TEST_CASE(
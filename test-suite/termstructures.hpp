@@ -34,6 +34,7 @@ class TermStructureTest {
     static void testFSpreadedObs();
     static void testZSpreaded();
     static void testZSpreadedObs();
+    static void testBatchCalculations();
     static void testCreateWithNullUnderlying();
     static void testLinkToNullUnderlying();
     static void testClonedYieldTermStructure();
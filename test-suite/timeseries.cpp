@@ -22,7 +22,10 @@
 #include "utilities.hpp"
 #include <ql/timeseries.hpp>
 #include <ql/prices.hpp>
+#include <ql/indexes/fixingsstore.hpp>
 #include <ql/time/calendars/unitedstates.hpp>
+#include <cstdio>
+#include <fstream>
 
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic push
@@ -193,11 +196,247 @@ void TimeSeriesTest::testIterators() {
     }
 }
 
+void TimeSeriesTest::testFlatContainer() {
+
+    BOOST_TEST_MESSAGE("Testing time series with flat container...");
+
+    typedef TimeSeries<Real, FlatMap<Date, Real> > FlatSeries;
+
+    std::vector<Date> dates;
+    std::vector<Real> values;
+    Date d0(3, January, 2005);
+    for (Size i=0; i<50; ++i) {
+        dates.push_back(d0 + Integer(7*i));
+        values.push_back(i*0.5);
+    }
+
+    TimeSeries<Real> expected(dates.begin(), dates.end(), values.begin());
+    FlatSeries ts(dates.begin(), dates.end(), values.begin());
+
+    // out-of-order insertions and overwrites
+    ts[d0 + 3] = 1.5;
+    expected[d0 + 3] = 1.5;
+    ts[d0 - 10] = -1.0;
+    expected[d0 - 10] = -1.0;
+    ts[d0 + 14] = 42.0;
+    expected[d0 + 14] = 42.0;
+
+    if (ts.size() != expected.size())
+        BOOST_ERROR("size mismatch: " << ts.size()
+                    << " instead of " << expected.size());
+    if (ts.firstDate() != expected.firstDate())
+        BOOST_ERROR("first date mismatch: " << ts.firstDate()
+                    << " instead of " << expected.firstDate());
+    if (ts.lastDate() != expected.lastDate())
+        BOOST_ERROR("last date mismatch: " << ts.lastDate()
+                    << " instead of " << expected.lastDate());
+
+    std::vector<Date> flatDates = ts.dates(), mapDates = expected.dates();
+    std::vector<Real> flatValues = ts.values(), mapValues = expected.values();
+    if (flatDates != mapDates || flatValues != mapValues)
+        BOOST_ERROR("flat series does not match map-based one");
+
+    // lookups; the const operator doesn't add null data
+    const FlatSeries& constTs = ts;
+    if (constTs[d0 + 1] != Null<Real>() || ts.size() != expected.size())
+        BOOST_ERROR("wrong lookup of missing datum");
+    if (constTs[d0 + 7] != 0.5 || constTs[d0 - 10] != -1.0)
+        BOOST_ERROR("wrong lookup of stored datum");
+
+    FlatSeries::const_iterator i = ts.find(d0 + 21);
+    if (i == ts.cend() || i->first != d0 + 21 || i->second != 1.5)
+        BOOST_ERROR("wrong datum found");
+    i = ts.find(d0 + 2);
+    if (i == ts.cend() || i->first != d0 + 2 || i->second != Null<Real>())
+        BOOST_ERROR("missing datum not added by find");
+    if (ts.size() != expected.size() + 1)
+        BOOST_ERROR("wrong size after find");
+
+    // reverse and projection iterators
+    if (ts.crbegin()->first != ts.lastDate()
+        || *ts.crbegin_values() != values.back()
+        || *(ts.crend_time()-1) != d0 - 10)
+        BOOST_ERROR("wrong reverse iterators");
+    if (ts.cend_values() - ts.cbegin_values() != Integer(ts.size()))
+        BOOST_ERROR("value iterators are not random access");
+}
+
+void TimeSeriesTest::testFixingsStore() {
+
+    BOOST_TEST_MESSAGE("Testing flat fixings store...");
+
+    FixingsStore& store = FixingsStore::instance();
+    store.clear();
+
+    FixingsStore::Id euribor = store.id("Euribor6M Actual/360");
+    FixingsStore::Id libor = store.id("USDLibor3M Actual/360");
+    if (store.id("EURIBOR6M ACTUAL/360") != euribor)
+        BOOST_ERROR("index names are not case insensitive");
+    if (!store.hasId("euribor6m actual/360") || store.hasId("Eonia"))
+        BOOST_ERROR("wrong registered indexes");
+    if (store.size() != 2)
+        BOOST_ERROR("wrong number of registered indexes: " << store.size());
+
+    Date d0(3, January, 2005);
+    std::vector<Date> dates;
+    std::vector<Real> values;
+    TimeSeries<Real> expected;
+    // read-only view, since operator[] would add null entries
+    const TimeSeries<Real>& expectedFixings = expected;
+    for (Size i=0; i<200; i+=3) {
+        dates.push_back(d0 + i);
+        values.push_back(0.01 + i*1.0e-5);
+        expected[d0 + i] = values.back();
+    }
+
+    Flag flag;
+    flag.registerWith(store.notifier(euribor));
+    store.setFixings(euribor, dates, values);
+    if (!flag.isUp())
+        BOOST_ERROR("observer was not notified of new fixings");
+
+    for (Date d=d0-10; d<d0+210; ++d) {
+        Real stored = store.fixing(euribor, d);
+        if (stored != expectedFixings[d])
+            BOOST_ERROR("wrong fixing at " << d << ": " << stored
+                        << " instead of " << expectedFixings[d]);
+    }
+    if (store.hasFixings(libor) || store.fixing(libor, d0) != Null<Real>())
+        BOOST_ERROR("fixings stored for the wrong index");
+    if (store.firstDate(euribor) != dates.front() ||
+        store.lastDate(euribor) != dates.back())
+        BOOST_ERROR("wrong fixing window");
+
+    // the window is extended by later writes
+    std::vector<Date> newDates(1, d0 - 30);
+    std::vector<Real> newValues(1, 0.02);
+    store.setFixings(euribor, newDates, newValues);
+    expected[d0 - 30] = 0.02;
+    if (store.firstDate(euribor) != d0 - 30
+        || store.fixing(euribor, d0 - 30) != 0.02
+        || store.fixing(euribor, d0) != expectedFixings[d0])
+        BOOST_ERROR("fixing window was not extended correctly");
+
+    // conflicting fixings are rejected as a whole
+    newDates.push_back(d0 + 300);
+    newValues[0] = 0.03;
+    newValues.push_back(0.04);
+    bool raised = false;
+    try {
+        store.setFixings(euribor, newDates, newValues);
+    } catch (Error&) {
+        raised = true;
+    }
+    if (!raised)
+        BOOST_ERROR("duplicated fixing was accepted");
+    if (store.fixing(euribor, d0 + 300) != Null<Real>()
+        || store.fixing(euribor, d0 - 30) != 0.02)
+        BOOST_ERROR("rejected fixings were partially stored");
+    store.setFixings(euribor, newDates, newValues, true);
+    expected[d0 - 30] = 0.03;
+    expected[d0 + 300] = 0.04;
+
+    TimeSeries<Real> history = store.history(euribor);
+    const TimeSeries<Real>& storedFixings = history;
+    if (history.size() != expected.size())
+        BOOST_ERROR("wrong history size: " << history.size()
+                    << " instead of " << expected.size());
+    for (TimeSeries<Real>::const_iterator i=expected.cbegin();
+         i!=expected.cend(); ++i) {
+        if (storedFixings[i->first] != i->second)
+            BOOST_ERROR("wrong history value at " << i->first);
+    }
+
+    std::vector<Date> queries;
+    for (Date d=d0+310; d>d0-40; d-=7)
+        queries.push_back(d);
+    std::vector<Real> batch;
+    store.fixings(euribor, queries, batch);
+    for (Size i=0; i<queries.size(); ++i) {
+        if (batch[i] != expectedFixings[queries[i]])
+            BOOST_ERROR("wrong batch fixing at " << queries[i]);
+    }
+
+    // files
+    std::string csvFile = "fixingsstore_test.csv";
+    std::string binaryFile = "fixingsstore_test.bin";
+    {
+        std::ofstream out(csvFile.c_str());
+        out << "# index,date,value\n"
+            << "Eonia,2010-01-04,0.0034\n"
+            << "Eonia, 2010-01-05 ,0.0035\r\n"
+            << "\n"
+            << "usdlibor3m actual/360,2010-01-04,0.0025\n"
+            << "EONIA,2010-01-07,0.0037\n";
+    }
+    Size lines = store.loadCsv(csvFile);
+    if (lines != 4)
+        BOOST_ERROR("wrong number of lines read: " << lines);
+    FixingsStore::Id eonia = store.id("Eonia");
+    if (store.fixing(eonia, Date(4, January, 2010)) != 0.0034
+        || store.fixing(eonia, Date(5, January, 2010)) != 0.0035
+        || store.fixing(eonia, Date(6, January, 2010)) != Null<Real>()
+        || store.fixing(eonia, Date(7, January, 2010)) != 0.0037
+        || store.fixing(libor, Date(4, January, 2010)) != 0.0025)
+        BOOST_ERROR("wrong fixings loaded from CSV file");
+
+    store.saveBinary(binaryFile);
+    store.clear();
+    if (store.size() != 0 || store.hasId("Eonia"))
+        BOOST_ERROR("store was not cleared");
+    store.loadBinary(binaryFile);
+
+    // a truncated file is rejected without storing anything
+    std::string truncatedFile = "fixingsstore_test_truncated.bin";
+    {
+        std::ifstream in(binaryFile.c_str(), std::ios::binary);
+        std::string contents((std::istreambuf_iterator<char>(in)),
+                             std::istreambuf_iterator<char>());
+        std::ofstream out(truncatedFile.c_str(), std::ios::binary);
+        out.write(contents.data(), contents.size() - 16);
+    }
+    // the first index in the file is still complete
+    FixingsStore::Id firstIndex = store.id("Euribor6M Actual/360");
+    store.clearFixings(firstIndex);
+    raised = false;
+    try {
+        store.loadBinary(truncatedFile);
+    } catch (Error&) {
+        raised = true;
+    }
+    if (!raised)
+        BOOST_ERROR("truncated binary file was accepted");
+    if (store.hasFixings(firstIndex))
+        BOOST_ERROR("fixings stored from a truncated binary file");
+    store.loadBinary(binaryFile);
+    std::remove(csvFile.c_str());
+    std::remove(binaryFile.c_str());
+    std::remove(truncatedFile.c_str());
+
+    euribor = store.id("Euribor6M Actual/360");
+    eonia = store.id("Eonia");
+    if (store.size() != 3)
+        BOOST_ERROR("wrong number of indexes loaded: " << store.size());
+    if (store.fixing(eonia, Date(7, January, 2010)) != 0.0037)
+        BOOST_ERROR("wrong fixing loaded from binary file");
+    history = store.history(euribor);
+    for (TimeSeries<Real>::const_iterator i=expected.cbegin();
+         i!=expected.cend(); ++i) {
+        if (storedFixings[i->first] != i->second)
+            BOOST_ERROR("wrong value loaded from binary file at "
+                        << i->first);
+    }
+
+    store.clear();
+}
+
 test_suite* TimeSeriesTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("time series tests");
     suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testConstruction));
     suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testIntervalPrice));
     suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testIterators));
+    suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testFlatContainer));
+    suite->add(QUANTLIB_TEST_CASE(&TimeSeriesTest::testFixingsStore));
     return suite;
 }
 
@@ -23,6 +23,8 @@
 #include <ql/models/volatility/constantestimator.hpp>
 #include <ql/models/volatility/simplelocalestimator.hpp>
 #include <ql/models/volatility/garmanklass.hpp>
+#include <ql/models/volatility/garch.hpp>
+#include <ql/math/randomnumbers/mt19937uniformrng.hpp>
 #include <ql/timeseries.hpp>
 
 using namespace QuantLib;
@@ -45,9 +47,107 @@ void VolatilityModelsTest::testConstruction() {
     sv.begin();
 }
 
+namespace {
+
+    template <class Series1, class Series2>
+    void checkSameSeries(const Series1& expected, const Series2& calculated,
+                         const std::string& estimator) {
+        if (expected.size() != calculated.size()) {
+            BOOST_ERROR(estimator << ": size mismatch"
+                        << "\n    expected:   " << expected.size()
+                        << "\n    calculated: " << calculated.size());
+            return;
+        }
+        typename Series1::const_iterator i = expected.cbegin();
+        typename Series2::const_iterator j = calculated.cbegin();
+        for (; i != expected.cend(); ++i, ++j) {
+            if (i->first != j->first || i->second != j->second)
+                BOOST_ERROR(estimator << ": mismatch"
+                            << "\n    expected:   " << i->first
+                            << ", " << i->second
+                            << "\n    calculated: " << j->first
+                            << ", " << j->second);
+        }
+    }
+
+}
+
+void VolatilityModelsTest::testFlatSeries() {
+
+    BOOST_TEST_MESSAGE("Testing volatility models on flat time series...");
+
+    typedef TimeSeries<Real, FlatMap<Date, Real> > FlatSeries;
+    typedef TimeSeries<IntervalPrice, FlatMap<Date, IntervalPrice> >
+                                                           FlatPriceSeries;
+
+    MersenneTwisterUniformRng rng(42);
+    TimeSeries<Real> quotes;
+    FlatSeries flatQuotes;
+    TimeSeries<IntervalPrice> prices;
+    FlatPriceSeries flatPrices;
+    Date d(3, January, 2005);
+    Real s = 100.0;
+    for (Size i=0; i<500; ++i, d += (i%5 == 0 ? 3 : 1)) {
+        Real open = s*(1.0 + 0.01*(rng.next().value-0.5));
+        Real close = s*(1.0 + 0.02*(rng.next().value-0.5));
+        Real high = std::max(open, close)*(1.0 + 0.01*rng.next().value);
+        Real low = std::min(open, close)*(1.0 - 0.01*rng.next().value);
+        quotes[d] = flatQuotes[d] = close;
+        prices[d] = flatPrices[d] = IntervalPrice(open, close, high, low);
+        s = close;
+    }
+
+    SimpleLocalEstimator sle(1/360.0);
+    TimeSeries<Volatility> localVols = sle.calculate(quotes);
+    FlatSeries flatLocalVols = sle.calculate(flatQuotes);
+    checkSameSeries(localVols, flatLocalVols, "simple local estimator");
+
+    GarmanKlassSigma1 gk1(1/360.0, 0.3);
+    checkSameSeries(gk1.calculate(prices), gk1.calculate(flatPrices),
+                    "Garman-Klass sigma 1");
+    GarmanKlassSigma6 gk6(1/360.0, 0.3);
+    checkSameSeries(gk6.calculate(prices), gk6.calculate(flatPrices),
+                    "Garman-Klass sigma 6");
+    ParkinsonSigma parkinson(1/360.0);
+    checkSameSeries(parkinson.calculate(prices),
+                    parkinson.calculate(flatPrices), "Parkinson sigma");
+
+    ConstantEstimator ce(20);
+    checkSameSeries(ce.calculate(localVols), ce.calculate(flatLocalVols),
+                    "constant estimator");
+
+    // returns
+    TimeSeries<Volatility> returns;
+    FlatSeries flatReturns;
+    TimeSeries<Real>::const_iterator prev = quotes.cbegin(), cur = prev;
+    for (++cur; cur != quotes.cend(); ++cur, ++prev) {
+        returns[cur->first] = flatReturns[cur->first] =
+            std::log(cur->second/prev->second);
+    }
+    Garch11 garch(returns), flatGarch(flatReturns);
+    if (garch.alpha() != flatGarch.alpha() || garch.beta() != flatGarch.beta()
+        || garch.ltVol() != flatGarch.ltVol())
+        BOOST_ERROR("GARCH calibration mismatch"
+                    << "\n    expected:   " << garch.alpha() << ", "
+                    << garch.beta() << ", " << garch.ltVol()
+                    << "\n    calculated: " << flatGarch.alpha() << ", "
+                    << flatGarch.beta() << ", " << flatGarch.ltVol());
+    checkSameSeries(garch.calculate(returns), garch.calculate(flatReturns),
+                    "GARCH");
+
+    // calls through the base classes
+    LocalVolatilityEstimator<Real>& local = sle;
+    checkSameSeries(localVols, local.calculate(flatQuotes),
+                    "simple local estimator through base class");
+    VolatilityCompositor& compositor = garch;
+    checkSameSeries(garch.calculate(returns), compositor.calculate(flatReturns),
+                    "GARCH through base class");
+}
+
 test_suite* VolatilityModelsTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("volatility models tests");
     suite->add(QUANTLIB_TEST_CASE(&VolatilityModelsTest::testConstruction));
+    suite->add(QUANTLIB_TEST_CASE(&VolatilityModelsTest::testFlatSeries));
     return suite;
 }
 
@@ -28,6 +28,7 @@
 class VolatilityModelsTest {
   public:
     static void testConstruction();
+    static void testFlatSeries();
     static boost::unit_test_framework::test_suite* suite();
 };
 
@@ -57,6 +57,9 @@ void ZabrTest::testConsistency() {
         tau, forward, boost::assign::list_of(alpha)(beta)(nu)(rho)(1.0),
         std::vector<Real>(), 2);
 
+    ZabrSmileSection<ZabrFokkerPlanck> zabr4(
+        tau, forward, boost::assign::list_of(alpha)(beta)(nu)(rho)(1.0));
+
     Real k = 0.0001;
     while (k <= 0.70) {
         Real c0 = sabr.optionPrice(k);
@@ -64,6 +67,7 @@ void ZabrTest::testConsistency() {
         Real z1 = zabr1.optionPrice(k);
         Real z2 = zabr2.optionPrice(k);
         Real z3 = zabr3.optionPrice(k);
+        Real z4 = zabr4.optionPrice(k);
         if (std::fabs(z0 - c0) > tol)
             BOOST_ERROR("Zabr short maturity lognormal expansion price "
                           "("
@@ -84,12 +88,69 @@ void ZabrTest::testConsistency() {
                           "("
                           << z3 << ") deviates from Sabr Hagan 2002 price "
                                    "by " << (z3 - c0));
+        if (std::fabs(z4 - c0) > tol)
+            BOOST_ERROR("Zabr Fokker-Planck price "
+                          "("
+                          << z4 << ") deviates from Sabr Hagan 2002 price "
+                                   "by " << (z4 - c0));
         k += 0.0001;
     }
 }
 
+void ZabrTest::testDensityCache() {
+
+    BOOST_TEST_MESSAGE("Testing zabr forward density cache...");
+
+    Real alpha = 0.08;
+    Real beta = 0.70;
+    Real nu = 0.20;
+    Real rho = -0.30;
+    Real gamma = 1.0;
+    Real tau = 5.0;
+    Real forward = 0.03;
+
+    ZabrDensityCache &cache = ZabrDensityCache::instance();
+    Size capacity = cache.capacity();
+    cache.setCapacity(2);
+    cache.clear();
+
+    std::vector<Real> params =
+        boost::assign::list_of(alpha)(beta)(nu)(rho)(gamma);
+    ZabrSmileSection<ZabrFokkerPlanck> zabr0(tau, forward, params);
+    ZabrSmileSection<ZabrFokkerPlanck> zabr1(tau, forward, params);
+
+    if (cache.misses() != 1 || cache.hits() != 1 || cache.size() != 1)
+        BOOST_ERROR("unexpected cache usage:"
+                    << "\n    hits:   " << cache.hits()
+                    << "\n    misses: " << cache.misses()
+                    << "\n    size:   " << cache.size());
+
+    params[2] = 0.25;
+    ZabrSmileSection<ZabrFokkerPlanck> zabr2(tau, forward, params);
+    ZabrSmileSection<ZabrFokkerPlanck> zabr3(tau, 0.035, params);
+
+    if (cache.misses() != 3 || cache.size() != 2)
+        BOOST_ERROR("unexpected cache usage:"
+                    << "\n    misses: " << cache.misses()
+                    << "\n    size:   " << cache.size());
+
+    for (Real k = 0.005; k <= 0.10; k += 0.005) {
+        if (zabr0.optionPrice(k) != zabr1.optionPrice(k))
+            BOOST_ERROR("cached density gives different price at strike "
+                        << k << ": " << zabr1.optionPrice(k)
+                        << ", expected " << zabr0.optionPrice(k));
+        if (zabr0.optionPrice(k) == zabr2.optionPrice(k))
+            BOOST_ERROR("same price for different parameters at strike "
+                        << k << ": " << zabr2.optionPrice(k));
+    }
+
+    cache.setCapacity(capacity);
+    cache.clear();
+}
+
 test_suite *ZabrTest::suite() {
     test_suite *suite = BOOST_TEST_SUITE("NoArbSabrModel tests");
     suite->add(QUANTLIB_TEST_CASE(&ZabrTest::testConsistency));
+    suite->add(QUANTLIB_TEST_CASE(&ZabrTest::testDensityCache));
     return suite;
 }
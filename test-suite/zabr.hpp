@@ -28,6 +28,7 @@
 class ZabrTest {
   public:
     static void testConsistency();
+    static void testDensityCache();
     static boost::unit_test_framework::test_suite* suite();
 };
 